@@ -66,6 +66,8 @@ void wb_supervisor_world_reload();
 void wb_supervisor_simulation_quit(int status);
 void wb_supervisor_simulation_reset();
 void wb_supervisor_simulation_reset_physics();
+void wb_supervisor_simulation_save_state(const char *state_name);
+void wb_supervisor_simulation_load_state(const char *state_name);
 
 WbSimulationMode wb_supervisor_simulation_get_mode();
 void wb_supervisor_simulation_set_mode(WbSimulationMode mode);
@@ -30,6 +30,8 @@ namespace webots {
     virtual void simulationQuit(int status);
     virtual void simulationReset();
     virtual void simulationResetPhysics();
+    virtual void simulationSaveState(const std::string &stateName);
+    virtual void simulationLoadState(const std::string &stateName);
 
     SimulationMode simulationGetMode() const;
     virtual void simulationSetMode(SimulationMode mode);
@@ -281,6 +281,7 @@ ODE_API dSpaceID dGeomGetSpace (dGeomID);
  *  @li dSimpleSpaceClass
  *  @li dHashSpaceClass
  *  @li dQuadTreeSpaceClass
+ *  @li dBVHSpaceClass
  *  @li dFirstUserClass
  *  @li dLastUserClass
  *
@@ -383,6 +384,34 @@ ODE_API void dGeomDisable (dGeomID geom);
  */
 ODE_API int dGeomIsEnabled (dGeomID geom);
 
+/**
+ * @brief Enable or disable the sleep culling of a geom.
+ *
+ * A geom is sleeping if it is attached to a disabled body or if it has no
+ * body. The pairs of sleeping geoms which both have sleep culling enabled are
+ * ignored by dSpaceCollide and dSpaceCollide2: the resting geoms of the
+ * disabled bodies are removed from the collision detection with each other
+ * and with the static environment. They are still collided with the geoms of
+ * the enabled bodies, whose contacts wake them up. New geoms are created with
+ * sleep culling disabled.
+ *
+ * @param geom   the geom to change
+ * @param enabled non-zero to enable the sleep culling
+ * @sa dGeomGetSleepCulling
+ * @ingroup collide
+ */
+ODE_API void dGeomSetSleepCulling (dGeomID geom, int enabled);
+
+/**
+ * @brief Check to see if the sleep culling of a geom is enabled.
+ *
+ * @param geom   the geom to query
+ * @returns Non-zero if the sleep culling is enabled, zero otherwise.
+ * @sa dGeomSetSleepCulling
+ * @ingroup collide
+ */
+ODE_API int dGeomGetSleepCulling (dGeomID geom);
+
 enum
 {
 	dGeomCommonControlClass = 0,
@@ -755,6 +784,73 @@ ODE_API void dGeomGetOffsetQuaternion (dGeomID geom, dQuaternion result);
 ODE_API int dCollide (dGeomID o1, dGeomID o2, int flags, dContactGeom *contact,
 	      int skip);
 
+/**
+ * @brief Reduces a set of contact points to a few representative ones.
+ *
+ * The deepest contact is kept, then the contact farthest from it, and then
+ * the contacts that enlarge the most the polygon of the kept contacts,
+ * projected on the plane orthogonal to the normal of the deepest contact.
+ * This is useful with colliders that generate many nearly redundant contacts,
+ * like the trimesh and convex ones.
+ *
+ * @param contact Array of contacts, as in dCollide. The kept contacts are
+ * moved to the beginning of the array, in their original order. Only the
+ * dContactGeom part of the elements is moved.
+ * @param count Number of contacts in the array.
+ * @param skip Byte offset from one dContactGeom to the next in the array.
+ * @param maxContacts Maximum number of contacts to keep, no reduction if 0.
+ *
+ * @returns The number of kept contacts.
+ *
+ * @ingroup collide
+ */
+ODE_API int dReduceContacts (dContactGeom *contact, int count, int skip, int maxContacts);
+
+/**
+ * @brief Cost of the collisions between two geom classes, see dCollideEnableProfiling().
+ * @ingroup collide
+ */
+typedef struct dCollideProfile {
+  unsigned long callCount;     /* number of dCollide() calls reaching a collider */
+  unsigned long contactCount;  /* number of contacts returned by these calls */
+  double time;                 /* cumulative time spent in the collider, in seconds */
+} dCollideProfile;
+
+/**
+ * @brief Enables or disables the profiling of dCollide().
+ *
+ * When enabled, dCollide() records the number of calls, the number of
+ * contacts and the time spent in the collider for each pair of geom
+ * classes. The profiles are shared by all the threads and are kept when the
+ * profiling is disabled. The profiling is disabled by default, it then costs
+ * a single test per call.
+ *
+ * @ingroup collide
+ */
+ODE_API void dCollideEnableProfiling (int enable);
+
+/**
+ * @brief Returns 1 if the profiling of dCollide() is enabled, 0 otherwise.
+ * @ingroup collide
+ */
+ODE_API int dCollideIsProfilingEnabled (void);
+
+/**
+ * @brief Retrieves the profile of the collisions between two geom classes.
+ *
+ * The order of the classes does not matter: the calls with a geom of class1
+ * and a geom of class2 are counted in the same profile whatever their order.
+ *
+ * @ingroup collide
+ */
+ODE_API void dCollideGetProfile (int class1, int class2, dCollideProfile *profile);
+
+/**
+ * @brief Resets the profiles of all the pairs of geom classes.
+ * @ingroup collide
+ */
+ODE_API void dCollideResetProfiles (void);
+
 /**
  * @brief Determines which pairs of geoms in a space may potentially intersect,
  * and calls the callback function for each candidate pair.
@@ -859,7 +955,8 @@ enum {
   dHashSpaceClass,
   dSweepAndPruneSpaceClass, /* SAP */
   dQuadTreeSpaceClass,
-  dLastSpaceClass = dQuadTreeSpaceClass,
+  dBVHSpaceClass,
+  dLastSpaceClass = dBVHSpaceClass,
 
   dFirstUserClass,
   dLastUserClass = dFirstUserClass + dMaxUserClasses - 1,
@@ -63,6 +63,9 @@ ODE_API dSpaceID dQuadTreeSpaceCreate (dSpaceID space, const dVector3 Center, co
 
 ODE_API dSpaceID dSweepAndPruneSpaceCreate( dSpaceID space, int axisorder );
 
+/* dynamic AABB tree */
+ODE_API dSpaceID dBVHSpaceCreate (dSpaceID space);
+
 ODE_API void dSpaceDestroy (dSpaceID);
 
 ODE_API void dHashSpaceSetLevels (dSpaceID space, int minlevel, int maxlevel);
@@ -156,6 +159,7 @@ ODE_API dGeomID dSpaceGetGeom (dSpaceID, int i);
  *  @li dHashSpaceClass
  *  @li dSweepAndPruneSpaceClass
  *  @li dQuadTreeSpaceClass
+ *  @li dBVHSpaceClass
  *  @li dFirstUserClass
  *  @li dLastUserClass
  *
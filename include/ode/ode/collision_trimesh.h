@@ -86,6 +86,22 @@ ODE_API void dGeomTriMeshDataBuildDouble1(dTriMeshDataID g,
                                   const void* Indices, int IndexCount, int TriStride,
                                   const void* Normals);
 
+/*
+ * Build a TriMesh data object with double precision vertex data from a collision tree saved by
+ * dGeomTriMeshDataGetTree() for the same vertices and indices, which is much faster than building
+ * the tree. Returns 1 if the tree was loaded, 0 if it didn't match the mesh and had to be built.
+ */
+ODE_API int dGeomTriMeshDataBuildDoubleWithTree(dTriMeshDataID g,
+                                        const void* Vertices, int VertexStride, int VertexCount,
+                                        const void* Indices, int IndexCount, int TriStride,
+                                        const void* Tree, size_t TreeSize);
+/*
+ * Save the collision tree of a built TriMesh data object to 'Buffer' and return its size in bytes.
+ * If 'Buffer' is NULL, only the size is returned. The tree is only valid for this version of ODE
+ * and for the same architecture.
+ */
+ODE_API size_t dGeomTriMeshDataGetTree(dTriMeshDataID g, void* Buffer);
+
 /*
  * Simple build. Single/double precision based on dSINGLE/dDOUBLE!
  */
@@ -113,6 +113,8 @@ typedef dReal dQuaternion[4];
 #define dCeil(x) ceilf(x)			/* ceil */
 #define dCopySign(a,b) _ode_copysignf(a, b) /* copy value sign */
 #define dNextAfter(x, y) _ode_nextafterf(x, y) /* next value after */
+#define dMax(a, b) ((a) > (b) ? (a) : (b))
+#define dMin(a, b) ((a) > (b) ? (b) : (a))
 
 #ifdef HAVE___ISNANF
 #define dIsNan(x) (__isnanf(x))
@@ -175,6 +177,7 @@ struct dxGeom;		/* geometry (collision object) */
 struct dxJoint;
 struct dxJointNode;
 struct dxJointGroup;
+struct dxJointPool;
 struct dxWorldProcessThreadingManager;
 
 typedef struct dxWorld *dWorldID;
@@ -183,6 +186,7 @@ typedef struct dxBody *dBodyID;
 typedef struct dxGeom *dGeomID;
 typedef struct dxJoint *dJointID;
 typedef struct dxJointGroup *dJointGroupID;
+typedef struct dxJointPool *dJointPoolID;
 typedef struct dxWorldProcessThreadingManager *dWorldStepThreadingManagerID;
 
 /* error numbers */
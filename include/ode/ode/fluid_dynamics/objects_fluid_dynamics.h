@@ -342,6 +342,15 @@ ODE_API dImmersionOutlineID dImmersionOutlineCreate ();
  */
 ODE_API void dImmersionOutlineDestroy (dImmersionOutlineID);
 
+/**
+ * @brief Removes all the edges of an immersion outline
+ *
+ * The memory of the edges is kept, so that an outline can be reused by
+ * dImmerse() at every step without reallocating it.
+ * @ingroup fluids
+ */
+ODE_API void dImmersionOutlineReset (dImmersionOutlineID);
+
 /**
  * @brief Return the size of the straight edge array in the given immersion outline.
  * @ingroup fluids
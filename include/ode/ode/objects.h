@@ -411,6 +411,233 @@ ODE_API void dWorldSetQuickStepW (dWorldID, dReal over_relaxation);
  */
 ODE_API dReal dWorldGetQuickStepW (dWorldID);
 
+/**
+ * @brief Set the warm starting factor of the QuickStep method.
+ * @ingroup world
+ * @remarks
+ * When the factor is not zero, the SOR iterations start from the impulses
+ * computed at the previous step multiplied by this factor instead of zero.
+ * The impulses of contact joints, which are recreated at every step, are
+ * kept in a cache keyed by geom pair and contact feature. Resting contacts
+ * then need far fewer iterations to reach the same stability.
+ * @param factor in [0, 1]. The default is 0, i.e. no warm starting.
+ */
+ODE_API void dWorldSetQuickStepWarmStarting (dWorldID, dReal factor);
+
+/**
+ * @brief Get the warm starting factor of the QuickStep method.
+ * @ingroup world
+ * @returns the warm starting factor
+ */
+ODE_API dReal dWorldGetQuickStepWarmStarting (dWorldID);
+
+/**
+ * @brief Set the number of threads the QuickStep method uses to relax the
+ *        constraint rows of an island.
+ * @ingroup world
+ * @remarks
+ * With more than one thread, the joints are graph-coloured so that no two
+ * joints of a colour share a body, and the joints of a colour are relaxed
+ * in parallel. The colours are relaxed in a fixed order instead of the
+ * random order of the sequential solver, so the result differs from the
+ * single-threaded one but does not depend on the number of threads.
+ * No more threads than processor cores are used, and an island whose
+ * colours are too small to be shared between threads is relaxed by the
+ * sequential solver, unless the deterministic mode is enabled
+ * (dWorldSetQuickStepDeterministic), in which case it is relaxed by the
+ * coloured solver on a single thread.
+ * @param count The default is 1 thread.
+ */
+ODE_API void dWorldSetQuickStepThreadCount (dWorldID, int count);
+
+/**
+ * @brief Get the number of threads the QuickStep method uses to relax the
+ *        constraint rows of an island.
+ * @ingroup world
+ * @return nr of threads
+ */
+ODE_API int dWorldGetQuickStepThreadCount (dWorldID);
+
+/**
+ * @brief Set the deterministic mode of the QuickStep method.
+ * @ingroup world
+ * @remarks
+ * In deterministic mode, the graph-coloured relaxation is used even with a
+ * single thread, and the random reordering of the constraint rows is
+ * disabled. Results are then reproducible whatever the thread count.
+ * @param deterministic 0 to disable, the default, or 1 to enable.
+ */
+ODE_API void dWorldSetQuickStepDeterministic (dWorldID, int deterministic);
+
+/**
+ * @brief Get the deterministic mode of the QuickStep method.
+ * @ingroup world
+ * @returns 1 if the deterministic mode is enabled, 0 otherwise
+ */
+ODE_API int dWorldGetQuickStepDeterministic (dWorldID);
+
+/**
+ * @brief Set the number of threads dWorldStep uses to solve independent
+ *        islands.
+ * @ingroup world
+ * @remarks
+ * Islands are distributed over a persistent pool of worker threads, the
+ * calling thread being one of them. The result does not depend on the
+ * number of threads. dWorldQuickStep always solves islands sequentially.
+ * @param count The default is 1 thread.
+ */
+ODE_API void dWorldSetIslandThreadCount (dWorldID, int count);
+
+/**
+ * @brief Get the number of threads dWorldStep uses to solve independent
+ *        islands.
+ * @ingroup world
+ * @return nr of threads
+ */
+ODE_API int dWorldGetIslandThreadCount (dWorldID);
+
+/**
+ * @brief Solve the hinge and slider trees in reduced coordinates in
+ *        dWorldStep.
+ * @ingroup world
+ * @remarks
+ * Each tree of rigid hinges and sliders is integrated with the
+ * articulated-body algorithm, in O(n) of its number of links, and its
+ * joints can not drift apart. Contacts, joint limits, motors and the joints
+ * closing a loop are still solved by the LCP. Hinges with a suspension are
+ * not part of the trees. Damping and the maximum angular speed only apply to
+ * the root of a tree. dWorldQuickStep is not affected.
+ * @param articulated 1 to enable the articulated-body solver, 0 (default)
+ *        to disable it.
+ */
+ODE_API void dWorldSetArticulatedBodySolver (dWorldID, int articulated);
+
+/**
+ * @brief Get whether dWorldStep solves the hinge and slider trees in
+ *        reduced coordinates.
+ * @ingroup world
+ */
+ODE_API int dWorldGetArticulatedBodySolver (dWorldID);
+
+/**
+ * @brief Keep the forces and torques added to the bodies over the steps.
+ * @ingroup world
+ * @remarks
+ * By default dWorldStep and dWorldQuickStep clear the force and torque
+ * accumulators of the bodies. When this flag is set, the accumulators are
+ * restored to their value before the step instead, so that the same forces
+ * are applied by the following steps. This is used to divide a time step in
+ * several smaller steps without adding the forces again. The first step run
+ * after clearing the flag clears the accumulators.
+ * @param keep 1 to keep the forces, 0 (default) to clear them after each
+ *        step.
+ */
+ODE_API void dWorldSetKeepForces (dWorldID, int keep);
+
+/**
+ * @brief Get whether the steps keep the forces and torques of the bodies.
+ * @ingroup world
+ */
+ODE_API int dWorldGetKeepForces (dWorldID);
+
+/**
+ * @brief Make the result of a step independent of the order of the bodies
+ *        in the world.
+ * @ingroup world
+ * @remarks
+ * The order of the bodies in a world changes when they are moved between
+ * the worlds of the ODE_MT clusters, and the islands are built from this
+ * order. In deterministic mode, the islands are built from the bodies in
+ * their creation order, so an island is solved the same way whatever the
+ * world it belongs to and whatever the number of threads. The contact
+ * joints must also be created in the same order. With dWorldQuickStep, the
+ * deterministic mode of the QuickStep method must be enabled as well.
+ * @param deterministic 1 to enable, 0 (default) to disable.
+ */
+ODE_API void dWorldSetDeterministic (dWorldID, int deterministic);
+
+/**
+ * @brief Get whether the result of a step is independent of the order of
+ *        the bodies in the world.
+ * @ingroup world
+ */
+ODE_API int dWorldGetDeterministic (dWorldID);
+
+/**
+ * @brief Give the world its own random number generator.
+ * @ingroup world
+ * @remarks
+ * By default, dWorldQuickStep draws the order in which it relaxes the
+ * constraint rows from the global generator of dRandSetSeed, which is shared
+ * by all the worlds of the process. The results of a world then depend on the
+ * steps of the other worlds, and worlds stepped in different threads race on
+ * the global seed. Once a seed is set, the world draws from its own
+ * generator, so that independent worlds can be stepped in parallel and reset
+ * separately, with the same results as if each one was alone in the process.
+ * The clusters of ODE_MT keep using the global generator.
+ * @param seed the initial state of the generator of the world.
+ */
+ODE_API void dWorldSetRandomSeed (dWorldID, unsigned long seed);
+
+/**
+ * @brief Get the current state of the random number generator of the world.
+ * @ingroup world
+ * @remarks
+ * Returns the state of the global generator if the world has no generator of
+ * its own. Setting it back with dWorldSetRandomSeed restarts the sequence at
+ * the same point.
+ */
+ODE_API unsigned long dWorldGetRandomSeed (dWorldID);
+
+/**
+ * @brief Get the size of the buffer needed by dWorldSaveState.
+ * @ingroup world
+ * @param bodies the bodies whose state is saved, or NULL for all the bodies
+ * of the world.
+ * @param count the number of bodies, ignored if bodies is NULL.
+ */
+ODE_API size_t dWorldGetStateSize (dWorldID, const dBodyID *bodies, int count);
+
+/**
+ * @brief Save the dynamic state of the world in memory.
+ * @ingroup world
+ * @remarks
+ * The state holds the positions, orientations, velocities, accumulated
+ * forces and sleeping status of the bodies, the random generator used by
+ * dWorldQuickStep and the contact impulses kept for warm starting. It also
+ * holds the joints attached to the bodies, except the contact joints: their
+ * enabled status, feedback, impulses of the last step and internal
+ * parameters, such as the relative orientation from which the angles are
+ * measured. The order of the geoms in the spaces of the geoms of the bodies
+ * is saved as well, as the collision detection reports the contacts in this
+ * order. The parameters of the world, the masses and the geoms themselves are
+ * not saved, and the contact joints are expected to be created again by the
+ * collision detection.
+ *
+ * The state refers to the bodies and joints by address, so it can only be
+ * loaded in the same process, into the same bodies and joints. In ODE_MT
+ * cluster mode, the bodies are spread over the worlds of the clusters: pass
+ * them explicitly, the contact impulses of the clusters are not saved.
+ * @param bodies the bodies whose state is saved, or NULL for all the bodies
+ * of the world.
+ * @param count the number of bodies, ignored if bodies is NULL.
+ * @param buffer at least dWorldGetStateSize bytes.
+ */
+ODE_API void dWorldSaveState (dWorldID, const dBodyID *bodies, int count, void *buffer);
+
+/**
+ * @brief Load a state saved by dWorldSaveState.
+ * @ingroup world
+ * @remarks
+ * The bodies have to be given in the same order as when the state was saved,
+ * with the same joints attached and the same geoms in their spaces. Nothing
+ * is changed if they differ. The geoms of these spaces are removed and added
+ * again in the saved order, they are considered as moved.
+ * @return 1 if the state was loaded, 0 if the bodies, their joints or the
+ * geoms of their spaces do not match the saved ones.
+ */
+ODE_API int dWorldLoadState (dWorldID, const dBodyID *bodies, int count, const void *buffer, size_t size);
+
 /* World contact parameter functions */
 
 /**
@@ -1680,6 +1907,65 @@ ODE_API void dJointGroupEmpty (dJointGroupID);
 
 ODE_API int dJointGroupGetCount(dJointGroupID);
 
+/**
+ * @brief Create a joint pool
+ * @ingroup joints
+ *
+ * The contact joints of the joint groups created from a pool are stored in
+ * slots shared by all these groups. Emptying a group gives its slots back to
+ * the pool, which only allocates memory when more contact joints are used
+ * than ever before: once this high-water mark is reached, creating and
+ * emptying the contact joints does not allocate any memory.
+ * The other types of joints are stored in their own group.
+ * A pool is not thread safe: its groups must be filled and emptied by a
+ * single thread at a time.
+ * @param initial_capacity number of slots allocated at once, typically the
+ * high-water mark of a previous run. Set to 0 to let the pool grow from the
+ * first contact joints.
+ */
+ODE_API dJointPoolID dJointPoolCreate (int initial_capacity);
+
+/**
+ * @brief Destroy a joint pool.
+ * @ingroup joints
+ *
+ * The joint groups created from the pool must be destroyed first.
+ */
+ODE_API void dJointPoolDestroy (dJointPoolID);
+
+/**
+ * @brief Create a joint group storing its contact joints in a pool
+ * @ingroup joints
+ * @sa dJointPoolCreate
+ */
+ODE_API dJointGroupID dJointGroupCreateFromPool (dJointPoolID);
+
+/**
+ * @brief Return the number of contact joints the pool can store without
+ * allocating memory.
+ * @ingroup joints
+ */
+ODE_API int dJointPoolGetCapacity (dJointPoolID);
+
+/**
+ * @brief Return the number of contact joints currently stored in the pool.
+ * @ingroup joints
+ */
+ODE_API int dJointPoolGetCount (dJointPoolID);
+
+/**
+ * @brief Return the largest number of contact joints ever stored in the pool.
+ * @ingroup joints
+ */
+ODE_API int dJointPoolGetHighWaterMark (dJointPoolID);
+
+/**
+ * @brief Return the number of memory allocations made by the pool since its
+ * creation.
+ * @ingroup joints
+ */
+ODE_API int dJointPoolGetAllocationCount (dJointPoolID);
+
 /**
  * @brief Return the number of bodies attached to the joint
  * @ingroup joints
@@ -61,9 +61,15 @@ ODE_API int dClusterGetCount(dWorldID _world, dSpaceID _space);
 ODE_API float dClusterGetGridStep(dWorldID _world, dSpaceID _space);
 ODE_API void dClusterGetCenter(dWorldID _world, dSpaceID _space, float &_x, float &_y, float &_z);
 ODE_API dxClusterNode** dClusterGetClusterAABBs(dWorldID _world, dSpaceID _space);
+// 'threadID' is the task index passed to the space update function, each task handles a single cluster
 ODE_API int dThreadGetSpacesCount(int threadID);
 ODE_API dSpaceID dThreadGetSpaceID(int threadID, int index);
 
+// runs 'function' on every task in [0, taskCount) using at most 'maxThreads' threads of the work-stealing pool shared with
+// the clusters, island and QuickStep threading, 'worker' is in [0, maxThreads) and the calling thread is worker 0
+typedef void dWorkerTaskFunction(unsigned int task, unsigned int worker, void *data);
+ODE_API void dRunWorkerTasks(unsigned int taskCount, unsigned int maxThreads, dWorkerTaskFunction *function, void *data);
+
 #ifdef __cplusplus
 }
 #endif
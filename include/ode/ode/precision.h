@@ -3,8 +3,14 @@
 
 /* Define dSINGLE for single precision, dDOUBLE for double precision,
  * but never both!
+ * Webots uses the double precision by default. Building ODE, Webots and the
+ * physics plugins with "make ODE_PRECISION=single" defines dIDESINGLE.
  */
 
+#if defined(dIDESINGLE)
+#define dSINGLE
+#else
 #define dDOUBLE
+#endif
 
 #endif
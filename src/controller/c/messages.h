@@ -122,6 +122,10 @@
 #define C_SUPERVISOR_POSE_CHANGE_TRACKING_STATE 102
 #define C_SUPERVISOR_CONTACT_POINTS_CHANGE_TRACKING_STATE 103
 
+// ctr -> sim
+#define C_SUPERVISOR_SIMULATION_SAVE_STATE 104
+#define C_SUPERVISOR_SIMULATION_LOAD_STATE 105
+
 // for the camera device
 // ctr -> sim
 #define C_CAMERA_SET_FOV 4
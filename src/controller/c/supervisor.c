@@ -481,6 +481,8 @@ static WbNodeRef save_node_state_node_ref = NULL;
 static const char *save_node_state_name = NULL;
 static WbNodeRef reset_node_state_node_ref = NULL;
 static const char *reset_node_state_name = NULL;
+static const char *save_simulation_state_name = NULL;
+static const char *load_simulation_state_name = NULL;
 
 static void supervisor_cleanup(WbDevice *d) {
   clean_field_request_garbage_collector();
@@ -901,6 +903,14 @@ static void supervisor_write_request(WbDevice *d, WbRequest *r) {
     request_write_uint32(r, reset_node_state_node_ref->id);
     request_write_string(r, reset_node_state_name);
   }
+  if (save_simulation_state_name) {
+    request_write_uchar(r, C_SUPERVISOR_SIMULATION_SAVE_STATE);
+    request_write_string(r, save_simulation_state_name);
+  }
+  if (load_simulation_state_name) {
+    request_write_uchar(r, C_SUPERVISOR_SIMULATION_LOAD_STATE);
+    request_write_string(r, load_simulation_state_name);
+  }
   if (set_joint_node_ref) {
     request_write_uchar(r, C_SUPERVISOR_NODE_SET_JOINT_POSITION);
     request_write_uint32(r, set_joint_node_ref->id);
@@ -1668,6 +1678,38 @@ void wb_supervisor_simulation_reset() {
   robot_mutex_unlock_step();
 }
 
+void wb_supervisor_simulation_save_state(const char *state_name) {
+  if (!robot_check_supervisor(__FUNCTION__))
+    return;
+
+  if (!state_name) {
+    fprintf(stderr, "Error: %s() called with a NULL 'state_name' argument.\n", __FUNCTION__);
+    return;
+  }
+
+  robot_mutex_lock_step();
+  save_simulation_state_name = state_name;
+  wb_robot_flush_unlocked();
+  save_simulation_state_name = NULL;
+  robot_mutex_unlock_step();
+}
+
+void wb_supervisor_simulation_load_state(const char *state_name) {
+  if (!robot_check_supervisor(__FUNCTION__))
+    return;
+
+  if (!state_name) {
+    fprintf(stderr, "Error: %s() called with a NULL 'state_name' argument.\n", __FUNCTION__);
+    return;
+  }
+
+  robot_mutex_lock_step();
+  load_simulation_state_name = state_name;
+  wb_robot_flush_unlocked();
+  load_simulation_state_name = NULL;
+  robot_mutex_unlock_step();
+}
+
 void wb_supervisor_simulation_revert() {
   if (!robot_check_supervisor(__FUNCTION__))
     return;
@@ -59,6 +59,14 @@ void Supervisor::simulationReset() {
   wb_supervisor_simulation_reset();
 }
 
+void Supervisor::simulationSaveState(const std::string &stateName) {
+  wb_supervisor_simulation_save_state(stateName.c_str());
+}
+
+void Supervisor::simulationLoadState(const std::string &stateName) {
+  wb_supervisor_simulation_load_state(stateName.c_str());
+}
+
 Supervisor::SimulationMode Supervisor::simulationGetMode() const {
   return SimulationMode(wb_supervisor_simulation_get_mode());
 }
@@ -12,7 +12,9 @@
 #ifndef __ICECONTAINER_H__
 #define __ICECONTAINER_H__
 
-	#define CONTAINER_STATS
+	// the statistics are global counters updated by every container, they are disabled because the trimesh colliders of the
+	// worker threads use their own containers concurrently
+//	#define CONTAINER_STATS
 
 	enum FindMode
 	{
@@ -209,6 +209,46 @@ bool Model::Build(const OPCODECREATE& create)
 	return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Loads a collision model from nodes previously saved with AABBNoLeafTree::Save(), instead of building it.
+ *	Only no-leaf, non-quantized trees are supported.
+ *	\param		create		[in] model creation structure, mSettings is ignored
+ *	\param		nodes		[in] saved nodes
+ *	\param		nb_nodes	[in] number of saved nodes
+ *	\return		true if success
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool Model::Load(const OPCODECREATE& create, const void* nodes, udword nb_nodes)
+{
+	// 1) Checkings
+	if(!create.mIMesh || !create.mIMesh->IsValid())	return false;
+	if(!create.mNoLeaf || create.mQuantized)	return SetIceError("OPCODE WARNING: only no-leaf non-quantized trees can be loaded.\n", null);
+
+	Release();
+
+	SetMeshInterface(create.mIMesh);
+
+	// Same special case for 1-triangle meshes as in Build()
+	udword NbTris = create.mIMesh->GetNbTriangles();
+	if(NbTris==1)
+	{
+		mModelCode |= OPC_SINGLE_NODE;
+		return nb_nodes==0;
+	}
+	if(nb_nodes!=NbTris-1)	return false;
+
+	// 2) Create the optimized tree and fill it with the saved nodes
+	if(!CreateTree(true, false))	return false;
+	if(!static_cast<AABBNoLeafTree*>(mTree)->Load(nodes, nb_nodes))
+	{
+		DELETESINGLE(mTree);
+		return false;
+	}
+
+	return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /**
  *	Gets the number of bytes used by the tree.
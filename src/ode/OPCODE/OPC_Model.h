@@ -36,6 +36,18 @@
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		override(BaseModel)	bool				Build(const OPCODECREATE& create);
 
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/**
+		 *	Loads a collision model from nodes previously saved with AABBNoLeafTree::Save(), instead of building it.
+		 *	Only no-leaf, non-quantized trees are supported.
+		 *	\param		create		[in] model creation structure, mSettings is ignored
+		 *	\param		nodes		[in] saved nodes
+		 *	\param		nb_nodes	[in] number of saved nodes
+		 *	\return		true if success
+		 */
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+							bool				Load(const OPCODECREATE& create, const void* nodes, udword nb_nodes);
+
 #ifdef __MESHMERIZER_H__
 		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		/**
@@ -347,6 +347,70 @@ bool AABBNoLeafTree::Build(AABBTree* tree)
 	return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Saves the nodes to a buffer of GetUsedBytes() bytes. Child pointers are replaced by byte offsets from the first node.
+ *	\param		buffer			[out] destination buffer
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void AABBNoLeafTree::Save(void* buffer) const
+{
+	AABBNoLeafNode* Nodes = (AABBNoLeafNode*)buffer;
+	CopyMemory(Nodes, mNodes, mNbNodes*sizeof(AABBNoLeafNode));
+	for(udword i=0;i<mNbNodes;i++)
+	{
+		// Leaves are primitive indices, internal nodes are pointers
+		if(!Nodes[i].HasPosLeaf())	Nodes[i].mPosData -= size_t(mNodes);
+		if(!Nodes[i].HasNegLeaf())	Nodes[i].mNegData -= size_t(mNodes);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ *	Loads the nodes saved by Save() and relocates the child offsets.
+ *	\param		buffer			[in] saved nodes
+ *	\param		nb_nodes		[in] number of saved nodes, i.e. number of primitives - 1
+ *	\return		true if success, false if the buffer doesn't describe a valid tree
+ */
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool AABBNoLeafTree::Load(const void* buffer, udword nb_nodes)
+{
+	// Checkings
+	if(!buffer || !nb_nodes)	return false;
+
+	if(mNbNodes!=nb_nodes)
+	{
+		mNbNodes = nb_nodes;
+		DELETEARRAY(mNodes);
+		mNodes = new AABBNoLeafNode[mNbNodes];
+		CHECKALLOC(mNodes);
+	}
+	CopyMemory(mNodes, buffer, mNbNodes*sizeof(AABBNoLeafNode));
+
+	// The children are always stored after their parent (see _BuildNoLeafTree), which also guarantees
+	// that a corrupted buffer can't create cycles.
+	const size_t Size = mNbNodes*sizeof(AABBNoLeafNode);
+	for(udword i=0;i<mNbNodes;i++)
+	{
+		size_t* Children[2] = { &mNodes[i].mPosData, &mNodes[i].mNegData };
+		for(udword j=0;j<2;j++)
+		{
+			size_t& Child = *Children[j];
+			bool Valid;
+			if(Child&1)	Valid = (Child>>1)<=mNbNodes;
+			else		Valid = Child%sizeof(AABBNoLeafNode)==0 && Child>i*sizeof(AABBNoLeafNode) && Child<Size;
+			if(!Valid)
+			{
+				mNbNodes = 0;
+				DELETEARRAY(mNodes);
+				return false;
+			}
+			if(!(Child&1))	Child += size_t(mNodes);
+		}
+	}
+	return true;
+}
+
 inline_ void ComputeMinMax(Point& min, Point& max, const VertexPointers& vp)
 {
 	// Compute triangle's AABB = a leaf box
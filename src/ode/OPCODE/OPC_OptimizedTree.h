@@ -183,6 +183,25 @@
 	class OPCODE_API AABBNoLeafTree : public AABBOptimizedTree
 	{
 		IMPLEMENT_COLLISION_TREE(AABBNoLeafTree, AABBNoLeafNode)
+
+		public:
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/**
+		 *	Saves the nodes to a buffer of GetUsedBytes() bytes. Child pointers are replaced by byte offsets from the first node.
+		 *	\param		buffer			[out] destination buffer
+		 */
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+						void				Save(void* buffer)								const;
+
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+		/**
+		 *	Loads the nodes saved by Save() and relocates the child offsets.
+		 *	\param		buffer			[in] saved nodes
+		 *	\param		nb_nodes		[in] number of saved nodes, i.e. number of primitives - 1
+		 *	\return		true if success, false if the buffer doesn't describe a valid tree
+		 */
+		///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+						bool				Load(const void* buffer, udword nb_nodes);
 	};
 
 	class OPCODE_API AABBQuantizedTree : public AABBOptimizedTree
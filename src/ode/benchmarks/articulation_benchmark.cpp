@@ -0,0 +1,217 @@
+/*
+ * Articulated-body solver benchmark
+ *
+ * Steps a chain of hinges hanging from the static environment and a floating
+ * humanoid-like tree of hinges and sliders falling on the ground, with
+ * dWorldStep in maximal coordinates and with dWorldSetArticulatedBodySolver.
+ * Reports the time per step, the largest gap between the anchors of the
+ * joints and the energy of the chain, for increasing step sizes.
+ *
+ * Usage: articulation_benchmark [number of chain links] [simulated time in s]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define MAX_CONTACTS 4
+
+struct Scene {
+    dWorldID world;
+    dSpaceID space;
+    dJointGroupID contacts;
+    std::vector<dBodyID> bodies;
+    std::vector<dJointID> joints;
+};
+
+static dBodyID createLink(Scene *scene, const dReal *pos, dReal lx, dReal ly, dReal lz)
+{
+    dBodyID body = dBodyCreate(scene->world);
+    dMass mass;
+    dMassSetBox(&mass, 1000, lx, ly, lz);
+    dBodySetMass(body, &mass);
+    dBodySetPosition(body, pos[0], pos[1], pos[2]);
+    dGeomID geom = dCreateBox(scene->space, lx, ly, lz);
+    dGeomSetBody(geom, body);
+    scene->bodies.push_back(body);
+    return body;
+}
+
+static dJointID createHinge(Scene *scene, dBodyID b1, dBodyID b2, const dReal *anchor, const dReal *axis)
+{
+    dJointID joint = dJointCreateHinge(scene->world, 0);
+    dJointAttach(joint, b1, b2);
+    dJointSetHingeAnchor(joint, anchor[0], anchor[1], anchor[2]);
+    dJointSetHingeAxis(joint, axis[0], axis[1], axis[2]);
+    scene->joints.push_back(joint);
+    return joint;
+}
+
+// horizontal chain of hinges along x, attached to the static environment
+static void createChain(Scene *scene, int links)
+{
+    const dReal length = 0.1, axis[3] = {0, 1, 0};
+    dBodyID previous = 0;
+    for (int i = 0; i < links; ++i) {
+        const dReal pos[3] = {(i + REAL(0.5)) * length, 0, 10}, anchor[3] = {i * length, 0, 10};
+        dBodyID body = createLink(scene, pos, length, REAL(0.02), REAL(0.02));
+        createHinge(scene, body, previous, anchor, axis);
+        previous = body;
+    }
+}
+
+// torso with a head on a slider, two legs of 6 hinges and two arms of 4 hinges
+static void createHumanoid(Scene *scene)
+{
+    const dReal axes[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    const dReal torso[3] = {0, 0, REAL(1.1)};
+    dBodyID root = createLink(scene, torso, REAL(0.3), REAL(0.2), REAL(0.5));
+
+    const dReal headPos[3] = {0, 0, REAL(1.45)};
+    dBodyID head = createLink(scene, headPos, REAL(0.15), REAL(0.15), REAL(0.15));
+    dJointID neck = dJointCreateSlider(scene->world, 0);
+    dJointAttach(neck, head, root);
+    dJointSetSliderAxis(neck, 0, 0, 1);
+    dJointSetSliderParam(neck, dParamLoStop, -0.02);
+    dJointSetSliderParam(neck, dParamHiStop, 0.02);
+    scene->joints.push_back(neck);
+
+    for (int side = -1; side <= 1; side += 2) {
+        dBodyID parent = root;
+        for (int i = 0; i < 6; ++i) {
+            const dReal z = REAL(0.85) - REAL(0.14) * i;
+            const dReal pos[3] = {0, REAL(0.1) * side, z - REAL(0.07)}, anchor[3] = {0, REAL(0.1) * side, z};
+            dBodyID body = createLink(scene, pos, REAL(0.08), REAL(0.08), REAL(0.12));
+            dJointID joint = createHinge(scene, body, parent, anchor, axes[i % 3]);
+            dJointSetHingeParam(joint, dParamLoStop, -0.5);
+            dJointSetHingeParam(joint, dParamHiStop, 0.5);
+            parent = body;
+        }
+        parent = root;
+        for (int i = 0; i < 4; ++i) {
+            const dReal y = (REAL(0.2) + REAL(0.12) * i) * side;
+            const dReal pos[3] = {0, y + REAL(0.06) * side, REAL(1.3)}, anchor[3] = {0, y, REAL(1.3)};
+            dBodyID body = createLink(scene, pos, REAL(0.1), REAL(0.1), REAL(0.06));
+            dJointID joint = createHinge(scene, body, parent, anchor, axes[(i + 1) % 3]);
+            dJointSetHingeParam(joint, dParamFMax, 20);
+            dJointSetHingeParam(joint, dParamVel, side * 0.5);
+            parent = body;
+        }
+    }
+}
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Scene *scene = (Scene *)data;
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (b1 && b2)
+        return;  // no self-collisions
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1;
+        contact[i].surface.mu = 1;
+        dJointID c = dJointCreateContact(scene->world, scene->contacts, &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static dReal jointGap(dJointID joint)
+{
+    dVector3 a1, a2;
+    if (dJointGetType(joint) == dJointTypeHinge) {
+        dJointGetHingeAnchor(joint, a1);
+        dJointGetHingeAnchor2(joint, a2);
+        return sqrt((a1[0] - a2[0]) * (a1[0] - a2[0]) + (a1[1] - a2[1]) * (a1[1] - a2[1]) + (a1[2] - a2[2]) * (a1[2] - a2[2]));
+    }
+    // slider: distance of the second body from the slider axis of the first one
+    dBodyID b1 = dJointGetBody(joint, 0), b2 = dJointGetBody(joint, 1);
+    const dReal *p1 = dBodyGetPosition(b1), *p2 = dBodyGetPosition(b2);
+    dVector3 axis, d;
+    dJointGetSliderAxis(joint, axis);
+    for (int i = 0; i < 3; ++i) d[i] = p2[i] - p1[i];
+    const dReal t = d[0] * axis[0] + d[1] * axis[1] + d[2] * axis[2];
+    for (int i = 0; i < 3; ++i) d[i] -= t * axis[i];
+    return sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+}
+
+static dReal energy(const Scene &scene)
+{
+    dReal e = 0;
+    for (size_t i = 0; i < scene.bodies.size(); ++i) {
+        dBodyID b = scene.bodies[i];
+        dMass m;
+        dBodyGetMass(b, &m);
+        const dReal *v = dBodyGetLinearVel(b), *w = dBodyGetAngularVel(b), *R = dBodyGetRotation(b);
+        dVector3 wl;  // angular velocity in the body frame
+        for (int k = 0; k < 3; ++k) wl[k] = R[k] * w[0] + R[4 + k] * w[1] + R[8 + k] * w[2];
+        dReal rot = 0;
+        for (int r = 0; r < 3; ++r)
+            for (int k = 0; k < 3; ++k) rot += wl[r] * m.I[4 * r + k] * wl[k];
+        e += 0.5 * m.mass * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) + 0.5 * rot + m.mass * 9.81 * dBodyGetPosition(b)[2];
+    }
+    return e;
+}
+
+static void run(bool humanoid, int links, bool articulated, dReal stepsize, dReal duration)
+{
+    Scene scene;
+    scene.world = dWorldCreate();
+    scene.space = dHashSpaceCreate(0);
+    scene.contacts = dJointGroupCreate(0);
+    dWorldSetGravity(scene.world, 0, 0, -9.81);
+    dWorldSetArticulatedBodySolver(scene.world, articulated);
+    if (humanoid) {
+        createHumanoid(&scene);
+        dCreatePlane(scene.space, 0, 0, 1, 0);
+    } else
+        createChain(&scene, links);
+
+    const dReal e0 = energy(scene);
+    dReal maxGap = 0;
+    const int steps = (int)(duration / stepsize + 0.5);
+    double time = 0;
+    for (int s = 0; s < steps; ++s) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dSpaceCollide(scene.space, &scene, &nearCallback);
+        dWorldStep(scene.world, stepsize);
+        dJointGroupEmpty(scene.contacts);
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (size_t j = 0; j < scene.joints.size(); ++j) {
+            const dReal gap = jointGap(scene.joints[j]);
+            if (!(gap <= maxGap))
+                maxGap = gap;
+        }
+    }
+    const dReal *p = dBodyGetPosition(scene.bodies.back());
+    printf("%-9s %-12s %8.4f %10.4f %12.2e %12.3f   (%.3f %.3f %.3f)\n", humanoid ? "humanoid" : "chain",
+           articulated ? "articulated" : "maximal", stepsize, 1000 * time / steps, maxGap,
+           humanoid ? 0.0 : (energy(scene) - e0) / scene.bodies.size(), p[0], p[1], p[2]);
+
+    dJointGroupDestroy(scene.contacts);
+    dSpaceDestroy(scene.space);
+    dWorldDestroy(scene.world);
+}
+
+int main(int argc, char **argv)
+{
+    const int links = argc > 1 ? atoi(argv[1]) : 30;
+    const dReal duration = argc > 2 ? atof(argv[2]) : 2;
+    // the free chain whips much faster than the humanoid
+    const dReal steps[2][3] = {{REAL(0.001), REAL(0.002), REAL(0.004)}, {REAL(0.004), REAL(0.016), REAL(0.032)}};
+
+    dInitODE();
+    printf("%d chain links, 22 humanoid links, %g s\n", links, duration);
+    printf("%-9s %-12s %8s %10s %12s %12s   %s\n", "scene", "solver", "step [s]", "ms/step", "joint gap", "energy/link",
+           "last link");
+    for (int scene = 0; scene < 2; ++scene)
+        for (int i = 0; i < 3; ++i)
+            for (int articulated = 0; articulated < 2; ++articulated)
+                run(scene == 1, links, articulated != 0, steps[scene][i], duration);
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
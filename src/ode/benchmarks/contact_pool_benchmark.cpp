@@ -0,0 +1,244 @@
+/*
+ * Contact joint pool benchmark
+ *
+ * Drops stacks of boxes on a ground plane and manages their contact joints
+ * like Webots: each body owns a contact joint group in each of two buffers
+ * used alternately, and only the groups of the enabled bodies are emptied.
+ * The groups are either plain joint groups, each with its own memory arenas,
+ * or groups created from a joint pool (dJointGroupCreateFromPool), which is
+ * either empty or given the high-water mark of the previous run at creation.
+ * The memory allocations of ODE are counted with a custom allocator.
+ *
+ * Usage: contact_pool_benchmark [steps] [number of boxes] [rounds]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#define MAX_CONTACTS 4
+
+static long long gAllocationCount = 0;
+static long long gAllocatedBytes = 0;
+static long long gPeakAllocatedBytes = 0;
+
+static void *countingAlloc(size_t size)
+{
+    ++gAllocationCount;
+    gAllocatedBytes += size;
+    if (gAllocatedBytes > gPeakAllocatedBytes)
+        gPeakAllocatedBytes = gAllocatedBytes;
+    return malloc(size);
+}
+
+static void *countingRealloc(void *ptr, size_t oldsize, size_t newsize)
+{
+    ++gAllocationCount;
+    gAllocatedBytes += newsize - oldsize;
+    if (gAllocatedBytes > gPeakAllocatedBytes)
+        gPeakAllocatedBytes = gAllocatedBytes;
+    return realloc(ptr, newsize);
+}
+
+static void countingFree(void *ptr, size_t size)
+{
+    gAllocatedBytes -= size;
+    free(ptr);
+}
+
+struct Scene {
+    dWorldID world;
+    dSpaceID space;
+    dJointPoolID pool;
+    std::map<dBodyID, dJointGroupID> groups[2];
+    int buffer;
+    std::vector<dBodyID> boxes;
+};
+
+static dJointGroupID bodyContactJointGroup(Scene *scene, dBodyID body)
+{
+    std::map<dBodyID, dJointGroupID> &groups = scene->groups[scene->buffer];
+    std::map<dBodyID, dJointGroupID>::iterator it = groups.find(body);
+    if (it != groups.end())
+        return it->second;
+    dJointGroupID group = scene->pool ? dJointGroupCreateFromPool(scene->pool) : dJointGroupCreate(0);
+    groups[body] = group;
+    return group;
+}
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Scene *scene = static_cast<Scene *>(data);
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (!b1 && !b2)
+        return;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1;
+        contact[i].surface.mu = 0.8;
+        dJointID c = dJointCreateContact(scene->world, bodyContactJointGroup(scene, b1 ? b1 : b2), &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static void emptyEnabledBodyContactJointGroups(Scene *scene, int buffer)
+{
+    std::map<dBodyID, dJointGroupID> &groups = scene->groups[buffer];
+    for (std::map<dBodyID, dJointGroupID>::iterator it = groups.begin(); it != groups.end(); ++it) {
+        if (dBodyIsEnabled(it->first))
+            dJointGroupEmpty(it->second);
+    }
+}
+
+static void createScene(Scene *scene, int boxCount, bool pooled, int initialCapacity)
+{
+    scene->world = dWorldCreate();
+    scene->space = dSimpleSpaceCreate(NULL);
+    scene->pool = pooled ? dJointPoolCreate(initialCapacity) : NULL;
+    scene->buffer = 0;
+    // the SOR constraint order is randomized, all the runs have to start from the same seed
+    dRandSetSeed(0);
+    dWorldSetGravity(scene->world, 0, 0, -9.81);
+    dCreatePlane(scene->space, 0, 0, 1, 0);
+
+    // stacks of 4 boxes on a square grid, slightly rotated so that they keep sliding on each other for a while
+    const dReal size = 0.5;
+    const int stacks = (boxCount + 3) / 4;
+    const int side = (int)ceil(sqrt((double)stacks));
+    for (int i = 0; i < boxCount; ++i) {
+        const int stack = i / 4, level = i % 4;
+        dBodyID body = dBodyCreate(scene->world);
+        dMass mass;
+        dMassSetBox(&mass, 200, size, size, size);
+        dBodySetMass(body, &mass);
+        dBodySetPosition(body, (stack % side) * 2 * size, (stack / side) * 2 * size, (level + REAL(0.5)) * size * REAL(1.01));
+        dMatrix3 rotation;
+        dRFromAxisAndAngle(rotation, 0, 0, 1, 0.1 * level);
+        dBodySetRotation(body, rotation);
+        dGeomID geom = dCreateBox(scene->space, size, size, size);
+        dGeomSetBody(geom, body);
+        scene->boxes.push_back(body);
+    }
+}
+
+static void destroyScene(Scene *scene)
+{
+    for (int b = 0; b < 2; ++b) {
+        for (std::map<dBodyID, dJointGroupID>::iterator it = scene->groups[b].begin(); it != scene->groups[b].end(); ++it)
+            dJointGroupDestroy(it->second);
+        scene->groups[b].clear();
+    }
+    if (scene->pool)
+        dJointPoolDestroy(scene->pool);
+    dSpaceDestroy(scene->space);
+    dWorldDestroy(scene->world);
+    scene->boxes.clear();
+}
+
+struct Result {
+    double times[3];  // collision detection and contact joint creation, world step, emptying, per step
+    long long allocationCount;
+    double steadyAllocationsPerStep;
+    double peakMegabytes;
+    int highWaterMark;
+    int capacity;
+    std::vector<dReal> positions;
+};
+
+static void run(int steps, int boxCount, bool pooled, int initialCapacity, Result *result)
+{
+    gAllocatedBytes = gPeakAllocatedBytes = 0;
+    const long long initialAllocationCount = gAllocationCount;
+    Scene scene;
+    createScene(&scene, boxCount, pooled, initialCapacity);
+
+    // only the second half of the run is timed, once the contacts are established
+    double times[3] = {0, 0, 0};
+    long long steadyAllocationCount = 0;
+    for (int s = 0; s < steps; ++s) {
+        if (s == steps / 2)
+            steadyAllocationCount = gAllocationCount;
+        std::chrono::steady_clock::time_point t[4];
+        t[0] = std::chrono::steady_clock::now();
+        dSpaceCollide(scene.space, &scene, &nearCallback);
+        t[1] = std::chrono::steady_clock::now();
+        dWorldQuickStep(scene.world, 0.004);
+        t[2] = std::chrono::steady_clock::now();
+        // the contacts of the next step are created in the other buffer, the current one is emptied
+        scene.buffer = 1 - scene.buffer;
+        emptyEnabledBodyContactJointGroups(&scene, scene.buffer);
+        t[3] = std::chrono::steady_clock::now();
+        if (s >= steps / 2) {
+            for (int i = 0; i < 3; ++i)
+                times[i] += std::chrono::duration<double>(t[i + 1] - t[i]).count();
+        }
+    }
+    const int timedSteps = steps - steps / 2;
+    for (int i = 0; i < 3; ++i)
+        result->times[i] = times[i] / timedSteps;
+    result->steadyAllocationsPerStep = (double)(gAllocationCount - steadyAllocationCount) / timedSteps;
+
+    result->positions.clear();
+    for (size_t i = 0; i < scene.boxes.size(); ++i) {
+        const dReal *p = dBodyGetPosition(scene.boxes[i]);
+        result->positions.insert(result->positions.end(), p, p + 3);
+    }
+    result->highWaterMark = scene.pool ? dJointPoolGetHighWaterMark(scene.pool) : 0;
+    result->capacity = scene.pool ? dJointPoolGetCapacity(scene.pool) : 0;
+    result->peakMegabytes = gPeakAllocatedBytes / 1048576.0;
+    destroyScene(&scene);
+    result->allocationCount = gAllocationCount - initialAllocationCount;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 500;
+    const int boxCount = argc > 2 ? atoi(argv[2]) : 1000;
+    const int rounds = argc > 3 ? atoi(argv[3]) : 5;
+
+    dSetAllocHandler(&countingAlloc);
+    dSetReallocHandler(&countingRealloc);
+    dSetFreeHandler(&countingFree);
+    dInitODE();
+
+    // the runs are interleaved and the best time of each phase is kept, so that the frequency changes of the processor do
+    // not favor the first or the last runs. The seeded pool is given the high-water mark of the first pool run.
+    const char *names[3] = {"plain", "pool", "seeded pool"};
+    Result results[3];
+    for (int round = 0; round < rounds; ++round) {
+        for (int mode = 0; mode < 3; ++mode) {
+            Result result;
+            run(steps, boxCount, mode != 0, mode == 2 ? results[1].highWaterMark : 0, &result);
+            if (round == 0) {
+                results[mode] = result;
+                continue;
+            }
+            for (int i = 0; i < 3; ++i) {
+                if (result.times[i] < results[mode].times[i])
+                    results[mode].times[i] = result.times[i];
+            }
+        }
+    }
+
+    printf("%d boxes, %d steps, best of %d rounds\n", boxCount, steps, rounds);
+    printf("%12s %12s %9s %9s %12s %12s %10s %10s %9s  %s\n", "groups", "collide [ms]", "step [ms]", "empty [ms]",
+           "allocations", "steady/step", "peak [MB]", "high mark", "capacity", "identical");
+    for (int mode = 0; mode < 3; ++mode) {
+        const Result &r = results[mode];
+        printf("%12s %12.3f %9.3f %9.3f %12lld %12.3f %10.1f %10d %9d", names[mode], 1000 * r.times[0], 1000 * r.times[1],
+               1000 * r.times[2], r.allocationCount, r.steadyAllocationsPerStep, r.peakMegabytes, r.highWaterMark,
+               r.capacity);
+        if (mode == 0)
+            printf("          -\n");
+        else
+            printf("  %9s\n", r.positions == results[0].positions ? "yes" : "no");
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*
+ * Heightfield collision benchmark
+ *
+ * Builds a large hilly terrain and a fleet of wheeled robots made of a box
+ * chassis and four cylinder wheels resting on it, then measures the time spent
+ * colliding all the robot geoms with the heightfield. The terrain is created
+ * twice from the same heights: once from sample data and once with a height
+ * callback. The contacts of both heightfields are compared.
+ *
+ * Before, the contacts of spheres, boxes, capsules and cylinders of all sizes
+ * are compared on smaller square, non-square and wrapped terrains. The program
+ * fails if any contact differs.
+ *
+ * Usage: heightfield_benchmark [steps] [number of robots] [number of samples per side] [terrain size]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_CONTACTS 10
+
+static int gSamples;
+static std::vector<double> gHeights;
+
+static dReal getHeight(void *userData, int x, int z)
+{
+    return gHeights[x + z * gSamples];
+}
+
+struct Grid {
+    const char *name;
+    int widthSamples;
+    int depthSamples;
+    dReal width;
+    dReal depth;
+    int wrap;
+};
+
+static const Grid gGrids[] = {
+    {"square", 257, 257, 10.0, 10.0, 0},
+    {"wide", 301, 77, 30.0, 5.0, 0},
+    {"deep", 65, 513, 4.0, 40.0, 0},
+    {"wrapped", 129, 129, 10.0, 10.0, 1},
+    {"wrapped wide", 257, 65, 20.0, 3.0, 1}
+};
+
+static const Grid *gGrid;
+
+static dReal getGridHeight(void *userData, int x, int z)
+{
+    return gHeights[x + z * gGrid->widthSamples];
+}
+
+// nearest sample below a point of the terrain, wrapped or clamped to the terrain
+static dReal gridHeight(dReal x, dReal z)
+{
+    int i = (int)floor((x / gGrid->width + 0.5) * (gGrid->widthSamples - 1) + 0.5);
+    int j = (int)floor((z / gGrid->depth + 0.5) * (gGrid->depthSamples - 1) + 0.5);
+    if (gGrid->wrap) {
+        i = ((i % (gGrid->widthSamples - 1)) + gGrid->widthSamples - 1) % (gGrid->widthSamples - 1);
+        j = ((j % (gGrid->depthSamples - 1)) + gGrid->depthSamples - 1) % (gGrid->depthSamples - 1);
+    } else {
+        i = i < 0 ? 0 : (i >= gGrid->widthSamples ? gGrid->widthSamples - 1 : i);
+        j = j < 0 ? 0 : (j >= gGrid->depthSamples ? gGrid->depthSamples - 1 : j);
+    }
+    return gHeights[i + j * gGrid->widthSamples];
+}
+
+static dReal randomReal(dReal min, dReal max)
+{
+    return min + (max - min) * rand() / (dReal)RAND_MAX;
+}
+
+static dReal terrainHeight(dReal x, dReal z, dReal size)
+{
+    // nearest sample, the robots only need to rest approximately on the ground
+    const int i = (int)((x / size + 0.5) * (gSamples - 1) + 0.5);
+    const int j = (int)((z / size + 0.5) * (gSamples - 1) + 0.5);
+    return gHeights[i + j * gSamples];
+}
+
+// returns the time in milliseconds spent colliding the geoms with the heightfield
+// and fills 'contacts' with all the contact points
+static double runBenchmark(dGeomID heightfield, const std::vector<dGeomID> &geoms, int steps,
+                           std::vector<dContactGeom> *contacts)
+{
+    dContactGeom buffer[MAX_CONTACTS];
+    contacts->clear();
+    std::chrono::duration<double> elapsed(0.0);
+    for (int i = 0; i < steps; ++i) {
+        for (size_t j = 0; j < geoms.size(); ++j) {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const int n = dCollide(heightfield, geoms[j], MAX_CONTACTS, buffer, sizeof(dContactGeom));
+            elapsed += std::chrono::steady_clock::now() - start;
+            if (i == 0)
+                contacts->insert(contacts->end(), buffer, buffer + n);
+        }
+    }
+    return 1000.0 * elapsed.count() / steps;
+}
+
+static bool sameContacts(const std::vector<dContactGeom> &a, const std::vector<dContactGeom> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (memcmp(a[i].pos, b[i].pos, 3 * sizeof(dReal)) != 0 || memcmp(a[i].normal, b[i].normal, 3 * sizeof(dReal)) != 0 ||
+            a[i].depth != b[i].depth)
+            return false;
+    }
+    return true;
+}
+
+// collides geoms of all classes and sizes, some lying across the terrain edges, with the same
+// terrain built from sample data and with a callback, returns false if any contact differs
+static bool compareGrid(const Grid &grid, int geomCount)
+{
+    gGrid = &grid;
+    gHeights.resize((size_t)grid.widthSamples * grid.depthSamples);
+    dReal minHeight = dInfinity, maxHeight = -dInfinity;
+    for (int z = 0; z < grid.depthSamples; ++z) {
+        for (int x = 0; x < grid.widthSamples; ++x) {
+            const dReal h = 1.5 * sin(x * 0.05) * cos(z * 0.037) + (rand() % 100) * 0.002;
+            gHeights[x + z * grid.widthSamples] = h;
+            if (h < minHeight)
+                minHeight = h;
+            if (h > maxHeight)
+                maxHeight = h;
+        }
+    }
+
+    dHeightfieldDataID sampleData = dGeomHeightfieldDataCreate();
+    dGeomHeightfieldDataBuildDouble(sampleData, &gHeights[0], 0, grid.width, grid.depth, grid.widthSamples,
+                                    grid.depthSamples, 1.0, 0.0, 0.0, grid.wrap);
+    dHeightfieldDataID callbackData = dGeomHeightfieldDataCreate();
+    dGeomHeightfieldDataBuildCallback(callbackData, NULL, &getGridHeight, grid.width, grid.depth, grid.widthSamples,
+                                      grid.depthSamples, 1.0, 0.0, 0.0, grid.wrap);
+    dGeomHeightfieldDataSetBounds(callbackData, minHeight, maxHeight);
+    dGeomID heightfields[2] = {dCreateHeightfield(NULL, sampleData, 1), dCreateHeightfield(NULL, callbackData, 1)};
+
+    std::vector<dGeomID> geoms;
+    for (int i = 0; i < geomCount; ++i) {
+        // from a fraction of a cell to several meters
+        const dReal size = i % 4 == 0 ? randomReal(0.5, 2.0) : randomReal(0.02, 0.5);
+        dGeomID geom;
+        switch (i % 4) {
+            case 0:
+                geom = dCreateSphere(NULL, 0.5 * size);
+                break;
+            case 1:
+                geom = dCreateBox(NULL, size, randomReal(0.02, 0.5), randomReal(0.02, 2.0));
+                break;
+            case 2:
+                geom = dCreateCapsule(NULL, 0.25 * size, size);
+                break;
+            default:
+                geom = dCreateCylinder(NULL, 0.5 * size, randomReal(0.02, 1.0));
+                break;
+        }
+        dMatrix3 R;
+        dRFromAxisAndAngle(R, randomReal(-1.0, 1.0), randomReal(-1.0, 1.0), randomReal(-1.0, 1.0), randomReal(0.0, M_PI));
+        dGeomSetRotation(geom, R);
+        const dReal x = grid.width * randomReal(-0.6, 0.6);
+        const dReal z = grid.depth * randomReal(-0.6, 0.6);
+        dGeomSetPosition(geom, x, gridHeight(x, z) + randomReal(-0.5, 1.0) * size, z);
+        geoms.push_back(geom);
+    }
+
+    std::vector<dContactGeom> contacts[2];
+    double times[2];
+    for (int i = 0; i < 2; ++i)
+        times[i] = runBenchmark(heightfields[i], geoms, 1, &contacts[i]);
+    const bool identical = sameContacts(contacts[0], contacts[1]);
+    printf("%14s %8dx%-5d %8.2fx%-6.2f %8d %14.3f %14.3f %10s\n", grid.name, grid.widthSamples, grid.depthSamples,
+           grid.width, grid.depth, (int)contacts[0].size(), times[0], times[1], identical ? "yes" : "no");
+    fflush(stdout);
+
+    for (size_t i = 0; i < geoms.size(); ++i)
+        dGeomDestroy(geoms[i]);
+    dGeomDestroy(heightfields[0]);
+    dGeomDestroy(heightfields[1]);
+    dGeomHeightfieldDataDestroy(sampleData);
+    dGeomHeightfieldDataDestroy(callbackData);
+    return identical;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 10;
+    const int robotCount = argc > 2 ? atoi(argv[2]) : 500;
+    gSamples = argc > 3 ? atoi(argv[3]) : 2049;
+    const dReal size = argc > 4 ? atof(argv[4]) : 50.0;
+
+    dInitODE();
+
+    srand(1);
+    printf("%14s %14s %15s %8s %14s %14s %10s\n", "terrain", "samples", "size [m]", "contacts", "samples [ms]",
+           "callback [ms]", "identical");
+    bool identical = true;
+    for (size_t i = 0; i < sizeof(gGrids) / sizeof(gGrids[0]); ++i)
+        identical = compareGrid(gGrids[i], 4000) && identical;
+    printf("\n");
+
+    // smooth hills with a few centimeters of noise
+    srand(1);
+    gHeights.resize((size_t)gSamples * gSamples);
+    for (int z = 0; z < gSamples; ++z) {
+        for (int x = 0; x < gSamples; ++x)
+            gHeights[x + z * gSamples] = 2.0 * sin(x * 0.01) * cos(z * 0.013) + (rand() % 100) * 0.0003;
+    }
+
+    dHeightfieldDataID sampleData = dGeomHeightfieldDataCreate();
+    dGeomHeightfieldDataBuildDouble(sampleData, &gHeights[0], 0, size, size, gSamples, gSamples, 1.0, 0.0, 1.0, 0);
+    dHeightfieldDataID callbackData = dGeomHeightfieldDataCreate();
+    dGeomHeightfieldDataBuildCallback(callbackData, NULL, &getHeight, size, size, gSamples, gSamples, 1.0, 0.0, 1.0, 0);
+    dGeomHeightfieldDataSetBounds(callbackData, -2.1, 2.1);
+    dGeomID heightfields[2] = {dCreateHeightfield(NULL, sampleData, 1), dCreateHeightfield(NULL, callbackData, 1)};
+
+    // the robots drive along the x axis, the wheels slightly sink into the ground
+    const dReal wheelRadius = 0.1;
+    std::vector<dGeomID> geoms;
+    for (int i = 0; i < robotCount; ++i) {
+        const dReal x = size * (0.9 * rand() / (dReal)RAND_MAX - 0.45);
+        const dReal z = size * (0.9 * rand() / (dReal)RAND_MAX - 0.45);
+        dReal lowestWheel = dInfinity;
+        for (int w = 0; w < 4; ++w) {
+            const dReal wx = x + (w & 1 ? 0.2 : -0.2);
+            const dReal wz = z + (w & 2 ? 0.18 : -0.18);
+            const dReal wy = terrainHeight(wx, wz, size) + wheelRadius - 0.005;
+            dGeomID wheel = dCreateCylinder(NULL, wheelRadius, 0.04);
+            dMatrix3 R;
+            dRFromAxisAndAngle(R, 0, 1, 0, 0.5 * M_PI);
+            dGeomSetRotation(wheel, R);
+            dGeomSetPosition(wheel, wx, wy, wz);
+            geoms.push_back(wheel);
+            if (wy < lowestWheel)
+                lowestWheel = wy;
+        }
+        dGeomID chassis = dCreateBox(NULL, 0.5, 0.1, 0.3);
+        dGeomSetPosition(chassis, x, lowestWheel + 0.1, z);
+        geoms.push_back(chassis);
+    }
+
+    printf("%d robots, %dx%d samples, %g m cells\n", robotCount, gSamples, gSamples, size / (gSamples - 1));
+    printf("%12s %14s %10s %10s\n", "heights", "collide [ms]", "contacts", "identical");
+    const char *names[] = {"samples", "callback"};
+    std::vector<dContactGeom> contacts[2];
+    for (int i = 0; i < 2; ++i) {
+        const double time = runBenchmark(heightfields[i], geoms, steps, &contacts[i]);
+        printf("%12s %14.3f %10d %10s\n", names[i], time, (int)contacts[i].size(),
+               i == 0 || sameContacts(contacts[0], contacts[i]) ? "yes" : "no");
+        if (i > 0 && !sameContacts(contacts[0], contacts[i]))
+            identical = false;
+        fflush(stdout);
+    }
+
+    for (size_t i = 0; i < geoms.size(); ++i)
+        dGeomDestroy(geoms[i]);
+    dGeomDestroy(heightfields[0]);
+    dGeomDestroy(heightfields[1]);
+    dGeomHeightfieldDataDestroy(sampleData);
+    dGeomHeightfieldDataDestroy(callbackData);
+    dCloseODE();
+    if (!identical) {
+        printf("The contacts of the sample and of the callback heightfields differ.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+/*
+ * Immersion benchmark
+ *
+ * Computes the immersions of boxes, spheres, capsules, cylinders and trimesh
+ * spheres floating with random orientations at the surface of a box fluid,
+ * like Webots does for the solids in contact with a Fluid node:
+ *
+ * - "create": the outline of each immersion is created before dImmerse and
+ *   destroyed at the next step, as Webots did before.
+ * - "reuse": the outlines are kept from one step to the next one and emptied
+ *   with dImmersionOutlineReset, their edges are not reallocated.
+ * - "reuse N": the outlines are reused and the immersions are computed by N
+ *   threads with dRunWorkerTasks.
+ *
+ * The memory allocations of the edges after the first step are counted with
+ * a custom allocator and the immersed volumes are checked to be identical to
+ * the "create" run.
+ *
+ * Usage: immersion_benchmark [steps] [number of geoms] [maximum number of threads] [rounds]
+ */
+
+#include <ode/fluid_dynamics/ode_fluid_dynamics.h>
+#include <ode/ode.h>
+#include <ode/ode_MT.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// number of immersions computed by a task, as in WbSimulationCluster
+#define IMMERSIONS_PER_TASK 16
+
+// tessellation of the trimesh spheres
+#define SLICES 16
+#define STACKS 8
+
+static long long gAllocationCount = 0;
+
+static void *countingAlloc(size_t size)
+{
+    ++gAllocationCount;
+    return malloc(size);
+}
+
+static void *countingRealloc(void *ptr, size_t oldsize, size_t newsize)
+{
+    ++gAllocationCount;
+    return realloc(ptr, newsize);
+}
+
+static void countingFree(void *ptr, size_t size)
+{
+    free(ptr);
+}
+
+struct Scene {
+    dWorldID world;
+    dFluidID fluid;
+    dGeomID fluidGeom;
+    dTriMeshDataID sphereData;
+    std::vector<dReal> sphereVertices;
+    std::vector<dTriIndex> sphereIndices;
+    std::vector<dGeomID> geoms;
+    std::vector<dImmersionGeom> immersions;
+    std::vector<dImmersionOutlineID> outlines;
+};
+
+// a sphere of the given radius made of SLICES * STACKS vertices, its triangles are oriented outwards
+static void createSphereData(Scene *scene, dReal radius)
+{
+    std::vector<dReal> &vertices = scene->sphereVertices;
+    std::vector<dTriIndex> &indices = scene->sphereIndices;
+    vertices.clear();
+    indices.clear();
+    // the poles are the first and last vertices, the rings of SLICES vertices are in between
+    const int count = 2 + (STACKS - 1) * SLICES;
+    vertices.resize(3 * count);
+    vertices[1] = radius;
+    vertices[3 * count - 2] = -radius;
+    for (int i = 1; i < STACKS; ++i) {
+        const double theta = M_PI * i / STACKS;
+        for (int j = 0; j < SLICES; ++j) {
+            const double phi = 2 * M_PI * j / SLICES;
+            dReal *v = &vertices[3 * (1 + (i - 1) * SLICES + j)];
+            v[0] = radius * sin(theta) * cos(phi);
+            v[1] = radius * cos(theta);
+            v[2] = -radius * sin(theta) * sin(phi);
+        }
+    }
+    for (int j = 0; j < SLICES; ++j) {
+        const int k = (j + 1) % SLICES;
+        const int top[3] = {0, 1 + j, 1 + k};
+        indices.insert(indices.end(), top, top + 3);
+        for (int i = 1; i < STACKS - 1; ++i) {
+            const int a = 1 + (i - 1) * SLICES + j, b = 1 + (i - 1) * SLICES + k;
+            const int quad[6] = {a, a + SLICES, b + SLICES, a, b + SLICES, b};
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+        const int bottom[3] = {count - 1, 1 + (STACKS - 2) * SLICES + k, 1 + (STACKS - 2) * SLICES + j};
+        indices.insert(indices.end(), bottom, bottom + 3);
+    }
+    scene->sphereData = dGeomTriMeshDataCreate();
+    dGeomTriMeshDataBuildDouble(scene->sphereData, &vertices[0], 3 * sizeof(dReal), count, &indices[0], (int)indices.size(),
+                                3 * sizeof(dTriIndex));
+}
+
+static void createScene(Scene *scene, int geomCount)
+{
+    scene->world = dWorldCreate();
+    scene->fluid = dFluidCreate(scene->world);
+    // the fluid surface is the top face of the box along the y axis, the y = 0 plane
+    scene->fluidGeom = dCreateBox(NULL, 100, 10, 100);
+    dGeomSetPosition(scene->fluidGeom, 0, -5, 0);
+    dGeomSetFluid(scene->fluidGeom, scene->fluid);
+    createSphereData(scene, 0.2);
+    dRandSetSeed(0);
+    const int side = (int)ceil(sqrt((double)geomCount));
+    for (int i = 0; i < geomCount; ++i) {
+        dGeomID geom;
+        switch (i % 5) {
+        case 0: geom = dCreateBox(NULL, 0.4, 0.3, 0.2); break;
+        case 1: geom = dCreateSphere(NULL, 0.2); break;
+        case 2: geom = dCreateCapsule(NULL, 0.1, 0.3); break;
+        case 3: geom = dCreateCylinder(NULL, 0.15, 0.3); break;
+        default: geom = dCreateTriMesh(NULL, scene->sphereData, NULL, NULL, NULL); break;
+        }
+        dBodyID body = dBodyCreate(scene->world);
+        dGeomSetBody(geom, body);
+        dMatrix3 rotation;
+        dRFromAxisAndAngle(rotation, dRandReal() - 0.5, dRandReal() - 0.5, dRandReal() - 0.5, 2 * M_PI * dRandReal());
+        dBodySetRotation(body, rotation);
+        dBodySetPosition(body, (i % side) * 90.0 / side - 45, 0.3 * (dRandReal() - 0.5), (i / side) * 90.0 / side - 45);
+        scene->geoms.push_back(geom);
+    }
+    scene->immersions.resize(geomCount);
+}
+
+static void destroyScene(Scene *scene)
+{
+    for (size_t i = 0; i < scene->outlines.size(); ++i)
+        dImmersionOutlineDestroy(scene->outlines[i]);
+    scene->outlines.clear();
+    for (size_t i = 0; i < scene->geoms.size(); ++i)
+        dGeomDestroy(scene->geoms[i]);
+    scene->geoms.clear();
+    dGeomTriMeshDataDestroy(scene->sphereData);
+    dGeomDestroy(scene->fluidGeom);
+    dFluidDestroy(scene->fluid);
+    dWorldDestroy(scene->world);
+}
+
+static void immerseTask(unsigned int task, unsigned int worker, void *data)
+{
+    Scene *scene = static_cast<Scene *>(data);
+    const size_t end = std::min((task + 1) * IMMERSIONS_PER_TASK, (unsigned int)scene->geoms.size());
+    for (size_t i = task * IMMERSIONS_PER_TASK; i < end; ++i)
+        dImmerse(scene->geoms[i], scene->fluidGeom, 1, &scene->immersions[i]);
+}
+
+struct Result {
+    double time;
+    double allocationsPerStep;
+    int edgeCount;
+    std::vector<dReal> volumes;
+};
+
+// threadCount is 0 for the "create" run
+static void run(int threadCount, int steps, int geomCount, Result *result)
+{
+    Scene scene;
+    createScene(&scene, geomCount);
+    // the allocations are counted once the outlines of the first step have been filled
+    long long initialAllocationCount = 0;
+    double time = 0;
+    for (int s = 0; s < steps; ++s) {
+        if (s == 1)
+            initialAllocationCount = gAllocationCount;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (threadCount == 0) {
+            for (size_t i = 0; i < scene.outlines.size(); ++i)
+                dImmersionOutlineDestroy(scene.outlines[i]);
+            scene.outlines.clear();
+            for (int i = 0; i < geomCount; ++i) {
+                scene.outlines.push_back(dImmersionOutlineCreate());
+                scene.immersions[i].outline = scene.outlines[i];
+                dImmerse(scene.geoms[i], scene.fluidGeom, 1, &scene.immersions[i]);
+            }
+        } else {
+            while (scene.outlines.size() < (size_t)geomCount)
+                scene.outlines.push_back(dImmersionOutlineCreate());
+            for (int i = 0; i < geomCount; ++i) {
+                dImmersionOutlineReset(scene.outlines[i]);
+                scene.immersions[i].outline = scene.outlines[i];
+            }
+            dRunWorkerTasks((geomCount + IMMERSIONS_PER_TASK - 1) / IMMERSIONS_PER_TASK, threadCount, &immerseTask, &scene);
+        }
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    result->time = time / steps;
+    result->allocationsPerStep = (double)(gAllocationCount - initialAllocationCount) / (steps - 1);
+    result->volumes.clear();
+    result->edgeCount = 0;
+    for (int i = 0; i < geomCount; ++i) {
+        result->volumes.push_back(scene.immersions[i].volume);
+        result->edgeCount += dImmersionOutlineGetStraightEdgesSize(scene.outlines[i]) +
+                             dImmersionOutlineGetCurvedEdgesSize(scene.outlines[i]);
+    }
+    destroyScene(&scene);
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 200;
+    const int geomCount = argc > 2 ? atoi(argv[2]) : 1000;
+    const int maxThreadCount = argc > 3 ? atoi(argv[3]) : 4;
+    const int rounds = argc > 4 ? atoi(argv[4]) : 5;
+
+    dSetAllocHandler(&countingAlloc);
+    dSetReallocHandler(&countingRealloc);
+    dSetFreeHandler(&countingFree);
+    dInitODE();
+
+    // the runs are interleaved and the best time of each one is kept, so that the frequency changes of the processor do not
+    // favor the first or the last runs
+    std::vector<int> threadCounts(1, 0);
+    for (int threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+        threadCounts.push_back(threadCount);
+    std::vector<Result> results(threadCounts.size());
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < threadCounts.size(); ++i) {
+            Result result;
+            run(threadCounts[i], steps, geomCount, &result);
+            if (round == 0 || result.time < results[i].time)
+                results[i] = result;
+        }
+    }
+
+    printf("%d geoms, %d steps, best of %d rounds\n", geomCount, steps, rounds);
+    printf("%10s %12s %10s %14s %10s  %s\n", "outlines", "step [ms]", "speed-up", "allocs/step", "edges", "identical");
+    for (size_t i = 0; i < threadCounts.size(); ++i) {
+        char name[16];
+        if (threadCounts[i] == 0)
+            sprintf(name, "create");
+        else if (threadCounts[i] == 1)
+            sprintf(name, "reuse");
+        else
+            sprintf(name, "reuse %d", threadCounts[i]);
+        printf("%10s %12.3f %10.2f %14.1f %10d", name, 1000 * results[i].time, results[0].time / results[i].time,
+               results[i].allocationsPerStep, results[i].edgeCount);
+        if (i == 0)
+            printf("\n");
+        else
+            printf("  %9s\n", results[i].volumes == results[0].volumes ? "yes" : "no");
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*
+ * Island threading benchmark
+ *
+ * Builds a swarm of small independent stacks of boxes standing on a plane.
+ * Static geometries do not connect islands, so every stack is solved as a
+ * separate island by dWorldStep. The benchmark measures how many dWorldStep
+ * calls per second are achieved with an increasing number of island threads
+ * and checks that the final body positions do not depend on the thread count.
+ *
+ * Usage: island_benchmark [steps] [number of stacks] [maximum number of threads]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_CONTACTS 10
+#define BOXES_PER_STACK 4
+
+struct BenchmarkContext {
+    dWorldID world;
+    dJointGroupID contactGroup;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    BenchmarkContext *context = static_cast<BenchmarkContext *>(data);
+    dBodyID b1 = dGeomGetBody(o1);
+    dBodyID b2 = dGeomGetBody(o2);
+    if (b1 == NULL && b2 == NULL)
+        return;
+
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        // same defaults as WbSimulationCluster::fillSurfaceParameters()
+        contact[i].surface.mode = dContactBounce | dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 1.0;
+        contact[i].surface.bounce = 0.5;
+        contact[i].surface.bounce_vel = 0.01;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID joint = dJointCreateContact(context->world, context->contactGroup, &contact[i]);
+        dJointAttach(joint, b1, b2);
+    }
+}
+
+// returns the number of steps per second and stores the final body positions in 'positions'
+static double runBenchmark(int threadCount, int stackCount, int steps, std::vector<dReal> *positions)
+{
+    BenchmarkContext context;
+    context.world = dWorldCreate();
+    context.contactGroup = dJointGroupCreate(0);
+    dWorldSetGravity(context.world, 0, -9.81, 0);
+    dWorldSetCFM(context.world, 0.00001);
+    dWorldSetERP(context.world, 0.2);
+    dWorldSetAutoDisableFlag(context.world, 0);
+    dWorldSetIslandThreadCount(context.world, threadCount);
+
+    dSpaceID space = dSimpleSpaceCreate(NULL);
+    dCreatePlane(space, 0, 1, 0, 0);
+
+    const dReal boxSize = 0.2;
+    const int stacksPerRow = 16;
+    std::vector<dBodyID> bodies;
+    for (int i = 0; i < stackCount; ++i) {
+        for (int j = 0; j < BOXES_PER_STACK; ++j) {
+            dBodyID body = dBodyCreate(context.world);
+            dMass mass;
+            dMassSetBox(&mass, 1000.0, boxSize, boxSize, boxSize);
+            dBodySetMass(body, &mass);
+            dBodySetPosition(body, 0.5 * (i % stacksPerRow) + 0.01 * j, 0.11 + 0.21 * j, 0.5 * (i / stacksPerRow));
+            dGeomID geom = dCreateBox(space, boxSize, boxSize, boxSize);
+            dGeomSetBody(geom, body);
+            bodies.push_back(body);
+        }
+    }
+
+    const dReal stepSize = 0.008;
+    // only dWorldStep is timed, the collision detection is the same whatever the number of threads
+    std::chrono::duration<double> elapsed(0.0);
+    for (int i = 0; i < steps; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dWorldStep(context.world, stepSize);
+        elapsed += std::chrono::steady_clock::now() - start;
+        dJointGroupEmpty(context.contactGroup);
+    }
+
+    positions->clear();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const dReal *position = dBodyGetPosition(bodies[i]);
+        positions->insert(positions->end(), position, position + 3);
+    }
+
+    dJointGroupDestroy(context.contactGroup);
+    dSpaceDestroy(space);
+    dWorldDestroy(context.world);
+    return steps / elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 500;
+    const int stackCount = argc > 2 ? atoi(argv[2]) : 256;
+    const int maxThreadCount = argc > 3 ? atoi(argv[3]) : 8;
+
+    dInitODE();
+    printf("%8s %14s %10s %10s\n", "threads", "steps [st/s]", "speed-up", "identical");
+    std::vector<dReal> reference, positions;
+    const double serial = runBenchmark(1, stackCount, steps, &reference);
+    printf("%8d %14.1f %10.2f %10s\n", 1, serial, 1.0, "yes");
+    for (int threadCount = 2; threadCount <= maxThreadCount; threadCount *= 2) {
+        const double parallel = runBenchmark(threadCount, stackCount, steps, &positions);
+        const bool identical = memcmp(&reference[0], &positions[0], reference.size() * sizeof(dReal)) == 0;
+        printf("%8d %14.1f %10.2f %10s\n", threadCount, parallel, parallel / serial, identical ? "yes" : "no");
+        fflush(stdout);
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+/*
+ * Multiple worlds benchmark
+ *
+ * Steps several independent copies of a scene in the same process, like a
+ * training setup running many environments at once. Each copy has its own
+ * world, space and contact joint group, and all the copies share the same
+ * heightfield terrain data. Boxes and spheres are dropped on the terrain and
+ * each copy is reset to its initial state with its own period, so the copies
+ * are never in the same state.
+ *
+ * The final positions of each copy are compared to the ones of the same copy
+ * run alone in the process:
+ *
+ * - "global serial": the QuickStep row order of all the copies is drawn from
+ *   the global random generator, the copies are stepped one after the other.
+ * - "world serial": each copy has its own generator (dWorldSetRandomSeed),
+ *   which is also reset with the copy.
+ * - "world N": same with the copies stepped by N threads with dRunWorkerTasks,
+ *   one task per copy.
+ *
+ * Usage: multi_world_benchmark [steps] [number of worlds] [bodies per world] [maximum number of threads]
+ */
+
+#include <ode/ode.h>
+#include <ode/ode_MT.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define MAX_CONTACTS 4
+#define TERRAIN_SAMPLES 257
+#define TERRAIN_SIZE 20.0
+
+struct Environment {
+    dWorldID world;
+    dSpaceID space;
+    dJointGroupID contacts;
+    dGeomID terrain;
+    std::vector<dBodyID> bodies;
+    std::vector<dReal> initialPoses;  // position and quaternion of each body
+    unsigned long seed;
+    int resetPeriod;
+    int step;
+    bool ownGenerator;
+};
+
+// pseudo-random value in [0, 1) which does not use the ODE generator
+static dReal hashReal(unsigned int i)
+{
+    i = (i ^ 61) ^ (i >> 16);
+    i *= 9;
+    i ^= i >> 4;
+    i *= 0x27d4eb2d;
+    i ^= i >> 15;
+    return (i & 0xffffff) / (dReal)0x1000000;
+}
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Environment *env = static_cast<Environment *>(data);
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (!b1 && !b2)
+        return;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1;
+        contact[i].surface.mu = 0.6;
+        dJointID c = dJointCreateContact(env->world, env->contacts, &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static void resetEnvironment(Environment *env)
+{
+    for (size_t i = 0; i < env->bodies.size(); ++i) {
+        const dReal *pose = &env->initialPoses[7 * i];
+        dBodySetPosition(env->bodies[i], pose[0], pose[1], pose[2]);
+        dBodySetQuaternion(env->bodies[i], pose + 3);
+        dBodySetLinearVel(env->bodies[i], 0, 0, 0);
+        dBodySetAngularVel(env->bodies[i], 0, 0, 0);
+        dBodyEnable(env->bodies[i]);
+    }
+    if (env->ownGenerator)
+        dWorldSetRandomSeed(env->world, env->seed);
+}
+
+static void createEnvironment(Environment *env, int index, int bodyCount, dHeightfieldDataID terrainData, bool ownGenerator)
+{
+    env->world = dWorldCreate();
+    env->space = dHashSpaceCreate(NULL);
+    env->contacts = dJointGroupCreate(0);
+    env->terrain = dCreateHeightfield(env->space, terrainData, 1);
+    env->seed = index + 1;
+    env->resetPeriod = 150 + 20 * index;
+    env->step = 0;
+    env->ownGenerator = ownGenerator;
+    dWorldSetGravity(env->world, 0, -9.81, 0);
+    dWorldSetQuickStepNumIterations(env->world, 20);
+
+    // the bodies are dropped on a grid at random heights and orientations depending on the index of the world
+    const int side = (int)ceil(sqrt((double)bodyCount));
+    const dReal spacing = 0.8 * TERRAIN_SIZE / side;
+    for (int i = 0; i < bodyCount; ++i) {
+        const unsigned int key = index * 7919 + i;
+        dBodyID body = dBodyCreate(env->world);
+        dMass mass;
+        dGeomID geom;
+        if (i % 2) {
+            dMassSetBox(&mass, 500, 0.4, 0.3, 0.2);
+            geom = dCreateBox(env->space, 0.4, 0.3, 0.2);
+        } else {
+            dMassSetSphere(&mass, 500, 0.15);
+            geom = dCreateSphere(env->space, 0.15);
+        }
+        dBodySetMass(body, &mass);
+        dGeomSetBody(geom, body);
+        dQuaternion q;
+        dQFromAxisAndAngle(q, hashReal(key) - 0.5, hashReal(key + 1) - 0.5, hashReal(key + 2) - 0.5,
+                           2 * M_PI * hashReal(key + 3));
+        const dReal pose[7] = {(i % side + REAL(0.5)) * spacing - REAL(0.4) * TERRAIN_SIZE, 1 + REAL(0.5) * hashReal(key + 4),
+                               (i / side + REAL(0.5)) * spacing - REAL(0.4) * TERRAIN_SIZE, q[0], q[1], q[2], q[3]};
+        env->initialPoses.insert(env->initialPoses.end(), pose, pose + 7);
+        env->bodies.push_back(body);
+    }
+    resetEnvironment(env);
+}
+
+static void destroyEnvironment(Environment *env)
+{
+    dJointGroupDestroy(env->contacts);
+    dSpaceDestroy(env->space);
+    dWorldDestroy(env->world);
+    env->bodies.clear();
+    env->initialPoses.clear();
+}
+
+static void stepEnvironment(Environment *env)
+{
+    dSpaceCollide(env->space, env, &nearCallback);
+    dWorldQuickStep(env->world, 0.004);
+    dJointGroupEmpty(env->contacts);
+    if (++env->step % env->resetPeriod == 0)
+        resetEnvironment(env);
+}
+
+static void stepTask(unsigned int task, unsigned int worker, void *data)
+{
+    stepEnvironment(&static_cast<Environment *>(data)[task]);
+}
+
+static void getPositions(const Environment *env, std::vector<dReal> &positions)
+{
+    positions.clear();
+    for (size_t i = 0; i < env->bodies.size(); ++i) {
+        const dReal *p = dBodyGetPosition(env->bodies[i]);
+        positions.insert(positions.end(), p, p + 3);
+    }
+}
+
+// runs the world 'index' alone in the process
+static void runAlone(int index, int steps, int bodyCount, dHeightfieldDataID terrainData, bool ownGenerator,
+                     std::vector<dReal> &positions)
+{
+    Environment env;
+    createEnvironment(&env, index, bodyCount, terrainData, ownGenerator);
+    dRandSetSeed(env.seed);
+    for (int s = 0; s < steps; ++s) {
+        stepEnvironment(&env);
+        // alone in the process, a world using the global generator can reset it with the world
+        if (!ownGenerator && env.step % env.resetPeriod == 0)
+            dRandSetSeed(env.seed);
+    }
+    getPositions(&env, positions);
+    destroyEnvironment(&env);
+}
+
+// threadCount is 0 to step the worlds serially, returns the time of the run
+static double run(const char *name, int threadCount, int steps, int worldCount, int bodyCount, dHeightfieldDataID terrainData,
+                  bool ownGenerator, const std::vector<std::vector<dReal> > &alonePositions, double referenceTime)
+{
+    std::vector<Environment> envs(worldCount);
+    for (int i = 0; i < worldCount; ++i)
+        createEnvironment(&envs[i], i, bodyCount, terrainData, ownGenerator);
+    dRandSetSeed(1);
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        if (threadCount == 0) {
+            for (int i = 0; i < worldCount; ++i)
+                stepEnvironment(&envs[i]);
+        } else
+            dRunWorkerTasks(worldCount, threadCount, &stepTask, &envs[0]);
+    }
+    const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int identicalCount = 0;
+    std::vector<dReal> positions;
+    for (int i = 0; i < worldCount; ++i) {
+        getPositions(&envs[i], positions);
+        if (positions == alonePositions[i])
+            ++identicalCount;
+        destroyEnvironment(&envs[i]);
+    }
+    printf("%16s %12.3f %10.2f %10d/%d\n", name, 1000 * time / steps, referenceTime > 0 ? referenceTime / time : 1.0,
+           identicalCount, worldCount);
+    fflush(stdout);
+    return time;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 500;
+    const int worldCount = argc > 2 ? atoi(argv[2]) : 8;
+    const int bodyCount = argc > 3 ? atoi(argv[3]) : 64;
+    const int maxThreadCount = argc > 4 ? atoi(argv[4]) : 4;
+
+    dInitODE();
+
+    // rolling hills shared by all the worlds, the samples are not copied by ODE
+    std::vector<double> heights((size_t)TERRAIN_SAMPLES * TERRAIN_SAMPLES);
+    for (int z = 0; z < TERRAIN_SAMPLES; ++z) {
+        for (int x = 0; x < TERRAIN_SAMPLES; ++x)
+            heights[x + z * TERRAIN_SAMPLES] = 0.5 * sin(x * 0.05) * cos(z * 0.04);
+    }
+    dHeightfieldDataID terrainData = dGeomHeightfieldDataCreate();
+    dGeomHeightfieldDataBuildDouble(terrainData, &heights[0], 0, TERRAIN_SIZE, TERRAIN_SIZE, TERRAIN_SAMPLES, TERRAIN_SAMPLES,
+                                    1.0, 0.0, 1.0, 0);
+
+    printf("%d worlds, %d bodies per world, %d steps, %.2f MB of terrain samples shared by all the worlds\n", worldCount,
+           bodyCount, steps, heights.size() * sizeof(double) / 1048576.0);
+    printf("%16s %12s %10s %12s\n", "generator", "step [ms]", "speed-up", "as if alone");
+
+    std::vector<std::vector<dReal> > alonePositions[2];
+    for (int generator = 0; generator < 2; ++generator) {
+        alonePositions[generator].resize(worldCount);
+        for (int i = 0; i < worldCount; ++i)
+            runAlone(i, steps, bodyCount, terrainData, generator == 1, alonePositions[generator][i]);
+    }
+
+    // the global generator cannot be used from several threads, it is only run serially
+    const double referenceTime =
+      run("global serial", 0, steps, worldCount, bodyCount, terrainData, false, alonePositions[0], 0);
+    run("world serial", 0, steps, worldCount, bodyCount, terrainData, true, alonePositions[1], referenceTime);
+    for (int threadCount = 2; threadCount <= maxThreadCount; threadCount *= 2) {
+        char name[16];
+        sprintf(name, "world %d", threadCount);
+        run(name, threadCount, steps, worldCount, bodyCount, terrainData, true, alonePositions[1], referenceTime);
+    }
+
+    dGeomHeightfieldDataDestroy(terrainData);
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*
+ * Precision benchmark
+ *
+ * Runs the same scenes with the ODE library it is linked against, built
+ * either in double precision (default) or in single precision (make
+ * ODE_PRECISION=single), and reports the cost and the accuracy of each:
+ *
+ * - "stacks": stacks of boxes resting on a ground plane solved by
+ *   dWorldQuickStep. Reports the step time, the peak memory allocated by ODE,
+ *   the deepest contact penetration and the largest speed once at rest.
+ * - "pendulum": a chain of hinged links swinging without damping, solved by
+ *   dWorldStep. Reports the relative drift of the mechanical energy.
+ *
+ * The final positions of the boxes are saved in precision_benchmark_<single
+ * or double>.txt. If the file of the other precision exists, the largest
+ * distance between the positions of the two builds is reported as well.
+ *
+ * Usage: precision_benchmark [steps] [number of boxes]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define MAX_CONTACTS 4
+
+static long long gAllocatedBytes = 0;
+static long long gPeakAllocatedBytes = 0;
+
+static void *countingAlloc(size_t size)
+{
+    gAllocatedBytes += size;
+    if (gAllocatedBytes > gPeakAllocatedBytes)
+        gPeakAllocatedBytes = gAllocatedBytes;
+    return malloc(size);
+}
+
+static void *countingRealloc(void *ptr, size_t oldsize, size_t newsize)
+{
+    gAllocatedBytes += newsize - oldsize;
+    if (gAllocatedBytes > gPeakAllocatedBytes)
+        gPeakAllocatedBytes = gAllocatedBytes;
+    return realloc(ptr, newsize);
+}
+
+static void countingFree(void *ptr, size_t size)
+{
+    gAllocatedBytes -= size;
+    free(ptr);
+}
+
+struct Scene {
+    dWorldID world;
+    dSpaceID space;
+    dJointGroupID contacts;
+    dReal maxDepth;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Scene *scene = static_cast<Scene *>(data);
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (!b1 && !b2)
+        return;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        if (contact[i].geom.depth > scene->maxDepth)
+            scene->maxDepth = contact[i].geom.depth;
+        contact[i].surface.mode = dContactApprox1 | dContactSoftERP | dContactSoftCFM;
+        contact[i].surface.mu = 0.8;
+        contact[i].surface.soft_erp = 0.2;
+        contact[i].surface.soft_cfm = 1e-5;
+        dJointID c = dJointCreateContact(scene->world, scene->contacts, &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static void runStacks(int steps, int boxCount, std::vector<double> &positions)
+{
+    gAllocatedBytes = gPeakAllocatedBytes = 0;
+    Scene scene;
+    scene.world = dWorldCreate();
+    scene.space = dSimpleSpaceCreate(NULL);
+    scene.contacts = dJointGroupCreate(0);
+    dRandSetSeed(0);
+    dWorldSetGravity(scene.world, 0, 0, -9.81);
+    dWorldSetQuickStepNumIterations(scene.world, 20);
+    dCreatePlane(scene.space, 0, 0, 1, 0);
+
+    // stacks of 4 boxes on a square grid, placed 1 km away from the origin where
+    // the single precision resolution of the positions is about 0.1 mm
+    std::vector<dBodyID> boxes;
+    const dReal size = 0.5;
+    const dReal offset = 1000;
+    const int stacks = (boxCount + 3) / 4;
+    const int side = (int)ceil(sqrt((double)stacks));
+    for (int i = 0; i < boxCount; ++i) {
+        const int stack = i / 4, level = i % 4;
+        dBodyID body = dBodyCreate(scene.world);
+        dMass mass;
+        dMassSetBox(&mass, 200, size, size, size);
+        dBodySetMass(body, &mass);
+        dBodySetPosition(body, offset + (stack % side) * 2 * size, offset + (stack / side) * 2 * size,
+                         (level + REAL(0.5)) * size * REAL(1.01));
+        dGeomID geom = dCreateBox(scene.space, size, size, size);
+        dGeomSetBody(geom, body);
+        boxes.push_back(body);
+    }
+
+    // the penetration and the speed are measured on the last tenth of the run, once at rest
+    double time = 0;
+    scene.maxDepth = 0;
+    for (int s = 0; s < steps; ++s) {
+        if (s == steps - steps / 10)
+            scene.maxDepth = 0;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dSpaceCollide(scene.space, &scene, &nearCallback);
+        dWorldQuickStep(scene.world, 0.004);
+        dJointGroupEmpty(scene.contacts);
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double maxSpeed = 0;
+    positions.clear();
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const dReal *p = dBodyGetPosition(boxes[i]);
+        const dReal *v = dBodyGetLinearVel(boxes[i]);
+        positions.insert(positions.end(), p, p + 3);
+        maxSpeed = fmax(maxSpeed, sqrt((double)(v[0] * v[0] + v[1] * v[1] + v[2] * v[2])));
+    }
+    const long long peakBytes = gPeakAllocatedBytes;
+    dJointGroupDestroy(scene.contacts);
+    dSpaceDestroy(scene.space);
+    dWorldDestroy(scene.world);
+    printf("%10s %12.3f %10.2f %12.3f %14.2e\n", "stacks", 1000 * time / steps, peakBytes / 1048576.0,
+           1000 * scene.maxDepth, maxSpeed);
+}
+
+static double mechanicalEnergy(const std::vector<dBodyID> &links, dReal gravity)
+{
+    double energy = 0;
+    for (size_t i = 0; i < links.size(); ++i) {
+        dMass mass;
+        dBodyGetMass(links[i], &mass);
+        const dReal *v = dBodyGetLinearVel(links[i]);
+        const dReal *w = dBodyGetAngularVel(links[i]);
+        const dReal *R = dBodyGetRotation(links[i]);
+        // angular kinetic energy 1/2 w' R I R' w, with the inertia expressed in the body frame
+        dVector3 wb, Iwb;
+        dMultiply1_331(wb, R, w);
+        dMultiply0_331(Iwb, mass.I, wb);
+        energy += 0.5 * mass.mass * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) + 0.5 * dCalcVectorDot3(wb, Iwb);
+        energy += mass.mass * gravity * dBodyGetPosition(links[i])[2];
+    }
+    return energy;
+}
+
+static void runPendulum(int steps)
+{
+    const int linkCount = 10;
+    const dReal length = 0.2;
+    const dReal gravity = 9.81;
+    dWorldID world = dWorldCreate();
+    dWorldSetGravity(world, 0, 0, -gravity);
+    dWorldSetERP(world, 0.2);
+    dWorldSetCFM(world, 1e-9);
+
+    // a horizontal chain of capsule links hinged along the y axis, released at rest
+    std::vector<dBodyID> links;
+    dBodyID previous = NULL;
+    for (int i = 0; i < linkCount; ++i) {
+        dBodyID link = dBodyCreate(world);
+        dMass mass;
+        dMassSetCapsule(&mass, 1000, 1, 0.02, length);
+        dBodySetMass(link, &mass);
+        dMatrix3 rotation;
+        dRFromAxisAndAngle(rotation, 0, 1, 0, M_PI / 2);
+        dBodySetRotation(link, rotation);
+        dBodySetPosition(link, (i + REAL(0.5)) * length, 0, 2);
+        dJointID hinge = dJointCreateHinge(world, NULL);
+        dJointAttach(hinge, link, previous);
+        dJointSetHingeAnchor(hinge, i * length, 0, 2);
+        dJointSetHingeAxis(hinge, 0, 1, 0);
+        links.push_back(link);
+        previous = link;
+    }
+
+    const double initialEnergy = mechanicalEnergy(links, gravity);
+    double scale = 0;  // largest potential energy variation, used as reference
+    double maxDrift = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        dWorldStep(world, 0.001);
+        double potential = 0;
+        for (int i = 0; i < linkCount; ++i) {
+            dMass mass;
+            dBodyGetMass(links[i], &mass);
+            potential += mass.mass * gravity * (2 - dBodyGetPosition(links[i])[2]);
+        }
+        scale = fmax(scale, potential);
+        maxDrift = fmax(maxDrift, fabs(mechanicalEnergy(links, gravity) - initialEnergy));
+    }
+    const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    dWorldDestroy(world);
+    printf("%10s %12.3f %10s %12s %14s   energy drift %.2e\n", "pendulum", 1000 * time / steps, "-", "-", "-",
+           maxDrift / scale);
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 2000;
+    const int boxCount = argc > 2 ? atoi(argv[2]) : 400;
+    const bool single = sizeof(dReal) == sizeof(float);
+    const char *precision = single ? "single" : "double";
+
+    dSetAllocHandler(&countingAlloc);
+    dSetReallocHandler(&countingRealloc);
+    dSetFreeHandler(&countingFree);
+    dInitODE();
+    printf("%s precision, %d boxes, %d steps\n", precision, boxCount, steps);
+    printf("%10s %12s %10s %12s %14s\n", "scene", "step [ms]", "peak [MB]", "depth [mm]", "speed [m/s]");
+    std::vector<double> positions;
+    runStacks(steps, boxCount, positions);
+    runPendulum(steps);
+    dCloseODE();
+
+    char fileName[64];
+    sprintf(fileName, "precision_benchmark_%s.txt", precision);
+    FILE *file = fopen(fileName, "w");
+    if (file) {
+        for (size_t i = 0; i < positions.size(); ++i)
+            fprintf(file, "%.17g\n", positions[i]);
+        fclose(file);
+    }
+
+    sprintf(fileName, "precision_benchmark_%s.txt", single ? "double" : "single");
+    file = fopen(fileName, "r");
+    if (file) {
+        double maxDistance = 0, value;
+        size_t i = 0;
+        for (; i < positions.size() && fscanf(file, "%lf", &value) == 1; ++i)
+            maxDistance = fmax(maxDistance, fabs(value - positions[i]));
+        fclose(file);
+        if (i == positions.size())
+            printf("largest position difference with the %s precision build: %.3f mm\n", single ? "double" : "single",
+                   1000 * maxDistance);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+/*
+ * SIMD SOR kernels benchmark
+ *
+ * Relaxes a set of random constraint rows, laid out like the contact rows of
+ * dWorldQuickStep (a normal row followed by two friction rows bound to it),
+ * with every SOR kernel supported by the processor. The benchmark reports the
+ * number of rows relaxed per second and the largest difference between the
+ * impulses computed by each kernel and by the scalar one after a sweep: the
+ * kernels only differ by the order of the floating point operations, but
+ * these rounding differences grow with the number of sweeps on such a random
+ * problem.
+ *
+ * The kernels are internal to ODE: this benchmark is compiled together with
+ * ../ode/src/sor_kernels.cpp instead of being linked against the library.
+ *
+ * Usage: simd_benchmark [sweeps] [number of contacts] [number of bodies]
+ */
+
+#include <ode/common.h>
+#include "sor_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct BenchmarkRows {
+    std::vector<dReal> J, iMJ, b, Ad, lo, hi;
+    std::vector<int> jb, findex;
+};
+
+static dReal randomReal(dReal min, dReal max)
+{
+    return min + (max - min) * (dReal)rand() / RAND_MAX;
+}
+
+// the rows are prepared like in SOR_LCP(): iMJ = inv(M)*J', J and b scaled by
+// the inverse diagonal of A and over-relaxation factor, Ad scaled by CFM
+static void createRows(int contactCount, int bodyCount, BenchmarkRows *rows)
+{
+    const int m = 3 * contactCount;
+    const dReal w = 1.3;
+    const dReal cfm = 0.001;
+    rows->J.resize(12 * m);
+    rows->iMJ.resize(12 * m);
+    rows->b.resize(m);
+    rows->Ad.resize(m);
+    rows->lo.resize(m);
+    rows->hi.resize(m);
+    rows->jb.resize(2 * m);
+    rows->findex.resize(m);
+    srand(1);
+    std::vector<dReal> invMass(bodyCount);
+    for (int i = 0; i < bodyCount; ++i)
+        invMass[i] = randomReal(0.1, 10.0);
+    for (int c = 0; c < contactCount; ++c) {
+        const int b1 = rand() % bodyCount;
+        // one contact out of eight is against the static environment
+        const int b2 = rand() % 8 == 0 ? -1 : (b1 + 1 + rand() % (bodyCount - 1)) % bodyCount;
+        for (int r = 3 * c; r < 3 * c + 3; ++r) {
+            dReal *J = &rows->J[12 * r];
+            dReal *iMJ = &rows->iMJ[12 * r];
+            dReal diagonal = cfm;
+            for (int j = 0; j < 12; ++j) {
+                if (j >= 6 && b2 == -1) {
+                    J[j] = iMJ[j] = 0;
+                    continue;
+                }
+                J[j] = randomReal(-1.0, 1.0);
+                iMJ[j] = invMass[j < 6 ? b1 : b2] * J[j];
+                diagonal += J[j] * iMJ[j];
+            }
+            const dReal Ad = w / diagonal;
+            for (int j = 0; j < 12; ++j)
+                J[j] *= Ad;
+            rows->b[r] = Ad * randomReal(-1.0, 1.0);
+            rows->Ad[r] = Ad * cfm;
+            rows->jb[2 * r] = b1;
+            rows->jb[2 * r + 1] = b2;
+            if (r == 3 * c) {
+                rows->lo[r] = 0;
+                rows->hi[r] = dInfinity;
+                rows->findex[r] = -1;
+            } else {
+                rows->lo[r] = -1;
+                rows->hi[r] = 1;
+                rows->findex[r] = 3 * c;
+            }
+        }
+    }
+}
+
+// returns the number of rows relaxed per second and stores the final impulses in 'lambda'
+static double runBenchmark(const dxSORKernels *kernels, const BenchmarkRows &rows, int bodyCount, int sweeps,
+                           std::vector<dReal> *lambda)
+{
+    const unsigned int m = rows.b.size();
+    std::vector<dReal> fc(6 * bodyCount, 0);
+    lambda->assign(m, 0);
+
+    dxSORRows sorRows;
+    sorRows.J = &rows.J[0];
+    sorRows.iMJ = &rows.iMJ[0];
+    sorRows.b = &rows.b[0];
+    sorRows.Ad = &rows.Ad[0];
+    sorRows.lo = &rows.lo[0];
+    sorRows.hi = &rows.hi[0];
+    sorRows.jb = &rows.jb[0];
+    sorRows.findex = &rows.findex[0];
+    sorRows.lambda = &(*lambda)[0];
+    sorRows.fc = &fc[0];
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < sweeps; ++i)
+        kernels->relax(sorRows, NULL, 0, 0, m);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return (double)m * sweeps / elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    const int sweeps = argc > 1 ? atoi(argv[1]) : 200;
+    const int contactCount = argc > 2 ? atoi(argv[2]) : 10000;
+    const int bodyCount = argc > 3 ? atoi(argv[3]) : 2000;
+
+    BenchmarkRows rows;
+    createRows(contactCount, bodyCount, &rows);
+    printf("%d rows, %d bodies, selected kernels: %s\n", 3 * contactCount, bodyCount, dxGetSORKernels()->name);
+    printf("%8s %14s %10s %14s\n", "kernels", "rows [Mrow/s]", "speed-up", "max rel. diff");
+
+    std::vector<dReal> reference, lambda;
+    runBenchmark(dxGetSORKernels("scalar"), rows, bodyCount, 1, &reference);
+    const double scalar = runBenchmark(dxGetSORKernels("scalar"), rows, bodyCount, sweeps, &lambda);
+    printf("%8s %14.1f %10.2f %14s\n", "scalar", 1e-6 * scalar, 1.0, "-");
+    const char *names[] = {"sse2", "avx2", "neon"};
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        const dxSORKernels *kernels = dxGetSORKernels(names[i]);
+        if (!kernels)
+            continue;
+        runBenchmark(kernels, rows, bodyCount, 1, &lambda);
+        double maxDifference = 0.0;
+        for (size_t j = 0; j < lambda.size(); ++j) {
+            const double difference = fabs(lambda[j] - reference[j]) / std::max(1.0, (double)fabs(reference[j]));
+            if (difference > maxDifference)
+                maxDifference = difference;
+        }
+        const double speed = runBenchmark(kernels, rows, bodyCount, sweeps, &lambda);
+        printf("%8s %14.1f %10.2f %14.2e\n", names[i], 1e-6 * speed, speed / scalar, maxDifference);
+        fflush(stdout);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/*
+ * Sleep culling benchmark
+ *
+ * Fills a warehouse with rows of boxes stacked on a ground plane and lets
+ * them fall asleep with the auto-disable, then rolls a heavy sphere through
+ * the first row. The world is run with and without sleep culling
+ * (dGeomSetSleepCulling) on all the geoms, for each kind of collision space.
+ * Like Webots, the near callback collides every pair but creates no contact
+ * joint between two disabled bodies nor between a disabled body and the
+ * static environment, so the final positions must be identical with and
+ * without culling. The contacts are as soft as the default ContactProperties.
+ *
+ * Usage: sleep_benchmark [steps] [number of boxes]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define MAX_CONTACTS 4
+
+struct Warehouse {
+    dWorldID world;
+    dSpaceID space;
+    dJointGroupID contacts;
+    std::vector<dBodyID> boxes;
+    dBodyID ball;
+    long long callbacks;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Warehouse *warehouse = static_cast<Warehouse *>(data);
+    warehouse->callbacks++;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+
+    // the contacts are computed before knowing that they are not needed, as Webots does in parallel
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    const bool asleep1 = !b1 || !dBodyIsEnabled(b1);
+    const bool asleep2 = !b2 || !dBodyIsEnabled(b2);
+    if (asleep1 && asleep2)
+        return;
+
+    // soft contacts with the default ContactProperties of Webots, the 4 contacts between two stacked boxes are redundant and
+    // make the LCP of rigid contacts degenerate
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 0.8;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID c = dJointCreateContact(warehouse->world, warehouse->contacts, &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static dSpaceID createSpace(int type)
+{
+    switch (type) {
+        case 0:
+            return dSimpleSpaceCreate(NULL);
+        case 1:
+            return dSweepAndPruneSpaceCreate(NULL, dSAP_AXES_XYZ);
+        case 2:
+            return dHashSpaceCreate(NULL);
+        default:
+            return dBVHSpaceCreate(NULL);
+    }
+}
+
+static const char *spaceName(int type)
+{
+    static const char *names[] = {"simple", "sweepAndPrune", "hash", "bvh"};
+    return names[type];
+}
+
+static void createWarehouse(Warehouse *warehouse, int type, int boxCount, bool culling)
+{
+    warehouse->world = dWorldCreate();
+    warehouse->space = createSpace(type);
+    warehouse->contacts = dJointGroupCreate(0);
+    warehouse->callbacks = 0;
+    dWorldSetGravity(warehouse->world, 0, 0, -9.81);
+    dWorldSetAutoDisableFlag(warehouse->world, 1);
+    dWorldSetAutoDisableTime(warehouse->world, 0.2);
+    dWorldSetAutoDisableSteps(warehouse->world, 0);
+
+    dGeomSetSleepCulling(dCreatePlane(warehouse->space, 0, 0, 1, 0), culling);
+
+    // stacks of 2 boxes on a square grid, the rows are along x
+    const dReal size = 0.5, gap = 0.05;
+    const int stacks = (boxCount + 1) / 2;
+    const int side = (int)ceil(sqrt((double)stacks));
+    for (int i = 0; i < boxCount; ++i) {
+        const int stack = i / 2, level = i % 2;
+        dBodyID body = dBodyCreate(warehouse->world);
+        dMass mass;
+        dMassSetBox(&mass, 200, size, size, size);
+        dBodySetMass(body, &mass);
+        dBodySetPosition(body, (stack % side) * (size + gap), (stack / side) * (size + gap),
+                         (level + REAL(0.5)) * size + level * REAL(0.001));
+        dGeomID geom = dCreateBox(warehouse->space, size, size, size);
+        dGeomSetBody(geom, body);
+        dGeomSetSleepCulling(geom, culling);
+        warehouse->boxes.push_back(body);
+    }
+
+    warehouse->ball = dBodyCreate(warehouse->world);
+    dMass mass;
+    dMassSetSphere(&mass, 2000, 0.3);
+    dBodySetMass(warehouse->ball, &mass);
+    dBodySetPosition(warehouse->ball, -2, 0, 0.3);
+    dBodySetAutoDisableFlag(warehouse->ball, 0);
+    dGeomID geom = dCreateSphere(warehouse->space, 0.3);
+    dGeomSetBody(geom, warehouse->ball);
+    dGeomSetSleepCulling(geom, culling);
+}
+
+static void destroyWarehouse(Warehouse *warehouse)
+{
+    dJointGroupDestroy(warehouse->contacts);
+    dSpaceDestroy(warehouse->space);
+    dWorldDestroy(warehouse->world);
+    warehouse->boxes.clear();
+}
+
+static void run(int type, int steps, int boxCount, bool culling, std::vector<dReal> &positions)
+{
+    Warehouse warehouse;
+    createWarehouse(&warehouse, type, boxCount, culling);
+
+    // the boxes settle during the first half, the ball is launched at the second half
+    double time = 0;
+    long long restingCallbacks = 0;
+    for (int s = 0; s < steps; ++s) {
+        if (s == steps / 2) {
+            dBodySetLinearVel(warehouse.ball, 6, 0, 0);
+            restingCallbacks = warehouse.callbacks;
+        }
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dSpaceCollide(warehouse.space, &warehouse, &nearCallback);
+        time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        dWorldStep(warehouse.world, 0.004);
+        dJointGroupEmpty(warehouse.contacts);
+    }
+
+    int awake = 0;
+    positions.clear();
+    for (size_t i = 0; i < warehouse.boxes.size(); ++i) {
+        const dReal *p = dBodyGetPosition(warehouse.boxes[i]);
+        positions.insert(positions.end(), p, p + 3);
+        awake += dBodyIsEnabled(warehouse.boxes[i]);
+    }
+    printf("%14s %8s %14.3f %12lld %12lld %8d", spaceName(type), culling ? "yes" : "no", 1000 * time / steps,
+           restingCallbacks / (steps / 2), (warehouse.callbacks - restingCallbacks) / (steps - steps / 2), awake);
+    destroyWarehouse(&warehouse);
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 1000;
+    const int boxCount = argc > 2 ? atoi(argv[2]) : 2000;
+
+    dInitODE();
+    printf("%d boxes, %d steps\n", boxCount, steps);
+    printf("%14s %8s %14s %12s %12s %8s  %s\n", "space", "culling", "collide [ms]", "pairs/step", "after hit", "awake",
+           "identical");
+    for (int type = 0; type < 4; ++type) {
+        std::vector<dReal> reference, positions;
+        run(type, steps, boxCount, false, reference);
+        printf("          -\n");
+        run(type, steps, boxCount, true, positions);
+        printf("  %9s\n", positions == reference ? "yes" : "no");
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/*
+ * Physics solver benchmark
+ *
+ * Drops a growing number of boxes into a walled pit so that they come to
+ * rest in piles and produce a large number of persistent contacts, then
+ * measures how many steps per second each stepping function achieves.
+ *
+ * The benchmark uses the public ODE API only and follows the way Webots
+ * drives ODE: contacts are created in a joint group during the collision
+ * callback, the world is stepped, and the group is emptied.
+ *
+ * Usage: solver_benchmark [steps] [maximum number of boxes]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#define MAX_CONTACTS 10
+
+struct BenchmarkContext {
+    dWorldID world;
+    dJointGroupID contactGroup;
+    int contactCount;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    BenchmarkContext *context = static_cast<BenchmarkContext *>(data);
+    dBodyID b1 = dGeomGetBody(o1);
+    dBodyID b2 = dGeomGetBody(o2);
+    if (b1 == NULL && b2 == NULL)
+        return;
+
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        // same defaults as WbSimulationCluster::fillSurfaceParameters()
+        contact[i].surface.mode = dContactBounce | dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 1.0;
+        contact[i].surface.bounce = 0.5;
+        contact[i].surface.bounce_vel = 0.01;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID joint = dJointCreateContact(context->world, context->contactGroup, &contact[i]);
+        dJointAttach(joint, b1, b2);
+    }
+    context->contactCount += n;
+}
+
+// returns the number of steps per second, and the mean contact count per step in 'contacts'
+static double runBenchmark(dWorldStepFunction *stepFunction, int boxCount, int steps, double *contacts)
+{
+    BenchmarkContext context;
+    context.world = dWorldCreate();
+    context.contactGroup = dJointGroupCreate(0);
+    dWorldSetGravity(context.world, 0, -9.81, 0);
+    dWorldSetCFM(context.world, 0.00001);
+    dWorldSetERP(context.world, 0.2);
+    dWorldSetQuickStepNumIterations(context.world, 20);
+    dWorldSetQuickStepW(context.world, 1.3);
+    // keep every body awake so that both solvers see the same problem size
+    dWorldSetAutoDisableFlag(context.world, 0);
+
+    dSpaceID space = dSimpleSpaceCreate(NULL);
+    dCreatePlane(space, 0, 1, 0, 0);
+    const dReal pitSize = 2.0;
+    const dReal wallHeight = 3.0;
+    const dReal wallThickness = 0.1;
+    dGeomSetPosition(dCreateBox(space, wallThickness, wallHeight, 2 * pitSize), -pitSize, 0.5 * wallHeight, 0);
+    dGeomSetPosition(dCreateBox(space, wallThickness, wallHeight, 2 * pitSize), pitSize, 0.5 * wallHeight, 0);
+    dGeomSetPosition(dCreateBox(space, 2 * pitSize, wallHeight, wallThickness), 0, 0.5 * wallHeight, -pitSize);
+    dGeomSetPosition(dCreateBox(space, 2 * pitSize, wallHeight, wallThickness), 0, 0.5 * wallHeight, pitSize);
+
+    const dReal boxSize = 0.2;
+    const int boxesPerLayer = 64;
+    for (int i = 0; i < boxCount; ++i) {
+        const int layer = i / boxesPerLayer;
+        const int row = (i % boxesPerLayer) / 8;
+        const int column = i % 8;
+        dBodyID body = dBodyCreate(context.world);
+        dMass mass;
+        dMassSetBox(&mass, 1000.0, boxSize, boxSize, boxSize);
+        dBodySetMass(body, &mass);
+        dBodySetPosition(body, -0.8 + 0.21 * column + 0.01 * layer, 0.15 + 0.25 * layer, -0.8 + 0.21 * row);
+        dGeomID geom = dCreateBox(space, boxSize, boxSize, boxSize);
+        dGeomSetBody(geom, body);
+    }
+
+    const dReal stepSize = 0.008;
+    // let the boxes settle before measuring
+    for (int i = 0; i < 250; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        stepFunction(context.world, stepSize);
+        dJointGroupEmpty(context.contactGroup);
+    }
+
+    context.contactCount = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        stepFunction(context.world, stepSize);
+        dJointGroupEmpty(context.contactGroup);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    *contacts = (double)context.contactCount / steps;
+
+    dJointGroupDestroy(context.contactGroup);
+    dSpaceDestroy(space);
+    dWorldDestroy(context.world);
+    return steps / elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 200;
+    const int maxBoxCount = argc > 2 ? atoi(argv[2]) : 256;
+
+    dInitODE();
+    printf("%8s %12s %14s %14s\n", "boxes", "contacts", "direct [st/s]", "quick [st/s]");
+    for (int boxCount = 8; boxCount <= maxBoxCount; boxCount *= 2) {
+        double directContacts, quickContacts;
+        const double direct = runBenchmark(&dWorldStep, boxCount, steps, &directContacts);
+        const double quick = runBenchmark(&dWorldQuickStep, boxCount, steps, &quickContacts);
+        printf("%8d %12.1f %14.1f %14.1f\n", boxCount, 0.5 * (directContacts + quickContacts), direct, quick);
+        fflush(stdout);
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*
+ * Parallel SOR benchmark
+ *
+ * Pours spheres into a walled pit so that they form a single granular pile
+ * with thousands of contact rows, then measures how many dWorldQuickStep
+ * calls per second are achieved by the sequential SOR solver and by the
+ * graph-coloured one with an increasing number of threads. The final body
+ * positions of the coloured runs are compared with the single-threaded
+ * deterministic run. The "threaded" runs are not deterministic: ODE uses the
+ * coloured solver only when it has enough cores and rows per colour, and the
+ * sequential one otherwise.
+ *
+ * Usage: sor_benchmark [steps] [number of spheres] [maximum number of threads]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_CONTACTS 4
+
+struct BenchmarkContext {
+    dWorldID world;
+    dJointGroupID contactGroup;
+    int contactCount;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    BenchmarkContext *context = static_cast<BenchmarkContext *>(data);
+    dBodyID b1 = dGeomGetBody(o1);
+    dBodyID b2 = dGeomGetBody(o2);
+    if (b1 == NULL && b2 == NULL)
+        return;
+
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        // same defaults as WbSimulationCluster::fillSurfaceParameters()
+        contact[i].surface.mode = dContactBounce | dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 1.0;
+        contact[i].surface.bounce = 0.5;
+        contact[i].surface.bounce_vel = 0.01;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID joint = dJointCreateContact(context->world, context->contactGroup, &contact[i]);
+        dJointAttach(joint, b1, b2);
+    }
+    context->contactCount += n;
+}
+
+// returns the number of steps per second, the mean contact count per step in 'contacts'
+// and the final body positions in 'positions'
+static double runBenchmark(int threadCount, bool deterministic, int sphereCount, int steps, double *contacts,
+                           std::vector<dReal> *positions)
+{
+    BenchmarkContext context;
+    context.world = dWorldCreate();
+    context.contactGroup = dJointGroupCreate(0);
+    dWorldSetGravity(context.world, 0, -9.81, 0);
+    dWorldSetCFM(context.world, 0.00001);
+    dWorldSetERP(context.world, 0.2);
+    dWorldSetAutoDisableFlag(context.world, 0);
+    dWorldSetQuickStepNumIterations(context.world, 20);
+    dWorldSetQuickStepW(context.world, 1.3);
+    dWorldSetQuickStepThreadCount(context.world, threadCount);
+    dWorldSetQuickStepDeterministic(context.world, deterministic);
+
+    dSpaceID space = dSimpleSpaceCreate(NULL);
+    dCreatePlane(space, 0, 1, 0, 0);
+    const dReal pitSize = 1.0;
+    const dReal wallHeight = 3.0;
+    const dReal wallThickness = 0.1;
+    dGeomSetPosition(dCreateBox(space, wallThickness, wallHeight, 2 * pitSize), -pitSize, 0.5 * wallHeight, 0);
+    dGeomSetPosition(dCreateBox(space, wallThickness, wallHeight, 2 * pitSize), pitSize, 0.5 * wallHeight, 0);
+    dGeomSetPosition(dCreateBox(space, 2 * pitSize, wallHeight, wallThickness), 0, 0.5 * wallHeight, -pitSize);
+    dGeomSetPosition(dCreateBox(space, 2 * pitSize, wallHeight, wallThickness), 0, 0.5 * wallHeight, pitSize);
+
+    const dReal radius = 0.05;
+    const int spheresPerLayer = 256;
+    std::vector<dBodyID> bodies;
+    for (int i = 0; i < sphereCount; ++i) {
+        const int layer = i / spheresPerLayer;
+        const int row = (i % spheresPerLayer) / 16;
+        const int column = i % 16;
+        dBodyID body = dBodyCreate(context.world);
+        dMass mass;
+        dMassSetSphere(&mass, 1000.0, radius);
+        dBodySetMass(body, &mass);
+        dBodySetPosition(body, -0.84 + 0.11 * column + 0.01 * (layer % 2), 0.06 + 0.11 * layer,
+                         -0.84 + 0.11 * row + 0.01 * (layer % 3));
+        dGeomID geom = dCreateSphere(space, radius);
+        dGeomSetBody(geom, body);
+        bodies.push_back(body);
+    }
+
+    const dReal stepSize = 0.008;
+    // let the spheres settle before measuring
+    for (int i = 0; i < 100; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        dWorldQuickStep(context.world, stepSize);
+        dJointGroupEmpty(context.contactGroup);
+    }
+
+    // only dWorldQuickStep is timed, the collision detection is the same whatever the number of threads
+    context.contactCount = 0;
+    std::chrono::duration<double> elapsed(0.0);
+    for (int i = 0; i < steps; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dWorldQuickStep(context.world, stepSize);
+        elapsed += std::chrono::steady_clock::now() - start;
+        dJointGroupEmpty(context.contactGroup);
+    }
+
+    *contacts = (double)context.contactCount / steps;
+    positions->clear();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        const dReal *position = dBodyGetPosition(bodies[i]);
+        positions->insert(positions->end(), position, position + 3);
+    }
+
+    dJointGroupDestroy(context.contactGroup);
+    dSpaceDestroy(space);
+    dWorldDestroy(context.world);
+    return steps / elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 100;
+    const int sphereCount = argc > 2 ? atoi(argv[2]) : 1024;
+    const int maxThreadCount = argc > 3 ? atoi(argv[3]) : 8;
+
+    dInitODE();
+    std::vector<dReal> reference, positions;
+    double contacts;
+    const double sequential = runBenchmark(1, false, sphereCount, steps, &contacts, &positions);
+    printf("%d spheres, %.1f contacts per step\n", sphereCount, contacts);
+    printf("%12s %8s %14s %10s %10s\n", "solver", "threads", "steps [st/s]", "speed-up", "identical");
+    printf("%12s %8d %14.1f %10.2f %10s\n", "sequential", 1, sequential, 1.0, "-");
+    const double coloured = runBenchmark(1, true, sphereCount, steps, &contacts, &reference);
+    printf("%12s %8d %14.1f %10.2f %10s\n", "coloured", 1, coloured, coloured / sequential, "yes");
+    for (int threadCount = 2; threadCount <= maxThreadCount; threadCount *= 2) {
+        const double parallel = runBenchmark(threadCount, true, sphereCount, steps, &contacts, &positions);
+        const bool identical = memcmp(&reference[0], &positions[0], reference.size() * sizeof(dReal)) == 0;
+        printf("%12s %8d %14.1f %10.2f %10s\n", "coloured", threadCount, parallel, parallel / sequential,
+               identical ? "yes" : "no");
+        fflush(stdout);
+    }
+    for (int threadCount = 2; threadCount <= maxThreadCount; threadCount *= 2) {
+        const double threaded = runBenchmark(threadCount, false, sphereCount, steps, &contacts, &positions);
+        printf("%12s %8d %14.1f %10.2f %10s\n", "threaded", threadCount, threaded, threaded / sequential, "-");
+        fflush(stdout);
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*
+ * Collision space benchmark
+ *
+ * Builds a large world made of a ground plane, static boxes of various sizes
+ * and spheres attached to bodies that move around between the boxes, then
+ * measures the time spent by dSpaceCollide and by dSpaceCollide2 for a set of
+ * long sensor rays with each kind of collision space. The number of colliding
+ * pairs and ray hits is compared with the simple space, that tests all the
+ * pairs.
+ *
+ * Usage: space_benchmark [steps] [number of spheres] [number of static boxes]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define RAY_COUNT 64
+
+struct BenchmarkContext {
+    int pairCount;
+    unsigned long long pairHash;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    BenchmarkContext *context = static_cast<BenchmarkContext *>(data);
+    dContactGeom contact;
+    if (dCollide(o1, o2, 1, &contact, sizeof(dContactGeom)) == 0)
+        return;
+
+    // order independent signature of the colliding pairs
+    const size_t i1 = (size_t)dGeomGetData(o1);
+    const size_t i2 = (size_t)dGeomGetData(o2);
+    context->pairCount++;
+    context->pairHash += (unsigned long long)(i1 + 1) * (i2 + 1) * 2654435761ULL;
+}
+
+static dSpaceID createSpace(int type, dReal worldSize)
+{
+    switch (type) {
+        case 0:
+            return dSimpleSpaceCreate(NULL);
+        case 1:
+            return dSweepAndPruneSpaceCreate(NULL, dSAP_AXES_XYZ);
+        case 2:
+            return dHashSpaceCreate(NULL);
+        case 3: {
+            const dVector3 center = {0, 0, 0};
+            const dVector3 extents = {0.5 * worldSize, 0.5 * worldSize, 0.5 * worldSize};
+            return dQuadTreeSpaceCreate(NULL, center, extents, 7);
+        }
+        default:
+            return dBVHSpaceCreate(NULL);
+    }
+}
+
+// returns the time in milliseconds spent per step in dSpaceCollide and in the ray queries in 'rayTime'
+static double runBenchmark(int type, int sphereCount, int boxCount, int steps, double *rayTime,
+                           BenchmarkContext *pairs, BenchmarkContext *rayHits)
+{
+    const dReal worldSize = 1000.0;
+    dWorldID world = dWorldCreate();
+    dWorldSetGravity(world, 0, 0, 0);
+    dSpaceID space = createSpace(type, worldSize);
+    size_t index = 0;
+    dGeomSetData(dCreatePlane(space, 0, 0, 1, 0), (void *)index++);
+
+    srand(1);
+    for (int i = 0; i < boxCount; ++i) {
+        const dReal size = 2.0 + (rand() % 1000) * (i % 20 == 0 ? 0.05 : 0.01);
+        dGeomID box = dCreateBox(space, size, size, size);
+        dGeomSetPosition(box, worldSize * (rand() / (dReal)RAND_MAX - 0.5),
+                         worldSize * (rand() / (dReal)RAND_MAX - 0.5), 0.5 * size);
+        dGeomSetData(box, (void *)index++);
+    }
+
+    std::vector<dBodyID> bodies;
+    for (int i = 0; i < sphereCount; ++i) {
+        dBodyID body = dBodyCreate(world);
+        dBodySetPosition(body, worldSize * (rand() / (dReal)RAND_MAX - 0.5),
+                         worldSize * (rand() / (dReal)RAND_MAX - 0.5), 0.5 + (rand() % 10) * 0.1);
+        dBodySetLinearVel(body, (rand() % 21 - 10) * 0.5, (rand() % 21 - 10) * 0.5, 0);
+        dGeomID sphere = dCreateSphere(space, 0.5 + (rand() % 10) * 0.1);
+        dGeomSetBody(sphere, body);
+        dGeomSetData(sphere, (void *)index++);
+        bodies.push_back(body);
+    }
+
+    std::vector<dGeomID> rays;
+    for (int i = 0; i < RAY_COUNT; ++i) {
+        dGeomID ray = dCreateRay(NULL, 100.0);
+        dGeomSetData(ray, (void *)index++);
+        rays.push_back(ray);
+    }
+
+    pairs->pairCount = 0;
+    pairs->pairHash = 0;
+    rayHits->pairCount = 0;
+    rayHits->pairHash = 0;
+    const dReal stepSize = 0.032;
+    std::chrono::duration<double> collideElapsed(0.0), rayElapsed(0.0);
+    for (int i = 0; i < steps; ++i) {
+        // the bodies are only moved, nothing is solved
+        dWorldStep(world, stepSize);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dSpaceCollide(space, pairs, &nearCallback);
+        collideElapsed += std::chrono::steady_clock::now() - start;
+
+        // rays cast diagonally from some of the moving bodies
+        for (int j = 0; j < RAY_COUNT; ++j) {
+            const dReal *position = dBodyGetPosition(bodies[(j * 97) % bodies.size()]);
+            const dReal angle = 0.1 * (i + j);
+            dGeomRaySet(rays[j], position[0], position[1], position[2] + 1.5, cos(angle), sin(angle), -0.1);
+        }
+        start = std::chrono::steady_clock::now();
+        for (int j = 0; j < RAY_COUNT; ++j)
+            dSpaceCollide2(rays[j], (dGeomID)space, rayHits, &nearCallback);
+        rayElapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    for (int i = 0; i < RAY_COUNT; ++i)
+        dGeomDestroy(rays[i]);
+    dSpaceDestroy(space);
+    dWorldDestroy(world);
+    *rayTime = 1000.0 * rayElapsed.count() / steps;
+    return 1000.0 * collideElapsed.count() / steps;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 100;
+    const int sphereCount = argc > 2 ? atoi(argv[2]) : 4000;
+    const int boxCount = argc > 3 ? atoi(argv[3]) : 2000;
+
+    dInitODE();
+    printf("%d spheres, %d static boxes, %d rays\n", sphereCount, boxCount, RAY_COUNT);
+    printf("%14s %14s %10s %10s %10s %10s\n", "space", "collide [ms]", "pairs", "rays [ms]", "hits", "identical");
+    const char *names[] = {"simple", "sweepAndPrune", "hash", "quadTree", "bvh"};
+    BenchmarkContext referencePairs = {}, referenceHits = {};
+    for (int type = 0; type < 5; ++type) {
+        BenchmarkContext pairs, hits;
+        double rayTime;
+        const double collideTime = runBenchmark(type, sphereCount, boxCount, steps, &rayTime, &pairs, &hits);
+        if (type == 0) {
+            referencePairs = pairs;
+            referenceHits = hits;
+        }
+        const bool identical = pairs.pairCount == referencePairs.pairCount &&
+                               pairs.pairHash == referencePairs.pairHash && hits.pairCount == referenceHits.pairCount &&
+                               hits.pairHash == referenceHits.pairHash;
+        printf("%14s %14.3f %10d %10.3f %10d %10s\n", names[type], collideTime, pairs.pairCount, rayTime, hits.pairCount,
+               identical ? "yes" : "no");
+        fflush(stdout);
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,201 @@
+/*
+ * State benchmark
+ *
+ * Drops stacks of boxes on a ground plane next to a chain of hinged links,
+ * like a training episode which is rolled out many times from the same
+ * point. The world uses warm starting, the auto-disable, joint feedbacks and
+ * its own random generator, so that all the state which is not in the public
+ * getters of the bodies matters.
+ *
+ * After the warm-up steps, the state is saved with dWorldSaveState and the
+ * rollout steps are run to get the reference positions. Then the state is
+ * loaded with dWorldLoadState and the rollout is run again several times.
+ * The contact joints are not part of the state: they are created again by
+ * the collision detection at the beginning of each step, in the order of the
+ * geoms in the space which is restored with the state. The save and load
+ * times are compared to the time needed to get back to the same point by
+ * running the warm-up steps again from the initial state.
+ *
+ * Usage: state_benchmark [warm-up steps] [rollout steps] [number of boxes] [number of rollouts]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define MAX_CONTACTS 4
+#define LINK_COUNT 8
+
+struct Scene {
+    dWorldID world;
+    dSpaceID space;
+    dJointGroupID contacts;
+    std::vector<dBodyID> bodies;
+    dJointFeedback feedbacks[LINK_COUNT];
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    Scene *scene = static_cast<Scene *>(data);
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (b1 && b2 && dAreConnected(b1, b2))
+        return;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1;
+        contact[i].surface.mu = 0.8;
+        dJointID c = dJointCreateContact(scene->world, scene->contacts, &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static void createScene(Scene *scene, int boxCount)
+{
+    scene->world = dWorldCreate();
+    scene->space = dHashSpaceCreate(NULL);
+    scene->contacts = dJointGroupCreate(0);
+    dWorldSetGravity(scene->world, 0, 0, -9.81);
+    dWorldSetQuickStepNumIterations(scene->world, 20);
+    dWorldSetQuickStepWarmStarting(scene->world, 0.9);
+    dWorldSetAutoDisableFlag(scene->world, 1);
+    dWorldSetAutoDisableAverageSamplesCount(scene->world, 10);
+    dWorldSetRandomSeed(scene->world, 1);
+    dCreatePlane(scene->space, 0, 0, 1, 0);
+
+    // stacks of 4 boxes, slightly rotated so that they do not rest at once
+    const dReal size = 0.5;
+    const int stacks = (boxCount + 3) / 4;
+    const int side = (int)ceil(sqrt((double)stacks));
+    for (int i = 0; i < boxCount; ++i) {
+        const int stack = i / 4, level = i % 4;
+        dBodyID body = dBodyCreate(scene->world);
+        dMass mass;
+        dMassSetBox(&mass, 200, size, size, size);
+        dBodySetMass(body, &mass);
+        dMatrix3 rotation;
+        dRFromAxisAndAngle(rotation, 0, 0, 1, 0.1 * ((i * 7) % 5));
+        dBodySetRotation(body, rotation);
+        dBodySetPosition(body, (stack % side) * 2 * size, (stack / side) * 2 * size, (level + REAL(0.5)) * size * REAL(1.2));
+        dGeomID geom = dCreateBox(scene->space, size, size, size);
+        dGeomSetBody(geom, body);
+        scene->bodies.push_back(body);
+    }
+
+    // a horizontal chain of links hinged to the static environment, swinging over the first row of stacks
+    dBodyID previous = NULL;
+    for (int i = 0; i < LINK_COUNT; ++i) {
+        const dReal length = 0.4;
+        dBodyID link = dBodyCreate(scene->world);
+        dMass mass;
+        dMassSetCapsule(&mass, 500, 1, 0.05, length);
+        dBodySetMass(link, &mass);
+        dMatrix3 rotation;
+        dRFromAxisAndAngle(rotation, 0, 1, 0, M_PI / 2);
+        dBodySetRotation(link, rotation);
+        dBodySetPosition(link, (i + REAL(0.5)) * length, -1, 3);
+        dGeomID geom = dCreateCapsule(scene->space, 0.05, length);
+        dGeomSetBody(geom, link);
+        dJointID hinge = dJointCreateHinge(scene->world, NULL);
+        dJointAttach(hinge, link, previous);
+        dJointSetHingeAnchor(hinge, i * length, -1, 3);
+        dJointSetHingeAxis(hinge, 1, 1, 0);
+        dJointSetFeedback(hinge, &scene->feedbacks[i]);
+        scene->bodies.push_back(link);
+        previous = link;
+    }
+}
+
+static void destroyScene(Scene *scene)
+{
+    dJointGroupDestroy(scene->contacts);
+    dSpaceDestroy(scene->space);
+    dWorldDestroy(scene->world);
+    scene->bodies.clear();
+}
+
+static void step(Scene *scene)
+{
+    dSpaceCollide(scene->space, scene, &nearCallback);
+    dWorldQuickStep(scene->world, 0.004);
+    dJointGroupEmpty(scene->contacts);
+}
+
+static void getPositions(const Scene *scene, std::vector<dReal> &positions)
+{
+    positions.clear();
+    for (size_t i = 0; i < scene->bodies.size(); ++i) {
+        const dReal *p = dBodyGetPosition(scene->bodies[i]);
+        positions.insert(positions.end(), p, p + 3);
+    }
+}
+
+static double elapsed(const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    const int warmUpSteps = argc > 1 ? atoi(argv[1]) : 500;
+    const int rolloutSteps = argc > 2 ? atoi(argv[2]) : 250;
+    const int boxCount = argc > 3 ? atoi(argv[3]) : 400;
+    const int rolloutCount = argc > 4 ? atoi(argv[4]) : 10;
+
+    dInitODE();
+    Scene scene;
+    createScene(&scene, boxCount);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int s = 0; s < warmUpSteps; ++s)
+        step(&scene);
+    const double warmUpTime = elapsed(start);
+
+    int awake = 0;
+    for (size_t i = 0; i < scene.bodies.size(); ++i)
+        awake += dBodyIsEnabled(scene.bodies[i]);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<char> state(dWorldGetStateSize(scene.world, NULL, 0));
+    dWorldSaveState(scene.world, NULL, 0, &state[0]);
+    const double saveTime = elapsed(start);
+
+    std::vector<dReal> reference, positions;
+    for (int s = 0; s < rolloutSteps; ++s)
+        step(&scene);
+    getPositions(&scene, reference);
+
+    double loadTime = 0;
+    int identicalCount = 0, loadedCount = 0;
+    double maxDistance = 0;
+    for (int r = 0; r < rolloutCount; ++r) {
+        start = std::chrono::steady_clock::now();
+        loadedCount += dWorldLoadState(scene.world, NULL, 0, &state[0], state.size());
+        loadTime += elapsed(start);
+        for (int s = 0; s < rolloutSteps; ++s)
+            step(&scene);
+        getPositions(&scene, positions);
+        if (positions == reference)
+            ++identicalCount;
+        for (size_t i = 0; i < positions.size(); ++i)
+            maxDistance = fmax(maxDistance, fabs(positions[i] - reference[i]));
+    }
+
+    // once a body was destroyed, the state no longer matches the bodies of the world
+    dBodyDestroy(scene.bodies.back());
+    const bool rejected = dWorldLoadState(scene.world, NULL, 0, &state[0], state.size()) == 0;
+    destroyScene(&scene);
+    dCloseODE();
+
+    printf("%d bodies (%d awake), %d warm-up steps, %d rollouts of %d steps\n", boxCount + LINK_COUNT, awake, warmUpSteps,
+           rolloutCount, rolloutSteps);
+    printf("%12s %12s %12s %16s %10s %14s\n", "state [kB]", "save [ms]", "load [ms]", "re-simulate [ms]", "identical",
+           "max diff [m]");
+    printf("%12.1f %12.3f %12.3f %16.1f %7d/%d %14.2e\n", state.size() / 1024.0, 1000 * saveTime,
+           1000 * loadTime / rolloutCount, 1000 * warmUpTime, identicalCount, loadedCount, maxDistance);
+    printf("state of a destroyed body rejected: %s\n", rejected ? "yes" : "no");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/*
+ * Trimesh tree save/load benchmark
+ *
+ * Builds a large bumpy sphere mesh, like the CAD meshes used as bounding
+ * objects, then measures the time spent building its OPCODE collision tree
+ * and the time spent loading the same tree saved with dGeomTriMeshDataGetTree.
+ * Spheres and boxes are collided with both trimesh data objects and their
+ * contacts are compared.
+ *
+ * Usage: trimesh_tree_benchmark [number of triangles] [number of geoms]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_CONTACTS 16
+
+static double elapsedMs(const std::chrono::steady_clock::time_point &start)
+{
+    return 1000.0 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void collide(dGeomID trimesh, const std::vector<dGeomID> &geoms, std::vector<dContactGeom> *contacts)
+{
+    dContactGeom buffer[MAX_CONTACTS];
+    contacts->clear();
+    for (size_t i = 0; i < geoms.size(); ++i) {
+        const int n = dCollide(trimesh, geoms[i], MAX_CONTACTS, buffer, sizeof(dContactGeom));
+        contacts->insert(contacts->end(), buffer, buffer + n);
+    }
+}
+
+static bool sameContacts(const std::vector<dContactGeom> &a, const std::vector<dContactGeom> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (memcmp(a[i].pos, b[i].pos, 3 * sizeof(dReal)) != 0 || memcmp(a[i].normal, b[i].normal, 3 * sizeof(dReal)) != 0 ||
+            a[i].depth != b[i].depth || a[i].side1 != b[i].side1)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const int triangleCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    const int geomCount = argc > 2 ? atoi(argv[2]) : 2000;
+
+    dInitODE();
+
+    // latitude/longitude sphere with random bumps
+    const int rings = (int)sqrt(triangleCount / 2.0) + 2;
+    const int segments = rings;
+    srand(1);
+    std::vector<double> vertices;
+    for (int i = 0; i <= rings; ++i) {
+        const double theta = M_PI * i / rings;
+        for (int j = 0; j < segments; ++j) {
+            const double phi = 2.0 * M_PI * j / segments;
+            const double r = 1.0 + (rand() % 100) * 0.0002;
+            vertices.push_back(r * sin(theta) * cos(phi));
+            vertices.push_back(r * cos(theta));
+            vertices.push_back(r * sin(theta) * sin(phi));
+        }
+    }
+    std::vector<int> indices;
+    for (int i = 0; i < rings; ++i) {
+        for (int j = 0; j < segments; ++j) {
+            const int a = i * segments + j, b = i * segments + (j + 1) % segments;
+            const int c = a + segments, d = b + segments;
+            const int triangle[6] = {a, c, b, b, c, d};
+            indices.insert(indices.end(), triangle, triangle + 6);
+        }
+    }
+    const int vertexCount = (int)vertices.size() / 3;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    dTriMeshDataID builtData = dGeomTriMeshDataCreate();
+    dGeomTriMeshDataBuildDouble(builtData, &vertices[0], 3 * sizeof(double), vertexCount, &indices[0], (int)indices.size(),
+                                3 * sizeof(int));
+    const double buildTime = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<char> tree(dGeomTriMeshDataGetTree(builtData, NULL));
+    dGeomTriMeshDataGetTree(builtData, &tree[0]);
+    const double saveTime = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    dTriMeshDataID loadedData = dGeomTriMeshDataCreate();
+    const int loaded = dGeomTriMeshDataBuildDoubleWithTree(loadedData, &vertices[0], 3 * sizeof(double), vertexCount,
+                                                           &indices[0], (int)indices.size(), 3 * sizeof(int), &tree[0],
+                                                           tree.size());
+    const double loadTime = elapsedMs(start);
+
+    // a corrupted tree must be rejected and rebuilt
+    std::vector<char> corruptedTree(tree);
+    memset(&corruptedTree[corruptedTree.size() / 2], 0x5a, 64);
+    dTriMeshDataID rebuiltData = dGeomTriMeshDataCreate();
+    const int corruptedLoaded = dGeomTriMeshDataBuildDoubleWithTree(
+        rebuiltData, &vertices[0], 3 * sizeof(double), vertexCount, &indices[0], (int)indices.size(), 3 * sizeof(int),
+        &corruptedTree[0], corruptedTree.size());
+
+    // small geoms around the surface of the sphere
+    std::vector<dGeomID> geoms;
+    for (int i = 0; i < geomCount; ++i) {
+        const double theta = M_PI * rand() / RAND_MAX, phi = 2.0 * M_PI * rand() / RAND_MAX;
+        const double r = 1.0 + 0.02 * (rand() / (double)RAND_MAX - 0.5);
+        dGeomID geom = i % 2 ? dCreateSphere(NULL, 0.02) : dCreateBox(NULL, 0.03, 0.03, 0.03);
+        dGeomSetPosition(geom, r * sin(theta) * cos(phi), r * cos(theta), r * sin(theta) * sin(phi));
+        geoms.push_back(geom);
+    }
+
+    dGeomID trimeshes[3] = {dCreateTriMesh(NULL, builtData, NULL, NULL, NULL),
+                            dCreateTriMesh(NULL, loadedData, NULL, NULL, NULL),
+                            dCreateTriMesh(NULL, rebuiltData, NULL, NULL, NULL)};
+    std::vector<dContactGeom> contacts[3];
+    for (int i = 0; i < 3; ++i)
+        collide(trimeshes[i], geoms, &contacts[i]);
+
+    printf("%d triangles, %d geoms, %.1f MB tree\n", (int)indices.size() / 3, geomCount, tree.size() / 1048576.0);
+    printf("%12s %10s %10s %10s\n", "tree", "time [ms]", "contacts", "identical");
+    printf("%12s %10.3f %10d %10s\n", "build", buildTime, (int)contacts[0].size(), "yes");
+    printf("%12s %10.3f %10s %10s\n", "save", saveTime, "", "");
+    printf("%12s %10.3f %10d %10s\n", loaded ? "load" : "load failed", loadTime, (int)contacts[1].size(),
+           sameContacts(contacts[0], contacts[1]) ? "yes" : "no");
+    printf("%12s %10s %10d %10s\n", corruptedLoaded ? "corrupted" : "rebuilt", "", (int)contacts[2].size(),
+           sameContacts(contacts[0], contacts[2]) ? "yes" : "no");
+
+    for (size_t i = 0; i < geoms.size(); ++i)
+        dGeomDestroy(geoms[i]);
+    for (int i = 0; i < 3; ++i)
+        dGeomDestroy(trimeshes[i]);
+    dGeomTriMeshDataDestroy(builtData);
+    dGeomTriMeshDataDestroy(loadedData);
+    dGeomTriMeshDataDestroy(rebuiltData);
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
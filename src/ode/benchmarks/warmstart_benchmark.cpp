@@ -0,0 +1,121 @@
+/*
+ * QuickStep warm starting benchmark
+ *
+ * Stacks boxes on top of each other and lets them rest with the QuickStep
+ * solver, with and without warm starting, for an increasing number of SOR
+ * iterations. For each configuration, the benchmark reports the tallest
+ * stack that is still standing at the end of the simulation, as well as the
+ * solver speed for this stack.
+ *
+ * Usage: warmstart_benchmark [steps] [maximum number of boxes in the stack]
+ */
+
+#include <ode/ode.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#define MAX_CONTACTS 10
+
+struct BenchmarkContext {
+    dWorldID world;
+    dJointGroupID contactGroup;
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    BenchmarkContext *context = static_cast<BenchmarkContext *>(data);
+    dBodyID b1 = dGeomGetBody(o1);
+    dBodyID b2 = dGeomGetBody(o2);
+    if (b1 == NULL && b2 == NULL)
+        return;
+
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        // same defaults as WbSimulationCluster::fillSurfaceParameters(), without bounce
+        contact[i].surface.mode = dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 1.0;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID joint = dJointCreateContact(context->world, context->contactGroup, &contact[i]);
+        dJointAttach(joint, b1, b2);
+    }
+}
+
+// returns the number of steps per second and whether the stack is still standing in 'standing'
+static double runBenchmark(int iterations, dReal warmStarting, int boxCount, int steps, bool *standing)
+{
+    BenchmarkContext context;
+    context.world = dWorldCreate();
+    context.contactGroup = dJointGroupCreate(0);
+    dWorldSetGravity(context.world, 0, -9.81, 0);
+    dWorldSetCFM(context.world, 0.00001);
+    dWorldSetERP(context.world, 0.2);
+    dWorldSetAutoDisableFlag(context.world, 0);
+    dWorldSetQuickStepNumIterations(context.world, iterations);
+    dWorldSetQuickStepW(context.world, 1.3);
+    dWorldSetQuickStepWarmStarting(context.world, warmStarting);
+
+    dSpaceID space = dSimpleSpaceCreate(NULL);
+    dCreatePlane(space, 0, 1, 0, 0);
+
+    const dReal boxSize = 0.2;
+    dBodyID top = NULL;
+    for (int i = 0; i < boxCount; ++i) {
+        top = dBodyCreate(context.world);
+        dMass mass;
+        dMassSetBox(&mass, 1000.0, boxSize, boxSize, boxSize);
+        dBodySetMass(top, &mass);
+        dBodySetPosition(top, 0, boxSize * (i + 0.5), 0);
+        dGeomID geom = dCreateBox(space, boxSize, boxSize, boxSize);
+        dGeomSetBody(geom, top);
+    }
+
+    const dReal stepSize = 0.008;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        dSpaceCollide(space, &context, &nearCallback);
+        dWorldQuickStep(context.world, stepSize);
+        dJointGroupEmpty(context.contactGroup);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // the soft contacts let the stack sink a little, but never by half a box
+    const dReal *position = dBodyGetPosition(top);
+    *standing = position[1] > boxSize * (boxCount - 1);
+
+    dJointGroupDestroy(context.contactGroup);
+    dSpaceDestroy(space);
+    dWorldDestroy(context.world);
+    return steps / elapsed.count();
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 1000;
+    const int maxBoxCount = argc > 2 ? atoi(argv[2]) : 16;
+
+    dInitODE();
+    printf("%10s %6s %14s %14s\n", "iterations", "warm", "tallest stack", "steps [st/s]");
+    const int iterations[] = {2, 5, 10, 20, 40};
+    for (size_t i = 0; i < sizeof(iterations) / sizeof(iterations[0]); ++i) {
+        for (int warm = 0; warm <= 1; ++warm) {
+            int tallest = 0;
+            double speed = 0.0;
+            for (int boxCount = 2; boxCount <= maxBoxCount; ++boxCount) {
+                bool standing;
+                const double s = runBenchmark(iterations[i], warm ? 0.9 : 0.0, boxCount, steps, &standing);
+                if (!standing)
+                    break;
+                tallest = boxCount;
+                speed = s;
+            }
+            printf("%10d %6s %14d %14.1f\n", iterations[i], warm ? "0.9" : "no", tallest, speed);
+            fflush(stdout);
+        }
+    }
+    dCloseODE();
+    return EXIT_SUCCESS;
+}
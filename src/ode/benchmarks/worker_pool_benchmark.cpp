@@ -0,0 +1,207 @@
+/*
+ * Worker pool benchmark
+ *
+ * Checks the work-stealing pool shared by the ODE_MT clusters, the island and
+ * QuickStep threading, beyond the 16 threads ODE_MT was once limited to:
+ *
+ * - "pool": dRunWorkerTasks runs 0 to 2000 tasks on 1 to 64 threads, every
+ *   task must run exactly once on a worker below the requested thread count.
+ *   The time per call is reported.
+ * - "clusters": groups of boxes dropped on a plane, far enough apart
+ *   to be simulated in separate clusters, are stepped by ODE_MT with 2 to 64
+ *   threads. Each cluster is stepped by a single thread, so the final
+ *   positions must be identical for every thread count.
+ *
+ * Usage: worker_pool_benchmark [steps] [number of groups] [maximum number of threads]
+ */
+
+#include <ode/ode.h>
+#include <ode/ode_MT.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MAX_CONTACTS 4
+#define BOXES_PER_GROUP 4
+#define GROUP_SPACING 10.0
+
+struct PoolCheck {
+    unsigned int maxThreads;
+    std::vector<unsigned int> runs;
+    volatile unsigned int badWorkers;
+};
+
+static void countTask(unsigned int task, unsigned int worker, void *data)
+{
+    PoolCheck *check = static_cast<PoolCheck *>(data);
+    __atomic_add_fetch(&check->runs[task], 1, __ATOMIC_RELAXED);
+    if (worker >= check->maxThreads)
+        __atomic_add_fetch(&check->badWorkers, 1, __ATOMIC_RELAXED);
+}
+
+// returns false if a task did not run exactly once or ran on an unexpected worker
+static bool checkPool(unsigned int maxThreads, unsigned int taskCount, int repeats, double *microseconds)
+{
+    PoolCheck check;
+    check.maxThreads = maxThreads;
+    check.badWorkers = 0;
+    std::chrono::duration<double> elapsed(0.0);
+    for (int r = 0; r < repeats; ++r) {
+        check.runs.assign(taskCount, 0);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        dRunWorkerTasks(taskCount, maxThreads, &countTask, &check);
+        elapsed += std::chrono::steady_clock::now() - start;
+        for (unsigned int i = 0; i < taskCount; ++i) {
+            if (check.runs[i] != 1)
+                return false;
+        }
+    }
+    *microseconds = 1e6 * elapsed.count() / repeats;
+    return check.badWorkers == 0;
+}
+
+struct Scene {
+    dWorldID world;
+    dSpaceID space;
+    dGeomID floor;
+    std::vector<dBodyID> bodies;
+    std::vector<dJointGroupID> contactGroups;  // one per body, like Webots, as the clusters are collided concurrently
+};
+
+static void nearCallback(void *data, dGeomID o1, dGeomID o2)
+{
+    dBodyID b1 = dGeomGetBody(o1), b2 = dGeomGetBody(o2);
+    if (!b1 && !b2)
+        return;
+    // the world of the cluster the bodies have been moved to
+    dBodyID owner = b1 ? b1 : b2;
+    dContact contact[MAX_CONTACTS];
+    const int n = dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    for (int i = 0; i < n; ++i) {
+        contact[i].surface.mode = dContactApprox1 | dContactSoftCFM | dContactSoftERP;
+        contact[i].surface.mu = 0.6;
+        contact[i].surface.soft_cfm = 0.001;
+        contact[i].surface.soft_erp = 0.2;
+        dJointID c = dJointCreateContact(dBodyGetWorld(owner), (dJointGroupID)dBodyGetData(owner), &contact[i]);
+        dJointAttach(c, b1, b2);
+    }
+}
+
+static void createScene(Scene *scene, int groupCount)
+{
+    scene->world = dWorldCreate();
+    dWorldSetGravity(scene->world, 0, 0, -9.81);
+    scene->space = dHashSpaceCreate(0);
+    // the infinite floor is not clustered, it is copied in every cluster
+    scene->floor = dCreatePlane(scene->space, 0, 0, 1, 0);
+    for (int g = 0; g < groupCount; ++g) {
+        for (int i = 0; i < BOXES_PER_GROUP; ++i) {
+            dBodyID body = dBodyCreate(scene->world);
+            dMass mass;
+            dMassSetBox(&mass, 1000, 0.3, 0.3, 0.3);
+            dBodySetMass(body, &mass);
+            // slightly shifted and tilted so that the boxes topple differently in each group
+            dBodySetPosition(body, GROUP_SPACING * g + 0.05 * (i % 2) + 0.01 * g / groupCount, 0.03 * i, 0.2 + 0.35 * i);
+            dMatrix3 R;
+            dRFromAxisAndAngle(R, 1, 1, 0, 0.1 * (i + 1) + 0.2 * g / groupCount);
+            dBodySetRotation(body, R);
+            dGeomID geom = dCreateBox(scene->space, 0.3, 0.3, 0.3);
+            dGeomSetBody(geom, body);
+            dJointGroupID group = dJointGroupCreate(0);
+            dBodySetData(body, group);
+            scene->bodies.push_back(body);
+            scene->contactGroups.push_back(group);
+        }
+    }
+}
+
+static void destroyScene(Scene *scene)
+{
+    for (size_t i = 0; i < scene->contactGroups.size(); ++i)
+        dJointGroupDestroy(scene->contactGroups[i]);
+    dSpaceDestroy(scene->space);
+    dWorldDestroy(scene->world);
+}
+
+// steps the scene with 'threadCount' threads and returns the time in milliseconds per step
+static double runClusters(int threadCount, int steps, int groupCount, int *clusterCount, std::vector<dReal> *positions)
+{
+    dToggleODE_MT(threadCount);
+    Scene scene;
+    createScene(&scene, groupCount);
+    std::chrono::duration<double> elapsed(0.0);
+    for (int step = 0; step < steps; ++step) {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < scene.contactGroups.size(); ++i)
+            dJointGroupEmpty(scene.contactGroups[i]);
+        dSpaceCollideAndWorldStep(scene.space, &scene, &nearCallback, scene.world, 0.004, &dWorldStep);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    *clusterCount = dClusterGetCount(scene.world, scene.space);
+    positions->clear();
+    for (size_t i = 0; i < scene.bodies.size(); ++i) {
+        const dReal *p = dBodyGetPosition(scene.bodies[i]);
+        positions->insert(positions->end(), p, p + 3);
+    }
+    destroyScene(&scene);
+    dToggleODE_MT(0);
+    return 1000.0 * elapsed.count() / steps;
+}
+
+int main(int argc, char **argv)
+{
+    const int steps = argc > 1 ? atoi(argv[1]) : 500;
+    const int groupCount = argc > 2 ? atoi(argv[2]) : 16;
+    const unsigned int maxThreads = argc > 3 ? atoi(argv[3]) : 64;
+
+    dInitODE();
+    bool success = true;
+
+    const unsigned int taskCounts[] = {0, 1, 2, 7, 100, 2000};
+    printf("%8s", "threads");
+    for (size_t t = 0; t < sizeof(taskCounts) / sizeof(taskCounts[0]); ++t) {
+        char name[32];
+        snprintf(name, sizeof(name), "%u tasks [us]", taskCounts[t]);
+        printf(" %16s", name);
+    }
+    printf("\n");
+    for (unsigned int threads = 1; threads <= maxThreads; threads = threads < 4 ? threads + 1 : 2 * threads) {
+        printf("%8u", threads);
+        for (size_t t = 0; t < sizeof(taskCounts) / sizeof(taskCounts[0]); ++t) {
+            double microseconds = 0.0;
+            if (checkPool(threads, taskCounts[t], 100, &microseconds))
+                printf(" %16.2f", microseconds);
+            else {
+                printf(" %16s", "FAILED");
+                success = false;
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    printf("\n");
+
+    printf("%d groups of %d boxes\n", groupCount, BOXES_PER_GROUP);
+    printf("%8s %12s %10s %10s\n", "threads", "step [ms]", "clusters", "identical");
+    std::vector<dReal> reference, positions;
+    for (unsigned int threads = 2; threads <= maxThreads; threads *= 2) {
+        int clusterCount = 0;
+        const double time = runClusters(threads, steps, groupCount, &clusterCount, &positions);
+        if (reference.empty())
+            reference = positions;
+        const bool identical = positions == reference;
+        success = success && identical;
+        printf("%8u %12.3f %10d %10s\n", threads, time, clusterCount, identical ? "yes" : "no");
+        fflush(stdout);
+    }
+
+    dCloseODE();
+    if (!success) {
+        printf("The worker pool ran a task more than once, not at all or on a wrong worker, or the clusters diverged.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,873 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/odeconfig.h>
+#include <ode/rotation.h>
+#include "config.h"
+#include "odemath.h"
+#include "objects.h"
+#include "joints/joint.h"
+#include "joints/joint_internal.h"
+#include "joints/hinge.h"
+#include "joints/slider.h"
+#include "articulation.h"
+#include "util.h"
+
+//****************************************************************************
+// spatial algebra
+
+static inline dReal dot6(const dReal *a, const dReal *b)
+{
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3] + a[4]*b[4] + a[5]*b[5];
+}
+
+static inline void multiply66(dReal *out, const dReal *M, const dReal *v)
+{
+    for (int i = 0; i < 6; ++i) out[i] = dot6(M + 6*i, v);
+}
+
+// out = v x m, the product of two motion vectors
+static void motionCross(dReal *out, const dReal *v, const dReal *m)
+{
+    dVector3 tmp;
+    dCalcVectorCross3(out, v, m);
+    dCalcVectorCross3(out + 3, v, m + 3);
+    dCalcVectorCross3(tmp, v + 3, m);
+    for (int i = 0; i < 3; ++i) out[3+i] += tmp[i];
+}
+
+// out = v x* f, the product of a motion vector and a force vector
+static void forceCross(dReal *out, const dReal *v, const dReal *f)
+{
+    dVector3 tmp;
+    dCalcVectorCross3(out, v, f);
+    dCalcVectorCross3(tmp, v + 3, f + 3);
+    for (int i = 0; i < 3; ++i) out[i] += tmp[i];
+    dCalcVectorCross3(out + 3, v, f + 3);
+}
+
+// spatial force of a force f applied at x with an additional moment n
+static inline void spatialForce(dReal *out, const dReal *n, const dReal *f, const dReal *x)
+{
+    dCalcVectorCross3(out, x, f);
+    for (int i = 0; i < 3; ++i) {
+        out[i] += n[i];
+        out[3+i] = f[i];
+    }
+}
+
+// Cholesky factorization of a symmetric positive definite 6x6 matrix
+static void factor6(dReal *L, const dReal *A)
+{
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            dReal sum = A[6*i+j];
+            for (int k = 0; k < j; ++k) sum -= L[6*i+k] * L[6*j+k];
+            if (i == j) L[6*i+i] = dSqrt(sum > 0 ? sum : dEpsilon);
+            else L[6*i+j] = sum / L[6*j+j];
+        }
+        for (int j = i + 1; j < 6; ++j) L[6*i+j] = 0;
+    }
+}
+
+static void solve6(const dReal *L, dReal *x)
+{
+    for (int i = 0; i < 6; ++i) {
+        for (int k = 0; k < i; ++k) x[i] -= L[6*i+k] * x[k];
+        x[i] /= L[6*i+i];
+    }
+    for (int i = 5; i >= 0; --i) {
+        for (int k = i + 1; k < 6; ++k) x[i] -= L[6*k+i] * x[k];
+        x[i] /= L[6*i+i];
+    }
+}
+
+//****************************************************************************
+// joints
+
+static bool isArticulationCandidate(const dxWorld *world, dxJoint *joint)
+{
+    if (joint->node[0].body->invMass == 0 || (joint->node[1].body && joint->node[1].body->invMass == 0))
+        return false; // kinematic bodies
+    switch (joint->type()) {
+    case dJointTypeHinge: {
+        // hinges with a suspension are soft and stay in the LCP
+        const dxJointHinge *hinge = (const dxJointHinge *)joint;
+        return hinge->susp_erp == world->global_erp && hinge->susp_cfm == world->global_cfm;
+    }
+    case dJointTypeSlider:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void getPose(const dxBody *b, const dReal *&pos, const dReal *&R, const dReal *&q)
+{
+    static const dReal zero[4] = {0, 0, 0, 0};
+    static const dReal identityR[12] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0};
+    static const dReal identityQ[4] = {1, 0, 0, 0};
+    if (b) {
+        pos = b->posr.pos;
+        R = b->posr.R;
+        q = b->q;
+    } else {
+        pos = zero;
+        R = identityR;
+        q = identityQ;
+    }
+}
+
+// joint motion axis of a link in its current pose
+static void computeJointAxis(dxArticulationLink *link, const dReal *origin)
+{
+    dxJoint *joint = link->joint;
+    const dxBody *b1 = joint->node[0].body;
+    const dReal sign = link->first ? 1 : -1;
+    dVector3 ax1;
+    if (joint->type() == dJointTypeHinge) {
+        const dxJointHinge *hinge = (const dxJointHinge *)joint;
+        dVector3 p;
+        dMultiply0_331(ax1, b1->posr.R, hinge->axis1);
+        dMultiply0_331(p, b1->posr.R, hinge->anchor1);
+        for (int i = 0; i < 3; ++i) p[i] += b1->posr.pos[i] - origin[i];
+        dCalcVectorCross3(link->s + 3, p, ax1);
+        for (int i = 0; i < 3; ++i) {
+            link->s[i] = sign * ax1[i];
+            link->s[3+i] *= sign;
+        }
+    } else {
+        const dxJointSlider *slider = (const dxJointSlider *)joint;
+        dMultiply0_331(ax1, b1->posr.R, slider->axis1);
+        for (int i = 0; i < 3; ++i) {
+            link->s[i] = 0;
+            link->s[3+i] = sign * ax1[i];
+        }
+    }
+}
+
+static dReal getJointPosition(dxJoint *joint)
+{
+    dxBody *b1 = joint->node[0].body, *b2 = joint->node[1].body;
+    if (joint->type() == dJointTypeHinge) {
+        dxJointHinge *hinge = (dxJointHinge *)joint;
+        return getHingeAngle(b1, b2, hinge->axis1, hinge->qrel);
+    }
+    // unlike dJointGetSliderPosition(), ignore dJOINT_REVERSE
+    const dxJointSlider *slider = (const dxJointSlider *)joint;
+    dVector3 ax1, d;
+    dMultiply0_331(ax1, b1->posr.R, slider->axis1);
+    if (b2) {
+        dMultiply0_331(d, b2->posr.R, slider->offset);
+        for (int i = 0; i < 3; ++i) d[i] = b1->posr.pos[i] - b2->posr.pos[i] - d[i];
+    } else {
+        for (int i = 0; i < 3; ++i) d[i] = b1->posr.pos[i] - slider->offset[i];
+    }
+    return dCalcVectorDot3(ax1, d);
+}
+
+// set the pose of a link from the pose of its parent and its joint position
+static void setLinkPose(const dxArticulationLink *link, dReal q)
+{
+    dxJoint *joint = link->joint;
+    dxBody *child = link->body;
+    const dReal *ppos, *pR, *pq;
+    getPose(link->first ? joint->node[1].body : joint->node[0].body, ppos, pR, pq);
+
+    dQuaternion tmp;
+    dVector3 p1, p2;
+    if (joint->type() == dJointTypeHinge) {
+        // q1 = q2 * qrel^-1 * rot(axis1, angle) and both anchors coincide
+        const dxJointHinge *hinge = (const dxJointHinge *)joint;
+        dQuaternion rot;
+        dQFromAxisAndAngle(rot, hinge->axis1[0], hinge->axis1[1], hinge->axis1[2], link->first ? q : -q);
+        if (link->first) {
+            dQMultiply2(tmp, pq, hinge->qrel);
+            dQMultiply0(child->q, tmp, rot);
+        } else {
+            dQMultiply0(tmp, pq, rot);
+            dQMultiply0(child->q, tmp, hinge->qrel);
+        }
+        dNormalize4(child->q);
+        dQtoR(child->q, child->posr.R);
+        const dReal *panchor = link->first ? hinge->anchor2 : hinge->anchor1;
+        const dReal *canchor = link->first ? hinge->anchor1 : hinge->anchor2;
+        if (joint->node[1].body) {
+            dMultiply0_331(p1, pR, panchor);
+            for (int i = 0; i < 3; ++i) p1[i] += ppos[i];
+        } else {
+            for (int i = 0; i < 3; ++i) p1[i] = panchor[i];
+        }
+        dMultiply0_331(p2, child->posr.R, canchor);
+        for (int i = 0; i < 3; ++i) child->posr.pos[i] = p1[i] - p2[i];
+    } else {
+        // q1 = q2 * qrel^-1 and x1 = x2 + R2 * offset + R1 * axis1 * position
+        const dxJointSlider *slider = (const dxJointSlider *)joint;
+        if (link->first)
+            dQMultiply2(child->q, pq, slider->qrel);
+        else
+            dQMultiply0(child->q, pq, slider->qrel);
+        dNormalize4(child->q);
+        dQtoR(child->q, child->posr.R);
+        const dReal *R1 = link->first ? child->posr.R : pR;
+        dMultiply0_331(p1, R1, slider->axis1);
+        if (link->first) {
+            if (joint->node[1].body) {
+                dMultiply0_331(p2, pR, slider->offset);
+                for (int i = 0; i < 3; ++i) child->posr.pos[i] = ppos[i] + p2[i] + p1[i] * q;
+            } else {
+                for (int i = 0; i < 3; ++i) child->posr.pos[i] = slider->offset[i] + p1[i] * q;
+            }
+        } else {
+            dMultiply0_331(p2, child->posr.R, slider->offset);
+            for (int i = 0; i < 3; ++i) child->posr.pos[i] = ppos[i] - p2[i] - p1[i] * q;
+        }
+    }
+}
+
+static void setBodyVelocity(dxBody *b, const dReal *v, const dReal *origin)
+{
+    dVector3 x, tmp;
+    for (int i = 0; i < 3; ++i) x[i] = b->posr.pos[i] - origin[i];
+    dCalcVectorCross3(tmp, v, x);
+    for (int i = 0; i < 3; ++i) {
+        b->avel[i] = v[i];
+        b->lvel[i] = v[3+i] + tmp[i];
+    }
+}
+
+static void getBodyVelocity(dReal *v, const dxBody *b, const dReal *origin)
+{
+    dVector3 x, tmp;
+    for (int i = 0; i < 3; ++i) x[i] = b->posr.pos[i] - origin[i];
+    dCalcVectorCross3(tmp, b->avel, x);
+    for (int i = 0; i < 3; ++i) {
+        v[i] = b->avel[i];
+        v[3+i] = b->lvel[i] - tmp[i];
+    }
+}
+
+// spatial velocities of the links for the generalized velocities u
+static void computeVelocities(dxArticulationSet *set, const dxArticulation &art, const dReal *u, bool products)
+{
+    dxArticulationLink *const links = set->links;
+    for (unsigned int i = art.firstLink; i < art.firstLink + art.linkCount; ++i) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint) {
+            for (int k = 0; k < 6; ++k) link.v[k] = u[k];
+            continue;
+        }
+        const dReal qd = u[link.dof];
+        dReal sqd[6];
+        for (int k = 0; k < 6; ++k) {
+            sqd[k] = link.s[k] * qd;
+            link.v[k] = (link.parent >= 0 ? links[link.parent].v[k] : 0) + sqd[k];
+        }
+        if (products)
+            motionCross(link.c, link.v, sqd);
+    }
+}
+
+//****************************************************************************
+// construction
+
+size_t dxEstimateArticulationMemoryRequirements(dxBody * const *body, unsigned int nb,
+                                                dxJoint * const *joint, unsigned int nj)
+{
+    if (nb == 0 || !body[0]->world->articulated)
+        return 0;
+
+    const dxWorld *world = body[0]->world;
+    unsigned int candidates = 0;
+    for (unsigned int i = 0; i < nj; ++i)
+        if (isArticulationCandidate(world, joint[i]))
+            ++candidates;
+    if (candidates == 0)
+        return 0;
+
+    // rows of the joints acting on a body which may be part of a tree
+    size_t rows = 0;
+    dxJoint::SureMaxInfo info;
+    for (unsigned int i = 0; i < nj; ++i) {
+        dxJoint *j = joint[i];
+        bool touches = false;
+        for (int n = 0; n < 2 && !touches; ++n) {
+            const dxBody *b = j->node[n].body;
+            for (const dxJointNode *node = b ? b->firstjoint : NULL; node && !touches; node = node->next)
+                touches = node->joint->isEnabled() && isArticulationCandidate(world, node->joint);
+        }
+        if (touches) {
+            j->getSureMaxInfo(&info);
+            rows += info.max_m;
+        }
+    }
+    // a row may act on two trees
+    rows *= 2;
+    const size_t dofs = 6 + (size_t)candidates;
+
+    size_t res = dEFFICIENT_SIZE(sizeof(dxArticulationSet));
+    res += 5 * dEFFICIENT_SIZE(sizeof(int) * (size_t)nb); // for linkOfBody and the construction
+    res += dEFFICIENT_SIZE(sizeof(dxArticulationLink) * (size_t)nb);
+    res += dEFFICIENT_SIZE(sizeof(dxArticulation) * (size_t)nb);
+    res += 2 * (size_t)nb * dEFFICIENT_SIZE(sizeof(dReal) * 6); // for u and uFree, bounded per tree
+    res += (size_t)nb * dEFFICIENT_SIZE(sizeof(dxArticulationRow) * rows);
+    res += 2 * dEFFICIENT_SIZE(sizeof(dReal) * rows * dofs) + 2 * (size_t)nb * EFFICIENT_ALIGNMENT; // for G and response
+    return res;
+}
+
+static int findSet(int *parent, int i)
+{
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+dxArticulationSet *dxBuildArticulations(dxWorldProcessMemArena *memarena, dxWorld *world,
+                                        dxBody * const *body, unsigned int nb,
+                                        dxJoint * const *joint, unsigned int nj)
+{
+    if (!world->articulated)
+        return NULL;
+
+    unsigned int candidates = 0;
+    for (unsigned int i = 0; i < nj; ++i)
+        if (isArticulationCandidate(world, joint[i]))
+            ++candidates;
+    if (candidates == 0)
+        return NULL;
+
+    // join the bodies connected by the candidate joints, in the joint order.
+    // a joint closing a loop, directly or through the static environment,
+    // stays in the LCP. grounded is 1 + the index of the body attached to the
+    // static environment, or 0.
+    int *parent = memarena->AllocateArray<int>(nb);
+    int *grounded = memarena->AllocateArray<int>(nb);
+    for (unsigned int i = 0; i < nb; ++i) {
+        parent[i] = i;
+        grounded[i] = 0;
+    }
+    unsigned int treeJoints = 0;
+    for (unsigned int i = 0; i < nj; ++i) {
+        dxJoint *j = joint[i];
+        if (!isArticulationCandidate(world, j))
+            continue;
+        const int r0 = findSet(parent, j->node[0].body->tag);
+        if (j->node[1].body) {
+            const int r1 = findSet(parent, j->node[1].body->tag);
+            if (r0 == r1 || (grounded[r0] && grounded[r1]))
+                continue;
+            parent[r1] = r0;
+            if (!grounded[r0])
+                grounded[r0] = grounded[r1];
+        } else {
+            if (grounded[r0])
+                continue;
+            grounded[r0] = 1 + j->node[0].body->tag;
+        }
+        j->flags |= dJOINT_ARTICULATED;
+        ++treeJoints;
+    }
+    if (treeJoints == 0)
+        return NULL;
+
+    // the root of a floating tree is its heaviest body
+    int *root = memarena->AllocateArray<int>(nb);
+    int *articulationOfSet = memarena->AllocateArray<int>(nb);
+    for (unsigned int i = 0; i < nb; ++i) {
+        root[i] = -1;
+        articulationOfSet[i] = -1;
+    }
+    for (unsigned int i = 0; i < nb; ++i) {
+        const int r = findSet(parent, i);
+        if (root[r] < 0 || body[i]->mass.mass > body[root[r]]->mass.mass)
+            root[r] = i;
+    }
+
+    dxArticulationSet *set = memarena->AllocateArray<dxArticulationSet>(1);
+    set->links = memarena->AllocateArray<dxArticulationLink>(nb);
+    set->linkOfBody = memarena->AllocateArray<int>(nb);
+    set->articulations = memarena->AllocateArray<dxArticulation>(nb);
+    set->articulationCount = 0;
+    set->freeMotion = false;
+    for (unsigned int i = 0; i < nb; ++i)
+        set->linkOfBody[i] = -1;
+
+    unsigned int linkCount = 0;
+    for (unsigned int i = 0; i < nb; ++i) {
+        const int r = findSet(parent, i);
+        if (articulationOfSet[r] >= 0)
+            continue;
+
+        // the root of a fixed tree is the body attached to the static environment
+        dxBody *rootBody = body[grounded[r] ? grounded[r] - 1 : root[r]];
+        dxJoint *rootJoint = NULL;
+        for (dxJointNode *n = rootBody->firstjoint; n && grounded[r]; n = n->next) {
+            if ((n->joint->flags & dJOINT_ARTICULATED) && !n->body) {
+                rootJoint = n->joint;
+                break;
+            }
+        }
+
+        // single bodies are free bodies
+        bool single = !rootJoint;
+        for (dxJointNode *n = rootBody->firstjoint; n && single; n = n->next)
+            if (n->joint->flags & dJOINT_ARTICULATED)
+                single = false;
+        if (single)
+            continue;
+
+        const unsigned int a = set->articulationCount++;
+        articulationOfSet[r] = a;
+        dxArticulation &art = set->articulations[a];
+        art.firstLink = linkCount;
+        art.floating = rootJoint == NULL;
+        art.dofCount = art.floating ? 5 : 0;
+        art.rowCount = art.rowCapacity = 0;
+        art.rows = NULL;
+        art.G = art.response = NULL;
+        for (int k = 0; k < 3; ++k) art.origin[k] = rootBody->posr.pos[k];
+
+        // breadth first traversal, parents are listed before their children
+        dxArticulationLink *link = set->links + linkCount;
+        link->body = rootBody;
+        link->joint = rootJoint;
+        link->parent = -1;
+        link->first = true;
+        set->linkOfBody[rootBody->tag] = linkCount++;
+        for (unsigned int l = art.firstLink; l < linkCount; ++l) {
+            dxArticulationLink &current = set->links[l];
+            current.articulation = a;
+            current.dof = art.dofCount++;
+            for (dxJointNode *n = current.body->firstjoint; n; n = n->next) {
+                if (!(n->joint->flags & dJOINT_ARTICULATED) || !n->body || set->linkOfBody[n->body->tag] >= 0)
+                    continue;
+                dxArticulationLink &child = set->links[linkCount];
+                child.body = n->body;
+                child.joint = n->joint;
+                child.parent = l;
+                child.first = n->joint->node[0].body == n->body;
+                set->linkOfBody[n->body->tag] = linkCount++;
+            }
+        }
+        art.linkCount = linkCount - art.firstLink;
+        if (art.floating)
+            set->links[art.firstLink].dof = 0;
+
+        // joint positions and generalized velocities
+        art.u = memarena->AllocateArray<dReal>(art.dofCount);
+        art.uFree = memarena->AllocateArray<dReal>(art.dofCount);
+        for (unsigned int l = art.firstLink; l < linkCount; ++l) {
+            dxArticulationLink &current = set->links[l];
+            dReal v[6];
+            getBodyVelocity(v, current.body, art.origin);
+            if (!current.joint) {
+                for (int k = 0; k < 6; ++k) art.u[k] = v[k];
+                continue;
+            }
+            computeJointAxis(&current, art.origin);
+            current.q = getJointPosition(current.joint);
+            // rate of the joint, the relative spatial velocity along its axis
+            if (current.parent >= 0) {
+                dReal vp[6];
+                getBodyVelocity(vp, set->links[current.parent].body, art.origin);
+                for (int k = 0; k < 6; ++k) v[k] -= vp[k];
+            }
+            const int k = current.joint->type() == dJointTypeHinge ? 0 : 3;
+            art.u[current.dof] = dCalcVectorDot3(current.s + k, v + k);
+        }
+    }
+
+    return set;
+}
+
+//****************************************************************************
+// constraint rows
+
+static void getRowArticulations(const dxArticulationSet *set, const dxJoint *joint, int *a0, int *a1)
+{
+    const dxBody *b0 = joint->node[0].body, *b1 = joint->node[1].body;
+    const int l0 = set->linkOfBody[b0->tag], l1 = b1 ? set->linkOfBody[b1->tag] : -1;
+    *a0 = l0 >= 0 ? (int)set->links[l0].articulation : -1;
+    *a1 = l1 >= 0 ? (int)set->links[l1].articulation : -1;
+    if (*a1 == *a0)
+        *a1 = -1;
+}
+
+void dxArticulationsCountRows(dxArticulationSet *set, const dxJoint *joint, unsigned int m)
+{
+    int a[2];
+    getRowArticulations(set, joint, a, a + 1);
+    for (int k = 0; k < 2; ++k)
+        if (a[k] >= 0)
+            set->articulations[a[k]].rowCapacity += m;
+}
+
+void dxArticulationsAllocateRows(dxArticulationSet *set, dxWorldProcessMemArena *memarena)
+{
+    for (unsigned int a = 0; a < set->articulationCount; ++a) {
+        dxArticulation &art = set->articulations[a];
+        if (art.rowCapacity == 0)
+            continue;
+        art.rows = memarena->AllocateArray<dxArticulationRow>(art.rowCapacity);
+        art.G = memarena->AllocateArray<dReal>((size_t)art.rowCapacity * art.dofCount);
+        art.response = memarena->AllocateArray<dReal>((size_t)art.rowCapacity * art.dofCount);
+    }
+}
+
+void dxArticulationsAddRows(dxArticulationSet *set, dxJoint *joint, unsigned int ofs, unsigned int m)
+{
+    int a[2];
+    getRowArticulations(set, joint, a, a + 1);
+    for (int k = 0; k < 2; ++k) {
+        if (a[k] < 0)
+            continue;
+        dxArticulation &art = set->articulations[a[k]];
+        dIASSERT(art.rowCount + m <= art.rowCapacity);
+        for (unsigned int r = 0; r < m; ++r) {
+            dxArticulationRow &row = art.rows[art.rowCount++];
+            row.joint = joint;
+            row.index = ofs + r;
+            row.block = ofs;
+            row.size = m;
+        }
+    }
+}
+
+void dxGetArticulatedJointInfo2(dxJoint *joint, dReal worldFPS, dReal worldERP,
+                                const dxJoint::Info2Descr *info, unsigned int m)
+{
+    // the joint fills its 6 rows in a scratch buffer, only its last row is kept
+    dIASSERT(m <= 1);
+    dReal J[2*6*8], c[6], cfm[6], lo[6], hi[6];
+    int findex[6];
+    dSetZero(J, 2*6*8);
+    dSetZero(c, 6);
+    dSetValue(cfm, 6, joint->world->global_cfm);
+    dSetValue(lo, 6, -dInfinity);
+    dSetValue(hi, 6, dInfinity);
+    for (int i = 0; i < 6; ++i) findex[i] = -1;
+
+    dxJoint::Info2Descr scratch;
+    scratch.rowskip = 8;
+    scratch.J1l = J;
+    scratch.J1a = J + 4;
+    scratch.J2l = J + 6*8;
+    scratch.J2a = J + 6*8 + 4;
+    scratch.c = c;
+    scratch.cfm = cfm;
+    scratch.lo = lo;
+    scratch.hi = hi;
+    scratch.findex = findex;
+    joint->getInfo2(worldFPS, worldERP, &scratch);
+
+    for (unsigned int r = 0; r < m; ++r) {
+        const unsigned int src = 5 + r;
+        for (int k = 0; k < 3; ++k) {
+            info->J1l[8*r+k] = scratch.J1l[8*src+k];
+            info->J1a[8*r+k] = scratch.J1a[8*src+k];
+            if (joint->node[1].body) {
+                info->J2l[8*r+k] = scratch.J2l[8*src+k];
+                info->J2a[8*r+k] = scratch.J2a[8*src+k];
+            }
+        }
+        info->c[r] = c[src];
+        info->cfm[r] = cfm[src];
+        info->lo[r] = lo[src];
+        info->hi[r] = hi[src];
+        info->findex[r] = -1;
+    }
+}
+
+//****************************************************************************
+// articulated-body algorithm
+
+// rigid-body and articulated-body inertias, which do not depend on the velocities
+static void computeInertias(dxArticulationSet *set, dxArticulation &art)
+{
+    dxArticulationLink *const links = set->links;
+    const unsigned int begin = art.firstLink, end = art.firstLink + art.linkCount;
+    for (unsigned int i = begin; i < end; ++i) {
+        dxArticulationLink &link = links[i];
+        const dxBody *b = link.body;
+        dVector3 x;
+        for (int k = 0; k < 3; ++k) x[k] = b->posr.pos[k] - art.origin[k];
+
+        dMatrix3 tmp;
+        dMultiply2_333(tmp, b->mass.I, b->posr.R);
+        dMultiply0_333(link.Ic, b->posr.R, tmp);
+        const dReal m = b->mass.mass, xx = dCalcVectorDot3(x, x);
+        const dReal X[9] = {0, -x[2], x[1], x[2], 0, -x[0], -x[1], x[0], 0};
+        for (int r = 0; r < 3; ++r) {
+            for (int k = 0; k < 3; ++k) {
+                link.I[6*r+k] = link.Ic[4*r+k] + m * ((r == k ? xx : 0) - x[r] * x[k]);
+                link.I[6*r+3+k] = m * X[3*r+k];
+                link.I[6*(3+r)+k] = m * X[3*k+r];
+                link.I[6*(3+r)+3+k] = r == k ? m : 0;
+            }
+        }
+        for (int k = 0; k < 36; ++k) link.IA[k] = link.I[k];
+    }
+
+    // from the leaves to the root
+    for (unsigned int i = end; i-- > begin;) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint)
+            continue;
+        multiply66(link.U, link.IA, link.s);
+        link.d = dot6(link.s, link.U);
+        if (link.parent < 0)
+            continue;
+        const dReal dRecip = REAL(1.0) / link.d;
+        dReal *IA = links[link.parent].IA;
+        for (int r = 0; r < 6; ++r)
+            for (int k = 0; k < 6; ++k)
+                IA[6*r+k] += link.IA[6*r+k] - link.U[r] * link.U[k] * dRecip;
+    }
+    if (art.floating)
+        factor6(art.L, links[art.firstLink].IA);
+}
+
+// uFree = u + h * accelerations, the velocity-product forces being computed
+// with the generalized velocities uBias
+static void computeFreeVelocities(dxArticulationSet *set, dxArticulation &art, const dReal *uBias, dReal h)
+{
+    dxArticulationLink *const links = set->links;
+    const unsigned int begin = art.firstLink, end = art.firstLink + art.linkCount;
+
+    // bias forces, from the root to the leaves
+    computeVelocities(set, art, uBias, true);
+    for (unsigned int i = begin; i < end; ++i) {
+        dxArticulationLink &link = links[i];
+        const dxBody *b = link.body;
+        dVector3 x;
+        for (int k = 0; k < 3; ++k) x[k] = b->posr.pos[k] - art.origin[k];
+        dReal momentum[6], fext[6];
+        multiply66(momentum, link.I, link.v);
+        forceCross(link.pA, link.v, momentum);
+        // the gyroscopic torque is already in tacc if the body uses it
+        dVector3 tmp, gyro;
+        dMultiply0_331(tmp, link.Ic, link.v);
+        dCalcVectorCross3(gyro, link.v, tmp);
+        spatialForce(fext, b->tacc, b->facc, x);
+        for (int k = 0; k < 3; ++k) link.pA[k] -= gyro[k];
+        for (int k = 0; k < 6; ++k) link.pA[k] -= fext[k];
+        if (!link.joint)
+            dSetZero(link.c, 6);
+    }
+
+    // articulated bias forces, from the leaves to the root
+    for (unsigned int i = end; i-- > begin;) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint)
+            continue;
+        link.u = -dot6(link.s, link.pA);
+        if (link.parent < 0)
+            continue;
+        // Ia * c with Ia = IA - U * U' / d
+        dReal pa[6];
+        multiply66(pa, link.IA, link.c);
+        const dReal k = (link.u - dot6(link.U, link.c)) / link.d;
+        dReal *pA = links[link.parent].pA;
+        for (int j = 0; j < 6; ++j) pA[j] += link.pA[j] + pa[j] + link.U[j] * k;
+    }
+
+    // accelerations, from the root to the leaves
+    for (unsigned int i = begin; i < end; ++i) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint) {
+            for (int k = 0; k < 6; ++k) link.a[k] = -link.pA[k];
+            solve6(art.L, link.a);
+            for (int k = 0; k < 6; ++k) art.uFree[k] = art.u[k] + h * link.a[k];
+            continue;
+        }
+        dReal ap[6];
+        for (int k = 0; k < 6; ++k) ap[k] = (link.parent >= 0 ? links[link.parent].a[k] : 0) + link.c[k];
+        const dReal qdd = (link.u - dot6(link.U, ap)) / link.d;
+        for (int k = 0; k < 6; ++k) link.a[k] = ap[k] + link.s[k] * qdd;
+        art.uFree[link.dof] = art.u[link.dof] + h * qdd;
+    }
+}
+
+void dxArticulationsComputeFreeMotion(dxArticulationSet *set, dReal stepsize)
+{
+    for (unsigned int a = 0; a < set->articulationCount; ++a) {
+        dxArticulation &art = set->articulations[a];
+        computeInertias(set, art);
+        // the velocity-product forces are evaluated again at the midpoint of a
+        // first prediction, explicit ones make fast chains gain energy
+        computeFreeVelocities(set, art, art.u, stepsize);
+        for (unsigned int k = 0; k < art.dofCount; ++k) art.uFree[k] = REAL(0.5) * (art.u[k] + art.uFree[k]);
+        computeFreeVelocities(set, art, art.uFree, stepsize);
+    }
+    set->freeMotion = true;
+}
+
+// response = H^-1 * tau, using the articulated-body inertias of the free motion
+static void solveResponse(dxArticulationSet *set, const dxArticulation &art, const dReal *tau, dReal *response)
+{
+    dxArticulationLink *const links = set->links;
+    const unsigned int begin = art.firstLink, end = art.firstLink + art.linkCount;
+    for (unsigned int i = begin; i < end; ++i)
+        dSetZero(links[i].pA, 6);
+    for (unsigned int i = end; i-- > begin;) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint)
+            continue;
+        link.u = tau[link.dof] - dot6(link.s, link.pA);
+        if (link.parent < 0)
+            continue;
+        const dReal k = link.u / link.d;
+        dReal *pA = links[link.parent].pA;
+        for (int j = 0; j < 6; ++j) pA[j] += link.pA[j] + link.U[j] * k;
+    }
+    for (unsigned int i = begin; i < end; ++i) {
+        dxArticulationLink &link = links[i];
+        if (!link.joint) {
+            for (int k = 0; k < 6; ++k) link.a[k] = tau[k] - link.pA[k];
+            solve6(art.L, link.a);
+            for (int k = 0; k < 6; ++k) response[k] = link.a[k];
+            continue;
+        }
+        static const dReal zero[6] = {0, 0, 0, 0, 0, 0};
+        const dReal *ap = link.parent >= 0 ? links[link.parent].a : zero;
+        const dReal qdd = (link.u - dot6(link.U, ap)) / link.d;
+        for (int k = 0; k < 6; ++k) link.a[k] = ap[k] + link.s[k] * qdd;
+        response[link.dof] = qdd;
+    }
+}
+
+void dxArticulationsAddToA(dxArticulationSet *set, const dReal *J, dReal *A, unsigned int mskip)
+{
+    dxArticulationLink *const links = set->links;
+    for (unsigned int a = 0; a < set->articulationCount; ++a) {
+        dxArticulation &art = set->articulations[a];
+        const unsigned int n = art.dofCount;
+
+        // generalized forces of the rows and their velocity responses
+        for (unsigned int r = 0; r < art.rowCount; ++r) {
+            const dxArticulationRow &row = art.rows[r];
+            dReal *G = art.G + (size_t)r * n;
+            dSetZero(G, n);
+            for (int s = 0; s < 2; ++s) {
+                const dxBody *b = row.joint->node[s].body;
+                const int l = b ? set->linkOfBody[b->tag] : -1;
+                if (l < 0 || links[l].articulation != a)
+                    continue;
+                const dReal *Jrow = J + 2*8*(size_t)row.block + 8*(size_t)(s * row.size + row.index - row.block);
+                dVector3 x;
+                for (int k = 0; k < 3; ++k) x[k] = b->posr.pos[k] - art.origin[k];
+                dReal f[6];
+                spatialForce(f, Jrow + 4, Jrow, x);
+                for (int k = l; k >= 0; k = links[k].parent) {
+                    if (links[k].joint)
+                        G[links[k].dof] += dot6(links[k].s, f);
+                    else
+                        for (int j = 0; j < 6; ++j) G[j] += f[j];
+                }
+            }
+            solveResponse(set, art, G, art.response + (size_t)r * n);
+        }
+
+        for (unsigned int i = 0; i < art.rowCount; ++i) {
+            const dxArticulationRow &rowi = art.rows[i];
+            const dReal *Gi = art.G + (size_t)i * n;
+            dReal *Arow = A + (size_t)mskip * rowi.index;
+            for (unsigned int j = 0; j < art.rowCount; ++j) {
+                const dxArticulationRow &rowj = art.rows[j];
+                if (rowj.index > rowi.index && rowj.block != rowi.block)
+                    break;
+                const dReal *Rj = art.response + (size_t)j * n;
+                dReal sum = 0;
+                for (unsigned int k = 0; k < n; ++k) sum += Gi[k] * Rj[k];
+                Arow[rowj.index] += sum;
+            }
+        }
+    }
+}
+
+void dxArticulationsGetFreeVelocities(const dxArticulationSet *set, dReal *tmp1, dReal stepsizeRecip)
+{
+    for (unsigned int a = 0; a < set->articulationCount; ++a) {
+        const dxArticulation &art = set->articulations[a];
+        computeVelocities(const_cast<dxArticulationSet *>(set), art, art.uFree, false);
+        for (unsigned int i = art.firstLink; i < art.firstLink + art.linkCount; ++i) {
+            const dxArticulationLink &link = set->links[i];
+            dReal *tmp1curr = tmp1 + 8*(size_t)(unsigned)link.body->tag;
+            dVector3 x, tmp;
+            for (int k = 0; k < 3; ++k) x[k] = link.body->posr.pos[k] - art.origin[k];
+            dCalcVectorCross3(tmp, link.v, x);
+            for (int k = 0; k < 3; ++k) {
+                tmp1curr[k] = (link.v[3+k] + tmp[k]) * stepsizeRecip;
+                tmp1curr[4+k] = link.v[k] * stepsizeRecip;
+            }
+        }
+    }
+}
+
+void dxArticulationsIntegrate(dxArticulationSet *set, const dReal *lambda, dReal stepsize)
+{
+    if (!set->freeMotion)
+        dxArticulationsComputeFreeMotion(set, stepsize);
+
+    dxArticulationLink *const links = set->links;
+    for (unsigned int a = 0; a < set->articulationCount; ++a) {
+        dxArticulation &art = set->articulations[a];
+        const unsigned int n = art.dofCount;
+
+        // u' = u_free + h * H^-1 * G' * lambda
+        dReal *u = art.u;
+        for (unsigned int k = 0; k < n; ++k) u[k] = art.uFree[k];
+        for (unsigned int r = 0; r < art.rowCount; ++r) {
+            const dReal impulse = stepsize * lambda[art.rows[r].index];
+            const dReal *response = art.response + (size_t)r * n;
+            for (unsigned int k = 0; k < n; ++k) u[k] += impulse * response[k];
+        }
+
+        // the root of a floating tree is integrated like a free body, the other
+        // links are placed by their joint positions
+        for (unsigned int i = art.firstLink; i < art.firstLink + art.linkCount; ++i) {
+            dxArticulationLink &link = links[i];
+            dxBody *b = link.body;
+            if (!link.joint) {
+                // the root starts at the reference point, its velocity is u
+                setBodyVelocity(b, u, art.origin);
+                dxStepBody(b, stepsize);
+                for (int k = 0; k < 3; ++k) {
+                    link.v[k] = b->avel[k];
+                    link.v[3+k] = b->lvel[k];
+                }
+                // the velocity of its new center of mass
+                setBodyVelocity(b, link.v, art.origin);
+                continue;
+            }
+            setLinkPose(&link, link.q + stepsize * u[link.dof]);
+            computeJointAxis(&link, art.origin);
+            for (int k = 0; k < 6; ++k) link.v[k] = (link.parent >= 0 ? links[link.parent].v[k] : 0) + link.s[k] * u[link.dof];
+            setBodyVelocity(b, link.v, art.origin);
+            if (!b->world->defer_moved_notifications)
+                dxNotifyBodyMoved(b);
+            link.joint->flags &= ~dJOINT_ARTICULATED;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+
+reduced coordinate dynamics of the hinge and slider trees of an island, used
+by dWorldStep when dWorldSetArticulatedBodySolver() is enabled.
+
+the rigid hinges and sliders of an island that form a tree are removed from
+the LCP, except for their limit and motor row. the links of each tree are
+integrated with Featherstone's articulated-body algorithm from their joint
+positions and rates, so the joints can not drift apart. the other rows acting
+on a tree (contacts, limits, motors, joints closing a loop, joints to free
+bodies) are coupled to it through the tree response to a unit impulse along
+each row, which is also computed in O(n) by the articulated-body algorithm.
+
+spatial vectors are expressed in the world frame at a reference point fixed
+during the step: motion vectors are (angular velocity, linear velocity of
+the body point located at the reference point) and force vectors are (moment
+about the reference point, force).
+
+*/
+
+#ifndef _ODE_ARTICULATION_H_
+#define _ODE_ARTICULATION_H_
+
+#include <ode/common.h>
+#include "objects.h"
+#include "joints/joint.h"
+
+class dxWorldProcessMemArena;
+
+struct dxArticulationLink
+{
+    dxBody *body;
+    dxJoint *joint;     // joint to the parent link, NULL for a floating root
+    int parent;         // index of the parent link, -1 for the root
+    unsigned int articulation;
+    unsigned int dof;   // index of the joint rate in the generalized velocities
+    bool first;         // the link is the first body of its joint
+    dReal s[6];         // joint motion axis
+    dReal q;            // joint position
+    dReal v[6];         // spatial velocity
+    dReal c[6];         // velocity-product acceleration
+    dMatrix3 Ic;        // rotational inertia about the center of mass
+    dReal I[36];        // rigid-body inertia
+    dReal IA[36];       // articulated-body inertia
+    dReal pA[6];        // articulated bias force
+    dReal U[6], d, u;   // IA*s, s*IA*s and the articulated joint force
+    dReal a[6];         // spatial acceleration
+};
+
+struct dxArticulationRow
+{
+    dxJoint *joint;
+    unsigned int index; // row index in the LCP
+    unsigned int block; // index of the first row of the joint
+    unsigned int size;  // number of rows of the joint
+};
+
+struct dxArticulation
+{
+    unsigned int firstLink, linkCount; // parents are listed before children
+    unsigned int dofCount;             // number of generalized velocities
+    bool floating;                     // the root is not attached to the static environment
+    dVector3 origin;                   // reference point of the spatial vectors
+    dReal L[36];                       // Cholesky factor of the root articulated inertia
+    dReal *u;                          // generalized velocities
+    dReal *uFree;                      // generalized velocities without constraint forces
+    unsigned int rowCount, rowCapacity;
+    dxArticulationRow *rows;
+    dReal *G;                          // generalized forces of the rows, rowCount x dofCount
+    dReal *response;                   // generalized velocity responses, rowCount x dofCount
+};
+
+struct dxArticulationSet
+{
+    dxArticulation *articulations;
+    unsigned int articulationCount;
+    dxArticulationLink *links;
+    int *linkOfBody;                   // link index of each body, by body tag, -1 for free bodies
+    bool freeMotion;                   // the free motion has been computed
+};
+
+size_t dxEstimateArticulationMemoryRequirements(dxBody * const *body, unsigned int nb,
+                                                dxJoint * const *joint, unsigned int nj);
+
+// find the trees of the island and set dJOINT_ARTICULATED on their joints.
+// the bodies must be tagged with their index. returns NULL if
+// dWorldSetArticulatedBodySolver() is disabled or if the island has no tree.
+dxArticulationSet *dxBuildArticulations(dxWorldProcessMemArena *memarena, dxWorld *world,
+                                        dxBody * const *body, unsigned int nb,
+                                        dxJoint * const *joint, unsigned int nj);
+
+static inline bool dxArticulationsContain(const dxArticulationSet *set, const dxBody *b)
+{
+    return set && set->linkOfBody[b->tag] >= 0;
+}
+
+// only the limit and motor row of an articulated joint remains in the LCP
+static inline void dxReduceArticulatedJointInfo1(dxJoint::Info1 *info)
+{
+    info->m -= 5;
+    info->nub = 0;
+}
+
+void dxGetArticulatedJointInfo2(dxJoint *joint, dReal worldFPS, dReal worldERP,
+                                const dxJoint::Info2Descr *info, unsigned int m);
+
+// rows are counted, then allocated, then added in increasing order
+void dxArticulationsCountRows(dxArticulationSet *set, const dxJoint *joint, unsigned int m);
+void dxArticulationsAllocateRows(dxArticulationSet *set, dxWorldProcessMemArena *memarena);
+void dxArticulationsAddRows(dxArticulationSet *set, dxJoint *joint, unsigned int ofs, unsigned int m);
+
+// must be called once the force accumulators are complete, i.e. after all
+// the getInfo2() calls which may add the motor forces to the bodies.
+void dxArticulationsComputeFreeMotion(dxArticulationSet *set, dReal stepsize);
+
+// add the tree contributions to the lower triangle and the diagonal blocks
+// of A, which has the layout of dInternalStepIsland
+void dxArticulationsAddToA(dxArticulationSet *set, const dReal *J, dReal *A, unsigned int mskip);
+
+// set the rows of tmp1 of the articulated bodies to their velocity after a
+// free step divided by the step size
+void dxArticulationsGetFreeVelocities(const dxArticulationSet *set, dReal *tmp1, dReal stepsizeRecip);
+
+// apply the LCP impulses (lambda can be NULL if there are no rows),
+// integrate the joint positions and update the poses and velocities of the
+// links. clears dJOINT_ARTICULATED.
+void dxArticulationsIntegrate(dxArticulationSet *set, const dReal *lambda, dReal stepsize);
+
+#endif
@@ -0,0 +1,761 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001-2003 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+/*
+ *  Dynamic AABB tree space, after b2DynamicTree of Box2D by Erin Catto.
+ *
+ *  The geoms are stored in two bounding volume hierarchies updated
+ *  incrementally:
+ *  - the dynamic tree holds the geoms attached to a body, the spaces and the
+ *    geoms flagged as dynamic (sensor rays). Their AABBs are enlarged by a
+ *    margin so that small motions do not require to update the tree.
+ *  - the static tree holds the other geoms with their exact AABB. It is only
+ *    updated when one of them moves, and the pairs of overlapping static
+ *    geoms are cached until then.
+ *  The geoms with an infinite AABB (planes) are kept in a list and tested
+ *  against all the other geoms.
+ *
+ *  Only the dirty geoms are visited when cleaning the space, and a geom is
+ *  only reinserted when its AABB leaves the AABB of its leaf. New leaves are
+ *  placed with the surface area heuristic and the trees are kept balanced
+ *  with AVL rotations.
+ */
+
+#include <ode/common.h>
+#include <ode/collision_space.h>
+#include <ode/collision.h>
+
+#include "config.h"
+#include "matrix.h"
+#include "array.h"
+#include "collision_kernel.h"
+#include "collision_space_internal.h"
+#include "ode_MT/ode_MT.h"
+
+#define GEOM_ENABLED(g) (((g)->gflags & GEOM_ENABLE_TEST_MASK) == GEOM_ENABLE_TEST_VALUE)
+
+// margin added to each side of the AABBs of the dynamic geoms, relative to
+// their size, and absolute
+#define BVH_MARGIN_RATIO REAL(0.1)
+#define BVH_MARGIN REAL(0.1)
+
+#define BVH_NULL_NODE (-1)
+
+// the list a geom is stored in is kept in tome_ex, and its leaf or its index
+// in the list of infinite geoms is kept in next_ex
+enum {
+    BVH_NO_LIST = 0,
+    BVH_DYNAMIC_TREE,
+    BVH_STATIC_TREE,
+    BVH_INFINITE_LIST
+};
+
+#define GEOM_SET_BVH(g,list,idx) { (g)->tome_ex = (dxGeom**)(size_t)(list); (g)->next_ex = (dxGeom*)(size_t)(idx); }
+#define GEOM_GET_BVH_LIST(g) ((int)(size_t)(g)->tome_ex)
+#define GEOM_GET_BVH_INDEX(g) ((int)(size_t)(g)->next_ex)
+
+//****************************************************************************
+// AABB helpers
+
+static inline bool aabbOverlap (const dReal *a, const dReal *b)
+{
+    return a[0] <= b[1] && a[1] >= b[0] &&
+        a[2] <= b[3] && a[3] >= b[2] &&
+        a[4] <= b[5] && a[5] >= b[4];
+}
+
+static inline bool aabbContains (const dReal *outer, const dReal *inner)
+{
+    return outer[0] <= inner[0] && outer[1] >= inner[1] &&
+        outer[2] <= inner[2] && outer[3] >= inner[3] &&
+        outer[4] <= inner[4] && outer[5] >= inner[5];
+}
+
+static inline bool aabbIsInfinite (const dReal *a)
+{
+    return a[0] == -dInfinity || a[1] == dInfinity ||
+        a[2] == -dInfinity || a[3] == dInfinity ||
+        a[4] == -dInfinity || a[5] == dInfinity;
+}
+
+static inline void aabbUnion (dReal *result, const dReal *a, const dReal *b)
+{
+    for (int i = 0; i < 6; i += 2) {
+        result[i] = a[i] < b[i] ? a[i] : b[i];
+        result[i+1] = a[i+1] > b[i+1] ? a[i+1] : b[i+1];
+    }
+}
+
+// half of the surface area
+static inline dReal aabbArea (const dReal *a)
+{
+    const dReal x = a[1] - a[0], y = a[3] - a[2], z = a[5] - a[4];
+    return x*y + y*z + z*x;
+}
+
+static inline dReal aabbUnionArea (const dReal *a, const dReal *b)
+{
+    dReal u[6];
+    aabbUnion (u,a,b);
+    return aabbArea (u);
+}
+
+static bool rayHitsAABB (const dReal *aabb, const dVector3 origin, const dVector3 dir, dReal length)
+{
+    dReal tmin = 0, tmax = length;
+    for (int i = 0; i < 3; i++) {
+        if (dFabs (dir[i]) < dEpsilon) {
+            if (origin[i] < aabb[2*i] || origin[i] > aabb[2*i+1])
+                return false;
+        }
+        else {
+            const dReal inv = dRecip (dir[i]);
+            dReal t1 = (aabb[2*i] - origin[i]) * inv;
+            dReal t2 = (aabb[2*i+1] - origin[i]) * inv;
+            if (t1 > t2) { const dReal t = t1; t1 = t2; t2 = t; }
+            if (t1 > tmin) tmin = t1;
+            if (t2 < tmax) tmax = t2;
+            if (tmin > tmax)
+                return false;
+        }
+    }
+    return true;
+}
+
+//****************************************************************************
+// dynamic AABB tree
+
+struct dxBVHNode {
+    dReal aabb[6];
+    int parent;             // next free node if the node is free
+    int child1, child2;     // BVH_NULL_NODE for the leaves
+    int height;             // 0 for the leaves, -1 for the free nodes
+    dxGeom *geom;           // 0 for the internal nodes
+
+    bool isLeaf() const { return child1 == BVH_NULL_NODE; }
+};
+
+struct dxBVHTree {
+    dArray<dxBVHNode> nodes;
+    int root;
+    int freelist;
+
+    dxBVHTree() : root(BVH_NULL_NODE), freelist(BVH_NULL_NODE) {}
+
+    // returns the leaf storing the geom
+    int insert (dxGeom *geom, const dReal aabb[6]);
+    void remove (int leaf);
+
+private:
+    int allocateNode();
+    void freeNode (int node);
+    void insertLeaf (int leaf);
+    void removeLeaf (int leaf);
+    void refitAncestors (int node);
+    int balance (int node);
+};
+
+int dxBVHTree::allocateNode()
+{
+    if (freelist == BVH_NULL_NODE) {
+        const int size = nodes.size();
+        nodes.setSize (size + 1);
+        nodes[size].parent = BVH_NULL_NODE;
+        freelist = size;
+    }
+    const int node = freelist;
+    dxBVHNode &n = nodes[node];
+    freelist = n.parent;
+    n.parent = BVH_NULL_NODE;
+    n.child1 = n.child2 = BVH_NULL_NODE;
+    n.height = 0;
+    n.geom = 0;
+    return node;
+}
+
+void dxBVHTree::freeNode (int node)
+{
+    nodes[node].parent = freelist;
+    nodes[node].height = -1;
+    freelist = node;
+}
+
+int dxBVHTree::insert (dxGeom *geom, const dReal aabb[6])
+{
+    const int leaf = allocateNode();
+    memcpy (nodes[leaf].aabb,aabb,6*sizeof(dReal));
+    nodes[leaf].geom = geom;
+    insertLeaf (leaf);
+    return leaf;
+}
+
+void dxBVHTree::remove (int leaf)
+{
+    dIASSERT (nodes[leaf].isLeaf());
+    removeLeaf (leaf);
+    freeNode (leaf);
+}
+
+void dxBVHTree::insertLeaf (int leaf)
+{
+    if (root == BVH_NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = BVH_NULL_NODE;
+        return;
+    }
+
+    // find the best sibling: descend while creating the new parent deeper
+    // costs less than creating it here, including the enlargement of the
+    // ancestors
+    const dReal *leafaabb = nodes[leaf].aabb;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        const dxBVHNode &n = nodes[index];
+        const dReal area = aabbArea (n.aabb);
+        const dReal combinedarea = aabbUnionArea (n.aabb,leafaabb);
+
+        // cost of creating a new parent for this node and the new leaf
+        const dReal cost = 2 * combinedarea;
+        // minimum cost of pushing the leaf further down the tree
+        const dReal inheritancecost = 2 * (combinedarea - area);
+
+        dReal cost1 = aabbUnionArea (nodes[n.child1].aabb,leafaabb) + inheritancecost;
+        if (!nodes[n.child1].isLeaf()) cost1 -= aabbArea (nodes[n.child1].aabb);
+        dReal cost2 = aabbUnionArea (nodes[n.child2].aabb,leafaabb) + inheritancecost;
+        if (!nodes[n.child2].isLeaf()) cost2 -= aabbArea (nodes[n.child2].aabb);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? n.child1 : n.child2;
+    }
+    const int sibling = index;
+
+    // create a new parent, nodes may be reallocated
+    const int oldparent = nodes[sibling].parent;
+    const int newparent = allocateNode();
+    dxBVHNode &p = nodes[newparent];
+    p.parent = oldparent;
+    aabbUnion (p.aabb,nodes[leaf].aabb,nodes[sibling].aabb);
+    p.height = nodes[sibling].height + 1;
+    p.child1 = sibling;
+    p.child2 = leaf;
+    if (oldparent != BVH_NULL_NODE) {
+        if (nodes[oldparent].child1 == sibling) nodes[oldparent].child1 = newparent;
+        else nodes[oldparent].child2 = newparent;
+    }
+    else {
+        root = newparent;
+    }
+    nodes[sibling].parent = newparent;
+    nodes[leaf].parent = newparent;
+
+    refitAncestors (nodes[leaf].parent);
+}
+
+void dxBVHTree::removeLeaf (int leaf)
+{
+    if (leaf == root) {
+        root = BVH_NULL_NODE;
+        return;
+    }
+
+    const int parent = nodes[leaf].parent;
+    const int grandparent = nodes[parent].parent;
+    const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandparent != BVH_NULL_NODE) {
+        // destroy the parent and connect the sibling to the grand parent
+        if (nodes[grandparent].child1 == parent) nodes[grandparent].child1 = sibling;
+        else nodes[grandparent].child2 = sibling;
+        nodes[sibling].parent = grandparent;
+        freeNode (parent);
+        refitAncestors (grandparent);
+    }
+    else {
+        root = sibling;
+        nodes[sibling].parent = BVH_NULL_NODE;
+        freeNode (parent);
+    }
+}
+
+// rebalance the nodes from 'node' up to the root and update their AABBs and heights
+void dxBVHTree::refitAncestors (int node)
+{
+    while (node != BVH_NULL_NODE) {
+        node = balance (node);
+        dxBVHNode &n = nodes[node];
+        const dxBVHNode &c1 = nodes[n.child1];
+        const dxBVHNode &c2 = nodes[n.child2];
+        n.height = 1 + (c1.height > c2.height ? c1.height : c2.height);
+        aabbUnion (n.aabb,c1.aabb,c2.aabb);
+        node = n.parent;
+    }
+}
+
+// perform a left or right rotation if node A is imbalanced, returns the new
+// root of the subtree
+int dxBVHTree::balance (int iA)
+{
+    dxBVHNode *A = &nodes[iA];
+    if (A->isLeaf() || A->height < 2)
+        return iA;
+
+    const int iB = A->child1;
+    const int iC = A->child2;
+    dxBVHNode *B = &nodes[iB];
+    dxBVHNode *C = &nodes[iC];
+    const int balance = C->height - B->height;
+
+    if (balance > 1) {
+        // rotate C up
+        const int iF = C->child1;
+        const int iG = C->child2;
+        dxBVHNode *F = &nodes[iF];
+        dxBVHNode *G = &nodes[iG];
+
+        // swap A and C
+        C->child1 = iA;
+        C->parent = A->parent;
+        A->parent = iC;
+
+        // A's old parent should point to C
+        if (C->parent != BVH_NULL_NODE) {
+            if (nodes[C->parent].child1 == iA) nodes[C->parent].child1 = iC;
+            else nodes[C->parent].child2 = iC;
+        }
+        else {
+            root = iC;
+        }
+
+        // rotate
+        if (F->height > G->height) {
+            C->child2 = iF;
+            A->child2 = iG;
+            G->parent = iA;
+            aabbUnion (A->aabb,B->aabb,G->aabb);
+            aabbUnion (C->aabb,A->aabb,F->aabb);
+            A->height = 1 + (B->height > G->height ? B->height : G->height);
+            C->height = 1 + (A->height > F->height ? A->height : F->height);
+        }
+        else {
+            C->child2 = iG;
+            A->child2 = iF;
+            F->parent = iA;
+            aabbUnion (A->aabb,B->aabb,F->aabb);
+            aabbUnion (C->aabb,A->aabb,G->aabb);
+            A->height = 1 + (B->height > F->height ? B->height : F->height);
+            C->height = 1 + (A->height > G->height ? A->height : G->height);
+        }
+        return iC;
+    }
+
+    if (balance < -1) {
+        // rotate B up
+        const int iD = B->child1;
+        const int iE = B->child2;
+        dxBVHNode *D = &nodes[iD];
+        dxBVHNode *E = &nodes[iE];
+
+        // swap A and B
+        B->child1 = iA;
+        B->parent = A->parent;
+        A->parent = iB;
+
+        // A's old parent should point to B
+        if (B->parent != BVH_NULL_NODE) {
+            if (nodes[B->parent].child1 == iA) nodes[B->parent].child1 = iB;
+            else nodes[B->parent].child2 = iB;
+        }
+        else {
+            root = iB;
+        }
+
+        // rotate
+        if (D->height > E->height) {
+            B->child2 = iD;
+            A->child1 = iE;
+            E->parent = iA;
+            aabbUnion (A->aabb,C->aabb,E->aabb);
+            aabbUnion (B->aabb,A->aabb,D->aabb);
+            A->height = 1 + (C->height > E->height ? C->height : E->height);
+            B->height = 1 + (A->height > D->height ? A->height : D->height);
+        }
+        else {
+            B->child2 = iE;
+            A->child1 = iD;
+            D->parent = iA;
+            aabbUnion (A->aabb,C->aabb,D->aabb);
+            aabbUnion (B->aabb,A->aabb,E->aabb);
+            A->height = 1 + (C->height > D->height ? C->height : D->height);
+            B->height = 1 + (A->height > E->height ? A->height : E->height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+//****************************************************************************
+// tree traversals, 'visitor' is called for the pairs of leaves whose AABBs
+// overlap
+
+template <class Visitor>
+static void collideNodes (const dxBVHTree &t1, int n1, const dxBVHTree &t2, int n2, Visitor &visitor)
+{
+    const dxBVHNode &a = t1.nodes[n1];
+    const dxBVHNode &b = t2.nodes[n2];
+    if (!aabbOverlap (a.aabb,b.aabb))
+        return;
+
+    if (a.isLeaf()) {
+        if (b.isLeaf()) {
+            visitor (a.geom,b.geom);
+        }
+        else {
+            collideNodes (t1,n1,t2,b.child1,visitor);
+            collideNodes (t1,n1,t2,b.child2,visitor);
+        }
+    }
+    else if (b.isLeaf() || aabbArea (a.aabb) >= aabbArea (b.aabb)) {
+        // descend into the largest node
+        collideNodes (t1,a.child1,t2,n2,visitor);
+        collideNodes (t1,a.child2,t2,n2,visitor);
+    }
+    else {
+        collideNodes (t1,n1,t2,b.child1,visitor);
+        collideNodes (t1,n1,t2,b.child2,visitor);
+    }
+}
+
+template <class Visitor>
+static void collideSelf (const dxBVHTree &tree, int node, Visitor &visitor)
+{
+    const dxBVHNode &n = tree.nodes[node];
+    if (n.isLeaf())
+        return;
+    collideSelf (tree,n.child1,visitor);
+    collideSelf (tree,n.child2,visitor);
+    collideNodes (tree,n.child1,tree,n.child2,visitor);
+}
+
+template <class Visitor>
+static void queryAABB (const dxBVHTree &tree, int node, const dReal *aabb, Visitor &visitor)
+{
+    const dxBVHNode &n = tree.nodes[node];
+    if (!aabbOverlap (n.aabb,aabb))
+        return;
+    if (n.isLeaf()) {
+        visitor (n.geom);
+        return;
+    }
+    queryAABB (tree,n.child1,aabb,visitor);
+    queryAABB (tree,n.child2,aabb,visitor);
+}
+
+template <class Visitor>
+static void queryRay (const dxBVHTree &tree, int node, const dVector3 origin, const dVector3 dir, dReal length,
+                      Visitor &visitor)
+{
+    const dxBVHNode &n = tree.nodes[node];
+    if (!rayHitsAABB (n.aabb,origin,dir,length))
+        return;
+    if (n.isLeaf()) {
+        visitor (n.geom);
+        return;
+    }
+    queryRay (tree,n.child1,origin,dir,length,visitor);
+    queryRay (tree,n.child2,origin,dir,length,visitor);
+}
+
+struct dxBVHCollider {
+    void *data;
+    dNearCallback *callback;
+    dxGeom *geom;   // geom of collide2()
+
+    void operator() (dxGeom *g1, dxGeom *g2) {
+        if (GEOM_ENABLED(g1) && GEOM_ENABLED(g2))
+            collideAABBs (g1,g2,data,callback);
+    }
+    void operator() (dxGeom *g) {
+        if (GEOM_ENABLED(g))
+            collideAABBs (g,geom,data,callback);
+    }
+};
+
+struct dxBVHPairCollector {
+    dArray<dxGeom*> *pairs;
+
+    void operator() (dxGeom *g1, dxGeom *g2) {
+        pairs->push (g1);
+        pairs->push (g2);
+    }
+};
+
+//****************************************************************************
+// BVH space
+
+struct dxBVHSpace : public dxSpace {
+    dxBVHSpace (dSpaceID _space);
+    ~dxBVHSpace();
+
+    virtual void add (dxGeom *g);
+    virtual void remove (dxGeom *g);
+    virtual void cleanGeoms();
+    virtual void collide (void *data, dNearCallback *callback);
+    virtual void collide2 (void *data, dxGeom *geom, dNearCallback *callback);
+
+private:
+    void update (dxGeom *g);
+    void insertGeom (dxGeom *g, int list);
+    void removeGeom (dxGeom *g);
+
+    dxBVHTree dynamicTree;
+    dxBVHTree staticTree;
+    dArray<dxGeom*> infiniteGeoms;
+
+    // overlapping static geoms, two by two, valid until the static tree changes
+    dArray<dxGeom*> staticPairs;
+    bool staticPairsValid;
+};
+
+dxBVHSpace::dxBVHSpace (dSpaceID _space) : dxSpace (_space)
+{
+    type = dBVHSpaceClass;
+    staticPairsValid = false;
+}
+
+dxBVHSpace::~dxBVHSpace()
+{
+    // the trees are gone by the time ~dxSpace() removes the geoms
+    CHECK_NOT_LOCKED (this);
+    if (cleanup) {
+        // note that destroying each geom will call remove()
+        while (first) dGeomDestroy (first);
+    }
+    else {
+        while (first) remove (first);
+    }
+}
+
+void dxBVHSpace::add (dxGeom *g)
+{
+    CHECK_NOT_LOCKED (this);
+    dAASSERT (g);
+
+    // the geom is inserted in a tree when the space is cleaned
+    GEOM_SET_BVH (g,BVH_NO_LIST,0);
+    dxSpace::add (g);
+}
+
+void dxBVHSpace::remove (dxGeom *g)
+{
+    CHECK_NOT_LOCKED (this);
+    dAASSERT (g);
+    dUASSERT (g->parent_space == this,"object is not in this space");
+
+    removeGeom (g);
+    dxSpace::remove (g);
+}
+
+static inline int bvhListOf (const dxGeom *g)
+{
+    if (aabbIsInfinite (g->aabb))
+        return BVH_INFINITE_LIST;
+    if (g->body || g->is_dynamic || IS_SPACE(g))
+        return BVH_DYNAMIC_TREE;
+    return BVH_STATIC_TREE;
+}
+
+void dxBVHSpace::insertGeom (dxGeom *g, int list)
+{
+    if (list == BVH_INFINITE_LIST) {
+        GEOM_SET_BVH (g,list,infiniteGeoms.size());
+        infiniteGeoms.push (g);
+    }
+    else if (list == BVH_DYNAMIC_TREE) {
+        dReal aabb[6];
+        for (int i = 0; i < 6; i += 2) {
+            const dReal margin = BVH_MARGIN_RATIO * (g->aabb[i+1] - g->aabb[i]) + BVH_MARGIN;
+            aabb[i] = g->aabb[i] - margin;
+            aabb[i+1] = g->aabb[i+1] + margin;
+        }
+        GEOM_SET_BVH (g,list,dynamicTree.insert (g,aabb));
+    }
+    else {
+        GEOM_SET_BVH (g,list,staticTree.insert (g,g->aabb));
+        staticPairsValid = false;
+    }
+}
+
+void dxBVHSpace::removeGeom (dxGeom *g)
+{
+    const int list = GEOM_GET_BVH_LIST(g);
+    const int index = GEOM_GET_BVH_INDEX(g);
+    if (list == BVH_INFINITE_LIST) {
+        const int last = infiniteGeoms.size() - 1;
+        dxGeom *lastg = infiniteGeoms[last];
+        infiniteGeoms[index] = lastg;
+        GEOM_SET_BVH (lastg,BVH_INFINITE_LIST,index);
+        infiniteGeoms.setSize (last);
+    }
+    else if (list == BVH_DYNAMIC_TREE) {
+        dynamicTree.remove (index);
+    }
+    else if (list == BVH_STATIC_TREE) {
+        staticTree.remove (index);
+        staticPairsValid = false;
+    }
+    GEOM_SET_BVH (g,BVH_NO_LIST,0);
+}
+
+// move the geom to the right list, or to the right leaf if it left the AABB of its leaf
+void dxBVHSpace::update (dxGeom *g)
+{
+    const int list = bvhListOf (g);
+    const int current = GEOM_GET_BVH_LIST(g);
+    if (list == current) {
+        if (list == BVH_INFINITE_LIST)
+            return;
+        const dxBVHTree &tree = list == BVH_DYNAMIC_TREE ? dynamicTree : staticTree;
+        if (aabbContains (tree.nodes[GEOM_GET_BVH_INDEX(g)].aabb,g->aabb))
+            return;
+    }
+    removeGeom (g);
+    insertGeom (g,list);
+}
+
+void dxBVHSpace::cleanGeoms()
+{
+    // compute the AABBs of all dirty geoms, update their leaves and clear
+    // the dirty flags
+    lock_count++;
+    for (dxGeom *g=first; g && (g->gflags & GEOM_DIRTY); g=g->next) {
+        if (IS_SPACE(g)) {
+            ((dxSpace*)g)->cleanGeoms();
+        }
+        g->recomputeAABB();
+        g->gflags &= (~(GEOM_DIRTY|GEOM_AABB_BAD));
+        update (g);
+    }
+    lock_count--;
+}
+
+void dxBVHSpace::collide (void *data, dNearCallback *callback)
+{
+    dAASSERT (callback);
+
+    lock_count++;
+    cleanGeoms();
+
+    dxBVHCollider collider = { data, callback, 0 };
+
+    if (dynamicTree.root != BVH_NULL_NODE) {
+        collideSelf (dynamicTree,dynamicTree.root,collider);
+        if (staticTree.root != BVH_NULL_NODE)
+            collideNodes (dynamicTree,dynamicTree.root,staticTree,staticTree.root,collider);
+    }
+
+    if (!staticPairsValid) {
+        staticPairs.setSize (0);
+        if (staticTree.root != BVH_NULL_NODE) {
+            dxBVHPairCollector collector = { &staticPairs };
+            collideSelf (staticTree,staticTree.root,collector);
+        }
+        staticPairsValid = true;
+    }
+    const int staticPairCount = staticPairs.size();
+    for (int i = 0; i < staticPairCount; i += 2)
+        collider (staticPairs[i],staticPairs[i+1]);
+
+    // collide the infinite geoms together and with all the other geoms
+    const int infiniteCount = infiniteGeoms.size();
+    for (int i = 0; i < infiniteCount; ++i) {
+        dxGeom *g1 = infiniteGeoms[i];
+        if (!GEOM_ENABLED(g1))
+            continue;
+        for (dxGeom *g2=first; g2; g2=g2->next) {
+            if (GEOM_GET_BVH_LIST(g2) == BVH_INFINITE_LIST && GEOM_GET_BVH_INDEX(g2) <= i)
+                continue;
+            if (GEOM_ENABLED(g2))
+                collideAABBs (g1,g2,data,callback);
+        }
+    }
+
+    lock_count--;
+}
+
+void dxBVHSpace::collide2 (void *data, dxGeom *geom, dNearCallback *callback)
+{
+    dAASSERT (geom && callback);
+
+    lock_count++;
+    cleanGeoms();
+    geom->recomputeAABB();
+
+    dxBVHCollider collider = { data, callback, geom };
+
+    if (aabbIsInfinite (geom->aabb)) {
+        // the trees cannot prune anything
+        for (dxGeom *g=first; g; g=g->next)
+            collider (g);
+    }
+    else {
+        if (geom->type == dRayClass) {
+            // the AABB of a long diagonal ray overlaps much more leaves than the ray itself
+            dVector3 origin, dir;
+            dGeomRayGet (geom,origin,dir);
+            const dReal length = dGeomRayGetLength (geom);
+            if (dynamicTree.root != BVH_NULL_NODE)
+                queryRay (dynamicTree,dynamicTree.root,origin,dir,length,collider);
+            if (staticTree.root != BVH_NULL_NODE)
+                queryRay (staticTree,staticTree.root,origin,dir,length,collider);
+        }
+        else {
+            if (dynamicTree.root != BVH_NULL_NODE)
+                queryAABB (dynamicTree,dynamicTree.root,geom->aabb,collider);
+            if (staticTree.root != BVH_NULL_NODE)
+                queryAABB (staticTree,staticTree.root,geom->aabb,collider);
+        }
+        const int infiniteCount = infiniteGeoms.size();
+        for (int i = 0; i < infiniteCount; ++i)
+            collider (infiniteGeoms[i]);
+    }
+
+    lock_count--;
+}
+
+//****************************************************************************
+// space functions
+
+dxSpace *dBVHSpaceCreate_ST (dxSpace *space)
+{
+    return new dxBVHSpace (space);
+}
+
+dxSpace *dBVHSpaceCreate (dxSpace *space)
+{
+#ifdef ODE_MT
+    return dSpaceCreate_MT(space, &dBVHSpaceCreate_ST);
+#else
+    return dBVHSpaceCreate_ST(space);
+#endif
+}
@@ -1042,12 +1042,6 @@ int dCollideCylinderTrimesh(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *con
     dIASSERT( o2->type == dTriMeshClass );
     dIASSERT ((flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     int nContactCount = 0;
 
     dxGeom *Cylinder = o1;
@@ -1060,9 +1054,9 @@ int dCollideCylinderTrimesh(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *con
     const unsigned uiTLSKind = Trimesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == Cylinder->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    OBBCollider& Collider = pccColliderCache->_OBBCollider[tid];
+    OBBCollider& Collider = pccColliderCache->_OBBCollider;
 
-    dQueryCTLPotentialCollisionTriangles(Collider, cData, Cylinder, Trimesh, pccColliderCache->defaultBoxCache[tid]);
+    dQueryCTLPotentialCollisionTriangles(Collider, cData, Cylinder, Trimesh, pccColliderCache->defaultBoxCache);
 
 	// Retrieve data
 	int TriCount = Collider.GetNbTouchedPrimitives();
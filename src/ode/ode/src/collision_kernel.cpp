@@ -41,6 +41,8 @@ for geometry objects
 #include "collision_space_internal.h"
 #include "odeou.h"
 #include "ode_MT/ode_MT.h"
+#include <atomic>
+#include <chrono>
 
 #ifdef dLIBCCD_ENABLED
 # include "collision_libccd.h"
@@ -278,6 +280,60 @@ void dSetColliderOverride (int i, int j, dColliderFn *fn)
     colliders[j][i].reverse = 1;
 }
 
+//****************************************************************************
+// collider profiling
+
+struct dxCollideProfile {
+    std::atomic<unsigned long> callCount;
+    std::atomic<unsigned long> contactCount;
+    std::atomic<long long> nanoseconds;
+};
+
+// only the [i][j] entries with i <= j are used, dCollide() may be called concurrently by several threads
+static dxCollideProfile collideProfiles[dGeomNumClasses][dGeomNumClasses];
+static std::atomic<bool> collideProfiling(false);
+
+static void recordCollideProfile (int class1, int class2, int count, const std::chrono::steady_clock::time_point &start)
+{
+    const long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    dxCollideProfile &profile = class1 <= class2 ? collideProfiles[class1][class2] : collideProfiles[class2][class1];
+    profile.callCount.fetch_add(1, std::memory_order_relaxed);
+    profile.contactCount.fetch_add(count, std::memory_order_relaxed);
+    profile.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void dCollideEnableProfiling (int enable)
+{
+    collideProfiling.store(enable != 0);
+}
+
+int dCollideIsProfilingEnabled ()
+{
+    return collideProfiling.load() ? 1 : 0;
+}
+
+void dCollideGetProfile (int class1, int class2, dCollideProfile *profile)
+{
+    dAASSERT(class1 >= 0 && class1 < dGeomNumClasses);
+    dAASSERT(class2 >= 0 && class2 < dGeomNumClasses);
+    dAASSERT(profile);
+    const dxCollideProfile &p = class1 <= class2 ? collideProfiles[class1][class2] : collideProfiles[class2][class1];
+    profile->callCount = p.callCount.load();
+    profile->contactCount = p.contactCount.load();
+    profile->time = 1e-9 * p.nanoseconds.load();
+}
+
+void dCollideResetProfiles ()
+{
+    for (int i = 0; i < dGeomNumClasses; ++i) {
+        for (int j = i; j < dGeomNumClasses; ++j) {
+            collideProfiles[i][j].callCount.store(0);
+            collideProfiles[i][j].contactCount.store(0);
+            collideProfiles[i][j].nanoseconds.store(0);
+        }
+    }
+}
+
 /*
 *	NOTE!
 *	If it is necessary to add special processing mode without contact generation
@@ -309,6 +365,10 @@ int dCollide (dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int skip
     dColliderEntry *ce = &colliders[o1->type][o2->type];
     int count = 0;
     if (ce->fn) {
+        const bool profiling = collideProfiling.load(std::memory_order_relaxed);
+        std::chrono::steady_clock::time_point start;
+        if (profiling)
+            start = std::chrono::steady_clock::now();
         if (ce->reverse) {
             count = (*ce->fn) (o2,o1,flags,contact,skip);
             for (int i=0; i<count; i++) {
@@ -327,6 +387,8 @@ int dCollide (dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int skip
         else {
             count = (*ce->fn) (o1,o2,flags,contact,skip);
         }
+        if (profiling)
+            recordCollideProfile (o1->type, o2->type, count, start);
     }
     return count;
 }
@@ -800,6 +862,21 @@ int dGeomIsEnabled (dxGeom *g)
     return (g->gflags & GEOM_ENABLED) != 0;
 }
 
+void dGeomSetSleepCulling (dxGeom *g, int enabled)
+{
+    dAASSERT (g);
+    if (enabled)
+        g->gflags |= GEOM_SLEEP_CULLING;
+    else
+        g->gflags &= ~GEOM_SLEEP_CULLING;
+}
+
+int dGeomGetSleepCulling (dxGeom *g)
+{
+    dAASSERT (g);
+    return (g->gflags & GEOM_SLEEP_CULLING) != 0;
+}
+
 void dGeomGetRelPointPos (dGeomID g, dReal px, dReal py, dReal pz, dVector3 result)
 {
     dAASSERT (g);
@@ -71,6 +71,7 @@ enum {
     GEOM_PLACEABLE = 8,   // geom is placeable
     GEOM_ENABLED = 16,    // geom is enabled
     GEOM_ZERO_SIZED = 32, // geom is zero sized
+    GEOM_SLEEP_CULLING = 64, // geom is not collided with the other sleeping geoms
 
     GEOM_ENABLE_TEST_MASK = GEOM_ENABLED | GEOM_ZERO_SIZED,
     GEOM_ENABLE_TEST_VALUE = GEOM_ENABLED,
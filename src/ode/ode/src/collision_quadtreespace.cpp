@@ -31,6 +31,7 @@
 #include "collision_kernel.h"
 
 #include "collision_space_internal.h"
+#include "ode_MT/ode_MT.h"
 
 #define AXIS0 0
 #define AXIS1 1
@@ -594,5 +595,8 @@ void dxQuadTreeSpace::collide2(void* UserData, dxGeom* g2, dNearCallback* Callba
 }
 
 dSpaceID dQuadTreeSpaceCreate(dxSpace* space, const dVector3 Center, const dVector3 Extents, int Depth){
+#ifdef ODE_MT
+    dRecombineClusters_MT();
+#endif
     return new dxQuadTreeSpace(space, Center, Extents, Depth);
 }
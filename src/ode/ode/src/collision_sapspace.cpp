@@ -41,6 +41,7 @@
 #include "matrix.h"
 #include "collision_kernel.h"
 #include "collision_space_internal.h"
+#include "ode_MT/ode_MT.h"
 
 // Reference counting helper for radix sort global data.
 //static void RadixSortRef();
@@ -209,6 +210,9 @@ private:
 
 // Creation
 dSpaceID dSweepAndPruneSpaceCreate( dxSpace* space, int axisorder ) {
+#ifdef ODE_MT
+    dRecombineClusters_MT();
+#endif
     return new dxSAPSpace( space, axisorder );
 }
 
@@ -241,6 +245,9 @@ static void collideGeomsNoAABBs( dxGeom *g1, dxGeom *g2, void *data, dNearCallba
             return;
     }
 
+    // no contacts between two resting geoms
+    if (geomIsSleeping(g1) && geomIsSleeping(g2)) return;
+
     dReal *bounds1 = g1->aabb;
     dReal *bounds2 = g2->aabb;
 
@@ -341,6 +348,10 @@ void dxSAPSpace::remove( dxGeom* g )
         GeomList.setSize( geomSize-1 );
     }
 
+    // safeguard, so that the geom can be added to a sweep and prune space again
+    g->next_ex = 0;
+    g->tome_ex = 0;
+
     dxSpace::remove(g);
 }
 
@@ -251,12 +251,47 @@ void dxSimpleSpace::collide (void *data, dNearCallback *callback)
     lock_count++;
     cleanGeoms();
 
-    // intersect all bounding boxes
-    for (dxGeom *g1=first; g1; g1=g1->next) {
-        if (GEOM_ENABLED(g1)){
-            for (dxGeom *g2=g1->next; g2; g2=g2->next) {
-                if (GEOM_ENABLED(g2)){
-                    collideAABBs (g1,g2,data,callback);
+    // the sleeping geoms are only intersected with the awake geoms listed
+    // after them, the pairs are reported in the same order as without culling
+    int sleeping = 0;
+    for (dxGeom *g=first; g; g=g->next) {
+        if (GEOM_ENABLED(g) && geomIsSleeping(g)) sleeping++;
+    }
+
+    if (sleeping == 0) {
+        // intersect all bounding boxes
+        for (dxGeom *g1=first; g1; g1=g1->next) {
+            if (GEOM_ENABLED(g1)){
+                for (dxGeom *g2=g1->next; g2; g2=g2->next) {
+                    if (GEOM_ENABLED(g2)){
+                        collideAABBs (g1,g2,data,callback);
+                    }
+                }
+            }
+        }
+    }
+    else {
+        const int awakeCount = count - sleeping;
+        dxGeom **awake = (dxGeom **) ALLOCA ((awakeCount + 1) * sizeof(dxGeom*));
+        int n = 0;
+        for (dxGeom *g=first; g; g=g->next) {
+            if (GEOM_ENABLED(g) && !geomIsSleeping(g)) awake[n++] = g;
+        }
+
+        int awakeBefore = 0;
+        for (dxGeom *g1=first; g1; g1=g1->next) {
+            if (!GEOM_ENABLED(g1)) continue;
+            if (geomIsSleeping(g1)) {
+                for (int i = awakeBefore; i < n; i++) {
+                    collideAABBs (g1,awake[i],data,callback);
+                }
+            }
+            else {
+                awakeBefore++;
+                for (dxGeom *g2=g1->next; g2; g2=g2->next) {
+                    if (GEOM_ENABLED(g2)){
+                        collideAABBs (g1,g2,data,callback);
+                    }
                 }
             }
         }
@@ -623,7 +658,7 @@ dxSpace *dHashSpaceCreate_ST (dxSpace *space)
     return new dxHashSpace (space);
 }
 
-dxSpace *dHashSpaceCreate_MT (dxSpace *space)
+dxSpace *dHashSpaceCreate (dxSpace *space)
 {
 #ifdef ODE_MT
     return dSpaceCreate_MT(space, &dHashSpaceCreate_ST);
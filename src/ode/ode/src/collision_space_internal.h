@@ -35,6 +35,15 @@ stuff common to all spaces
     dUASSERT ((space)==0 || (space)->lock_count==0, \
     "invalid operation for locked space");
 
+// a geom is sleeping if it is static or attached to a disabled body. the pairs
+// of sleeping geoms with sleep culling enabled are not collided, see
+// dGeomSetSleepCulling().
+
+static inline bool geomIsSleeping (const dxGeom *g)
+{
+    return (g->gflags & GEOM_SLEEP_CULLING) && (!g->body || (g->body->flags & dxBodyDisabled));
+}
+
 // collide two geoms together. for the hash table space, this is
 // called if the two AABBs inhabit the same hash table cells.
 // this only calls the callback function if the AABBs actually
@@ -59,6 +68,9 @@ static inline void collideAABBs (dxGeom *g1, dxGeom *g2,
             return;
     }
 
+    // no contacts between two resting geoms
+    if (geomIsSleeping(g1) && geomIsSleeping(g2)) return;
+
     // if the bounding boxes are disjoint then don't do anything
     dReal *bounds1 = g1->aabb;
     dReal *bounds2 = g2->aabb;
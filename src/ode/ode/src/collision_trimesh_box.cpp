@@ -1175,12 +1175,6 @@ int dCollideBTL(dxGeom* g1, dxGeom* BoxGeom, int Flags, dContactGeom* Contacts,
     dIASSERT (BoxGeom->type == dBoxClass);
     dIASSERT ((Flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-    int tid = dThreadManager()->currentThreadId();
-#else
-    int tid = 0;
-#endif
-
     dxTriMesh* TriMesh = (dxTriMesh*)g1;
 
     sTrimeshBoxColliderData cData;
@@ -1189,10 +1183,10 @@ int dCollideBTL(dxGeom* g1, dxGeom* BoxGeom, int Flags, dContactGeom* Contacts,
     const unsigned uiTLSKind = TriMesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == BoxGeom->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    OBBCollider& Collider = pccColliderCache->_OBBCollider[tid];
+    OBBCollider& Collider = pccColliderCache->_OBBCollider;
 
     dQueryBTLPotentialCollisionTriangles(Collider, cData, TriMesh, BoxGeom,
-        pccColliderCache->defaultBoxCache[tid]);
+        pccColliderCache->defaultBoxCache);
 
     if (!Collider.GetContactStatus()) {
         // no collision occurred
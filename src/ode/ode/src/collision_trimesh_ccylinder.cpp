@@ -1031,12 +1031,6 @@ int dCollideCCTL(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int s
     dIASSERT (o2->type == dCapsuleClass);
     dIASSERT ((flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     int nContactCount = 0;
 
     dxTriMesh *TriMesh = (dxTriMesh*)o1;
@@ -1048,11 +1042,11 @@ int dCollideCCTL(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int s
     const unsigned uiTLSKind = TriMesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == Capsule->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    OBBCollider& Collider = pccColliderCache->_OBBCollider[tid];
+    OBBCollider& Collider = pccColliderCache->_OBBCollider;
 
     // Will it better to use LSS here? -> confirm Pierre.
     dQueryCCTLPotentialCollisionTriangles(Collider, cData,
-        TriMesh, Capsule, pccColliderCache->defaultBoxCache[tid]);
+        TriMesh, Capsule, pccColliderCache->defaultBoxCache);
 
     if (Collider.GetContactStatus())
     {
@@ -98,6 +98,13 @@ void dGeomTriMeshDataBuildDouble1(dTriMeshDataID g,
     const void* Indices, int IndexCount, int TriStride,
     const void* Normals) { }
 
+int dGeomTriMeshDataBuildDoubleWithTree(dTriMeshDataID g,
+    const void* Vertices,  int VertexStride, int VertexCount,
+    const void* Indices, int IndexCount, int TriStride,
+    const void* Tree, size_t TreeSize) { return 0; }
+
+size_t dGeomTriMeshDataGetTree(dTriMeshDataID g, void* Buffer) { return 0; }
+
 void dGeomTriMeshDataBuildSimple(dTriMeshDataID g,
     const dReal* Vertices, int VertexCount,
     const dTriIndex* Indices, int IndexCount) { }
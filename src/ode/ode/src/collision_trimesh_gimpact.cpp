@@ -103,6 +103,23 @@ void dGeomTriMeshDataBuildDouble(dTriMeshDataID g,
         Indices, IndexCount, TriStride, NULL);
 }
 
+int dGeomTriMeshDataBuildDoubleWithTree(dTriMeshDataID g,
+                                        const void* Vertices, int VertexStride, int VertexCount,
+                                        const void* Indices, int IndexCount, int TriStride,
+                                        const void* Tree, size_t TreeSize)
+{
+    // GIMPACT doesn't build a tree, the saved tree is empty
+    dGeomTriMeshDataBuildDouble1(g, Vertices, VertexStride, VertexCount,
+        Indices, IndexCount, TriStride, NULL);
+    return 1;
+}
+
+size_t dGeomTriMeshDataGetTree(dTriMeshDataID g, void* Buffer)
+{
+    dUASSERT(g, "argument not trimesh data");
+    return 0;
+}
+
 void dGeomTriMeshDataBuildSimple1(dTriMeshDataID g,
                                   const dReal* Vertices, int VertexCount,
                                   const dTriIndex* Indices, int IndexCount,
@@ -40,13 +40,6 @@
 #include "Opcode.h"
 using namespace Opcode;
 
-#ifdef ODE_MT
-#include "ode_MT/ode_MT.h"
-#define COLLIDER_SIZE MAX_THREADS
-#else
-#define COLLIDER_SIZE 1
-#endif
-
 #endif // dTRIMESH_OPCODE
 
 #if dTRIMESH_GIMPACT
@@ -150,31 +143,31 @@ struct TrimeshCollidersCache
     void InitOPCODECaches();
 
     // Collider caches
-    BVTCache ColCache[COLLIDER_SIZE];
+    BVTCache ColCache;
 
 #if !dTRIMESH_OPCODE_USE_OLD_TRIMESH_TRIMESH_COLLIDER
-    CONTACT_KEY_HASH_TABLE _hashcontactset[COLLIDER_SIZE];
+    CONTACT_KEY_HASH_TABLE _hashcontactset;
 #endif
 
     // Colliders
     /* -- not used -- also uncomment in InitOPCODECaches()
     PlanesCollider _PlanesCollider; -- not used
     */
-    SphereCollider _SphereCollider[COLLIDER_SIZE];
-    OBBCollider _OBBCollider[COLLIDER_SIZE];
-    RayCollider _RayCollider[COLLIDER_SIZE];
-    AABBTreeCollider _AABBTreeCollider[COLLIDER_SIZE];
+    SphereCollider _SphereCollider;
+    OBBCollider _OBBCollider;
+    RayCollider _RayCollider;
+    AABBTreeCollider _AABBTreeCollider;
     /* -- not used -- also uncomment in InitOPCODECaches()
     LSSCollider _LSSCollider;
     */
     // Trimesh caches
-    CollisionFaces Faces[COLLIDER_SIZE];
-    SphereCache defaultSphereCache[COLLIDER_SIZE];
-    OBBCache defaultBoxCache[COLLIDER_SIZE];
-    LSSCache defaultCapsuleCache[COLLIDER_SIZE];
+    CollisionFaces Faces;
+    SphereCache defaultSphereCache;
+    OBBCache defaultBoxCache;
+    LSSCache defaultCapsuleCache;
 
     // Trimesh-plane collision vertex use cache
-    VertexUseCache VertexUses[COLLIDER_SIZE];
+    VertexUseCache VertexUses;
 
 #endif // dTRIMESH_OPCODE
 };
@@ -193,9 +186,16 @@ inline TrimeshCollidersCache *GetTrimeshCollidersCache(unsigned uiTLSKind)
 {
     (void)uiTLSKind; // unused
 
+#ifdef ODE_MT
+    // the collisions are detected by the threads of the worker pool, each of them needs its own colliders
+    static thread_local TrimeshCollidersCache ccTrimeshCollidersCache;
+
+    return &ccTrimeshCollidersCache;
+#else
     extern TrimeshCollidersCache g_ccTrimeshCollidersCache;
 
     return &g_ccTrimeshCollidersCache;
+#endif
 }
 
 #endif // dTLS_ENABLED
@@ -227,10 +227,14 @@ struct dxTriMeshData  : public dBase
     dxTriMeshData();
     ~dxTriMeshData();
 
-    void Build(const void* Vertices, int VertexStide, int VertexCount,
+    /* Returns false if 'Tree' is set but can't be loaded, in which case the tree is built */
+    bool Build(const void* Vertices, int VertexStide, int VertexCount,
         const void* Indices, int IndexCount, int TriStride,
         const void* Normals,
-        bool Single);
+        bool Single,
+        const void* Tree = NULL, size_t TreeSize = 0);
+    /* Saves the tree to 'Buffer' and returns its size, only returns the size if 'Buffer' is NULL */
+    size_t SaveTree(void* Buffer) const;
 
     /* aabb in model space */
     dVector3 AABBCenter;
@@ -41,26 +41,24 @@ void TrimeshCollidersCache::InitOPCODECaches()
     _PlanesCollider.SetTemporalCoherence(true);
     */
 
-	for (int i=0; i<COLLIDER_SIZE; i++) {
-		_RayCollider[i].SetDestination(&Faces[i]);
-
-		_SphereCollider[i].SetTemporalCoherence(true);
-		_SphereCollider[i].SetPrimitiveTests(false);
-
-		_OBBCollider[i].SetTemporalCoherence(true);
-
-		// no first-contact test (i.e. return full contact info)
-		_AABBTreeCollider[i].SetFirstContact( false );
-		// temporal coherence only works with "first contact" tests
-		_AABBTreeCollider[i].SetTemporalCoherence(false);
-        // Perform full BV-BV tests (true) or SAT-lite tests (false)
-		_AABBTreeCollider[i].SetFullBoxBoxTest( true );
-		// Perform full Primitive-BV tests (true) or SAT-lite tests (false)
-		_AABBTreeCollider[i].SetFullPrimBoxTest( true );
-		const char* msg;
-		if ((msg =_AABBTreeCollider[i].ValidateSettings()))
-			dDebug (d_ERR_UASSERT, msg, " (%s:%d)", __FILE__,__LINE__);
-  }
+    _RayCollider.SetDestination(&Faces);
+
+    _SphereCollider.SetTemporalCoherence(true);
+    _SphereCollider.SetPrimitiveTests(false);
+
+    _OBBCollider.SetTemporalCoherence(true);
+
+    // no first-contact test (i.e. return full contact info)
+    _AABBTreeCollider.SetFirstContact( false );
+    // temporal coherence only works with "first contact" tests
+    _AABBTreeCollider.SetTemporalCoherence(false);
+    // Perform full BV-BV tests (true) or SAT-lite tests (false)
+    _AABBTreeCollider.SetFullBoxBoxTest( true );
+    // Perform full Primitive-BV tests (true) or SAT-lite tests (false)
+    _AABBTreeCollider.SetFullPrimBoxTest( true );
+    const char* msg;
+    if ((msg =_AABBTreeCollider.ValidateSettings()))
+        dDebug (d_ERR_UASSERT, msg, " (%s:%d)", __FILE__,__LINE__);
 
     /* -- not used
     _LSSCollider.SetTemporalCoherence(false);
@@ -83,12 +81,29 @@ dxTriMeshData::~dxTriMeshData()
         delete [] UseFlags;
 }
 
-void
+// Header of the buffers written by dxTriMeshData::SaveTree(), followed by the tree nodes.
+// The version has to be increased whenever the tree building settings below change.
+struct dxTriMeshTreeHeader
+{
+    uint32 Magic;
+    uint32 Version;
+    uint32 NodeSize;
+    uint32 TriangleCount;
+    uint32 NodeCount;
+    uint32 Reserved;
+};
+
+#define TRIMESH_TREE_MAGIC 0x45455254 // "TREE"
+#define TRIMESH_TREE_VERSION 1
+
+bool
 dxTriMeshData::Build(const void* Vertices, int VertexStide, int VertexCount,
                      const void* Indices, int IndexCount, int TriStride,
                      const void* in_Normals,
-                     bool Single)
+                     bool Single,
+                     const void* Tree, size_t TreeSize)
 {
+    bool TreeLoaded = false;
 #if dTRIMESH_ENABLED
 
     Mesh.SetNbTriangles(IndexCount / 3);
@@ -117,7 +132,18 @@ dxTriMeshData::Build(const void* Vertices, int VertexStide, int VertexCount,
     TreeBuilder.mKeepOriginal = false;
     TreeBuilder.mCanRemap = false;
 
-    BVTree.Build(TreeBuilder);
+    if (Tree) {
+        dxTriMeshTreeHeader Header;
+        if (TreeSize >= sizeof(Header)) {
+            memcpy(&Header, Tree, sizeof(Header));
+            if (Header.Magic == TRIMESH_TREE_MAGIC && Header.Version == TRIMESH_TREE_VERSION &&
+                Header.NodeSize == sizeof(AABBNoLeafNode) && Header.TriangleCount == (uint32)(IndexCount / 3) &&
+                TreeSize == sizeof(Header) + (size_t)Header.NodeCount * sizeof(AABBNoLeafNode))
+                TreeLoaded = BVTree.Load(TreeBuilder, (const char*)Tree + sizeof(Header), Header.NodeCount);
+        }
+    }
+    if (!TreeLoaded)
+        BVTree.Build(TreeBuilder);
 
     // compute model space AABB
     dVector3 AABBMax, AABBMin;
@@ -161,6 +187,29 @@ dxTriMeshData::Build(const void* Vertices, int VertexStide, int VertexCount,
     UseFlags = 0;
 
 #endif // dTRIMESH_ENABLED
+    return TreeLoaded || !Tree;
+}
+
+size_t
+dxTriMeshData::SaveTree(void* Buffer) const
+{
+    const AABBNoLeafTree* Tree = static_cast<const AABBNoLeafTree*>(BVTree.GetTree());
+    const uint32 NodeCount = Tree ? Tree->GetNbNodes() : 0;
+    const size_t Size = sizeof(dxTriMeshTreeHeader) + (size_t)NodeCount * sizeof(AABBNoLeafNode);
+    if (!Buffer)
+        return Size;
+
+    dxTriMeshTreeHeader Header;
+    Header.Magic = TRIMESH_TREE_MAGIC;
+    Header.Version = TRIMESH_TREE_VERSION;
+    Header.NodeSize = sizeof(AABBNoLeafNode);
+    Header.TriangleCount = Mesh.GetNbTriangles();
+    Header.NodeCount = NodeCount;
+    Header.Reserved = 0;
+    memcpy(Buffer, &Header, sizeof(Header));
+    if (Tree)
+        Tree->Save((char*)Buffer + sizeof(Header));
+    return Size;
 }
 
 struct EdgeRecord
@@ -466,6 +515,27 @@ void dGeomTriMeshDataBuildDouble(dTriMeshDataID g,
         Indices, IndexCount, TriStride, NULL);
 }
 
+int dGeomTriMeshDataBuildDoubleWithTree(dTriMeshDataID g,
+                                        const void* Vertices, int VertexStride, int VertexCount,
+                                        const void* Indices, int IndexCount, int TriStride,
+                                        const void* Tree, size_t TreeSize)
+{
+    dUASSERT(g, "argument not trimesh data");
+    dUASSERT(Tree, "argument not tree data");
+
+    return g->Build(Vertices, VertexStride, VertexCount,
+        Indices, IndexCount, TriStride,
+        NULL,
+        false,
+        Tree, TreeSize) ? 1 : 0;
+}
+
+size_t dGeomTriMeshDataGetTree(dTriMeshDataID g, void* Buffer)
+{
+    dUASSERT(g, "argument not trimesh data");
+    return g->SaveTree(Buffer);
+}
+
 void dGeomTriMeshDataBuildSimple1(dTriMeshDataID g,
                                   const dReal* Vertices, int VertexCount,
                                   const dTriIndex* Indices, int IndexCount,
@@ -553,12 +623,10 @@ dxTriMesh::~dxTriMesh(){
 
     // Clear TC caches
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(0);
-	for (int i=0; i<COLLIDER_SIZE; i++) {
-        pccColliderCache->Faces[i].Empty();
-        pccColliderCache->defaultSphereCache[i].TouchedPrimitives.Empty();
-        pccColliderCache->defaultBoxCache[i].TouchedPrimitives.Empty();
-        pccColliderCache->defaultCapsuleCache[i].TouchedPrimitives.Empty();
-    }
+    pccColliderCache->Faces.Empty();
+    pccColliderCache->defaultSphereCache.TouchedPrimitives.Empty();
+    pccColliderCache->defaultBoxCache.TouchedPrimitives.Empty();
+    pccColliderCache->defaultCapsuleCache.TouchedPrimitives.Empty();
 
 #endif // dTRIMESH_ENABLED
 #endif // dTLS_ENABLED
@@ -42,12 +42,6 @@ int dCollideTrimeshPlane( dxGeom *o1, dxGeom *o2, int flags, dContactGeom* conta
     dIASSERT( o2->type == dPlaneClass );
     dIASSERT ((flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     // Alias pointers to the plane and trimesh
     dxTriMesh* trimesh = (dxTriMesh*)( o1 );
     dxPlane* plane = (dxPlane*)( o2 );
@@ -78,7 +72,7 @@ int dCollideTrimeshPlane( dxGeom *o1, dxGeom *o2, int flags, dContactGeom* conta
     const unsigned uiTLSKind = trimesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == plane->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    VertexUseCache &vertex_use_cache = pccColliderCache->VertexUses[tid];
+    VertexUseCache &vertex_use_cache = pccColliderCache->VertexUses;
 
     // Reallocate vertex use cache if necessary
     const int vertex_count = trimesh->Data->Mesh.GetNbVertices();
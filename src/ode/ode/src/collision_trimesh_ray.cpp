@@ -40,12 +40,6 @@ int dCollideRTL(dxGeom* g1, dxGeom* RayGeom, int Flags, dContactGeom* Contacts,
     dIASSERT (RayGeom->type == dRayClass);
     dIASSERT ((Flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     dxTriMesh* TriMesh = (dxTriMesh*)g1;
 
     const dVector3& TLPosition = *(const dVector3*)dGeomGetPosition(TriMesh);
@@ -54,7 +48,7 @@ int dCollideRTL(dxGeom* g1, dxGeom* RayGeom, int Flags, dContactGeom* Contacts,
     const unsigned uiTLSKind = TriMesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == RayGeom->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    RayCollider& Collider = pccColliderCache->_RayCollider[tid];
+    RayCollider& Collider = pccColliderCache->_RayCollider;
 
     dReal Length = dGeomRayGetLength(RayGeom);
 
@@ -83,14 +77,14 @@ int dCollideRTL(dxGeom* g1, dxGeom* RayGeom, int Flags, dContactGeom* Contacts,
     Matrix4x4 amatrix;
     int TriCount = 0;
     if (Collider.Collide(WorldRay, TriMesh->Data->BVTree, &MakeMatrix(TLPosition, TLRotation, amatrix))) {
-        TriCount = pccColliderCache->Faces[tid].GetNbFaces();
+        TriCount = pccColliderCache->Faces.GetNbFaces();
     }
 
     if (TriCount == 0) {
         return 0;
     }
 
-    const CollisionFace* Faces = pccColliderCache->Faces[tid].GetFaces();
+    const CollisionFace* Faces = pccColliderCache->Faces.GetFaces();
 
     int OutTriCount = 0;
     for (int i = 0; i < TriCount; i++) {
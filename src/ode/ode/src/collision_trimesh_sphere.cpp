@@ -247,12 +247,6 @@ int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contact
     dIASSERT (SphereGeom->type == dSphereClass);
     dIASSERT ((Flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     dxTriMesh* TriMesh = (dxTriMesh*)g1;
 
     // Init
@@ -262,7 +256,7 @@ int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contact
     const unsigned uiTLSKind = TriMesh->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == SphereGeom->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    SphereCollider& Collider = pccColliderCache->_SphereCollider[tid];
+    SphereCollider& Collider = pccColliderCache->_SphereCollider;
 
     const dVector3& Position = *(const dVector3*)dGeomGetPosition(SphereGeom);
     dReal Radius = dGeomSphereGetRadius(SphereGeom);
@@ -300,7 +294,7 @@ int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contact
     }
     else {
         Collider.SetTemporalCoherence(false);
-        Collider.Collide(pccColliderCache->defaultSphereCache[tid], Sphere, TriMesh->Data->BVTree, null,
+        Collider.Collide(pccColliderCache->defaultSphereCache, Sphere, TriMesh->Data->BVTree, null,
             &MakeMatrix(TLPosition, TLRotation, amatrix));
     }
 
@@ -470,12 +470,6 @@ dCollideTTL(dxGeom* g1, dxGeom* g2, int Flags, dContactGeom* Contacts, int Strid
     dIASSERT (g2->type == dTriMeshClass);
     dIASSERT ((Flags & NUMC_MASK) >= 1);
 
-#ifdef ODE_MT
-	int tid = dThreadManager()->currentThreadId();
-#else
-	int tid = 0;
-#endif
-
     dxTriMesh* TriMesh1 = (dxTriMesh*) g1;
     dxTriMesh* TriMesh2 = (dxTriMesh*) g2;
 
@@ -493,9 +487,9 @@ dCollideTTL(dxGeom* g1, dxGeom* g2, int Flags, dContactGeom* Contacts, int Strid
     const unsigned uiTLSKind = TriMesh1->getParentSpaceTLSKind();
     dIASSERT(uiTLSKind == TriMesh2->getParentSpaceTLSKind()); // The colliding spaces must use matching cleanup method
     TrimeshCollidersCache *pccColliderCache = GetTrimeshCollidersCache(uiTLSKind);
-    AABBTreeCollider& Collider = pccColliderCache->_AABBTreeCollider[tid];
-    BVTCache &ColCache = pccColliderCache->ColCache[tid];
-    CONTACT_KEY_HASH_TABLE &hashcontactset = pccColliderCache->_hashcontactset[tid];
+    AABBTreeCollider& Collider = pccColliderCache->_AABBTreeCollider;
+    BVTCache &ColCache = pccColliderCache->ColCache;
+    CONTACT_KEY_HASH_TABLE &hashcontactset = pccColliderCache->_hashcontactset;
 
     ColCache.Model0 = &TriMesh1->Data->BVTree;
     ColCache.Model1 = &TriMesh2->Data->BVTree;
@@ -32,6 +32,7 @@ functions that are defined in the public header files.
 #include "config.h"
 #include "odemath.h"
 #include "collision_util.h"
+#include "util.h"
 
 //****************************************************************************
 
@@ -594,3 +595,72 @@ void		 dClipPolyToCircle(const dVector3 avArrayIn[], const int ctIn,
         }
     }
 }
+
+// area of the polygon (p,a,b) projected on the plane orthogonal to 'normal', times two
+static inline dReal projectedTriangleArea (const dReal *p, const dReal *a, const dReal *b, const dReal *normal)
+{
+    dVector3 pa, pb, c;
+    dSubtractVectors3 (pa, a, p);
+    dSubtractVectors3 (pb, b, p);
+    dCalcVectorCross3 (c, pa, pb);
+    return dFabs (dCalcVectorDot3 (c, normal));
+}
+
+int dReduceContacts (dContactGeom *contact, int count, int skip, int maxContacts)
+{
+    dAASSERT (contact && skip >= (int)sizeof(dContactGeom));
+    if (maxContacts <= 0 || count <= maxContacts)
+        return count;
+
+    int *selected = (int *) dALLOCA16 (maxContacts * sizeof(int));
+    bool *used = (bool *) dALLOCA16 (count * sizeof(bool));
+    memset (used, 0, count * sizeof(bool));
+
+    // the deepest contact is always kept, its normal defines the contact plane
+    int deepest = 0;
+    for (int i = 1; i < count; ++i) {
+        if (CONTACT(contact, i*skip)->depth > CONTACT(contact, deepest*skip)->depth)
+            deepest = i;
+    }
+    selected[0] = deepest;
+    used[deepest] = true;
+    const dReal *normal = CONTACT(contact, deepest*skip)->normal;
+
+    // then the point farthest from it, and the points enlarging the most the
+    // polygon of the selected points, the deepest one in case of a tie
+    for (int k = 1; k < maxContacts; ++k) {
+        int best = -1;
+        dReal bestScore = -1, bestDepth = 0;
+        for (int i = 0; i < count; ++i) {
+            if (used[i])
+                continue;
+            const dContactGeom *c = CONTACT(contact, i*skip);
+            dReal score = 0;
+            if (k == 1)
+                score = dCalcPointsDistance3 (c->pos, CONTACT(contact, deepest*skip)->pos);
+            else {
+                for (int j = 0; j < k; ++j)
+                    score += projectedTriangleArea (c->pos, CONTACT(contact, selected[j]*skip)->pos,
+                                                    CONTACT(contact, selected[(j + 1) % k]*skip)->pos, normal);
+            }
+            if (score > bestScore || (score == bestScore && c->depth > bestDepth)) {
+                best = i;
+                bestScore = score;
+                bestDepth = c->depth;
+            }
+        }
+        selected[k] = best;
+        used[best] = true;
+    }
+
+    // keep the original order of the contacts
+    int n = 0;
+    for (int i = 0; i < count; ++i) {
+        if (used[i]) {
+            if (i != n)
+                memcpy (CONTACT(contact, n*skip), CONTACT(contact, i*skip), sizeof(dContactGeom));
+            ++n;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,150 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/odemath.h>
+#include "config.h"
+#include "objects.h"
+#include "contact_cache.h"
+#include "joints/contact.h"
+
+// cached contacts farther than this distance or whose normal deviates too much are not matched
+#define CONTACT_CACHE_MAX_DISTANCE REAL(0.01)
+#define CONTACT_CACHE_MIN_NORMAL_DOT REAL(0.95)
+
+dxContactCache::dxContactCache():
+    entries(NULL),
+    capacity(0)
+{
+}
+
+dxContactCache::~dxContactCache()
+{
+    if (entries)
+        dFree(entries, capacity * sizeof(Entry));
+}
+
+size_t dxContactCache::hash(const dxGeom *g1, const dxGeom *g2, int side1, int side2)
+{
+    size_t h = (size_t)g1 >> 4;
+    h = h * 31 + ((size_t)g2 >> 4);
+    h = h * 31 + (size_t)(unsigned)side1;
+    h = h * 31 + (size_t)(unsigned)side2;
+    return h ^ (h >> 16);
+}
+
+void dxContactCache::update(dxWorld *world)
+{
+    size_t count = 0;
+    for (dxJoint *j = world->firstjoint; j; j = (dxJoint *)j->next) {
+        if (j->type() == dJointTypeContact)
+            count++;
+    }
+
+    // keep the load factor below one half
+    size_t newcapacity = 16;
+    while (newcapacity < 2 * count)
+        newcapacity *= 2;
+    if (newcapacity != capacity) {
+        if (entries)
+            dFree(entries, capacity * sizeof(Entry));
+        entries = (Entry *)dAlloc(newcapacity * sizeof(Entry));
+        capacity = newcapacity;
+    }
+    for (size_t i = 0; i < capacity; i++)
+        entries[i].g1 = NULL;
+
+    const size_t mask = capacity - 1;
+    for (dxJoint *j = world->firstjoint; j; j = (dxJoint *)j->next) {
+        if (j->type() != dJointTypeContact)
+            continue;
+        const dxJointContact *contact = (const dxJointContact *)j;
+        const dContactGeom &geom = contact->contact.geom;
+        // the_m is only set by getInfo1, i.e. for the contacts which were
+        // solved: the ones between disabled bodies keep their initial 0
+        if (contact->the_m <= 0 || contact->the_m > 6 || geom.g1 == NULL)
+            continue;
+
+        size_t i = hash(geom.g1, geom.g2, geom.side1, geom.side2) & mask;
+        while (entries[i].g1 != NULL)
+            i = (i + 1) & mask;
+
+        Entry &e = entries[i];
+        e.g1 = geom.g1;
+        e.g2 = geom.g2;
+        e.side1 = geom.side1;
+        e.side2 = geom.side2;
+        dCopyVector3(e.pos, geom.pos);
+        dCopyVector3(e.normal, geom.normal);
+        e.m = (unsigned int)contact->the_m;
+        for (unsigned int k = 0; k < e.m; k++)
+            e.lambda[k] = j->lambda[k];
+    }
+}
+
+bool dxContactCache::lookup(const dContactGeom &geom, unsigned int m, dReal *lambda) const
+{
+    if (capacity == 0)
+        return false;
+
+    const size_t mask = capacity - 1;
+    const Entry *best = NULL;
+    dReal bestdistance = CONTACT_CACHE_MAX_DISTANCE * CONTACT_CACHE_MAX_DISTANCE;
+    for (size_t i = hash(geom.g1, geom.g2, geom.side1, geom.side2) & mask; entries[i].g1 != NULL; i = (i + 1) & mask) {
+        const Entry &e = entries[i];
+        if (e.g1 != geom.g1 || e.g2 != geom.g2 || e.side1 != geom.side1 || e.side2 != geom.side2 || e.m != m)
+            continue;
+        if (dCalcVectorDot3(e.normal, geom.normal) < CONTACT_CACHE_MIN_NORMAL_DOT)
+            continue;
+        dVector3 offset;
+        dSubtractVectors3(offset, e.pos, geom.pos);
+        const dReal distance = dCalcVectorDot3(offset, offset);
+        if (distance <= bestdistance) {
+            bestdistance = distance;
+            best = &e;
+        }
+    }
+
+    if (best == NULL)
+        return false;
+    for (unsigned int k = 0; k < m; k++)
+        lambda[k] = best->lambda[k];
+    return true;
+}
+
+void dxContactCache::saveState(void *buffer) const
+{
+    if (capacity > 0)
+        memcpy(buffer, entries, capacity * sizeof(Entry));
+}
+
+void dxContactCache::loadState(const void *buffer, size_t size)
+{
+    const size_t newcapacity = size / sizeof(Entry);
+    if (newcapacity != capacity) {
+        if (entries)
+            dFree(entries, capacity * sizeof(Entry));
+        entries = newcapacity > 0 ? (Entry *)dAlloc(newcapacity * sizeof(Entry)) : NULL;
+        capacity = newcapacity;
+    }
+    if (capacity > 0)
+        memcpy(entries, buffer, capacity * sizeof(Entry));
+}
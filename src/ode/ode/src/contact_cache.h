@@ -0,0 +1,71 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_CONTACT_CACHE_H_
+#define _ODE_CONTACT_CACHE_H_
+
+#include <ode/common.h>
+#include <ode/contact.h>
+
+// Contact joints are recreated at every step, so the impulses computed by
+// the QuickStep solver are lost with them. This cache keeps the impulses of
+// the previous step, keyed by geom pair and contact feature (side1, side2),
+// so that they can be used as a warm start by the next step. Several cached
+// contacts may share the same key, the closest one with a similar normal is
+// used.
+
+struct dxContactCache
+{
+    dxContactCache();
+    ~dxContactCache();
+
+    // rebuild the cache from the contact joints of the world
+    void update(dxWorld *world);
+
+    // copy the impulses of the matching contact of the previous step in 'lambda'
+    // returns false if there is no match with the same number of rows 'm'
+    bool lookup(const dContactGeom &geom, unsigned int m, dReal *lambda) const;
+
+    // copy of the cached impulses, see dWorldSaveState. The entries refer to
+    // the geoms by address, so a copy is only valid in the same process
+    size_t getStateSize() const { return capacity * sizeof(Entry); }
+    void saveState(void *buffer) const;
+    void loadState(const void *buffer, size_t size);
+
+private:
+    struct Entry
+    {
+        dxGeom *g1, *g2;    // NULL for an empty slot
+        int side1, side2;
+        dVector3 pos;
+        dVector3 normal;
+        unsigned int m;
+        dReal lambda[6];
+    };
+
+    static size_t hash(const dxGeom *g1, const dxGeom *g2, int side1, int side2);
+
+    Entry *entries;     // open addressing table with linear probing
+    size_t capacity;    // power of two
+};
+
+#endif
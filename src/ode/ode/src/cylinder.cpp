@@ -933,7 +933,7 @@ void sCylinderCylinderData::computeContactPointsParallelAxesCAC(
     }
 
     const dVector3 v2 = { r2 * R2[1], r2 * R2[5], r2 * R2[9] };
-    const dVector3 v3Plus = { M_SQRT1_2 * (v1[0] + v2[0]), M_SQRT1_2 * (v1[1] + v2[1]), M_SQRT1_2 * (v1[2] + v2[2]) };
+    const dVector3 v3Plus = { (dReal)M_SQRT1_2 * (v1[0] + v2[0]), (dReal)M_SQRT1_2 * (v1[1] + v2[1]), (dReal)M_SQRT1_2 * (v1[2] + v2[2]) };
     const dReal sinus2  = dCalcVectorDot3_44(R1 + 2, R2 + 1);
     const dReal r2PythagorPlusPlus = M_SQRT1_2 * r2 * (cosinus2 + sinus2);
     depth = h1 - dFabs(temp + r2PythagorPlusPlus);
@@ -960,7 +960,7 @@ void sCylinderCylinderData::computeContactPointsParallelAxesCAC(
         return;
     }
 
-    const dVector3 v3Minus = { M_SQRT1_2 * (v1[0] - v2[0]), M_SQRT1_2 * (v1[1] - v2[1]), M_SQRT1_2 * (v1[2] - v2[2]) };
+    const dVector3 v3Minus = { (dReal)M_SQRT1_2 * (v1[0] - v2[0]), (dReal)M_SQRT1_2 * (v1[1] - v2[1]), (dReal)M_SQRT1_2 * (v1[2] - v2[2]) };
     const dReal r2PythagorMinusPlus = M_SQRT1_2 * r2 *(-cosinus2 + sinus2);
     depth = h1 - dFabs(temp + r2PythagorMinusPlus);
     if (depth > 0.0) {
@@ -71,7 +71,7 @@ struct sBoxImmersionData {
     for (int i = 0; i < 2; ++i) {
       for (int j = 0; j < 2; ++j) {
         for (int k = 0; k < 2; ++k) {
-          dVector3 v = { i ? 1.0 : -1.0, j ? 1.0 : -1.0, k ? 1.0 : -1.0 };
+          dVector3 v = { i ? REAL(1.0) : -REAL(1.0), j ? REAL(1.0) : -REAL(1.0), k ? REAL(1.0) : -REAL(1.0) };
           const dReal depth = boxCenterDepth - dCalcVectorDot3(v, s);
           dCopyVector3(m_vImmersedVertices[vertexCount].pos, v);
           m_vImmersedVertices[vertexCount].depth = depth;
@@ -46,6 +46,11 @@ struct dxImmersionOutline {
   dCurvedEdge &curvedEdge(int index) { return curvedEdgesArray[index]; }
   int straightEdgesSize() { return straightEdgesArray.size(); }
   int curvedEdgesSize() { return curvedEdgesArray.size(); }
+  // empties the arrays without freeing their memory
+  void reset() {
+    straightEdgesArray.setSize(0);
+    curvedEdgesArray.setSize(0);
+  }
 };
 
 #ifdef __cplusplus
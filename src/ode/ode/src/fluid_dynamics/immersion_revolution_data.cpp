@@ -71,8 +71,8 @@ int sRevolutionImmersionData::oneFullyImmersedDisk(dReal sign) {
 
     const dReal tanTheta = - nX / nZ;
     const dReal hPrime = zI - m_fRadius * tanTheta + m_fHalfHeight;
-    const dVector3 gamma0 = { 0.0, 0.0, - m_fHalfHeight + 0.5 * hPrime };
-    const dVector3 gamma1 = { 0.25 * m_fRadius, 0.0, zI - 3.0 * (m_fRadius * tanTheta) / 8.0 };
+    const dVector3 gamma0 = { 0.0, 0.0, - m_fHalfHeight + REAL(0.5) * hPrime };
+    const dVector3 gamma1 = { REAL(0.25) * m_fRadius, 0.0, zI - REAL(3.0) * (m_fRadius * tanTheta) / REAL(8.0) };
     const dReal temp = M_PI * m_fRadiusSquare;
     const dReal V0 = temp * hPrime; // volume of a subcylinder
     const dReal V1 = temp * tanTheta * m_fRadius; // volume of a half-subcylinder
@@ -149,7 +149,7 @@ int sRevolutionImmersionData::onePartiallyImmersedDisk(dReal sign) {
 
   dReal gamma[2];
   computeCylinderSectionGamma(gamma, phi, sinusPhi, cosinusPhi);
-  dReal b[2] = { m_fRadius * gamma[0] / (12.0 * t), m_fRadius * tanTheta * gamma[1] / (8.0 * t) + zI };
+  dReal b[2] = { m_fRadius * gamma[0] / (REAL(12.0) * t), m_fRadius * tanTheta * gamma[1] / (REAL(8.0) * t) + zI };
 
   // Absolute coordinates
   dAddScaledVectors3(m_gImmersion->buoyancyCenter, m_vEx, m_vEz, b[0], b[1]);
@@ -247,7 +247,7 @@ int sRevolutionImmersionData::twoPartiallyImmersedDisks() {
     dReal gammaMinus[2];
     computeCylinderSectionGamma(gammaMinus, phiMinus, sinusPhiMinus, cosinusPhiMinus);
     const dReal delta[2] = { gammaMinus[0] - gammaPlus[0], gammaMinus[1] - gammaPlus[1] };
-    const dVector3 b = { m_fRadius * delta[0] / (12.0 * t), 0.0, m_fRadius * tanTheta * delta[1] / (8.0 * t) + zI };
+    const dVector3 b = { m_fRadius * delta[0] / (REAL(12.0) * t), 0.0, m_fRadius * tanTheta * delta[1] / (REAL(8.0) * t) + zI };
 
     // Absolute coordinates
     dAddScaledVectors3(m_gImmersion->buoyancyCenter, m_vEx, m_vEz, b[0], b[2]);
@@ -379,6 +379,50 @@ void dGeomTriMeshGetImmersionPlane (dGeomID g, dVector4 plane)
   dGeomTriMeshGetBoundingPlane(g, 2 * FLUID_PLANE_NORMAL + 1, plane);
  }
 
+// Computes the area, the volume and the relative center of mass of a trimesh like the dGeomTriMeshGet* functions, in a
+// single pass and without caching them in the geom: a trimesh may be immersed in several fluids by several threads at once
+static void computeTriMeshMassProperties (dxTriMesh *trimesh, dReal *area, dReal *volume, dVector3 relCenterOfMass)
+{
+  const unsigned int numberOfTriangles = FetchTriangleCount(trimesh);
+  dVector3 v[3];
+  dVector3 e1, e2, n;
+  dReal a = 0.0;
+  dReal V = 0.0;
+  dSetZero(relCenterOfMass, 3);
+#if dTRIMESH_OPCODE
+  VertexPointers VP;
+  ConversionArea VC;
+#endif
+  for (unsigned int i = 0; i < numberOfTriangles; ++i) {
+#if dTRIMESH_OPCODE
+    trimesh->Data->Mesh.GetTriangle(VP, i, VC);
+    for (int j = 0; j < 3; ++j) {
+      v[j][0] = VP.Vertex[j]->x;
+      v[j][1] = VP.Vertex[j]->y;
+      v[j][2] = VP.Vertex[j]->z;
+    }
+#endif
+#if dTRIMESH_GIMPACT
+    FetchTransformedTriangle(trimesh, i, v);
+#endif
+    dSubtractVectors3(e1, v[1], v[0]);
+    dSubtractVectors3(e2, v[2], v[0]);
+    dCalcVectorCross3(n, e1, e2);
+    a += dCalcVectorLength3(n);
+    for (int j = 0; j < 3; ++j)
+      V += n[j] * (v[0][j] + (e1[j] + e2[j]) / 3.0);
+    for (int j = 0; j < 3; ++j) {
+      const dReal v0 = v[0][j];
+      const dReal a1 = e1[j];
+      const dReal a2 = e2[j];
+      relCenterOfMass[j] += n[j] * (v0 * (v0 + (2.0 / 3.0) * (a1 + a2)) + (a1 * a1 + a1 * a2 + a2 * a2) / 6.0);
+    }
+  }
+  *area = 0.5 * a;
+  *volume = (1.0 / 6.0) * V;
+  dScaleVector3(relCenterOfMass, 0.25 / *volume);
+}
+
 int dImmerseTriMesh (dxTriMesh *trimesh, const dReal *fluidPlane, int flags,
       dImmersionGeom *immersion)
 {
@@ -400,9 +444,18 @@ int dImmerseTriMesh (dxTriMesh *trimesh, const dReal *fluidPlane, int flags,
   }
 
   if (fullyImmersed) {
-    immersion->area = dGeomTriMeshGetArea(trimesh);
-    immersion->volume = dGeomTriMeshGetVolume(trimesh);
-    dGeomTriMeshGetCenterOfMass(trimesh, immersion->buoyancyCenter);
+    // the values cached by the dGeomTriMeshGet* functions are only read here, they are computed for this call otherwise
+    const dReal *relCenterOfMass = trimesh->centerOfMass;
+    dVector3 c;
+    if (trimesh->dataFlag & (dxTriMesh::areaChanged | dxTriMesh::volumeChanged | dxTriMesh::centerOfMassChanged)) {
+      computeTriMeshMassProperties(trimesh, &immersion->area, &immersion->volume, c);
+      relCenterOfMass = c;
+    } else {
+      immersion->area = trimesh->area;
+      immersion->volume = trimesh->volume;
+    }
+    dMultiply0_331(immersion->buoyancyCenter, dGeomGetRotation(trimesh), relCenterOfMass);
+    dAddVectors3(immersion->buoyancyCenter, immersion->buoyancyCenter, dGeomGetPosition(trimesh));
     return 1;
   }
 
@@ -286,6 +286,13 @@ int dFluidDynamicsStep (dWorldID w)
         dCopyScaledVector3(quadraticDragTorque, av, p * t[0] * avLength);
       }
 
+#if dTRIMESH_ENABLED
+      // caches the volume and the center of mass of a trimesh, its area is cached below: its next immersions may be
+      // computed by several threads at once and only read these values
+      if (dGeomGetClass(img.g1) == dTriMeshClass)
+        dGeomTriMeshGetRelCenterOfMass(img.g1);
+#endif
+
       // Viscous resistance (linear drags)
       dVector3 viscousResistanceForce, viscousResistanceTorque;
       const dReal p = - (img.area / dGeomGetArea(img.g1)) * immersionLink->fluid->viscosity;
@@ -562,6 +569,10 @@ void dImmersionOutlineDestroy (dImmersionOutlineID io) {
   delete io;
 }
 
+void dImmersionOutlineReset (dImmersionOutlineID io) {
+  io->reset();
+}
+
 int dImmersionOutlineGetStraightEdgesSize (dImmersionOutlineID io) {
   return io->straightEdgesSize();
 }
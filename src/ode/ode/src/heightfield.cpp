@@ -38,6 +38,8 @@
 #include "collision_util.h"
 #include "heightfield.h"
 
+#include <algorithm>
+
 #if dTRIMESH_ENABLED
 #include "collision_trimesh_colliders.h"
 #endif // dTRIMESH_ENABLED
@@ -117,7 +119,6 @@ dxHeightfieldData::dxHeightfieldData():
 
     m_pGetHeightCallback( NULL )
 {
-    memset( m_contacts, 0, sizeof( m_contacts ) );
 }
 
 // build Heightfield data
@@ -471,6 +472,7 @@ dxHeightfield::dxHeightfield( dSpaceID space,
     tempPlaneBufferSize(0),
     tempTriangleBuffer(0),
     tempTriangleBufferSize(0),
+    tempTriangleIndexBuffer(0),
     tempHeightBuffer(0),
     tempHeightInstances(0),
     tempHeightBufferSizeX(0),
@@ -621,11 +623,13 @@ void dxHeightfield::allocateTriangleBuffer(size_t numTri)
     size_t alignedNumTri = AlignBufferSize(numTri, TEMP_TRIANGLE_BUFFER_ELEMENT_COUNT_ALIGNMENT);
     tempTriangleBufferSize = alignedNumTri;
     tempTriangleBuffer = new HeightFieldTriangle[alignedNumTri];
+    tempTriangleIndexBuffer = new unsigned int[2 * alignedNumTri];
 }
 
 void dxHeightfield::resetTriangleBuffer()
 {
     delete[] tempTriangleBuffer;
+    delete[] tempTriangleIndexBuffer;
 }
 
 void dxHeightfield::allocatePlaneBuffer(size_t numTri)
@@ -680,6 +684,7 @@ void dxHeightfield::resetBufferPointers()
     tempPlaneBufferSize = 0;
     tempTriangleBuffer = 0;
     tempTriangleBufferSize = 0;
+    tempTriangleIndexBuffer = 0;
     tempHeightBuffer = 0;
     tempHeightInstances = 0;
     tempHeightBufferSizeX = 0;
@@ -917,30 +922,30 @@ static inline bool DescendingPlaneSort(const HeightFieldPlane * const A, const H
     return ((A->maxAAAB - B->maxAAAB) > dEpsilon);
 }
 
-void dxHeightfield::sortPlanes(const size_t numPlanes)
+// a plane goes after the next one if DescendingPlaneSort is true for them
+static inline bool PlaneGoesBefore(const HeightFieldPlane * const A, const HeightFieldPlane * const B)
 {
-    bool has_swapped = true;
-    do
-    {
-        has_swapped = false;//reset flag
-        for (size_t i = 0; i < numPlanes - 1; i++)
-        {
-            //if they are in the wrong order
-            if (DescendingPlaneSort(tempPlaneBuffer[i], tempPlaneBuffer[i + 1]))
-            {
-                //exchange them
-                HeightFieldPlane * tempPlane = tempPlaneBuffer[i];
-                tempPlaneBuffer[i] = tempPlaneBuffer[i + 1];
-                tempPlaneBuffer[i + 1] = tempPlane;
+    return DescendingPlaneSort(B, A);
+}
 
-                //we have swapped at least once, list may not be sorted yet
-                has_swapped = true;
-            }
-        }
-    }    //if no swaps were made during this pass, the list has been sorted
-    while (has_swapped);
+void dxHeightfield::sortPlanes(const size_t numPlanes)
+{
+    // stable, gives the same order as swapping the consecutive planes in the wrong
+    // order until there are none, without its quadratic cost
+    std::stable_sort(tempPlaneBuffer, tempPlaneBuffer + numPlanes, PlaneGoesBefore);
 }
 
+// orders triangle indices by the y component of the triangle normals
+struct HeightFieldTriangleNormalYCompare
+{
+    explicit HeightFieldTriangleNormalYCompare(const HeightFieldTriangle *triangles) : m_triangles(triangles) {}
+
+    bool operator()(unsigned int a, unsigned int b) const { return m_triangles[a].planeDef[1] < m_triangles[b].planeDef[1]; }
+    bool operator()(unsigned int a, dReal normy) const { return m_triangles[a].planeDef[1] < normy; }
+
+    const HeightFieldTriangle *m_triangles;
+};
+
 // fabien.rohrer@cyberbotics.com:
 //   the following lines are causing clang warnings about unused-function
 /*
@@ -1205,7 +1210,8 @@ int dxHeightfield::dCollideHeightfieldZone( const int minX, const int maxX, cons
     */
 
     int numTerrainContacts = 0;
-    dContactGeom *PlaneContact = m_p_data->m_contacts;
+    // on the stack: the heightfield data may be shared by geoms collided by several threads
+    dContactGeom PlaneContact[HEIGHTFIELDMAXCONTACTPERCELL];
 
     const unsigned int numTriMax = (maxX - minX) * (maxZ - minZ) * 2;
     if (tempTriangleBufferSize < numTriMax)
@@ -1397,6 +1403,15 @@ int dxHeightfield::dCollideHeightfieldZone( const int minX, const int maxX, cons
             allocatePlaneBuffer(numTri);
         }
 
+        // the triangles sharing the plane of a given triangle have about the same
+        // normal, they are searched among the triangles sorted by normal y component
+        unsigned int * const triangleOrder = tempTriangleIndexBuffer;
+        unsigned int * const planeTriangles = tempTriangleIndexBuffer + numTri;
+        const HeightFieldTriangleNormalYCompare normalYCompare(tempTriangleBuffer);
+        for (unsigned int k = 0; k < numTri; k++)
+            triangleOrder[k] = k;
+        std::sort(triangleOrder, triangleOrder + numTri, normalYCompare);
+
         unsigned int numPlanes = 0;
         for (unsigned int k = 0; k < numTri; k++)
         {
@@ -1418,8 +1433,15 @@ int dxHeightfield::dCollideHeightfieldZone( const int minX, const int maxX, cons
             const dReal normz = tri_base->planeDef[2];
             const dReal dist = tri_base->planeDef[3];
 
-            for (unsigned int m = k + 1; m < numTri; m++)
+            // the window is wider than dEpsilon to be safe from rounding errors
+            const unsigned int *it = std::lower_bound(triangleOrder, triangleOrder + numTri,
+                normy - 2 * dEpsilon, normalYCompare);
+            unsigned int numPlaneTriangles = 0;
+            for (; it != triangleOrder + numTri && tempTriangleBuffer[*it].planeDef[1] <= normy + 2 * dEpsilon; ++it)
             {
+                const unsigned int m = *it;
+                if (m <= k)
+                    continue;
 
                 HeightFieldTriangle * const tri_test = &tempTriangleBuffer[m];
                 if (tri_test->state == true)
@@ -1432,10 +1454,16 @@ int dxHeightfield::dCollideHeightfieldZone( const int minX, const int maxX, cons
                     dFabs(normx - tri_test->planeDef[0]) < dEpsilon &&
                     dFabs(normz - tri_test->planeDef[2]) < dEpsilon
                     )
-                {
-                    currPlane->addTriangle (tri_test);
-                    tri_test->state = true;
-                }
+                    planeTriangles[numPlaneTriangles++] = m;
+            }
+
+            // keep the triangles in the order they were generated
+            std::sort(planeTriangles, planeTriangles + numPlaneTriangles);
+            for (unsigned int m = 0; m < numPlaneTriangles; m++)
+            {
+                HeightFieldTriangle * const tri_test = &tempTriangleBuffer[planeTriangles[m]];
+                currPlane->addTriangle (tri_test);
+                tri_test->state = true;
             }
 
             tri_base->state = true;
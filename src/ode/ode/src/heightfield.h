@@ -71,8 +71,6 @@ struct dxHeightfieldData
     const void* m_pHeightData; // Sample data array
     void* m_pUserData;         // Callback user data
 
-    dContactGeom            m_contacts[HEIGHTFIELDMAXCONTACTPERCELL];
-
     dHeightfieldGetHeight* m_pGetHeightCallback;		// Callback pointer.
 
     dxHeightfieldData();
@@ -231,6 +229,7 @@ struct dxHeightfield : public dxGeom
 
     HeightFieldTriangle *tempTriangleBuffer;
     size_t              tempTriangleBufferSize;
+    unsigned int        *tempTriangleIndexBuffer;   // 2 indices per triangle, used to group them by plane
 
     HeightFieldVertex   **tempHeightBuffer;
     HeightFieldVertex   *tempHeightInstances;
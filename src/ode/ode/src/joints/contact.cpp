@@ -29,7 +29,8 @@
 // contact
 
 dxJointContact::dxJointContact( dxWorld *w ) :
-    dxJoint( w )
+    dxJoint( w ),
+    the_m( 0 )
 {
 }
 
@@ -81,10 +81,118 @@ size_t dxJointGroup::exportJoints(dxJoint **jlist)
     return i;
 }
 
+dxJoint *dxJointGroup::continueSlotEnum(dxJoint *j)
+{
+    dxJointPool::Slot *next = dxJointPool::getSlot(j)->m_next;
+    return next != NULL ? dxJointPool::getJoint(next) : NULL;
+}
+
+void *dxJointGroup::allocSlot()
+{
+    dxJointPool::Slot *slot = m_pool->allocSlot();
+    if (slot == NULL)
+        return NULL;
+    slot->m_next = m_slots;
+    if (m_slots == NULL)
+        m_last_slot = slot;
+    m_slots = slot;
+    ++m_num_slots;
+    return dxJointPool::getJoint(slot);
+}
+
 void dxJointGroup::freeAll()
 {
     m_num = 0;
     m_stack.freeAll();
+    if (m_slots != NULL) {
+        m_pool->freeSlots(m_slots, m_last_slot, m_num_slots);
+        m_slots = m_last_slot = NULL;
+        m_num_slots = 0;
+    }
+}
+
+//****************************************************************************
+// dxJointPool
+
+#define SLOT_HEADER_SIZE dEFFICIENT_SIZE(sizeof(dxJointPool::Slot))
+#define BLOCK_HEADER_SIZE dEFFICIENT_SIZE(sizeof(Block))
+// number of slots of the first block, if no initial capacity is given
+#define MIN_BLOCK_SLOTS 32
+
+dxJointPool::dxJointPool(size_t joint_size, size_t initial_capacity):
+    m_joint_size(joint_size), m_slot_size(SLOT_HEADER_SIZE + dEFFICIENT_SIZE(joint_size)),
+    m_blocks(NULL), m_free(NULL),
+    m_capacity(0), m_used(0), m_high_water_mark(0), m_allocations(0)
+{
+    if (initial_capacity != 0)
+        grow(initial_capacity);
+}
+
+dxJointPool::~dxJointPool()
+{
+    dUASSERT(m_used == 0, "the joint groups of the pool must be destroyed first");
+    Block *b = m_blocks;
+    while (b != NULL) {
+        Block *next = b->m_next;
+        dFree(b, b->m_size);
+        b = next;
+    }
+}
+
+dxJoint *dxJointPool::getJoint(Slot *slot)
+{
+    return (dxJoint *)((char *)slot + SLOT_HEADER_SIZE);
+}
+
+dxJointPool::Slot *dxJointPool::getSlot(dxJoint *joint)
+{
+    return (Slot *)((char *)joint - SLOT_HEADER_SIZE);
+}
+
+void dxJointPool::grow(size_t count)
+{
+    // the slots are aligned on the efficient alignment inside the block
+    const size_t size = BLOCK_HEADER_SIZE + EFFICIENT_ALIGNMENT + count * m_slot_size;
+    Block *b = (Block *)dAlloc(size);
+    if (b == NULL)
+        return;
+    b->m_next = m_blocks;
+    b->m_size = size;
+    m_blocks = b;
+    ++m_allocations;
+
+    char *first = (char *)dEFFICIENT_PTR((char *)b + BLOCK_HEADER_SIZE);
+    // the free list is built from the end so that the slots are used in the order of the memory
+    for (size_t i = count; i != 0; ) {
+        --i;
+        Slot *slot = (Slot *)(first + i * m_slot_size);
+        slot->m_next = m_free;
+        m_free = slot;
+    }
+    m_capacity += count;
+}
+
+dxJointPool::Slot *dxJointPool::allocSlot()
+{
+    if (m_free == NULL) {
+        // double the capacity, so that a rising high-water mark only causes a few allocations
+        grow(m_capacity > MIN_BLOCK_SLOTS ? m_capacity : MIN_BLOCK_SLOTS);
+        if (m_free == NULL)
+            return NULL;
+    }
+    Slot *slot = m_free;
+    m_free = slot->m_next;
+    ++m_used;
+    if (m_used > m_high_water_mark)
+        m_high_water_mark = m_used;
+    return slot;
+}
+
+void dxJointPool::freeSlots(Slot *first, Slot *last, size_t count)
+{
+    last->m_next = m_free;
+    m_free = first;
+    m_used -= count;
 }
 
 //****************************************************************************
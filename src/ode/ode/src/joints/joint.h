@@ -44,7 +44,11 @@ enum
     // it must have either zero or two bodies attached.
     dJOINT_TWOBODIES = 4,
 
-    dJOINT_DISABLED = 8
+    dJOINT_DISABLED = 8,
+
+    // set during dWorldStep on the joints solved in reduced coordinates by
+    // the articulated-body solver, see articulation.h.
+    dJOINT_ARTICULATED = 16
 };
 
 // there are two of these nodes in the joint, one for each connection to a
@@ -152,17 +156,64 @@ struct dxJoint : public dObject
     bool mtTag; // used in clustering algorithm to indicate that the joint was reattached
 };
 
+// joint pool. the joints of the groups created from a pool are stored in
+// fixed size slots shared by all these groups. the slots of an emptied group
+// are given back to the pool and reused: memory is only allocated when more
+// slots are used than ever before. a pool is not thread safe.
+
+struct dxJointPool : public dBase
+{
+    struct Slot {
+        Slot *m_next;   // next slot of the group or of the free list
+    };
+
+    dxJointPool(size_t joint_size, size_t initial_capacity);
+    ~dxJointPool();
+
+    size_t getJointSize() const { return m_joint_size; }
+    Slot *allocSlot();
+    // give back a list of 'count' slots linked from 'first' to 'last'
+    void freeSlots(Slot *first, Slot *last, size_t count);
+
+    static dxJoint *getJoint(Slot *slot);
+    static Slot *getSlot(dxJoint *joint);
+
+    size_t getCapacity() const { return m_capacity; }
+    size_t getUsedCount() const { return m_used; }
+    size_t getHighWaterMark() const { return m_high_water_mark; }
+    size_t getAllocationCount() const { return m_allocations; }
+
+private:
+    struct Block {
+        Block *m_next;
+        size_t m_size;
+    };
+
+    void grow(size_t count);
+
+    size_t m_joint_size;        // largest joint stored in a slot
+    size_t m_slot_size;         // slot header and joint, rounded up to the alignment
+    Block *m_blocks;            // memory blocks holding the slots
+    Slot *m_free;               // list of the unused slots
+    size_t m_capacity;          // number of slots in all the blocks
+    size_t m_used;              // number of slots used by the groups
+    size_t m_high_water_mark;   // largest number of slots ever used
+    size_t m_allocations;       // number of blocks allocated
+};
+
 // joint group. NOTE: any joints in the group that have their world destroyed
 // will have their world pointer set to 0.
 
 struct dxJointGroup : public dBase
 {
-    dxJointGroup(): m_num(0), m_stack() {}
+    dxJointGroup(dxJointPool *pool = NULL):
+        m_num(0), m_stack(), m_pool(pool), m_slots(NULL), m_last_slot(NULL), m_num_slots(0) {}
 
     template<class T>
     T *alloc(dWorldID w)
     {
-        T *j = (T *)m_stack.alloc(sizeof(T));
+        // the joints which are too large for the slots of the pool are stored on the stack
+        T *j = (T *)(m_pool != NULL && sizeof(T) <= m_pool->getJointSize() ? allocSlot() : m_stack.alloc(sizeof(T)));
         if (j != NULL) {
             ++m_num;
             new(j) T(w);
@@ -172,16 +223,29 @@ struct dxJointGroup : public dBase
     }
 
     size_t getJointCount() const { return m_num; }
+
+    // joints stored on the stack
+    size_t getStackJointCount() const { return m_num - m_num_slots; }
     size_t exportJoints(dxJoint **jlist);
 
     void *beginEnum() { return m_stack.rewind(); }
     void *continueEnum(size_t num_bytes) { return m_stack.next(num_bytes); }
 
+    // joints stored in the slots of the pool, from the most recently added one
+    dxJoint *beginSlotEnum() { return m_slots != NULL ? dxJointPool::getJoint(m_slots) : NULL; }
+    dxJoint *continueSlotEnum(dxJoint *j);
+
     void freeAll();
 
 private:
-    size_t m_num;        // number of joints on the stack
+    void *allocSlot();
+
+    size_t m_num;        // number of joints in the group
     dObStack m_stack; // a stack of (possibly differently sized) dxJoint objects.
+    dxJointPool *m_pool;
+    dxJointPool::Slot *m_slots;       // slots of the pool used by the group, from the most recent one
+    dxJointPool::Slot *m_last_slot;
+    size_t m_num_slots;
 };
 
 // common limit and motor information for a single joint axis of movement
@@ -25,16 +25,22 @@
 #include "config.h"
 #include "matrix.h"
 #include "error.h"
+#include "util.h"
 
 //****************************************************************************
 // random numbers
 
 static unsigned long seed = 0;
 
+static inline unsigned long dRandFromSeed (unsigned long *s)
+{
+  *s = (1664525UL * *s + 1013904223UL) & 0xffffffff;
+  return *s;
+}
+
 unsigned long dRand()
 {
-  seed = (1664525UL*seed + 1013904223UL) & 0xffffffff;
-  return seed;
+  return dRandFromSeed(&seed);
 }
 
 unsigned long  dRandGetSeed()
@@ -61,11 +67,16 @@ int dTestRand()
 
 // adam's all-int straightforward(?) dRandInt (0..n-1)
 int dRandInt (int n)
+{
+    return dRandIntFromSeed(&seed, n);
+}
+
+int dRandIntFromSeed (unsigned long *s, int n)
 {
     int result;
     // Since there is no memory barrier macro in ODE assign via volatile variable
     // to prevent compiler reusing seed as value of `r'
-    volatile unsigned long raw_r = dRand();
+    volatile unsigned long raw_r = dRandFromSeed(s);
     duint32 r = (duint32)raw_r;
 
     duint32 un = n;
@@ -28,6 +28,7 @@
 #include "matrix.h"
 #include "objects.h"
 #include "util.h"
+#include "contact_cache.h"
 
 #define dWORLD_DEFAULT_GLOBAL_ERP REAL(0.2)
 
@@ -63,7 +64,10 @@ dxDampingParameters::dxDampingParameters(void *):
 
 dxQuickStepParameters::dxQuickStepParameters(void *):
     num_iterations(20),
-    w(REAL(1.3))
+    w(REAL(1.3)),
+    warm_starting(REAL(0.0)),
+    num_threads(1),
+    deterministic(false)
 {
 }
 
@@ -88,6 +92,14 @@ dxWorld::dxWorld():
     contactp(NULL),
     dampingp(NULL),
     max_angular_speed(dInfinity),
+    island_threads(1),
+    articulated(false),
+    keep_forces(false),
+    deterministic(false),
+    defer_moved_notifications(false),
+    own_random_seed(false),
+    random_seed(0),
+    contact_cache(NULL),
     userdata(0)
 {
     dSetZero (gravity, 4);
@@ -99,4 +111,6 @@ dxWorld::~dxWorld()
     {
         wmem->Release();
     }
+
+    delete contact_cache;
 }
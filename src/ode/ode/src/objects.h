@@ -33,6 +33,7 @@
 #include "array.h"
 
 class dxStepWorkingMemory;
+struct dxContactCache;
 
 // some body flags
 
@@ -99,6 +100,9 @@ struct dxDampingParameters {
 struct dxQuickStepParameters {
     int num_iterations;		// number of SOR iterations to perform
     dReal w;			// the SOR over-relaxation parameter
+    dReal warm_starting;	// fraction of the previous impulses used as initial guess, 0 to start from zero
+    unsigned int num_threads;	// number of threads relaxing the graph-coloured rows
+    bool deterministic;		// relax the graph-coloured rows even with a single thread
 
     dxQuickStepParameters() {}
     explicit dxQuickStepParameters(void *);
@@ -132,6 +136,7 @@ struct dxBody : public dObject {
     dQuaternion q;		// orientation quaternion
     dVector3 lvel,avel;		// linear and angular velocity of POR
     dVector3 facc,tacc;		// force and torque accumulators
+    dVector3 kept_facc,kept_tacc;	// accumulators before the step, restored if the world keeps the forces
     dVector3 finite_rot_axis;	// finite rotation axis, unit length or 0=none
 
     // auto-disable information
@@ -148,6 +153,7 @@ struct dxBody : public dObject {
     dReal max_angular_speed;      // limit the angular velocity to this magnitude
 
     bool mtTag;  // used in clustering algorithm to indicate that the body was reattached
+    unsigned int serial;  // creation order, the islands of a deterministic world are built in this order
 
     dxBody(dxWorld *w);
 };
@@ -168,6 +174,14 @@ struct dxWorld : public dBase {
     dxContactParameters contactp;
     dxDampingParameters dampingp; // damping parameters
     dReal max_angular_speed;      // limit the angular velocity to this magnitude
+    unsigned int island_threads;  // number of threads used by dWorldStep to solve independent islands
+    bool articulated;             // dWorldStep solves the hinge and slider trees in reduced coordinates
+    bool keep_forces;             // the steps restore the force accumulators of the bodies instead of clearing them
+    bool deterministic;           // the result of a step does not depend on the order of the bodies in the world
+    bool defer_moved_notifications; // set while islands are stepped in parallel: geoms are notified afterwards
+    bool own_random_seed;         // QuickStep draws its row order from random_seed instead of the global generator
+    unsigned long random_seed;
+    dxContactCache *contact_cache; // contact impulses of the previous step, used when qs.warm_starting > 0
 
     void* userdata;
 
@@ -40,6 +40,7 @@
 #include "fluid_dynamics/immersion_link/immersion_link.h"
 #include "step.h"
 #include "quickstep.h"
+#include "contact_cache.h"
 #include "util.h"
 #include "odetls.h"
 #include "ode_MT/ode_MT.h"
@@ -237,10 +238,14 @@ dxWorld* dBodyGetWorld (dxBody * b)
     return b->world;
 }
 
+// bodies are numbered in their creation order, which does not depend on the world they are moved to by ODE_MT
+static unsigned int body_serial = 0;
+
 dxBody *dBodyCreate_ST (dxWorld *w)
 {
     dAASSERT (w);
     dxBody *b = new dxBody(w);
+    b->serial = body_serial++;
     b->firstjoint = 0;
     b->firstimmersionlink = 0;
     b->flags = 0;
@@ -1264,6 +1269,13 @@ dJointGroupID dJointGroupCreate (int /*max_size*/)
     return group;
 }
 
+dJointGroupID dJointGroupCreateFromPool (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    dxJointGroup *group = new dxJointGroup(pool);
+    return group;
+}
+
 void dJointGroupDestroy (dJointGroupID group)
 {
     dAASSERT (group);
@@ -1275,7 +1287,12 @@ void dJointGroupEmpty (dJointGroupID group)
 {
     dAASSERT (group);
 
-    const size_t num_joints = group->getJointCount();
+    // the joints stored in the slots of a pool are listed from the most recently added one
+    for (dxJoint *j = group->beginSlotEnum(); j != NULL; j = group->continueSlotEnum(j)) {
+        FinalizeAndDestroyJointInstance(j, false);
+    }
+
+    const size_t num_joints = group->getStackJointCount();
     if (num_joints != 0) {
         // Local array is used since ALLOCA leads to mysterious NULL values in first array element and crashes under VS2005 :)
         const size_t max_stack_jlist_size = 1024;
@@ -1306,12 +1323,14 @@ void dJointGroupEmpty (dJointGroupID group)
             }
         }
 
-        group->freeAll();
-
         if (jlist != stack_jlist && jlist != NULL) {
             dFree(jlist, jlist_size);
         }
     }
+
+    if (group->getJointCount() != 0) {
+        group->freeAll();
+    }
 }
 
 int dJointGroupGetCount(dJointGroupID group)
@@ -1319,6 +1338,44 @@ int dJointGroupGetCount(dJointGroupID group)
     return group->getJointCount();
 }
 
+dJointPoolID dJointPoolCreate (int initial_capacity)
+{
+    dUASSERT (initial_capacity >= 0, "the initial capacity must be >= 0");
+    // the slots are sized for the contact joints, the other joints are stored in their group
+    dxJointPool *pool = new dxJointPool(sizeof(dxJointContact), initial_capacity);
+    return pool;
+}
+
+void dJointPoolDestroy (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    delete pool;
+}
+
+int dJointPoolGetCapacity (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    return (int)pool->getCapacity();
+}
+
+int dJointPoolGetCount (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    return (int)pool->getUsedCount();
+}
+
+int dJointPoolGetHighWaterMark (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    return (int)pool->getHighWaterMark();
+}
+
+int dJointPoolGetAllocationCount (dJointPoolID pool)
+{
+    dAASSERT (pool);
+    return (int)pool->getAllocationCount();
+}
+
 int dJointGetNumBodies(dxJoint *joint)
 {
     // check arguments
@@ -1764,25 +1821,50 @@ int dWorldSetStepMemoryManager(dWorldID w, const dWorldStepMemoryFunctionsInfo *
     return result;
 }
 
+// save the forces added to the bodies before the fluid forces and the
+// gravity are added by the step
+static void dxSaveKeptForces (dxWorld *w)
+{
+    for (dxBody *b = w->firstbody; b; b = (dxBody*)b->next) {
+        dCopyVector3 (b->kept_facc,b->facc);
+        dCopyVector3 (b->kept_tacc,b->tacc);
+    }
+}
+
+static void dxRestoreKeptForces (dxWorld *w)
+{
+    for (dxBody *b = w->firstbody; b; b = (dxBody*)b->next) {
+        dCopyVector3 (b->facc,b->kept_facc);
+        dCopyVector3 (b->tacc,b->kept_tacc);
+    }
+}
+
 int dWorldStep (dWorldID w, dReal stepsize)
 {
     dUASSERT (w,"bad world argument");
     dUASSERT (stepsize > 0,"stepsize must be > 0");
 
+    const bool keep_forces = w->keep_forces;
+    if (keep_forces)
+        dxSaveKeptForces (w);
+
     dFluidDynamicsStep(w);
 
     bool result = false;
 
   dxWorldProcessIslandsInfo islandsinfo;
-  if (dxReallocateWorldProcessContext (w, islandsinfo, stepsize, &dxEstimateStepMemoryRequirements))
+  if (dxReallocateWorldProcessContext (w, islandsinfo, stepsize, &dxEstimateStepMemoryRequirements, w->island_threads))
   {
-    dxProcessIslands (w, islandsinfo, stepsize, &dInternalStepIsland);
+    dxProcessIslands (w, islandsinfo, stepsize, &dInternalStepIsland, w->island_threads);
 
     result = true;
   }
 
   dxCleanupWorldProcessContext (w);
 
+  if (keep_forces)
+      dxRestoreKeptForces (w);
+
   return result;
 }
 
@@ -1791,6 +1873,12 @@ int dWorldQuickStep (dWorldID w, dReal stepsize)
     dUASSERT (w,"bad world argument");
     dUASSERT (stepsize > 0,"stepsize must be > 0");
 
+    const bool keep_forces = w->keep_forces;
+    if (keep_forces)
+        dxSaveKeptForces (w);
+
+    dFluidDynamicsStep(w);
+
     bool result = false;
 
   dxWorldProcessIslandsInfo islandsinfo;
@@ -1798,11 +1886,22 @@ int dWorldQuickStep (dWorldID w, dReal stepsize)
   {
     dxProcessIslands (w, islandsinfo, stepsize, &dxQuickStepper);
 
+    // keep the contact impulses for the next step as the contact joints are about to be destroyed
+    if (w->qs.warm_starting > 0)
+    {
+      if (!w->contact_cache)
+        w->contact_cache = new dxContactCache;
+      w->contact_cache->update(w);
+    }
+
     result = true;
   }
 
   dxCleanupWorldProcessContext (w);
 
+  if (keep_forces)
+      dxRestoreKeptForces (w);
+
   return result;
 }
 
@@ -2042,6 +2141,132 @@ dReal dWorldGetQuickStepW (dWorldID w)
     return w->qs.w;
 }
 
+void dWorldSetQuickStepWarmStarting (dWorldID w, dReal factor)
+{
+    dAASSERT(w);
+    dUASSERT(factor >= 0 && factor <= 1, "warm starting factor must be in [0, 1]");
+    w->qs.warm_starting = factor;
+    if (factor == 0 && w->contact_cache)
+    {
+        delete w->contact_cache;
+        w->contact_cache = NULL;
+    }
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+dReal dWorldGetQuickStepWarmStarting (dWorldID w)
+{
+    dAASSERT(w);
+    return w->qs.warm_starting;
+}
+
+void dWorldSetQuickStepThreadCount (dWorldID w, int count)
+{
+    dAASSERT(w);
+    dUASSERT(count >= 1, "thread count must be >= 1");
+    w->qs.num_threads = (unsigned int)count;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetQuickStepThreadCount (dWorldID w)
+{
+    dAASSERT(w);
+    return (int)w->qs.num_threads;
+}
+
+void dWorldSetQuickStepDeterministic (dWorldID w, int deterministic)
+{
+    dAASSERT(w);
+    w->qs.deterministic = deterministic != 0;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetQuickStepDeterministic (dWorldID w)
+{
+    dAASSERT(w);
+    return w->qs.deterministic ? 1 : 0;
+}
+
+void dWorldSetIslandThreadCount (dWorldID w, int count)
+{
+    dAASSERT(w);
+    dUASSERT(count >= 1, "thread count must be >= 1");
+    w->island_threads = (unsigned int)count;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetIslandThreadCount (dWorldID w)
+{
+    dAASSERT(w);
+    return (int)w->island_threads;
+}
+
+void dWorldSetArticulatedBodySolver (dWorldID w, int articulated)
+{
+    dAASSERT(w);
+    w->articulated = articulated != 0;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetArticulatedBodySolver (dWorldID w)
+{
+    dAASSERT(w);
+    return w->articulated ? 1 : 0;
+}
+
+void dWorldSetKeepForces (dWorldID w, int keep)
+{
+    dAASSERT(w);
+    w->keep_forces = keep != 0;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetKeepForces (dWorldID w)
+{
+    dAASSERT(w);
+    return w->keep_forces ? 1 : 0;
+}
+
+void dWorldSetDeterministic (dWorldID w, int deterministic)
+{
+    dAASSERT(w);
+    w->deterministic = deterministic != 0;
+#ifdef ODE_MT
+    dWorldRefreshParameters(w);
+#endif
+}
+
+int dWorldGetDeterministic (dWorldID w)
+{
+    dAASSERT(w);
+    return w->deterministic ? 1 : 0;
+}
+
+void dWorldSetRandomSeed (dWorldID w, unsigned long seed)
+{
+    dAASSERT(w);
+    w->own_random_seed = true;
+    w->random_seed = seed;
+}
+
+unsigned long dWorldGetRandomSeed (dWorldID w)
+{
+    dAASSERT(w);
+    return w->own_random_seed ? w->random_seed : dRandGetSeed();
+}
+
 void dWorldSetContactMaxCorrectingVel (dWorldID w, dReal vel)
 {
     dAASSERT(w);
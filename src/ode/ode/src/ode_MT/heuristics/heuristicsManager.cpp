@@ -13,9 +13,9 @@ void dxHeuristicsManager::alertCallback(dxHeuristic<int>* _heuristic)
     {
         ODE_PRINT("Cluster Count Heuristic\n");
 
+        // no limit since the worker pool replaced the arrays of MAX_THREADS per-thread slots: a thread count above
+        // the number of clusters only leaves workers idle, see worker_pool_benchmark
         int newThreadCount = clusterCountHeuristic->getNewValue();
-        if (newThreadCount > MAX_THREADS)
-            newThreadCount = MAX_THREADS;
         if (dynamic_cast<dxThreadManagerPthread*>(threadManager) == NULL)
             dToggleODE_MT(newThreadCount);
 
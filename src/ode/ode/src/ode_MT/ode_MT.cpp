@@ -4,9 +4,12 @@
 #include "clustering/cluster.h"
 #include "threading/threadManagerPthread.h"
 #include "threading/threadManagerOpenMP.h"
+#include "threading/workerPool.h"
 #include "heuristics/heuristicsManager.h"
 #include "clustering/clusterManager.h"
 
+#include <algorithm>
+
 static bool bMTmode = true;
 static int threadCount = 4;
 static bool bMainThread = true;
@@ -26,30 +29,19 @@ static dWorldStepFunction *stepFunc;
 static dWorldID currentWorld;
 static dSpaceID currentSpace;
 
-struct threadCluster
+// each active cluster is a task of the worker pool, the heaviest clusters come first
+struct clusterTask
 {
-  int tid;
-  dxMaintainedArray<int> clusterIDs;
-  int clusterCount;
-  int bodyCount;
+  int clusterID;
   int geomCount;
 };
 
-static dxMaintainedArray<threadCluster> threadClusters;
+static dxMaintainedArray<clusterTask> clusterTasks;
+static int clusterTaskCount = 0;
 
-static int findLeastLoadedThread()
+static bool isClusterTaskHeavier(const clusterTask &a, const clusterTask &b)
 {
-    int minVal = 99999;
-    int minIndex = -1;
-    for (int t=0; t<threadCount; t++)
-    {
-        if (threadClusters[t].geomCount < minVal)
-        {
-            minVal = threadClusters[t].geomCount;
-            minIndex = t;
-        }
-    }
-    return minIndex;
+    return a.geomCount != b.geomCount ? a.geomCount > b.geomCount : a.clusterID < b.clusterID;
 }
 
 static void clusterChangeCallback();
@@ -62,21 +54,11 @@ static dxThreadManager *threadManager = new dxThreadManagerOpenMP();
 static dxClusterManager* clusterManager = new dxClusterManager(&clusterChangeCallback);
 static dxHeuristicsManager *heuristicsManager = new dxHeuristicsManager(threadCount, 10, clusterManager, threadManager);
 
-dxThreadManager *dThreadManager() {
-  return threadManager;
-}
-
 static void clusterChangeCallback()
 {
-    // cluster count has changed, update thread load balancing
+    // cluster count has changed, update the tasks
     ODE_IMPORTANT("Cluster count changed!\n");
-    for (int t=0; t<threadCount; t++)
-    {
-        threadClusters[t].tid = t;
-        threadClusters[t].clusterCount = 0;
-        threadClusters[t].bodyCount = 0;
-        threadClusters[t].geomCount = 0;
-    }
+    clusterTaskCount = 0;
     for (int j=0; j<clusterManager->currentCWAS->activeClusterCount; j++)
     {
         int k = clusterManager->currentCWAS->activeClusters[j];
@@ -84,11 +66,11 @@ static void clusterChangeCallback()
         if (clusterManager->currentCWAS->worlds[k] == NULL || clusterManager->currentCWAS->spaces[k] == 0)
             continue;
 
-        int tid = findLeastLoadedThread();
-        threadClusters[tid].clusterIDs[threadClusters[tid].clusterCount++] = k;
-        threadClusters[tid].bodyCount += clusterManager->currentCWAS->worlds[k]->nb;
-        threadClusters[tid].geomCount += clusterManager->currentCWAS->spaces[k]->count;
+        clusterTask &task = clusterTasks[clusterTaskCount++];
+        task.clusterID = k;
+        task.geomCount = clusterManager->currentCWAS->spaces[k]->count;
     }
+    std::sort(&clusterTasks[0], &clusterTasks[0] + clusterTaskCount, isClusterTaskHeavier);
 }
 
 static void dHashSpaceCollide(int tid, void *data, dNearCallback *callback)
@@ -100,65 +82,52 @@ static void dHashSpaceCollide(int tid, void *data, dNearCallback *callback)
 #endif
 }
 
-bool clusterCollide(int tid)
+bool clusterCollide(int task)
 {
-  ODE_PRINT("ClusterCollide with id: %d\n", tid);
+  ODE_PRINT("ClusterCollide with id: %d\n", task);
   bool bError = false;
   if (bMTmode) {
-      for (int j = 0; j < threadClusters[tid].clusterCount; ++j)
-      {
-          int kid = threadClusters[tid].clusterIDs[j];
-          // first of all, see if any static clusters need to be added or removed
-          clusterManager->currentCWAS->checkClusterConsistency(kid);
-          clusterManager->currentCWAS->spaces[kid]->cleanGeoms();
-          bError = clusterManager->currentCWAS->updateClusterAABBsAndTable(kid);
-          if (bError == false)
-            dHashSpaceCollide(kid, colData, colCallback);
-      }
+      int kid = clusterTasks[task].clusterID;
+      // first of all, see if any static clusters need to be added or removed
+      clusterManager->currentCWAS->checkClusterConsistency(kid);
+      clusterManager->currentCWAS->spaces[kid]->cleanGeoms();
+      bError = clusterManager->currentCWAS->updateClusterAABBsAndTable(kid);
+      if (bError == false)
+        dHashSpaceCollide(kid, colData, colCallback);
   }
-  else if (tid < 1 && !bMainThread) dSpaceCollide(currentSpace, colData, colCallback);
+  else if (task < 1 && !bMainThread) dSpaceCollide(currentSpace, colData, colCallback);
   return bError;
 }
 
-void clusterLCP(int tid)
+void clusterLCP(int task)
 {
-  ODE_PRINT("Performing child LCP %d\n", tid);
+  ODE_PRINT("Performing child LCP %d\n", task);
   ODE_PRINT("Original Joint count: %d\n", currentWorld->nj);
-  ODE_PRINT("Cluster Joint count: %d\n", clusterManager->currentCWAS->worlds[tid]->nj);
   // in reverse order, the collider runs after the lcp solver
   // hence, any errors from the collider in the previous frame
   // will have been sorted out by the CheckHashSpaceConsistency function
   // at the beginning of this frame. Therefore, no need to check for collider error
   // hypothetically.
-  //if (bError == false) // FIXME: remove that line when sure it makes no problem
-  {
-      for (int j = 0; j < threadClusters[tid].clusterCount; ++j)
-      {
-          int kid = threadClusters[tid].clusterIDs[j];
-          if (bMTmode) stepFunc(clusterManager->currentCWAS->worlds[kid], LCPstepsize);
-          else if (tid < 1 && !bMainThread) stepFunc(currentWorld, LCPstepsize);
-      }
-
-  }
+  if (bMTmode) stepFunc(clusterManager->currentCWAS->worlds[clusterTasks[task].clusterID], LCPstepsize);
+  else if (task < 1 && !bMainThread) stepFunc(currentWorld, LCPstepsize);
 }
 
-void* simLoopChild(int tid, void* args)
+void* simLoopChild(int task, void* args)
 {
-    if (tid >= threadCount || clusterManager->currentCWAS == NULL || tid >= clusterManager->currentCWAS->clusterCount)
+    if (clusterManager->currentCWAS == NULL || task >= clusterTaskCount)
         return NULL;
 
-    int i = tid;
     if (bPhysicsStepsReverse == false)
     {
-        bool bError = clusterCollide(i);
+        bool bError = clusterCollide(task);
         if (bError == false)
-            clusterLCP(i);
+            clusterLCP(task);
     } else
     {
-        clusterLCP(i);
+        clusterLCP(task);
         if (spaceUpdateFunc != NULL)
-          spaceUpdateFunc(tid);
-        clusterCollide(i);
+          spaceUpdateFunc(task);
+        clusterCollide(task);
     }
   return NULL;
 }
@@ -206,20 +175,37 @@ ODE_API dxClusterNode** dClusterGetClusterAABBs(dWorldID _world, dSpaceID _space
     return clusterManager->getCWAS(_world, _space)->clusterAABBs.data();
 }
 
+// in multi-threaded mode, each task updates the space of a single cluster
 ODE_API int dThreadGetSpacesCount(int threadID) {
     if (threadID >= 0 && bMTmode)
-        return threadClusters[threadID].clusterCount;
+        return threadID < clusterTaskCount ? 1 : 0;
     return 1;
 }
 
 ODE_API dSpaceID dThreadGetSpaceID(int threadID, int index) {
     if (threadID >= 0 && bMTmode) {
-        int kid = threadClusters[threadID].clusterIDs[index];
+        (void)index;
+        int kid = clusterTasks[threadID].clusterID;
         return clusterManager->currentCWAS->spaces[kid];
     }
     return currentSpace;
 }
 
+ODE_API void dRunWorkerTasks(unsigned int taskCount, unsigned int maxThreads, dWorkerTaskFunction *function, void *data)
+{
+#ifdef ODE_THREADMODE_PTHREAD
+    if (maxThreads > 1)
+    {
+        dxWorkerPool *pool = dWorkerPool();
+        pool->reserveWorkers(maxThreads);
+        pool->run(taskCount, maxThreads, function, data);
+        return;
+    }
+#endif
+    for (unsigned int task = 0; task < taskCount; ++task)
+        function(task, 0, data);
+}
+
 ODE_API void dGeomSetDynamicFlag(dGeomID geom)
 {
     geom->is_dynamic = true;
@@ -244,7 +230,7 @@ void dSpaceCollideAndWorldStep (dSpaceID _space, void *_data, dNearCallback *_ca
         clusterManager->currentCWAS = clusterManager->getCWAS(_world, _space);
 
         clusterManager->simLoop(bRefreshClusters);
-        threadManager->simLoop();
+        threadManager->simLoop(clusterTaskCount);
         heuristicsManager->simLoop(_world, _space);
 
         bRefreshClusters = false;
@@ -278,7 +264,7 @@ void dWorldStepAndSpaceCollide (dSpaceID _space, void *_data, dNearCallback *_ca
         clusterManager->currentCWAS = clusterManager->getCWAS(_world, _space);
 
         clusterManager->simLoop(bRefreshClusters);
-        threadManager->simLoop();
+        threadManager->simLoop(clusterTaskCount);
         heuristicsManager->simLoop(_world, _space);
 
         bRefreshClusters = false;
@@ -395,6 +381,12 @@ dSpaceID dSpaceCreate_MT(dSpaceID _space, dSpaceCreateFunction *_spaceFunc)
     return newSpace;
 }
 
+void dRecombineClusters_MT()
+{
+    if (bMTmode && !bRefreshClusters && clusterManager->currentCWAS)
+        resetWorldsAndSpaces();
+}
+
 void dSpaceDestroy_MT(dxSpace *space, dSpaceDestroyFunction *_spaceDestroyFunc)
 {
     ODE_PRINT("Removing space %p\n", space);
@@ -6,9 +6,6 @@
 #include "util_MT.h"
 #include "objects.h"
 #include "ode/collision_space.h"
-#include "threading/threadManager.h"
-
-dxThreadManager *dThreadManager();
 
 /* multi-threaded utility functions for collision detection and LCP solver */
 typedef void dSpaceCollideFunction(dSpaceID, void *, dNearCallback);
@@ -16,6 +13,8 @@ typedef int dWorldStepFunction(dxWorld *, dReal);
 
 dWorldID dWorldCreate_MT(dWorldCreateFunction *_worldFunc);
 dSpaceID dSpaceCreate_MT(dSpaceID _space, dSpaceCreateFunction *_spaceFunc);
+// for spaces that cannot be created by a dSpaceCreateFunction, and thus not used as cluster spaces
+void dRecombineClusters_MT();
 
 typedef void dInitODEFunction();
 typedef void dCloseODEFunction();
@@ -7,11 +7,12 @@
 
 //pthread_attr_t gomp_thread_attr;
 
-void dxThreadManagerOpenMP::simLoop()
+void dxThreadManagerOpenMP::simLoop(int taskCount)
 {
 #ifdef ODE_THREADMODE_OPENMP
-    #pragma omp parallel
-    threadFunc(omp_get_thread_num(), NULL);
+    #pragma omp parallel for schedule(dynamic)
+    for (int task = 0; task < taskCount; ++task)
+        threadFunc(task, NULL);
 #endif
 }
 
@@ -32,16 +33,6 @@ void dxThreadManagerOpenMP::reinit(int numThreads)
 #endif
 }
 
-int dxThreadManagerOpenMP::currentThreadId() const
-{
-#ifdef ODE_THREADMODE_OPENMP
-  #pragma message ("To implement: dxThreadManagerPthread::currentThreadId()")
-  // probably:
-  // return omp_get_thread_num();
-#endif
-  return 0;
-}
-
 dxThreadManagerOpenMP::dxThreadManagerOpenMP()
 {
 
@@ -11,9 +11,8 @@ public:
     ~dxThreadManagerOpenMP();
 
     void init(int numThreads, voidFunc threadFunc);
-    void simLoop();
+    void simLoop(int taskCount);
     void reinit(int numThreads);
-    int currentThreadId() const;
 };
 
 #endif
@@ -0,0 +1,241 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include "workerPool.h"
+#include "ode_MT/util_MT.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <thread>
+
+dxWorkerPool *dWorkerPool()
+{
+    static dxWorkerPool pool;
+    return &pool;
+}
+
+dxWorkerPool::dxWorkerPool() :
+    threads(NULL),
+    threadCount(0),
+    generation(0),
+    busyThreads(0),
+    quit(false),
+    taskFunction(NULL),
+    taskData(NULL),
+    activeWorkerCount(0),
+    ranges(NULL),
+    threadArguments(NULL)
+{
+    pthread_mutex_init(&runMutex, NULL);
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&startCondition, NULL);
+    pthread_cond_init(&doneCondition, NULL);
+}
+
+dxWorkerPool::~dxWorkerPool()
+{
+    stopThreads();
+    free(ranges);
+    pthread_cond_destroy(&doneCondition);
+    pthread_cond_destroy(&startCondition);
+    pthread_mutex_destroy(&mutex);
+    pthread_mutex_destroy(&runMutex);
+}
+
+void dxWorkerPool::stopThreads()
+{
+    pthread_mutex_lock(&mutex);
+    quit = true;
+    pthread_cond_broadcast(&startCondition);
+    pthread_mutex_unlock(&mutex);
+    for (unsigned int i = 0; i < threadCount; ++i)
+        pthread_join(threads[i], NULL);
+    free(threads);
+    free(threadArguments);
+    threads = NULL;
+    threadArguments = NULL;
+    threadCount = 0;
+    quit = false;
+}
+
+void dxWorkerPool::reserveWorkers(unsigned int count)
+{
+    if (count <= threadCount + 1)
+        return;
+
+    pthread_mutex_lock(&runMutex);
+    if (count <= threadCount + 1)
+    {
+        // another caller already spawned enough threads
+        pthread_mutex_unlock(&runMutex);
+        return;
+    }
+    // threads are restarted so that they all wait on the current generation
+    stopThreads();
+    threadCount = count - 1;
+    free(ranges);
+    ranges = (taskRange *)malloc(count * sizeof(taskRange));
+    threads = (pthread_t *)malloc(threadCount * sizeof(pthread_t));
+    threadArguments = (threadArgument *)malloc(threadCount * sizeof(threadArgument));
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        ODE_IMPORTANT("Creating worker thread %d\n", i + 1);
+        threadArguments[i].pool = this;
+        threadArguments[i].worker = i + 1;
+        threadArguments[i].startGeneration = generation;
+        pthread_create(&threads[i], NULL, &workerMain, &threadArguments[i]);
+    }
+    pthread_mutex_unlock(&runMutex);
+}
+
+void dxWorkerPool::yield()
+{
+    sched_yield();
+}
+
+unsigned int dxWorkerPool::getCoreCount()
+{
+    static const unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+void* dxWorkerPool::workerMain(void *arg)
+{
+    dxWorkerPool *pool = ((threadArgument *)arg)->pool;
+    const unsigned int worker = ((threadArgument *)arg)->worker;
+
+    unsigned int lastGeneration = ((threadArgument *)arg)->startGeneration;
+    pthread_mutex_lock(&pool->mutex);
+    while (true)
+    {
+        while (!pool->quit && pool->generation == lastGeneration)
+            pthread_cond_wait(&pool->startCondition, &pool->mutex);
+        if (pool->quit)
+            break;
+        lastGeneration = pool->generation;
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (worker < pool->activeWorkerCount)
+            pool->processTasks(worker);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->busyThreads == 0)
+            pthread_cond_signal(&pool->doneCondition);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+static inline duint64 packRange(unsigned int first, unsigned int end)
+{
+    return ((duint64)first << 32) | end;
+}
+
+bool dxWorkerPool::popTask(unsigned int worker, unsigned int *task)
+{
+    duint64 *bounds = &ranges[worker].bounds;
+    while (true)
+    {
+        const duint64 range = __atomic_load_n(bounds, __ATOMIC_ACQUIRE);
+        const unsigned int first = (unsigned int)(range >> 32);
+        const unsigned int end = (unsigned int)range;
+        if (first >= end)
+            return false;
+        if (__sync_bool_compare_and_swap(bounds, range, packRange(first + 1, end)))
+        {
+            *task = first;
+            return true;
+        }
+    }
+}
+
+bool dxWorkerPool::stealTasks(unsigned int thief)
+{
+    // the range of the thief is empty, so nobody else modifies it until it is refilled here
+    for (unsigned int i = 1; i < activeWorkerCount; ++i)
+    {
+        duint64 *bounds = &ranges[(thief + i) % activeWorkerCount].bounds;
+        while (true)
+        {
+            const duint64 range = __atomic_load_n(bounds, __ATOMIC_ACQUIRE);
+            const unsigned int first = (unsigned int)(range >> 32);
+            const unsigned int end = (unsigned int)range;
+            if (first >= end)
+                break;
+            const unsigned int middle = end - (end - first + 1) / 2;
+            if (__sync_bool_compare_and_swap(bounds, range, packRange(first, middle)))
+            {
+                __atomic_store_n(&ranges[thief].bounds, packRange(middle, end), __ATOMIC_RELEASE);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void dxWorkerPool::processTasks(unsigned int worker)
+{
+    unsigned int task;
+    do
+    {
+        while (popTask(worker, &task))
+            taskFunction(task, worker, taskData);
+    } while (stealTasks(worker));
+}
+
+void dxWorkerPool::run(unsigned int taskCount, unsigned int maxWorkers, dxWorkerTaskFunction *function, void *data)
+{
+    // The pool runs a single set of tasks at a time. A task running tasks itself, like a cluster stepping its
+    // islands on several threads, or another thread calling run() meanwhile gets the run mutex busy: its tasks
+    // are run serially instead of waiting, which would deadlock in the first case. The tasks of a run() being
+    // independent by contract, any order gives the same result. They all get worker 0, which is also used by the
+    // run in progress: the per-worker data of nested runs must belong to the caller, like the stepper arenas of
+    // the world of a cluster.
+    if (maxWorkers <= 1 || taskCount <= 1 || threadCount == 0 || pthread_mutex_trylock(&runMutex) != 0)
+    {
+        for (unsigned int task = 0; task < taskCount; ++task)
+            function(task, 0, data);
+        return;
+    }
+
+    pthread_mutex_lock(&mutex);
+    taskFunction = function;
+    taskData = data;
+    activeWorkerCount = maxWorkers < threadCount + 1 ? maxWorkers : threadCount + 1;
+    for (unsigned int i = 0; i < activeWorkerCount; ++i)
+        __atomic_store_n(&ranges[i].bounds, packRange((unsigned int)((duint64)taskCount * i / activeWorkerCount),
+                                                      (unsigned int)((duint64)taskCount * (i + 1) / activeWorkerCount)),
+                         __ATOMIC_RELAXED);
+    busyThreads = threadCount;
+    ++generation;
+    pthread_cond_broadcast(&startCondition);
+    pthread_mutex_unlock(&mutex);
+
+    processTasks(0);
+
+    pthread_mutex_lock(&mutex);
+    while (busyThreads > 0)
+        pthread_cond_wait(&doneCondition, &mutex);
+    pthread_mutex_unlock(&mutex);
+
+    pthread_mutex_unlock(&runMutex);
+}
@@ -0,0 +1,99 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_MT_WORKERPOOL_H_
+#define _ODE_MT_WORKERPOOL_H_
+
+#include <ode/odeconfig.h>
+#include <pthread.h>
+
+// task function: 'task' is in [0, taskCount) and 'worker' in [0, workerCount)
+typedef void dxWorkerTaskFunction(unsigned int task, unsigned int worker, void *data);
+
+// Persistent pool of worker threads running independent tasks, without limit on the number of threads.
+// The calling thread takes part in the work as worker 0. The tasks are split in contiguous ranges, one per
+// worker, each worker runs the tasks of its range in increasing order and, once it is done, steals the last
+// half of the range of another worker.
+class dxWorkerPool
+{
+private:
+    pthread_t *threads;
+    unsigned int threadCount; // number of spawned threads, i.e. workers excluding the caller
+
+    pthread_mutex_t runMutex; // only one run() at a time, concurrent callers fall back on serial execution
+    pthread_mutex_t mutex;
+    pthread_cond_t startCondition;
+    pthread_cond_t doneCondition;
+    unsigned int generation;
+    unsigned int busyThreads;
+    bool quit;
+
+    dxWorkerTaskFunction *taskFunction;
+    void *taskData;
+    unsigned int activeWorkerCount;
+
+    // first and end tasks of the range of a worker packed in a single word, so that the owner
+    // and the thieves can update it with a compare-and-swap, one cache line per worker.
+    // Only accessed with atomic builtins while the workers run.
+    struct taskRange
+    {
+        duint64 bounds;
+        char padding[64 - sizeof(duint64)];
+    };
+    taskRange *ranges;
+
+    struct threadArgument
+    {
+        dxWorkerPool *pool;
+        unsigned int worker;
+        unsigned int startGeneration; // generation at creation time, so that no run() can be missed
+    };
+    threadArgument *threadArguments;
+
+    static void* workerMain(void *arg);
+    void processTasks(unsigned int worker);
+    bool popTask(unsigned int worker, unsigned int *task);
+    bool stealTasks(unsigned int thief);
+    void stopThreads();
+
+public:
+    dxWorkerPool();
+    ~dxWorkerPool();
+
+    // makes sure at least 'count' workers (including the calling thread) are available
+    void reserveWorkers(unsigned int count);
+    unsigned int getWorkerCount() const { return threadCount + 1; }
+
+    // gives the processor to another thread, to be called by tasks waiting for each other
+    static void yield();
+    // number of hardware threads, at least 1
+    static unsigned int getCoreCount();
+
+    // runs 'function' on every task using at most 'maxWorkers' workers and returns when all tasks are done.
+    // If another run() is in progress, for example when a task runs tasks itself, the tasks are run serially
+    // by the calling thread as worker 0.
+    void run(unsigned int taskCount, unsigned int maxWorkers, dxWorkerTaskFunction *function, void *data);
+};
+
+dxWorkerPool *dWorkerPool();
+
+#endif
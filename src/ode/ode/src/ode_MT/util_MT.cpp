@@ -37,6 +37,13 @@ void util_MT::copyWorldParameters(dWorldID _destWorld, dWorldID _srcWorld)
     dWorldSetMaxAngularSpeed(_destWorld, dWorldGetMaxAngularSpeed(_srcWorld));
     dWorldSetQuickStepNumIterations(_destWorld, dWorldGetQuickStepNumIterations(_srcWorld));
     dWorldSetQuickStepW(_destWorld, dWorldGetQuickStepW(_srcWorld));
+    dWorldSetQuickStepWarmStarting(_destWorld, dWorldGetQuickStepWarmStarting(_srcWorld));
+    dWorldSetQuickStepThreadCount(_destWorld, dWorldGetQuickStepThreadCount(_srcWorld));
+    dWorldSetQuickStepDeterministic(_destWorld, dWorldGetQuickStepDeterministic(_srcWorld));
+    dWorldSetIslandThreadCount(_destWorld, dWorldGetIslandThreadCount(_srcWorld));
+    dWorldSetArticulatedBodySolver(_destWorld, dWorldGetArticulatedBodySolver(_srcWorld));
+    dWorldSetKeepForces(_destWorld, dWorldGetKeepForces(_srcWorld));
+    dWorldSetDeterministic(_destWorld, dWorldGetDeterministic(_srcWorld));
 }
 
 void util_MT::cleanTags(dxWorld* _world, dxClusteredWorldAndSpace* _cwas)
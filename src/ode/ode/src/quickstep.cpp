@@ -30,8 +30,14 @@
 #include "odemath.h"
 #include "objects.h"
 #include "joints/joint.h"
+#include "joints/contact.h"
 #include "lcp.h"
 #include "util.h"
+#include "contact_cache.h"
+#include "sor_kernels.h"
+#ifdef ODE_MT
+#include "ode_MT/threading/workerPool.h"
+#endif
 
 #include <new>
 
@@ -41,10 +47,10 @@
 //***************************************************************************
 // configuration
 
-// for the SOR and CG methods:
-// uncomment the following line to use warm starting. this definitely
-// help for motor-driven joints. unfortunately it appears to hurt
-// with high-friction contacts using the SOR method. use with care
+// for the CG method:
+// uncomment the following line to use warm starting. the SOR method is
+// warm started at runtime when the world qs.warm_starting factor is not
+// zero, see dWorldSetQuickStepWarmStarting().
 
 //#define WARM_STARTING 1
 
@@ -142,7 +148,6 @@ static void compute_invM_JT (unsigned int m, const dReal *J, dReal *iMJ, int *jb
 }
 
 // compute out = inv(M)*J'*in.
-#ifdef WARM_STARTING
 static void multiply_invM_JT (unsigned int m, unsigned int nb, dReal *iMJ, int *jb,
                               const dReal *in, dReal *out)
 {
@@ -162,7 +167,6 @@ static void multiply_invM_JT (unsigned int m, unsigned int nb, dReal *iMJ, int *
         iMJ_ptr += 6;
     }
 }
-#endif
 
 // compute out = J*in.
 
@@ -342,21 +346,208 @@ static int compare_index_error (const void *a, const void *b)
 
 #endif
 
+//***************************************************************************
+// graph-coloured SOR sweeps
+//
+// the rows of a joint are consecutive in J and share the same bodies, they
+// form a group that is always relaxed in order by a single thread so that
+// friction rows see the normal row they depend on. groups are coloured so
+// that no two groups of a colour share a body: the groups of a colour can
+// then be relaxed in any order, concurrently, and the result depends neither
+// on the number of threads nor on the scheduling. colours are relaxed one
+// after another, in a fixed order.
+
+// number of colours handed out in parallel, the groups that cannot get one
+// of them are relaxed sequentially in a last colour
+#define SOR_PARALLEL_COLOURS 64
+// minimum number of rows relaxed by a worker at once
+#define SOR_CHUNK_ROWS 32
+// minimum number of chunks per colour, on average, for the colours to be
+// relaxed by several workers: below it they mostly wait for each other
+#define SOR_MIN_CHUNKS_PER_COLOUR 2
+
+struct dxSORChunk {
+    unsigned int first, last;   // range in the coloured group array
+    unsigned int phase;         // index of the first chunk of the same colour
+};
+
+struct dxSORColouredInfo {
+    dxSORRows rows;
+    dxSORRelaxFunction *relax;
+    const unsigned int *groupstart;     // first row of each group, m+1 entries
+    const unsigned int *groups;         // groups sorted by colour
+    const dxSORChunk *chunks;           // chunks of one iteration
+    unsigned int chunkcount;            // number of chunks per iteration
+    unsigned int totalcount;            // number of chunks for all iterations
+    volatile unsigned int nextchunk;    // next chunk to relax
+    volatile unsigned int donechunks;   // number of chunks relaxed, in order of their start
+};
+
+static void SOR_RelaxChunks (unsigned int task, unsigned int worker, void *data)
+{
+    (void)task; (void)worker;
+    dxSORColouredInfo *info = (dxSORColouredInfo *)data;
+    const unsigned int chunkcount = info->chunkcount;
+
+    // chunks are taken in order, so waiting for the chunks of the previous
+    // colour only waits for chunks already taken by running workers
+    while (true) {
+        const unsigned int k = __sync_fetch_and_add (&info->nextchunk, 1);
+        if (k >= info->totalcount)
+            return;
+        const dxSORChunk &chunk = info->chunks[k % chunkcount];
+        const unsigned int required = k - k % chunkcount + chunk.phase;
+        for (unsigned int spin = 0; info->donechunks < required; spin++) {
+#ifdef ODE_MT
+            // let the workers relaxing the previous colour run if there are more threads than cores
+            if (spin >= 64)
+                dxWorkerPool::yield();
+#endif
+        }
+        __sync_synchronize();
+
+        for (unsigned int g = chunk.first; g != chunk.last; g++) {
+            const unsigned int group = info->groups[g];
+            const unsigned int rowstart = info->groupstart[group];
+            info->relax (info->rows,NULL,0,rowstart,info->groupstart[group + 1] - rowstart);
+        }
+
+        __sync_fetch_and_add (&info->donechunks, 1);
+    }
+}
+
+static size_t EstimateSOR_ColouredMemoryRequirements (unsigned int m, unsigned int nb)
+{
+    size_t res = dEFFICIENT_SIZE(sizeof(unsigned int) * ((size_t)m + 1)); // for groupstart
+    res += 2 * dEFFICIENT_SIZE(sizeof(unsigned int) * (size_t)m); // for groupcolour, groups
+    res += dEFFICIENT_SIZE(sizeof(duint64) * (size_t)nb); // for bodycolours
+    res += dEFFICIENT_SIZE(sizeof(unsigned int) * (SOR_PARALLEL_COLOURS + 2)); // for colourstart
+    res += dEFFICIENT_SIZE(sizeof(unsigned int) * (SOR_PARALLEL_COLOURS + 1)); // for colourpos
+    res += dEFFICIENT_SIZE(sizeof(dxSORChunk) * ((size_t)m + SOR_PARALLEL_COLOURS + 1)); // for chunks
+    return res;
+}
+
+// returns false without relaxing anything if the coloured sweeps would run
+// on a single worker and are not required by the deterministic mode: the
+// sequential solver is faster then
+static bool SOR_ColouredSweeps (dxWorldProcessMemArena *memarena,
+                                const unsigned int m, const unsigned int nb, const dxSORRows &rows,
+                                const dxQuickStepParameters *qs)
+{
+    const int *jb = rows.jb;
+    const unsigned int serialcolour = SOR_PARALLEL_COLOURS;
+
+    // split the rows into groups of consecutive rows acting on the same bodies
+    unsigned int *groupstart = memarena->AllocateArray<unsigned int>((size_t)m + 1);
+    unsigned int groupcount = 0;
+    for (unsigned int i=0; i<m; i++) {
+        if (i == 0 || jb[(size_t)i*2] != jb[(size_t)i*2-2] || jb[(size_t)i*2+1] != jb[(size_t)i*2-1])
+            groupstart[groupcount++] = i;
+    }
+    groupstart[groupcount] = m;
+
+    // greedy colouring, the colours used by each body are kept in a bit mask
+    unsigned int *groupcolour = memarena->AllocateArray<unsigned int>(groupcount);
+    duint64 *bodycolours = memarena->AllocateArray<duint64>(nb);
+    for (unsigned int i=0; i<nb; i++) bodycolours[i] = 0;
+    unsigned int *colourstart = memarena->AllocateArray<unsigned int>(SOR_PARALLEL_COLOURS + 2);
+    for (unsigned int c=0; c<SOR_PARALLEL_COLOURS + 2; c++) colourstart[c] = 0;
+    for (unsigned int g=0; g<groupcount; g++) {
+        const int b1 = jb[(size_t)groupstart[g]*2];
+        const int b2 = jb[(size_t)groupstart[g]*2+1];
+        const duint64 used = bodycolours[b1] | (b2 != -1 ? bodycolours[b2] : 0);
+        unsigned int colour = 0;
+        while (colour < SOR_PARALLEL_COLOURS && (used & ((duint64)1 << colour)))
+            colour++;
+        if (colour < SOR_PARALLEL_COLOURS) {
+            bodycolours[b1] |= (duint64)1 << colour;
+            if (b2 != -1) bodycolours[b2] |= (duint64)1 << colour;
+        }
+        groupcolour[g] = colour;
+        colourstart[colour + 1]++;
+    }
+
+    // sort the groups by colour, keeping their original order within a colour
+    for (unsigned int c=0; c<=serialcolour; c++) colourstart[c + 1] += colourstart[c];
+    unsigned int *groups = memarena->AllocateArray<unsigned int>(groupcount);
+    {
+        unsigned int *colourpos = memarena->AllocateArray<unsigned int>(SOR_PARALLEL_COLOURS + 1);
+        memcpy (colourpos,colourstart,(SOR_PARALLEL_COLOURS + 1)*sizeof(unsigned int));
+        for (unsigned int g=0; g<groupcount; g++) groups[colourpos[groupcolour[g]]++] = g;
+    }
+
+    // cut each colour into chunks of at least SOR_CHUNK_ROWS rows, the serial colour is one chunk
+    dxSORChunk *chunks = memarena->AllocateArray<dxSORChunk>((size_t)groupcount + SOR_PARALLEL_COLOURS + 1);
+    unsigned int chunkcount = 0;
+    unsigned int colourcount = 0;
+    for (unsigned int c=0; c<=serialcolour; c++) {
+        if (colourstart[c] != colourstart[c + 1]) colourcount++;
+        const unsigned int phase = chunkcount;
+        unsigned int g = colourstart[c];
+        while (g != colourstart[c + 1]) {
+            dxSORChunk &chunk = chunks[chunkcount++];
+            chunk.first = g;
+            chunk.phase = phase;
+            unsigned int rows = 0;
+            while (g != colourstart[c + 1] && (c == serialcolour || rows < SOR_CHUNK_ROWS)) {
+                rows += groupstart[groups[g] + 1] - groupstart[groups[g]];
+                g++;
+            }
+            chunk.last = g;
+        }
+    }
+
+    dxSORColouredInfo info;
+    info.rows = rows;
+    info.relax = dxGetSORKernels()->relax;
+    info.groupstart = groupstart;
+    info.groups = groups;
+    info.chunks = chunks;
+    info.chunkcount = chunkcount;
+    info.totalcount = chunkcount * (unsigned int)qs->num_iterations;
+    info.nextchunk = 0;
+    info.donechunks = 0;
+
+    // the result does not depend on the number of workers: more workers than
+    // cores or than chunks per colour would only spin on the colour barriers
+    unsigned int workers = 1;
+#ifdef ODE_MT
+    if (qs->num_threads > 1 && colourcount > 0) {
+        const unsigned int cores = dxWorkerPool::getCoreCount();
+        const unsigned int chunkspercolour = chunkcount / colourcount;
+        workers = qs->num_threads < cores ? qs->num_threads : cores;
+        if (chunkspercolour < SOR_MIN_CHUNKS_PER_COLOUR)
+            workers = 1;
+        else if (workers > chunkspercolour)
+            workers = chunkspercolour;
+    }
+#endif
+    if (workers <= 1 && !qs->deterministic)
+        return false;
+
+#ifdef ODE_MT
+    if (workers > 1) {
+        dxWorkerPool *pool = dWorkerPool();
+        pool->reserveWorkers(workers);
+        pool->run(workers, workers, &SOR_RelaxChunks, &info);
+        return true;
+    }
+#endif
+    SOR_RelaxChunks (0,0,&info);
+    return true;
+}
+
 static void SOR_LCP (dxWorldProcessMemArena *memarena,
                      const unsigned int m, const unsigned int nb, dReal *J, int *jb, dxBody * const *body,
                      const dReal *invI, dReal *lambda, dReal *fc, dReal *b,
                      const dReal *lo, const dReal *hi, const dReal *cfm, const int *findex,
-                     const dxQuickStepParameters *qs)
+                     const dxQuickStepParameters *qs, unsigned long *random_seed)
 {
-#ifdef WARM_STARTING
-    {
-        // for warm starting, this seems to be necessary to prevent
-        // jerkiness in motor-driven joints. i have no idea why this works.
-        for (unsigned int i=0; i<m; i++) lambda[i] *= 0.9;
-    }
-#else
-    dSetZero (lambda,m);
-#endif
+    // when warm starting, lambda holds the impulses of the previous step,
+    // already scaled by qs->warm_starting
+    const bool warm_starting = qs->warm_starting > 0;
+    if (!warm_starting)
+        dSetZero (lambda,m);
 
     // precompute iMJ = inv(M)*J'
     dReal *iMJ = memarena->AllocateArray<dReal>((size_t)m*12);
@@ -364,11 +555,10 @@ static void SOR_LCP (dxWorldProcessMemArena *memarena,
 
     // compute fc=(inv(M)*J')*lambda. we will incrementally maintain fc
     // as we change lambda.
-#ifdef WARM_STARTING
-    multiply_invM_JT (m,nb,iMJ,jb,lambda,fc);
-#else
-    dSetZero (fc,(size_t)nb*6);
-#endif
+    if (warm_starting)
+        multiply_invM_JT (m,nb,iMJ,jb,lambda,fc);
+    else
+        dSetZero (fc,(size_t)nb*6);
 
     dReal *Ad = memarena->AllocateArray<dReal>(m);
 
@@ -404,6 +594,20 @@ static void SOR_LCP (dxWorldProcessMemArena *memarena,
         }
     }
 
+    dxSORRows rows;
+    rows.J = J; rows.iMJ = iMJ; rows.b = b; rows.Ad = Ad; rows.lo = lo; rows.hi = hi;
+    rows.jb = jb; rows.findex = findex;
+    rows.lambda = lambda; rows.fc = fc;
+
+    if (qs->num_threads > 1 || qs->deterministic) {
+        bool relaxed;
+        BEGIN_STATE_SAVE(memarena, colouredstate) {
+            relaxed = SOR_ColouredSweeps (memarena,m,nb,rows,qs);
+        } END_STATE_SAVE(memarena, colouredstate);
+        if (relaxed)
+            return;
+    }
+
     // order to solve constraint rows in
     IndexError *order = memarena->AllocateArray<IndexError>(m);
     unsigned int head_size;
@@ -434,6 +638,7 @@ static void SOR_LCP (dxWorldProcessMemArena *memarena,
     dReal *last_lambda = memarena->AllocateArray<dReal>(m);
 #endif
 
+    dxSORRelaxFunction *relax = dxGetSORKernels()->relax;
     const unsigned int num_iterations = qs->num_iterations;
     for (unsigned int iteration=0; iteration < num_iterations; iteration++) {
 
@@ -482,14 +687,14 @@ static void SOR_LCP (dxWorldProcessMemArena *memarena,
 #ifdef RANDOMLY_REORDER_CONSTRAINTS
         if ((iteration & 7) == 0) {
             for (unsigned int i=1; i<head_size; i++) {
-                int swapi = dRandInt(i+1);
+                int swapi = random_seed ? dRandIntFromSeed(random_seed,i+1) : dRandInt(i+1);
                 IndexError tmp = order[i];
                 order[i] = order[swapi];
                 order[swapi] = tmp;
             }
             unsigned int tail_size = m - head_size;
             for (unsigned int j=1; j<tail_size; j++) {
-                int swapj = dRandInt(j+1);
+                int swapj = random_seed ? dRandIntFromSeed(random_seed,j+1) : dRandInt(j+1);
                 IndexError tmp = order[head_size + j];
                 order[head_size + j] = order[head_size + swapj];
                 order[head_size + swapj] = tmp;
@@ -497,105 +702,11 @@ static void SOR_LCP (dxWorldProcessMemArena *memarena,
         }
 #endif
 
-        for (unsigned int i=0; i<m; i++) {
-            // @@@ potential optimization: we could pre-sort J and iMJ, thereby
-            //     linearizing access to those arrays. hmmm, this does not seem
-            //     like a win, but we should think carefully about our memory
-            //     access pattern.
-
-            unsigned int index = order[i].index;
-
-            dReal *fc_ptr1;
-            dReal *fc_ptr2;
-            dReal delta;
-
-            {
-                int b1 = jb[(size_t)index*2];
-                int b2 = jb[(size_t)index*2+1];
-                fc_ptr1 = fc + 6*(size_t)(unsigned)b1;
-                fc_ptr2 = (b2 != -1) ? fc + 6*(size_t)(unsigned)b2 : NULL;
-            }
-
-            dReal old_lambda = lambda[index];
-
-            {
-                delta = b[index] - old_lambda*Ad[index];
-
-                const dReal *J_ptr = J + (size_t)index*12;
-                // @@@ potential optimization: SIMD-ize this and the b2 >= 0 case
-                delta -=fc_ptr1[0] * J_ptr[0] + fc_ptr1[1] * J_ptr[1] +
-                    fc_ptr1[2] * J_ptr[2] + fc_ptr1[3] * J_ptr[3] +
-                    fc_ptr1[4] * J_ptr[4] + fc_ptr1[5] * J_ptr[5];
-                // @@@ potential optimization: handle 1-body constraints in a separate
-                //     loop to avoid the cost of test & jump?
-                if (fc_ptr2) {
-                    delta -=fc_ptr2[0] * J_ptr[6] + fc_ptr2[1] * J_ptr[7] +
-                        fc_ptr2[2] * J_ptr[8] + fc_ptr2[3] * J_ptr[9] +
-                        fc_ptr2[4] * J_ptr[10] + fc_ptr2[5] * J_ptr[11];
-                }
-            }
-
-            {
-                dReal hi_act, lo_act;
-
-                // set the limits for this constraint.
-                // this is the place where the QuickStep method differs from the
-                // direct LCP solving method, since that method only performs this
-                // limit adjustment once per time step, whereas this method performs
-                // once per iteration per constraint row.
-                // the constraints are ordered so that all lambda[] values needed have
-                // already been computed.
-                if (findex[index] != -1) {
-                    hi_act = dFabs (hi[index] * lambda[findex[index]]);
-                    lo_act = -hi_act;
-                } else {
-                    hi_act = hi[index];
-                    lo_act = lo[index];
-                }
-
-                // compute lambda and clamp it to [lo,hi].
-                // @@@ potential optimization: does SSE have clamping instructions
-                //     to save test+jump penalties here?
-                dReal new_lambda = old_lambda + delta;
-                if (new_lambda < lo_act) {
-                    delta = lo_act-old_lambda;
-                    lambda[index] = lo_act;
-                }
-                else if (new_lambda > hi_act) {
-                    delta = hi_act-old_lambda;
-                    lambda[index] = hi_act;
-                }
-                else {
-                    lambda[index] = new_lambda;
-                }
-            }
-
-            //@@@ a trick that may or may not help
-            //dReal ramp = (1-((dReal)(iteration+1)/(dReal)num_iterations));
-            //delta *= ramp;
-
-            {
-                const dReal *iMJ_ptr = iMJ + (size_t)index*12;
-                // update fc.
-                // @@@ potential optimization: SIMD for this and the b2 >= 0 case
-                fc_ptr1[0] += delta * iMJ_ptr[0];
-                fc_ptr1[1] += delta * iMJ_ptr[1];
-                fc_ptr1[2] += delta * iMJ_ptr[2];
-                fc_ptr1[3] += delta * iMJ_ptr[3];
-                fc_ptr1[4] += delta * iMJ_ptr[4];
-                fc_ptr1[5] += delta * iMJ_ptr[5];
-                // @@@ potential optimization: handle 1-body constraints in a separate
-                //     loop to avoid the cost of test & jump?
-                if (fc_ptr2) {
-                    fc_ptr2[0] += delta * iMJ_ptr[6];
-                    fc_ptr2[1] += delta * iMJ_ptr[7];
-                    fc_ptr2[2] += delta * iMJ_ptr[8];
-                    fc_ptr2[3] += delta * iMJ_ptr[9];
-                    fc_ptr2[4] += delta * iMJ_ptr[10];
-                    fc_ptr2[5] += delta * iMJ_ptr[11];
-                }
-            }
-        }
+        // @@@ potential optimization: we could pre-sort J and iMJ, thereby
+        //     linearizing access to those arrays. hmmm, this does not seem
+        //     like a win, but we should think carefully about our memory
+        //     access pattern.
+        relax (rows,&order[0].index,sizeof(IndexError)/sizeof(int),0,m);
     }
 }
 
@@ -869,33 +980,42 @@ void dxQuickStepper (dxWorldProcessMemArena *memarena,
     // load lambda from the value saved on the previous iteration
     dReal *lambda = memarena->AllocateArray<dReal> (m);
 
-#ifdef WARM_STARTING
-    {
+    const dReal warm_starting = world->qs.warm_starting;
+    if (warm_starting > 0) {
+      // contact joints are recreated at every step, their previous impulses
+      // are retrieved from the world contact cache
+      const dxContactCache *cache = world->contact_cache;
       dReal *lambdscurr = lambda;
       const dJointWithInfo1 *jicurr = jointiinfos;
       const dJointWithInfo1 *const jiend = jicurr + nj;
       for (; jicurr != jiend; jicurr++) {
+        dxJoint *joint = jicurr->joint;
         unsigned int infom = jicurr->info.m;
-        memcpy (lambdscurr, jicurr->joint->lambda, (size_t)infom * sizeof(dReal));
+        if (joint->type() == dJointTypeContact) {
+          if (!cache || !cache->lookup (((dxJointContact *)joint)->contact.geom, infom, lambdscurr))
+            dSetZero (lambdscurr, infom);
+        }
+        else
+          memcpy (lambdscurr, joint->lambda, (size_t)infom * sizeof(dReal));
+        // scaling down the previous impulses prevents jerkiness in motor-driven joints
+        for (unsigned int i=0; i<infom; i++) lambdscurr[i] *= warm_starting;
         lambdscurr += infom;
       }
     }
-#endif
 
         dReal *cforce = memarena->AllocateArray<dReal>((size_t)nb*6);
 
         BEGIN_STATE_SAVE(memarena, lcpstate) {
             IFTIMING (dTimerNow ("solving LCP problem"));
             // solve the LCP problem and get lambda and invM*constraint_force
-            SOR_LCP (memarena,m,nb,J,jb,body,invI,lambda,cforce,rhs,lo,hi,cfm,findex,&world->qs);
+            SOR_LCP (memarena,m,nb,J,jb,body,invI,lambda,cforce,rhs,lo,hi,cfm,findex,&world->qs,
+                     world->own_random_seed ? &world->random_seed : NULL);
 
         } END_STATE_SAVE(memarena, lcpstate);
 
-#ifdef WARM_STARTING
-        {
-            // save lambda for the next iteration
-            //@@@ note that this doesn't work for contact joints yet, as they are
-            // recreated every iteration
+        if (warm_starting > 0) {
+            // save lambda for the next iteration, the lambda of contact joints
+            // are moved to the contact cache at the end of the step
             const dReal *lambdacurr = lambda;
             const dJointWithInfo1 *jicurr = jointiinfos;
             const dJointWithInfo1 *const jiend = jicurr + nj;
@@ -905,7 +1025,6 @@ void dxQuickStepper (dxWorldProcessMemArena *memarena,
                 lambdacurr += infom;
             }
         }
-#endif
 
         // note that the SOR method overwrites rhs and J at this point, so
         // they should not be used again.
@@ -1041,14 +1160,16 @@ static size_t EstimateGR_LCPMemoryRequirements(unsigned int m)
 }
 #endif
 
-static size_t EstimateSOR_LCPMemoryRequirements(unsigned int m)
+static size_t EstimateSOR_LCPMemoryRequirements(unsigned int m, unsigned int nb)
 {
     size_t res = dEFFICIENT_SIZE(sizeof(dReal) * 12 * (size_t)m); // for iMJ
     res += dEFFICIENT_SIZE(sizeof(dReal) * (size_t)m); // for Ad
-    res += dEFFICIENT_SIZE(sizeof(IndexError) * (size_t)m); // for order
+    size_t sub1_res1 = dEFFICIENT_SIZE(sizeof(IndexError) * (size_t)m); // for order
 #ifdef REORDER_CONSTRAINTS
-    res += dEFFICIENT_SIZE(sizeof(dReal) * (size_t)m); // for last_lambda
+    sub1_res1 += dEFFICIENT_SIZE(sizeof(dReal) * (size_t)m); // for last_lambda
 #endif
+    size_t sub1_res2 = EstimateSOR_ColouredMemoryRequirements(m, nb); // for the coloured sweeps
+    res += (sub1_res1 >= sub1_res2) ? sub1_res1 : sub1_res2;
     return res;
 }
 
@@ -1108,7 +1229,7 @@ size_t dxEstimateQuickStepMemoryRequirements (dxBody * const *body,
                 size_t sub2_res2 = dEFFICIENT_SIZE(sizeof(dReal) * (size_t)m); // for lambda
                 sub2_res2 += dEFFICIENT_SIZE(sizeof(dReal) * 6 * (size_t)nb); // for cforce
                 {
-                    size_t sub3_res1 = EstimateSOR_LCPMemoryRequirements(m); // for SOR_LCP
+                    size_t sub3_res1 = EstimateSOR_LCPMemoryRequirements(m, nb); // for SOR_LCP
 
                     size_t sub3_res2 = 0;
 #ifdef CHECK_VELOCITY_OBEYS_CONSTRAINT
@@ -0,0 +1,445 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include <ode/common.h>
+#include "config.h"
+#include "sor_kernels.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// the vectorised kernels exist in double and single precision. in single
+// precision, a 6 vector fits in a quadruple and a pair, or in a masked octuple
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SOR_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define SOR_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// compute lambda[index] + delta, clamp it to its limits and return the applied delta
+static inline dReal SOR_ClampRow (const dxSORRows &rows, unsigned int index, dReal delta)
+{
+    dReal hi_act, lo_act;
+
+    // set the limits for this constraint.
+    // this is the place where the QuickStep method differs from the
+    // direct LCP solving method, since that method only performs this
+    // limit adjustment once per time step, whereas this method performs
+    // once per iteration per constraint row.
+    // the constraints are ordered so that all lambda[] values needed have
+    // already been computed.
+    const int findex = rows.findex[index];
+    if (findex != -1) {
+        hi_act = dFabs (rows.hi[index] * rows.lambda[findex]);
+        lo_act = -hi_act;
+    } else {
+        hi_act = rows.hi[index];
+        lo_act = rows.lo[index];
+    }
+
+    // compute lambda and clamp it to [lo,hi].
+    const dReal old_lambda = rows.lambda[index];
+    const dReal new_lambda = old_lambda + delta;
+    if (new_lambda < lo_act) {
+        delta = lo_act-old_lambda;
+        rows.lambda[index] = lo_act;
+    }
+    else if (new_lambda > hi_act) {
+        delta = hi_act-old_lambda;
+        rows.lambda[index] = hi_act;
+    }
+    else {
+        rows.lambda[index] = new_lambda;
+    }
+    return delta;
+}
+
+//****************************************************************************
+// scalar kernels
+
+static void SOR_RelaxScalar (const dxSORRows &rows, const int *index, size_t stride,
+                             unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+
+        dReal *fc_ptr1;
+        dReal *fc_ptr2;
+        {
+            int b1 = rows.jb[(size_t)i*2];
+            int b2 = rows.jb[(size_t)i*2+1];
+            fc_ptr1 = rows.fc + 6*(size_t)(unsigned)b1;
+            fc_ptr2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        }
+
+        dReal delta = rows.b[i] - rows.lambda[i]*rows.Ad[i];
+        {
+            const dReal *J_ptr = rows.J + (size_t)i*12;
+            delta -=fc_ptr1[0] * J_ptr[0] + fc_ptr1[1] * J_ptr[1] +
+                fc_ptr1[2] * J_ptr[2] + fc_ptr1[3] * J_ptr[3] +
+                fc_ptr1[4] * J_ptr[4] + fc_ptr1[5] * J_ptr[5];
+            // @@@ potential optimization: handle 1-body constraints in a separate
+            //     loop to avoid the cost of test & jump?
+            if (fc_ptr2) {
+                delta -=fc_ptr2[0] * J_ptr[6] + fc_ptr2[1] * J_ptr[7] +
+                    fc_ptr2[2] * J_ptr[8] + fc_ptr2[3] * J_ptr[9] +
+                    fc_ptr2[4] * J_ptr[10] + fc_ptr2[5] * J_ptr[11];
+            }
+        }
+
+        delta = SOR_ClampRow (rows, i, delta);
+
+        {
+            const dReal *iMJ_ptr = rows.iMJ + (size_t)i*12;
+            // update fc.
+            fc_ptr1[0] += delta * iMJ_ptr[0];
+            fc_ptr1[1] += delta * iMJ_ptr[1];
+            fc_ptr1[2] += delta * iMJ_ptr[2];
+            fc_ptr1[3] += delta * iMJ_ptr[3];
+            fc_ptr1[4] += delta * iMJ_ptr[4];
+            fc_ptr1[5] += delta * iMJ_ptr[5];
+            if (fc_ptr2) {
+                fc_ptr2[0] += delta * iMJ_ptr[6];
+                fc_ptr2[1] += delta * iMJ_ptr[7];
+                fc_ptr2[2] += delta * iMJ_ptr[8];
+                fc_ptr2[3] += delta * iMJ_ptr[9];
+                fc_ptr2[4] += delta * iMJ_ptr[10];
+                fc_ptr2[5] += delta * iMJ_ptr[11];
+            }
+        }
+    }
+}
+
+static const dxSORKernels scalarKernels = { "scalar", &SOR_RelaxScalar };
+
+#if defined(SOR_KERNELS_X86) && defined(dDOUBLE)
+
+//****************************************************************************
+// SSE2 kernels: a 6 vector is processed as three pairs
+
+__attribute__((target("sse2")))
+static void SOR_RelaxSSE2 (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        double *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        double *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const double *J = rows.J + (size_t)i*12;
+
+        __m128d sum = _mm_add_pd (_mm_add_pd (_mm_mul_pd (_mm_loadu_pd (fc1), _mm_loadu_pd (J)),
+                                              _mm_mul_pd (_mm_loadu_pd (fc1 + 2), _mm_loadu_pd (J + 2))),
+                                  _mm_mul_pd (_mm_loadu_pd (fc1 + 4), _mm_loadu_pd (J + 4)));
+        if (fc2) {
+            sum = _mm_add_pd (sum, _mm_add_pd (_mm_add_pd (_mm_mul_pd (_mm_loadu_pd (fc2), _mm_loadu_pd (J + 6)),
+                                                           _mm_mul_pd (_mm_loadu_pd (fc2 + 2), _mm_loadu_pd (J + 8))),
+                                               _mm_mul_pd (_mm_loadu_pd (fc2 + 4), _mm_loadu_pd (J + 10))));
+        }
+        const double dot = _mm_cvtsd_f64 (_mm_add_sd (sum, _mm_unpackhi_pd (sum, sum)));
+
+        const double delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const __m128d d = _mm_set1_pd (delta);
+        const double *iMJ = rows.iMJ + (size_t)i*12;
+        _mm_storeu_pd (fc1, _mm_add_pd (_mm_loadu_pd (fc1), _mm_mul_pd (d, _mm_loadu_pd (iMJ))));
+        _mm_storeu_pd (fc1 + 2, _mm_add_pd (_mm_loadu_pd (fc1 + 2), _mm_mul_pd (d, _mm_loadu_pd (iMJ + 2))));
+        _mm_storeu_pd (fc1 + 4, _mm_add_pd (_mm_loadu_pd (fc1 + 4), _mm_mul_pd (d, _mm_loadu_pd (iMJ + 4))));
+        if (fc2) {
+            _mm_storeu_pd (fc2, _mm_add_pd (_mm_loadu_pd (fc2), _mm_mul_pd (d, _mm_loadu_pd (iMJ + 6))));
+            _mm_storeu_pd (fc2 + 2, _mm_add_pd (_mm_loadu_pd (fc2 + 2), _mm_mul_pd (d, _mm_loadu_pd (iMJ + 8))));
+            _mm_storeu_pd (fc2 + 4, _mm_add_pd (_mm_loadu_pd (fc2 + 4), _mm_mul_pd (d, _mm_loadu_pd (iMJ + 10))));
+        }
+    }
+}
+
+static const dxSORKernels sse2Kernels = { "sse2", &SOR_RelaxSSE2 };
+
+//****************************************************************************
+// AVX2 kernels: a 6 vector is processed as a quadruple and a pair, with FMA
+
+__attribute__((target("avx2,fma")))
+static void SOR_RelaxAVX2 (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        double *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        double *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const double *J = rows.J + (size_t)i*12;
+
+        __m256d sum4 = _mm256_mul_pd (_mm256_loadu_pd (fc1), _mm256_loadu_pd (J));
+        __m128d sum2 = _mm_mul_pd (_mm_loadu_pd (fc1 + 4), _mm_loadu_pd (J + 4));
+        if (fc2) {
+            sum4 = _mm256_fmadd_pd (_mm256_loadu_pd (fc2), _mm256_loadu_pd (J + 6), sum4);
+            sum2 = _mm_fmadd_pd (_mm_loadu_pd (fc2 + 4), _mm_loadu_pd (J + 10), sum2);
+        }
+        __m128d sum = _mm_add_pd (_mm_add_pd (_mm256_castpd256_pd128 (sum4), _mm256_extractf128_pd (sum4, 1)), sum2);
+        const double dot = _mm_cvtsd_f64 (_mm_add_sd (sum, _mm_unpackhi_pd (sum, sum)));
+
+        const double delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const double *iMJ = rows.iMJ + (size_t)i*12;
+        const __m256d d4 = _mm256_set1_pd (delta);
+        const __m128d d2 = _mm_set1_pd (delta);
+        _mm256_storeu_pd (fc1, _mm256_fmadd_pd (d4, _mm256_loadu_pd (iMJ), _mm256_loadu_pd (fc1)));
+        _mm_storeu_pd (fc1 + 4, _mm_fmadd_pd (d2, _mm_loadu_pd (iMJ + 4), _mm_loadu_pd (fc1 + 4)));
+        if (fc2) {
+            _mm256_storeu_pd (fc2, _mm256_fmadd_pd (d4, _mm256_loadu_pd (iMJ + 6), _mm256_loadu_pd (fc2)));
+            _mm_storeu_pd (fc2 + 4, _mm_fmadd_pd (d2, _mm_loadu_pd (iMJ + 10), _mm_loadu_pd (fc2 + 4)));
+        }
+    }
+}
+
+static const dxSORKernels avx2Kernels = { "avx2", &SOR_RelaxAVX2 };
+
+#endif
+
+#if defined(SOR_KERNELS_X86) && defined(dSINGLE)
+
+//****************************************************************************
+// SSE2 kernels: a 6 vector is processed as a quadruple and a pair
+
+__attribute__((target("sse2")))
+static inline __m128 SOR_LoadPairSSE2 (const float *p)
+{
+    return _mm_loadl_pi (_mm_setzero_ps (), (const __m64 *)p);
+}
+
+__attribute__((target("sse2")))
+static inline void SOR_StorePairSSE2 (float *p, __m128 v)
+{
+    _mm_storel_pi ((__m64 *)p, v);
+}
+
+__attribute__((target("sse2")))
+static void SOR_RelaxSSE2 (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        float *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        float *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const float *J = rows.J + (size_t)i*12;
+
+        __m128 sum4 = _mm_mul_ps (_mm_loadu_ps (fc1), _mm_loadu_ps (J));
+        __m128 sum2 = _mm_mul_ps (SOR_LoadPairSSE2 (fc1 + 4), SOR_LoadPairSSE2 (J + 4));
+        if (fc2) {
+            sum4 = _mm_add_ps (sum4, _mm_mul_ps (_mm_loadu_ps (fc2), _mm_loadu_ps (J + 6)));
+            sum2 = _mm_add_ps (sum2, _mm_mul_ps (SOR_LoadPairSSE2 (fc2 + 4), SOR_LoadPairSSE2 (J + 10)));
+        }
+        // the two upper elements of sum2 are zero
+        __m128 sum = _mm_add_ps (sum4, sum2);
+        sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+        const float dot = _mm_cvtss_f32 (_mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1)));
+
+        const float delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const __m128 d = _mm_set1_ps (delta);
+        const float *iMJ = rows.iMJ + (size_t)i*12;
+        _mm_storeu_ps (fc1, _mm_add_ps (_mm_loadu_ps (fc1), _mm_mul_ps (d, _mm_loadu_ps (iMJ))));
+        SOR_StorePairSSE2 (fc1 + 4, _mm_add_ps (SOR_LoadPairSSE2 (fc1 + 4), _mm_mul_ps (d, SOR_LoadPairSSE2 (iMJ + 4))));
+        if (fc2) {
+            _mm_storeu_ps (fc2, _mm_add_ps (_mm_loadu_ps (fc2), _mm_mul_ps (d, _mm_loadu_ps (iMJ + 6))));
+            SOR_StorePairSSE2 (fc2 + 4, _mm_add_ps (SOR_LoadPairSSE2 (fc2 + 4), _mm_mul_ps (d, SOR_LoadPairSSE2 (iMJ + 10))));
+        }
+    }
+}
+
+static const dxSORKernels sse2Kernels = { "sse2", &SOR_RelaxSSE2 };
+
+//****************************************************************************
+// AVX2 kernels: a 6 vector is processed as a quadruple and a pair, with FMA.
+// masked octuples are slower because of the masked stores
+
+__attribute__((target("avx2,fma")))
+static void SOR_RelaxAVX2 (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        float *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        float *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const float *J = rows.J + (size_t)i*12;
+
+        __m128 sum4 = _mm_mul_ps (_mm_loadu_ps (fc1), _mm_loadu_ps (J));
+        __m128 sum2 = _mm_mul_ps (SOR_LoadPairSSE2 (fc1 + 4), SOR_LoadPairSSE2 (J + 4));
+        if (fc2) {
+            sum4 = _mm_fmadd_ps (_mm_loadu_ps (fc2), _mm_loadu_ps (J + 6), sum4);
+            sum2 = _mm_fmadd_ps (SOR_LoadPairSSE2 (fc2 + 4), SOR_LoadPairSSE2 (J + 10), sum2);
+        }
+        __m128 sum = _mm_add_ps (sum4, sum2);
+        sum = _mm_add_ps (sum, _mm_movehl_ps (sum, sum));
+        const float dot = _mm_cvtss_f32 (_mm_add_ss (sum, _mm_shuffle_ps (sum, sum, 1)));
+
+        const float delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const float *iMJ = rows.iMJ + (size_t)i*12;
+        const __m128 d = _mm_set1_ps (delta);
+        _mm_storeu_ps (fc1, _mm_fmadd_ps (d, _mm_loadu_ps (iMJ), _mm_loadu_ps (fc1)));
+        SOR_StorePairSSE2 (fc1 + 4, _mm_fmadd_ps (d, SOR_LoadPairSSE2 (iMJ + 4), SOR_LoadPairSSE2 (fc1 + 4)));
+        if (fc2) {
+            _mm_storeu_ps (fc2, _mm_fmadd_ps (d, _mm_loadu_ps (iMJ + 6), _mm_loadu_ps (fc2)));
+            SOR_StorePairSSE2 (fc2 + 4, _mm_fmadd_ps (d, SOR_LoadPairSSE2 (iMJ + 10), SOR_LoadPairSSE2 (fc2 + 4)));
+        }
+    }
+}
+
+static const dxSORKernels avx2Kernels = { "avx2", &SOR_RelaxAVX2 };
+
+#endif
+
+#if defined(SOR_KERNELS_NEON) && defined(dDOUBLE)
+
+//****************************************************************************
+// NEON kernels: a 6 vector is processed as three pairs, with FMA
+
+static void SOR_RelaxNEON (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        double *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        double *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const double *J = rows.J + (size_t)i*12;
+
+        float64x2_t sum = vmulq_f64 (vld1q_f64 (fc1), vld1q_f64 (J));
+        sum = vfmaq_f64 (sum, vld1q_f64 (fc1 + 2), vld1q_f64 (J + 2));
+        sum = vfmaq_f64 (sum, vld1q_f64 (fc1 + 4), vld1q_f64 (J + 4));
+        if (fc2) {
+            sum = vfmaq_f64 (sum, vld1q_f64 (fc2), vld1q_f64 (J + 6));
+            sum = vfmaq_f64 (sum, vld1q_f64 (fc2 + 2), vld1q_f64 (J + 8));
+            sum = vfmaq_f64 (sum, vld1q_f64 (fc2 + 4), vld1q_f64 (J + 10));
+        }
+        const double dot = vaddvq_f64 (sum);
+
+        const double delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const double *iMJ = rows.iMJ + (size_t)i*12;
+        const float64x2_t d = vdupq_n_f64 (delta);
+        vst1q_f64 (fc1, vfmaq_f64 (vld1q_f64 (fc1), d, vld1q_f64 (iMJ)));
+        vst1q_f64 (fc1 + 2, vfmaq_f64 (vld1q_f64 (fc1 + 2), d, vld1q_f64 (iMJ + 2)));
+        vst1q_f64 (fc1 + 4, vfmaq_f64 (vld1q_f64 (fc1 + 4), d, vld1q_f64 (iMJ + 4)));
+        if (fc2) {
+            vst1q_f64 (fc2, vfmaq_f64 (vld1q_f64 (fc2), d, vld1q_f64 (iMJ + 6)));
+            vst1q_f64 (fc2 + 2, vfmaq_f64 (vld1q_f64 (fc2 + 2), d, vld1q_f64 (iMJ + 8)));
+            vst1q_f64 (fc2 + 4, vfmaq_f64 (vld1q_f64 (fc2 + 4), d, vld1q_f64 (iMJ + 10)));
+        }
+    }
+}
+
+static const dxSORKernels neonKernels = { "neon", &SOR_RelaxNEON };
+
+#endif
+
+#if defined(SOR_KERNELS_NEON) && defined(dSINGLE)
+
+//****************************************************************************
+// NEON kernels: a 6 vector is processed as a quadruple and a pair, with FMA
+
+static void SOR_RelaxNEON (const dxSORRows &rows, const int *index, size_t stride,
+                           unsigned int first, unsigned int count)
+{
+    for (unsigned int k=0; k<count; k++) {
+        const unsigned int i = index ? (unsigned int)index[k*stride] : first + k;
+        const int b2 = rows.jb[(size_t)i*2+1];
+        float *fc1 = rows.fc + 6*(size_t)(unsigned)rows.jb[(size_t)i*2];
+        float *fc2 = (b2 != -1) ? rows.fc + 6*(size_t)(unsigned)b2 : NULL;
+        const float *J = rows.J + (size_t)i*12;
+
+        float32x4_t sum4 = vmulq_f32 (vld1q_f32 (fc1), vld1q_f32 (J));
+        float32x2_t sum2 = vmul_f32 (vld1_f32 (fc1 + 4), vld1_f32 (J + 4));
+        if (fc2) {
+            sum4 = vfmaq_f32 (sum4, vld1q_f32 (fc2), vld1q_f32 (J + 6));
+            sum2 = vfma_f32 (sum2, vld1_f32 (fc2 + 4), vld1_f32 (J + 10));
+        }
+        const float dot = vaddvq_f32 (sum4) + vaddv_f32 (sum2);
+
+        const float delta = SOR_ClampRow (rows, i, rows.b[i] - rows.lambda[i]*rows.Ad[i] - dot);
+
+        const float *iMJ = rows.iMJ + (size_t)i*12;
+        const float32x4_t d4 = vdupq_n_f32 (delta);
+        const float32x2_t d2 = vdup_n_f32 (delta);
+        vst1q_f32 (fc1, vfmaq_f32 (vld1q_f32 (fc1), d4, vld1q_f32 (iMJ)));
+        vst1_f32 (fc1 + 4, vfma_f32 (vld1_f32 (fc1 + 4), d2, vld1_f32 (iMJ + 4)));
+        if (fc2) {
+            vst1q_f32 (fc2, vfmaq_f32 (vld1q_f32 (fc2), d4, vld1q_f32 (iMJ + 6)));
+            vst1_f32 (fc2 + 4, vfma_f32 (vld1_f32 (fc2 + 4), d2, vld1_f32 (iMJ + 10)));
+        }
+    }
+}
+
+static const dxSORKernels neonKernels = { "neon", &SOR_RelaxNEON };
+
+#endif
+
+//****************************************************************************
+// dispatch
+
+const dxSORKernels *dxGetSORKernels (const char *name)
+{
+    if (strcmp (name, "scalar") == 0)
+        return &scalarKernels;
+#ifdef SOR_KERNELS_X86
+    if (strcmp (name, "sse2") == 0 && __builtin_cpu_supports ("sse2"))
+        return &sse2Kernels;
+    if (strcmp (name, "avx2") == 0 && __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+        return &avx2Kernels;
+#endif
+#ifdef SOR_KERNELS_NEON
+    if (strcmp (name, "neon") == 0)
+        return &neonKernels;
+#endif
+    return NULL;
+}
+
+static const dxSORKernels *SelectSORKernels ()
+{
+    const char *forced = getenv ("ODE_SIMD");
+    if (forced) {
+        const dxSORKernels *kernels = dxGetSORKernels (forced);
+        if (kernels)
+            return kernels;
+    }
+
+    static const char *const preferred[] = { "avx2", "neon", "sse2" };
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+        const dxSORKernels *kernels = dxGetSORKernels (preferred[i]);
+        if (kernels)
+            return kernels;
+    }
+    return &scalarKernels;
+}
+
+const dxSORKernels *dxGetSORKernels ()
+{
+    static const dxSORKernels *const kernels = SelectSORKernels ();
+    return kernels;
+}
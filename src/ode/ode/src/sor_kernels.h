@@ -0,0 +1,61 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_SOR_KERNELS_H_
+#define _ODE_SOR_KERNELS_H_
+
+#include <ode/common.h>
+
+// constraint rows of the SOR-LCP method, J and b already scaled by Ad,
+// see SOR_LCP() in quickstep.cpp
+
+struct dxSORRows {
+    const dReal *J;       // m*12 jacobian, two 6 blocks per row
+    const dReal *iMJ;     // m*12 inv(M)*J'
+    const dReal *b;
+    const dReal *Ad;      // cfm scaled by the inverse diagonal of A
+    const dReal *lo, *hi;
+    const int *jb;        // m*2 body indices, the second one is -1 for single body rows
+    const int *findex;
+    dReal *lambda;
+    dReal *fc;            // nb*6 inv(M)*J'*lambda
+};
+
+// relax 'count' rows and update lambda and fc accordingly. the rows are
+// index[0], index[stride], ... or first, first+1, ... if index is NULL
+typedef void dxSORRelaxFunction (const dxSORRows &rows, const int *index, size_t stride,
+                                 unsigned int first, unsigned int count);
+
+struct dxSORKernels {
+    const char *name;
+    dxSORRelaxFunction *relax;
+};
+
+// kernels of the best instruction set supported by the processor, selected
+// at the first call. the ODE_SIMD environment variable (scalar, sse2, avx2
+// or neon) forces a given instruction set if it is supported
+const dxSORKernels *dxGetSORKernels ();
+
+// kernels of a given instruction set, NULL if it is not supported
+const dxSORKernels *dxGetSORKernels (const char *name);
+
+#endif
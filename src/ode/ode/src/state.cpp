@@ -0,0 +1,420 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+// in-memory copy of the dynamic state of a world, see dWorldSaveState
+
+#include <algorithm>
+#include <vector>
+#include <ode/odemath.h>
+#include <ode/misc.h>
+#include <ode/objects.h>
+#include <ode/collision.h>
+#include "config.h"
+#include "objects.h"
+#include "collision_kernel.h"
+#include "contact_cache.h"
+#include "joints/joint.h"
+
+#define STATE_MAGIC 0x4f444553  // "ODES"
+
+// the same function computes the size of the state and writes it: nothing is
+// copied while the buffer is NULL
+struct dxStateWriter
+{
+    char *buffer;
+    size_t size;
+
+    template<class T> void put(const T *values, size_t count = 1)
+    {
+        if (buffer)
+            memcpy(buffer + size, values, count * sizeof(T));
+        size += count * sizeof(T);
+    }
+};
+
+// nothing is copied while 'apply' is false, the state is only checked
+struct dxStateReader
+{
+    const char *buffer;
+    size_t size;
+    size_t position;
+    bool apply;
+
+    bool skip(size_t bytes)
+    {
+        if (position + bytes > size)
+            return false;
+        position += bytes;
+        return true;
+    }
+
+    template<class T> bool get(T *values, size_t count = 1)
+    {
+        if (position + count * sizeof(T) > size)
+            return false;
+        if (apply)
+            memcpy(values, buffer + position, count * sizeof(T));
+        position += count * sizeof(T);
+        return true;
+    }
+
+    // read a value which has to be checked even if it is not applied
+    template<class T> bool read(T &value)
+    {
+        if (position + sizeof(T) > size)
+            return false;
+        memcpy(&value, buffer + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+};
+
+// the contact joints are created again by the collision detection, the other
+// joints are saved with their first body
+static bool isSavedJoint(const dxJoint *j, const dxBody *b)
+{
+    return j->node[0].body == b && j->type() != dJointTypeContact;
+}
+
+// the members of the joint classes derived from dxJoint are plain values
+static size_t jointParametersOffset(const dxJoint *j)
+{
+    return (const char *)&j->mtTag + sizeof(j->mtTag) - (const char *)j;
+}
+
+// the collision detection reports the pairs in the order of the geoms in their
+// spaces, which depends on the order in which the geoms were moved. The spaces
+// of the geoms of the bodies are sorted from the innermost ones, so that
+// restoring the order of a space is not undone by its sub-spaces.
+static bool isDeeperSpace(const std::pair<int, dxSpace *> &a, const std::pair<int, dxSpace *> &b)
+{
+    return a.first < b.first;
+}
+
+static void getSpaces(dxBody *const *bodies, int count, std::vector<dxSpace *> &spaces)
+{
+    std::vector<std::pair<int, dxSpace *> > depths;
+    for (int i = 0; i < count; i++) {
+        for (dxGeom *geom = bodies[i]->geom; geom; geom = geom->body_next) {
+            for (dxSpace *s = geom->parent_space; s; s = s->parent_space) {
+                bool found = false;
+                for (size_t k = 0; k < depths.size() && !found; k++)
+                    found = depths[k].second == s;
+                if (found)
+                    break;  // its parents were added with it
+                int depth = 0;
+                for (dxSpace *p = s->parent_space; p; p = p->parent_space)
+                    depth--;
+                depths.push_back(std::make_pair(depth, s));
+            }
+        }
+    }
+    std::stable_sort(depths.begin(), depths.end(), isDeeperSpace);
+    spaces.clear();
+    for (size_t k = 0; k < depths.size(); k++)
+        spaces.push_back(depths[k].second);
+}
+
+static void writeSpaces(dxBody *const *bodies, int count, dxStateWriter &writer)
+{
+    std::vector<dxSpace *> spaces;
+    getSpaces(bodies, count, spaces);
+    const unsigned int spaceCount = (unsigned int)spaces.size();
+    writer.put(&spaceCount);
+    for (unsigned int k = 0; k < spaceCount; k++) {
+        dxSpace *s = spaces[k];
+        writer.put(&s);
+        writer.put(&s->count);
+        for (int i = 0; i < s->count; i++) {
+            const dxGeom *geom = s->getGeom(i);
+            writer.put(&geom);
+        }
+    }
+}
+
+// the geoms are removed and added again in the saved order, which also marks
+// them as moved
+static bool readSpaces(dxBody *const *bodies, int count, dxStateReader &reader)
+{
+    std::vector<dxSpace *> spaces;
+    getSpaces(bodies, count, spaces);
+    unsigned int spaceCount;
+    if (!reader.read(spaceCount) || spaceCount != spaces.size())
+        return false;
+    std::vector<dxGeom *> saved, current;
+    for (unsigned int k = 0; k < spaceCount; k++) {
+        dxSpace *s = spaces[k];
+        const dxSpace *savedSpace;
+        int geomCount;
+        if (!reader.read(savedSpace) || savedSpace != s || !reader.read(geomCount) || geomCount != s->count)
+            return false;
+        saved.resize(geomCount);
+        for (int i = 0; i < geomCount; i++) {
+            if (!reader.read(saved[i]))
+                return false;
+        }
+        if (!reader.apply) {
+            // the saved pointers are only compared: the geoms may have been destroyed
+            current.resize(geomCount);
+            for (int i = 0; i < geomCount; i++)
+                current[i] = s->getGeom(i);
+            std::vector<dxGeom *> sorted(saved);
+            std::sort(sorted.begin(), sorted.end());
+            std::sort(current.begin(), current.end());
+            if (sorted != current)
+                return false;
+            continue;
+        }
+        for (int i = 0; i < geomCount; i++)
+            dSpaceRemove(s, saved[i]);
+        // the sweep and prune space appends the added geoms, the other ones insert them first
+        if (s->type == dSweepAndPruneSpaceClass) {
+            for (int i = 0; i < geomCount; i++)
+                dSpaceAdd(s, saved[i]);
+        } else {
+            for (int i = geomCount - 1; i >= 0; i--)
+                dSpaceAdd(s, saved[i]);
+        }
+    }
+    return true;
+}
+
+static void writeState(dxWorld *w, dxBody *const *bodies, int count, dxStateWriter &writer)
+{
+    const unsigned int header[3] = { STATE_MAGIC, (unsigned int)sizeof(dReal), (unsigned int)count };
+    writer.put(header, 3);
+
+    const unsigned char ownRandomSeed = w->own_random_seed ? 1 : 0;
+    const unsigned long globalRandomSeed = dRandGetSeed();
+    writer.put(&ownRandomSeed);
+    writer.put(&w->random_seed);
+    writer.put(&globalRandomSeed);
+    const size_t cacheSize = w->contact_cache ? w->contact_cache->getStateSize() : 0;
+    writer.put(&cacheSize);
+    if (cacheSize > 0) {
+        if (writer.buffer)
+            w->contact_cache->saveState(writer.buffer + writer.size);
+        writer.size += cacheSize;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const dxBody *b = bodies[i];
+        writer.put(&b);
+        writer.put(&b->posr);
+        writer.put(b->q, 4);
+        writer.put(b->lvel, 4);
+        writer.put(b->avel, 4);
+        writer.put(b->facc, 4);
+        writer.put(b->tacc, 4);
+        writer.put(b->kept_facc, 4);
+        writer.put(b->kept_tacc, 4);
+        const unsigned int disabled = b->flags & dxBodyDisabled;
+        writer.put(&disabled);
+        writer.put(&b->adis_timeleft);
+        writer.put(&b->adis_stepsleft);
+        writer.put(&b->average_counter);
+        writer.put(&b->average_ready);
+        const unsigned int samples = b->average_lvel_buffer ? b->adis.average_samples : 0;
+        writer.put(&samples);
+        if (samples > 0) {
+            writer.put(b->average_lvel_buffer, samples);
+            writer.put(b->average_avel_buffer, samples);
+        }
+
+        unsigned int jointCount = 0;
+        for (const dxJointNode *n = b->firstjoint; n; n = n->next) {
+            if (isSavedJoint(n->joint, b))
+                jointCount++;
+        }
+        writer.put(&jointCount);
+        for (const dxJointNode *n = b->firstjoint; n; n = n->next) {
+            const dxJoint *j = n->joint;
+            if (!isSavedJoint(j, b))
+                continue;
+            const int type = j->type();
+            const unsigned int jointDisabled = j->flags & dJOINT_DISABLED;
+            const unsigned char hasFeedback = j->feedback ? 1 : 0;
+            const size_t offset = jointParametersOffset(j);
+            const size_t parametersSize = j->size() - offset;
+            writer.put(&j);
+            writer.put(&type);
+            writer.put(&jointDisabled);
+            writer.put(j->lambda, 6);
+            writer.put(&hasFeedback);
+            if (hasFeedback)
+                writer.put(j->feedback);
+            writer.put(&parametersSize);
+            writer.put((const char *)j + offset, parametersSize);
+        }
+    }
+
+    writeSpaces(bodies, count, writer);
+}
+
+// returns false if the state does not match the bodies and their joints
+static bool readState(dxWorld *w, dxBody *const *bodies, int count, dxStateReader &reader)
+{
+    unsigned int header[3];
+    for (int k = 0; k < 3; k++) {
+        if (!reader.read(header[k]))
+            return false;
+    }
+    if (header[0] != STATE_MAGIC || header[1] != sizeof(dReal) || header[2] != (unsigned int)count)
+        return false;
+
+    unsigned char ownRandomSeed;
+    unsigned long randomSeed, globalRandomSeed;
+    size_t cacheSize;
+    if (!reader.read(ownRandomSeed) || !reader.read(randomSeed) || !reader.read(globalRandomSeed) ||
+        !reader.read(cacheSize) || reader.position + cacheSize > reader.size)
+        return false;
+    if (reader.apply) {
+        w->own_random_seed = ownRandomSeed != 0;
+        w->random_seed = randomSeed;
+        dRandSetSeed(globalRandomSeed);
+        if (cacheSize > 0) {
+            if (!w->contact_cache)
+                w->contact_cache = new dxContactCache;
+            w->contact_cache->loadState(reader.buffer + reader.position, cacheSize);
+        } else if (w->contact_cache) {
+            delete w->contact_cache;
+            w->contact_cache = NULL;
+        }
+    }
+    reader.skip(cacheSize);
+
+    for (int i = 0; i < count; i++) {
+        dxBody *b = bodies[i];
+        const dxBody *savedBody;
+        if (!reader.read(savedBody) || savedBody != b)
+            return false;
+        if (!reader.get(&b->posr) || !reader.get(b->q, 4) || !reader.get(b->lvel, 4) || !reader.get(b->avel, 4) ||
+            !reader.get(b->facc, 4) || !reader.get(b->tacc, 4) || !reader.get(b->kept_facc, 4) ||
+            !reader.get(b->kept_tacc, 4))
+            return false;
+        unsigned int disabled, samples;
+        if (!reader.read(disabled) || !reader.get(&b->adis_timeleft) || !reader.get(&b->adis_stepsleft) ||
+            !reader.get(&b->average_counter) || !reader.get(&b->average_ready) || !reader.read(samples))
+            return false;
+        if (samples != (b->average_lvel_buffer ? b->adis.average_samples : 0))
+            return false;
+        if (samples > 0 && (!reader.get(b->average_lvel_buffer, samples) || !reader.get(b->average_avel_buffer, samples)))
+            return false;
+        if (reader.apply) {
+            b->flags = (b->flags & ~dxBodyDisabled) | (disabled & dxBodyDisabled);
+            for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext(geom))
+                dGeomMoved(geom);
+        }
+
+        unsigned int jointCount;
+        if (!reader.read(jointCount))
+            return false;
+        dxJointNode *n = b->firstjoint;
+        for (unsigned int k = 0; k < jointCount; k++) {
+            while (n && !isSavedJoint(n->joint, b))
+                n = n->next;
+            if (!n)
+                return false;
+            dxJoint *j = n->joint;
+            n = n->next;
+            const dxJoint *savedJoint;
+            int type;
+            unsigned int jointDisabled;
+            if (!reader.read(savedJoint) || savedJoint != j || !reader.read(type) || type != j->type() ||
+                !reader.read(jointDisabled) || !reader.get(j->lambda, 6))
+                return false;
+            unsigned char hasFeedback;
+            if (!reader.read(hasFeedback) || (hasFeedback != 0) != (j->feedback != NULL))
+                return false;
+            if (hasFeedback && !reader.get(j->feedback))
+                return false;
+            const size_t offset = jointParametersOffset(j);
+            size_t parametersSize;
+            if (!reader.read(parametersSize) || parametersSize != j->size() - offset ||
+                !reader.get((char *)j + offset, parametersSize))
+                return false;
+            if (reader.apply)
+                j->flags = (j->flags & ~dJOINT_DISABLED) | (jointDisabled & dJOINT_DISABLED);
+        }
+        while (n && !isSavedJoint(n->joint, b))
+            n = n->next;
+        if (n)
+            return false;  // a joint was attached since the state was saved
+    }
+    return readSpaces(bodies, count, reader) && reader.position == reader.size;
+}
+
+// the bodies of the world if none are given
+static dxBody **getBodies(dxWorld *w, const dBodyID *bodies, int &count)
+{
+    if (bodies) {
+        dUASSERT(count >= 0, "bad body count");
+        return const_cast<dxBody **>(bodies);
+    }
+    count = w->nb;
+    dxBody **list = (dxBody **)dAlloc(count * sizeof(dxBody *));
+    int i = 0;
+    for (dxBody *b = w->firstbody; b; b = (dxBody *)b->next)
+        list[i++] = b;
+    return list;
+}
+
+static void freeBodies(dxBody **list, const dBodyID *bodies, int count)
+{
+    if (!bodies)
+        dFree(list, count * sizeof(dxBody *));
+}
+
+size_t dWorldGetStateSize(dWorldID w, const dBodyID *bodies, int count)
+{
+    dAASSERT(w);
+    dxBody **list = getBodies(w, bodies, count);
+    dxStateWriter writer = { NULL, 0 };
+    writeState(w, list, count, writer);
+    freeBodies(list, bodies, count);
+    return writer.size;
+}
+
+void dWorldSaveState(dWorldID w, const dBodyID *bodies, int count, void *buffer)
+{
+    dAASSERT(w && buffer);
+    dxBody **list = getBodies(w, bodies, count);
+    dxStateWriter writer = { (char *)buffer, 0 };
+    writeState(w, list, count, writer);
+    freeBodies(list, bodies, count);
+}
+
+int dWorldLoadState(dWorldID w, const dBodyID *bodies, int count, const void *buffer, size_t size)
+{
+    dAASSERT(w && buffer);
+    dxBody **list = getBodies(w, bodies, count);
+    // the state is checked before anything is changed
+    dxStateReader reader = { (const char *)buffer, size, 0, false };
+    bool result = readState(w, list, count, reader);
+    if (result) {
+        reader.position = 0;
+        reader.apply = true;
+        result = readState(w, list, count, reader);
+    }
+    freeBodies(list, bodies, count);
+    return result ? 1 : 0;
+}
@@ -31,6 +31,7 @@
 #include "joints/joint.h"
 #include "lcp.h"
 #include "util.h"
+#include "articulation.h"
 
 #include <new>
 
@@ -262,6 +263,9 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
     }
   }
 
+  // find the hinge and slider trees solved in reduced coordinates
+  dxArticulationSet *articulations = dxBuildArticulations (memarena,world,body,nb,_joint,_nj);
+
   // get m = total constraint dimension, nub = number of unbounded variables.
   // create constraint offset array and number-of-rows array for all joints.
   // the constraints are re-ordered as follows: the purely unbounded
@@ -302,6 +306,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
           }
           dxJoint *j = *_jcurr++;
           j->getInfo1 (&jicurr->info);
+          if (j->flags & dJOINT_ARTICULATED) dxReduceArticulatedJointInfo1 (&jicurr->info);
           dIASSERT (jicurr->info.m >= 0 && jicurr->info.m <= 6 && jicurr->info.nub >= 0 && jicurr->info.nub <= jicurr->info.m);
           if (jicurr->info.m > 0) {
             if (jicurr->info.nub == 0) { // A lcp info - a correct guess!!!
@@ -355,6 +360,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
           }
           dxJoint *j = *_jcurr++;
           j->getInfo1 (&jicurr->info);
+          if (j->flags & dJOINT_ARTICULATED) dxReduceArticulatedJointInfo1 (&jicurr->info);
           dIASSERT (jicurr->info.m >= 0 && jicurr->info.m <= 6 && jicurr->info.nub >= 0 && jicurr->info.nub <= jicurr->info.m);
           if (jicurr->info.m > 0) {
             if (jicurr->info.nub == jicurr->info.m) { // An unbounded info - a correct guess!!!
@@ -417,11 +423,17 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
       jicurr->joint->tag = i;
       unsigned int jm = jicurr->info.m;
       mcurr += jm;
+      if (articulations) dxArticulationsCountRows (articulations,jicurr->joint,jm);
     }
 
     m = mcurr;
   }
 
+  if (articulations) dxArticulationsAllocateRows (articulations,memarena);
+
+  // this will be set to the LCP solution
+  dReal *lambda = NULL;
+
   // this will be set to the force due to the constraints
   dReal *cforce = memarena->AllocateArray<dReal> ((size_t)nb*8);
   dSetZero (cforce,(size_t)nb*8);
@@ -508,7 +520,12 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
           Jinfo.findex = findex + ofsi;
 
           dxJoint *joint = jicurr->joint;
-          joint->getInfo2 (stepsizeRecip, world->global_erp, &Jinfo);
+          if (joint->flags & dJOINT_ARTICULATED) {
+            dxGetArticulatedJointInfo2 (joint, stepsizeRecip, world->global_erp, &Jinfo, infom);
+          } else {
+            joint->getInfo2 (stepsizeRecip, world->global_erp, &Jinfo);
+          }
+          if (articulations) dxArticulationsAddRows (articulations, joint, ofsi, infom);
 
           // adjust returned findex values for global index numbering
           int *findex_ofsi = findex + ofsi;
@@ -520,6 +537,9 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
 
           ofsi += infom;
         }
+
+        // the joint motors have added their forces to the bodies
+        if (articulations) dxArticulationsComputeFreeMotion (articulations, stepsize);
       }
 
       {
@@ -539,15 +559,22 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
             dReal *body_invI0 = invI + (size_t)b0*12;
             dReal *Jsrc = J + 2*8*(size_t)ofsi;
             dReal *Jdst = JinvM + 2*8*(size_t)ofsi;
-            for (unsigned int j=infom; j>0;) {
-              j -= 1;
-              for (unsigned int k=0; k<3; ++k) Jdst[k] = Jsrc[k] * body_invMass0;
-              dMultiply0_133 (Jdst+4,Jsrc+4,body_invI0);
-              Jsrc += 8;
-              Jdst += 8;
+            // the JinvM blocks of the articulated bodies stay zero, their
+            // contribution to A is added by dxArticulationsAddToA
+            if (!dxArticulationsContain (articulations, body[b0])) {
+              for (unsigned int j=infom; j>0;) {
+                j -= 1;
+                for (unsigned int k=0; k<3; ++k) Jdst[k] = Jsrc[k] * body_invMass0;
+                dMultiply0_133 (Jdst+4,Jsrc+4,body_invI0);
+                Jsrc += 8;
+                Jdst += 8;
+              }
+            } else {
+              Jsrc += 8*(size_t)infom;
+              Jdst += 8*(size_t)infom;
             }
 
-            if (joint->node[1].body) {
+            if (joint->node[1].body && !dxArticulationsContain (articulations, joint->node[1].body)) {
               unsigned int b1 = joint->node[1].body->tag;
               dReal body_invMass1 = body[b1]->invMass;
               dReal *body_invI1 = invI + (size_t)b1*12;
@@ -584,7 +611,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
               dReal *JinvMrow = JinvM + 2*8*(size_t)ofsi;
 
               dxBody *jb0 = joint->node[0].body;
-              for (dxJointNode *n0=jb0->firstjoint; n0; n0=n0->next) {
+              for (dxJointNode *n0=(dxArticulationsContain (articulations, jb0) ? NULL : jb0->firstjoint); n0; n0=n0->next) {
                 // if joint was tagged as -1 then it is an inactive (m=0 or disabled)
                 // joint that should not be considered
                 int j0 = n0->joint->tag;
@@ -599,7 +626,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
 
               dxBody *jb1 = joint->node[1].body;
               dIASSERT(jb1 != jb0);
-              if (jb1)
+              if (jb1 && !dxArticulationsContain (articulations, jb1))
               {
                 for (dxJointNode *n1=jb1->firstjoint; n1; n1=n1->next) {
                   // if joint was tagged as -1 then it is an inactive (m=0 or disabled)
@@ -643,6 +670,11 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
           }
         }
 
+        if (articulations) {
+          // add the blocks of the rows acting on the articulated bodies
+          dxArticulationsAddToA (articulations, J, A, dPAD(m));
+        }
+
         {
           // add cfm to the diagonal of A
           const unsigned int mskip = dPAD(m);
@@ -674,6 +706,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
           dMultiply0_331 (tmp1curr+4, invIrow, b->tacc);
           for (unsigned int k=0; k<3; ++k) tmp1curr[4+k] += b->avel[k]*stepsizeRecip;
         }
+        if (articulations) dxArticulationsGetFreeVelocities (articulations, tmp1, stepsizeRecip);
       }
 
       {
@@ -704,7 +737,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
       }
     } END_STATE_SAVE(memarena, tmp1state);
 
-    dReal *lambda = memarena->AllocateArray<dReal> (m);
+    lambda = memarena->AllocateArray<dReal> (m);
 
     BEGIN_STATE_SAVE(memarena, lcpstate) {
       IFTIMING(dTimerNow ("solving LCP problem"));
@@ -791,6 +824,7 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
     dxBody *const *const bodyend = body + nb;
     for (dxBody *const *bodycurr = body; bodycurr != bodyend; invIrow+=12, cforcecurr+=8, ++bodycurr) {
       dxBody *b = *bodycurr;
+      if (dxArticulationsContain (articulations, b)) continue;
 
       dReal body_invMass_mul_stepsize = stepsize * b->invMass;
       for (unsigned int j=0; j<3; ++j) b->lvel[j] += (cforcecurr[j] + b->facc[j]) * body_invMass_mul_stepsize;
@@ -807,8 +841,12 @@ static void dInternalStepIsland_x2 (dxWorldProcessMemArena *memarena,
     dxBody *const *const bodyend = body + nb;
     for (dxBody *const *bodycurr = body; bodycurr != bodyend; ++bodycurr) {
       dxBody *b = *bodycurr;
+      if (dxArticulationsContain (articulations, b)) continue;
       dxStepBody (b,stepsize);
     }
+
+    // the articulated bodies are moved by their joints
+    if (articulations) dxArticulationsIntegrate (articulations, lambda, stepsize);
   }
 
   {
@@ -868,6 +906,7 @@ size_t dxEstimateStepMemoryRequirements (dxBody * const *body, unsigned int nb,
   size_t res = 0;
 
   res += dEFFICIENT_SIZE(sizeof(dReal) * 3 * 4 * (size_t)nb); // for invI
+  res += dxEstimateArticulationMemoryRequirements (body, nb, _joint, _nj); // for the articulations and their rows
 
   {
     size_t sub1_res1 = dEFFICIENT_SIZE(sizeof(dJointWithInfo1) * 2 * (size_t)_nj); // for initial jointiinfos
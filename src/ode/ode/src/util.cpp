@@ -25,7 +25,11 @@
 #include "objects.h"
 #include "joints/joint.h"
 #include "util.h"
+#ifdef ODE_MT
+#include "ode_MT/threading/workerPool.h"
+#endif
 
+#include <algorithm>
 #include <new>
 
 #define dMIN(A,B)  ((A)>(B) ? (B) : (A))
@@ -42,7 +46,9 @@ dxWorldProcessMemoryReserveInfo g_WorldProcessDefaultReserveInfo(dWORLDSTEP_RESE
 
 dxWorldProcessContext::dxWorldProcessContext():
   m_pmaIslandsArena(NULL),
-  m_pmaStepperArena(NULL)
+  m_pmaStepperArena(NULL),
+  m_ppmaWorkerStepperArenas(NULL),
+  m_uiWorkerStepperArenaCount(0)
 {
     // Do nothing
 }
@@ -58,10 +64,26 @@ dxWorldProcessContext::~dxWorldProcessContext()
   {
     dxWorldProcessMemArena::FreeMemArena(m_pmaStepperArena);
   }
+
+  for (unsigned i = 0; i < m_uiWorkerStepperArenaCount; i++)
+  {
+    if (m_ppmaWorkerStepperArenas[i])
+    {
+      dxWorldProcessMemArena::FreeMemArena(m_ppmaWorkerStepperArenas[i]);
+    }
+  }
+  dFree(m_ppmaWorkerStepperArenas, m_uiWorkerStepperArenaCount * sizeof(dxWorldProcessMemArena *));
 }
 
 bool dxWorldProcessContext::IsStructureValid() const
 {
+  for (unsigned i = 0; i < m_uiWorkerStepperArenaCount; i++)
+  {
+    if (m_ppmaWorkerStepperArenas[i] && !m_ppmaWorkerStepperArenas[i]->IsStructureValid())
+    {
+      return false;
+    }
+  }
   return (!m_pmaIslandsArena || m_pmaIslandsArena->IsStructureValid()) && (!m_pmaStepperArena || m_pmaStepperArena->IsStructureValid());
 }
 
@@ -76,6 +98,14 @@ void dxWorldProcessContext::CleanupContext()
   {
     m_pmaStepperArena->ResetState();
   }
+
+  for (unsigned i = 0; i < m_uiWorkerStepperArenaCount; i++)
+  {
+    if (m_ppmaWorkerStepperArenas[i])
+    {
+      m_ppmaWorkerStepperArenas[i]->ResetState();
+    }
+  }
 }
 
 dxWorldProcessMemArena *dxWorldProcessContext::ReallocateIslandsMemArena(size_t nMemoryRequirement,
@@ -96,6 +126,30 @@ dxWorldProcessMemArena *dxWorldProcessContext::ReallocateStepperMemArena(size_t
     return pmaNewMemArena;
 }
 
+bool dxWorldProcessContext::ReallocateWorkerStepperMemArenas(unsigned uiWorkerCount, size_t nMemoryRequirement,
+  const dxWorldProcessMemoryManager *pmmMemortManager, float fReserveFactor, unsigned uiReserveMinimum)
+{
+    unsigned uiArenaCount = uiWorkerCount > 1 ? uiWorkerCount - 1 : 0;
+    if (uiArenaCount > m_uiWorkerStepperArenaCount)
+    {
+        m_ppmaWorkerStepperArenas = (dxWorldProcessMemArena **)dRealloc(m_ppmaWorkerStepperArenas,
+            m_uiWorkerStepperArenaCount * sizeof(dxWorldProcessMemArena *), uiArenaCount * sizeof(dxWorldProcessMemArena *));
+        for (unsigned i = m_uiWorkerStepperArenaCount; i < uiArenaCount; i++)
+        {
+            m_ppmaWorkerStepperArenas[i] = NULL;
+        }
+        m_uiWorkerStepperArenaCount = uiArenaCount;
+    }
+
+    bool bSuccess = true;
+    for (unsigned i = 0; i < uiArenaCount; i++)
+    {
+        m_ppmaWorkerStepperArenas[i] = dxWorldProcessMemArena::ReallocateMemArena(m_ppmaWorkerStepperArenas[i], nMemoryRequirement, pmmMemortManager, fReserveFactor, uiReserveMinimum);
+        bSuccess = bSuccess && m_ppmaWorkerStepperArenas[i] != NULL;
+    }
+    return bSuccess;
+}
+
 //****************************************************************************
 // Auto disabling
 
@@ -331,14 +385,10 @@ void dxStepBody (dxBody *b, dReal h)
     dNormalize4 (b->q);
     dQtoR (b->q,b->posr.R);
 
-    // notify all attached geoms that this body has moved
-    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
-        dGeomMoved (geom);
-
-    // notify the user
-    if (b->moved_callback != NULL) {
-        b->moved_callback(b);
-    }
+    // notify the attached geoms and the user, unless islands are stepped in parallel:
+    // spaces are not thread-safe, so dxProcessIslands() notifies them afterwards
+    if (!b->world->defer_moved_notifications)
+        dxNotifyBodyMoved (b);
 
     // damping
     if (b->flags & dxBodyLinearDamping) {
@@ -359,14 +409,67 @@ void dxStepBody (dxBody *b, dReal h)
     }
 }
 
+void dxNotifyBodyMoved (dxBody *b)
+{
+    // notify all attached geoms that this body has moved
+    for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+        dGeomMoved (geom);
+
+    // notify the user
+    if (b->moved_callback != NULL) {
+        b->moved_callback(b);
+    }
+}
+
 //****************************************************************************
 // island processing
 
+// an island handed out to a worker thread
+struct dxIslandTask
+{
+    dxBody *const *body;
+    dxJoint *const *joint;
+    unsigned int bcount;
+    unsigned int jcount;
+    unsigned int index;
+};
+
+// solve the islands with the most joints first to balance the load between the workers
+static bool IsIslandTaskHeavier(const dxIslandTask &a, const dxIslandTask &b)
+{
+    return a.jcount != b.jcount ? a.jcount > b.jcount : a.index < b.index;
+}
+
+struct dxIslandTasksInfo
+{
+    dxWorld *world;
+    dxWorldProcessContext *context;
+    const dxIslandTask *tasks;
+    dstepper_fn_t stepper;
+    dReal stepSize;
+};
+
+static void StepIslandTask(unsigned int task, unsigned int worker, void *data)
+{
+    const dxIslandTasksInfo *info = (const dxIslandTasksInfo *)data;
+    const dxIslandTask &island = info->tasks[task];
+    dxWorldProcessMemArena *stepperarena = info->context->GetWorkerStepperMemArena(worker);
+
+    BEGIN_STATE_SAVE(stepperarena, stepperstate) {
+      info->stepper (stepperarena,info->world,island.body,island.bcount,island.joint,island.jcount,info->stepSize);
+    } END_STATE_SAVE(stepperarena, stepperstate);
+}
+
 // This estimates dynamic memory requirements for dxProcessIslands
-static size_t EstimateIslandsProcessingMemoryRequirements(dxWorld *world)
+static size_t EstimateIslandsProcessingMemoryRequirements(dxWorld *world, unsigned int threadcount)
 {
     size_t res = 0;
 
+    if (threadcount > 1) {
+        // there are at most as many islands as bodies
+        res += dEFFICIENT_SIZE((size_t)(unsigned)world->nb * sizeof(dxIslandTask));
+    }
+
     size_t islandcounts = dEFFICIENT_SIZE((size_t)(unsigned)world->nb * 2 * sizeof(int));
     res += islandcounts;
 
@@ -377,9 +480,19 @@ static size_t EstimateIslandsProcessingMemoryRequirements(dxWorld *world)
     size_t sesize = (bodiessize < jointssize) ? bodiessize : jointssize;
     res += sesize;
 
+    // order of the bodies from which the islands are built
+    res += bodiessize;
+
     return res;
 }
 
+// the bodies of a world to which no body was moved are listed from the last
+// created one, deterministic worlds always build their islands in this order
+static bool IsBodyCreatedLater(const dxBody *a, const dxBody *b)
+{
+    return a->serial > b->serial;
+}
+
 static size_t BuildIslandsAndEstimateStepperMemoryRequirements(
     dxWorldProcessIslandsInfo &islandsInfo, dxWorldProcessMemArena *memarena,
     dxWorld *world, dReal stepSize, dmemestimate_fn_t stepperEstimate)
@@ -413,10 +526,20 @@ static size_t BuildIslandsAndEstimateStepperMemoryRequirements(
             for (dxJoint *j=world->firstjoint; j; j=(dxJoint*)j->next) j->tag = 0;
         }
 
+        // the bodies and joints of an island are listed in the order they are
+        // reached from the first body of the island found in this order
+        dxBody **order = memarena->AllocateArray<dxBody *>(nb);
+        {
+            dxBody **ordercurr = order;
+            for (dxBody *b=world->firstbody; b; b=(dxBody*)b->next) *ordercurr++ = b;
+            if (world->deterministic) std::sort(order, order + nb, IsBodyCreatedLater);
+        }
+
         sizescurr = islandsizes;
         dxBody **bodystart = body;
         dxJoint **jointstart = joint;
-        for (dxBody *bb=world->firstbody; bb; bb=(dxBody*)bb->next) {
+        for (dxBody **ordercurr = order; ordercurr != order + nb; ordercurr++) {
+            dxBody *bb = *ordercurr;
             // get bb = the next enabled, untagged body, and tag it
             if (!bb->tag) {
                 if (!(bb->flags & dxBodyDisabled)) {
@@ -531,7 +654,7 @@ static size_t BuildIslandsAndEstimateStepperMemoryRequirements(
 // re-enabled if they are found to be part of an active island.
 
 void dxProcessIslands (dxWorld *world, const dxWorldProcessIslandsInfo &islandsInfo,
-  dReal stepSize, dstepper_fn_t stepper)
+  dReal stepSize, dstepper_fn_t stepper, unsigned int threadcount)
 {
   const unsigned int sizeelements = 2;
 
@@ -551,6 +674,41 @@ void dxProcessIslands (dxWorld *world, const dxWorldProcessIslandsInfo &islandsI
   dxBody *const *bodystart = body;
   dxJoint *const *jointstart = joint;
 
+#ifdef ODE_MT
+  if (threadcount > 1 && islandcount > 1) {
+    // the task list is allocated after the island lists in the islands arena
+    dxIslandTask *tasks = context->GetIslandsMemArena()->AllocateArray<dxIslandTask>(islandcount);
+    for (size_t i = 0; i < islandcount; i++) {
+      tasks[i].body = bodystart;
+      tasks[i].joint = jointstart;
+      tasks[i].bcount = islandsizes[i * sizeelements];
+      tasks[i].jcount = islandsizes[i * sizeelements + 1];
+      tasks[i].index = (unsigned int)i;
+      bodystart += tasks[i].bcount;
+      jointstart += tasks[i].jcount;
+    }
+    std::sort(tasks, tasks + islandcount, IsIslandTaskHeavier);
+
+    dxIslandTasksInfo info;
+    info.world = world;
+    info.context = context;
+    info.tasks = tasks;
+    info.stepper = stepper;
+    info.stepSize = stepSize;
+
+    dxWorkerPool *pool = dWorkerPool();
+    pool->reserveWorkers(threadcount);
+    world->defer_moved_notifications = true;
+    pool->run((unsigned int)islandcount, threadcount, &StepIslandTask, &info);
+    world->defer_moved_notifications = false;
+
+    // notify the spaces in the same order as the sequential solver would
+    for (dxBody *const *bodycurr = body; bodycurr != bodystart; bodycurr++)
+      dxNotifyBodyMoved (*bodycurr);
+    return;
+  }
+#endif
+
   unsigned int const *const sizesend = islandsizes + islandcount * sizeelements;
   for (unsigned int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
     unsigned int bcount = sizescurr[0];
@@ -652,7 +810,7 @@ size_t dxWorldProcessMemArena::AdjustArenaSizeForReserveRequirements(size_t aren
 }
 
 bool dxReallocateWorldProcessContext (dxWorld *world, dxWorldProcessIslandsInfo &islandsInfo,
-    dReal stepSize, dmemestimate_fn_t stepperEstimate)
+    dReal stepSize, dmemestimate_fn_t stepperEstimate, unsigned int threadcount)
 {
   dxStepWorkingMemory *wmem = AllocateOnDemand(world->wmem);
   if (wmem == NULL) return false;
@@ -664,7 +822,7 @@ bool dxReallocateWorldProcessContext (dxWorld *world, dxWorldProcessIslandsInfo
   const dxWorldProcessMemoryReserveInfo *reserveinfo = wmem->SureGetMemoryReserveInfo();
   const dxWorldProcessMemoryManager *memmgr = wmem->SureGetMemoryManager();
 
-  size_t islandsreq = EstimateIslandsProcessingMemoryRequirements(world);
+  size_t islandsreq = EstimateIslandsProcessingMemoryRequirements(world, threadcount);
   dIASSERT(islandsreq == dEFFICIENT_SIZE(islandsreq));
 
   dxWorldProcessMemArena *stepperarena = NULL;
@@ -676,6 +834,12 @@ bool dxReallocateWorldProcessContext (dxWorld *world, dxWorldProcessIslandsInfo
     dIASSERT(stepperreq == dEFFICIENT_SIZE(stepperreq));
 
     stepperarena = context->ReallocateStepperMemArena(stepperreq, memmgr, reserveinfo->m_fReserveFactor, reserveinfo->m_uiReserveMinimum);
+
+    if (stepperarena != NULL && threadcount > 1 &&
+        !context->ReallocateWorkerStepperMemArenas(threadcount, stepperreq, memmgr, reserveinfo->m_fReserveFactor, reserveinfo->m_uiReserveMinimum))
+    {
+      stepperarena = NULL;
+    }
   }
 
   return stepperarena != NULL;
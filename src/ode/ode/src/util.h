@@ -57,7 +57,10 @@
 #endif
 
 void dInternalHandleAutoDisabling (dxWorld *world, dReal stepsize);
+// same as dRandInt() but drawn from the generator whose state is *seed instead of the global one
+int dRandIntFromSeed (unsigned long *seed, int n);
 void dxStepBody (dxBody *b, dReal h);
+void dxNotifyBodyMoved (dxBody *b);
 
 struct dxWorldProcessMemoryManager:
     public dBase
@@ -216,6 +219,11 @@ public:
   dxWorldProcessMemArena *ReallocateStepperMemArena(size_t nMemoryRequirement,
     const dxWorldProcessMemoryManager *pmmMemortManager, float fReserveFactor, unsigned uiReserveMinimum);
 
+  // worker 0 uses the regular stepper arena, the other island solving threads get their own arena
+  dxWorldProcessMemArena *GetWorkerStepperMemArena(unsigned uiWorker) const { return uiWorker == 0 ? m_pmaStepperArena : m_ppmaWorkerStepperArenas[uiWorker - 1]; }
+  bool ReallocateWorkerStepperMemArenas(unsigned uiWorkerCount, size_t nMemoryRequirement,
+    const dxWorldProcessMemoryManager *pmmMemortManager, float fReserveFactor, unsigned uiReserveMinimum);
+
 private:
   void SetIslandsMemArena(dxWorldProcessMemArena *pmaInstance) { m_pmaIslandsArena = pmaInstance; }
   void SetStepperMemArena(dxWorldProcessMemArena *pmaInstance) { m_pmaStepperArena = pmaInstance; }
@@ -223,6 +231,8 @@ private:
 private:
   dxWorldProcessMemArena  *m_pmaIslandsArena;
   dxWorldProcessMemArena  *m_pmaStepperArena;
+  dxWorldProcessMemArena  **m_ppmaWorkerStepperArenas;
+  unsigned                m_uiWorkerStepperArenaCount;
 };
 
 struct dxWorldProcessIslandsInfo
@@ -254,13 +264,15 @@ typedef void (*dstepper_fn_t) (dxWorldProcessMemArena *memarena,
         dxWorld *world, dxBody * const *body, unsigned int nb,
         dxJoint * const *_joint, unsigned int _nj, dReal stepsize);
 
-void dxProcessIslands (dxWorld *world, const dxWorldProcessIslandsInfo &islandsinfo, dReal stepsize, dstepper_fn_t stepper);
+// islands are dispatched to 'threadcount' workers, each of them using its own stepper arena
+void dxProcessIslands (dxWorld *world, const dxWorldProcessIslandsInfo &islandsinfo, dReal stepsize, dstepper_fn_t stepper,
+                       unsigned int threadcount = 1);
 
 typedef size_t (*dmemestimate_fn_t) (dxBody * const *body, unsigned int nb,
                                      dxJoint * const *_joint, unsigned int _nj);
 
 bool dxReallocateWorldProcessContext (dxWorld *world, dxWorldProcessIslandsInfo &islandsinfo,
-                                      dReal stepsize, dmemestimate_fn_t stepperestimate);
+                                      dReal stepsize, dmemestimate_fn_t stepperestimate, unsigned int threadcount = 1);
 
 void dxCleanupWorldProcessContext (dxWorld *world);
 
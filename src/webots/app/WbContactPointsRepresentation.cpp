@@ -122,11 +122,11 @@ void WbContactPointsRepresentation::updateOptionalRendering(int option) {
 void WbContactPointsRepresentation::updateRendering() {
   const WbSimulationWorld *const world = WbSimulationWorld::instance();
 
-  const QList<WbOdeContact> &odeContacts = world->odeContacts();
+  const QVector<WbOdeContact> &odeContacts = world->odeContacts();
   const int contactSize = odeContacts.size();
   wr_dynamic_mesh_clear(mContactMesh);
 
-  const QList<dImmersionGeom> &immersionGeoms = world->immersionGeoms();
+  const QVector<dImmersionGeom> &immersionGeoms = world->immersionGeoms();
   const int immersionSize = immersionGeoms.size();
   wr_dynamic_mesh_clear(mImmersionMesh);
 
@@ -220,9 +220,9 @@ void WbContactPointsRepresentation::updateRendering() {
     dImmersionOutlineID io = immersionGeoms[i].outline;
     const int ssize = dImmersionOutlineGetStraightEdgesSize(io);
     for (int j = 0; j < ssize; ++j) {
-      const double *const origin = dImmersionOutlineGetStraightEdgeOrigin(io, j);
+      const dReal *const origin = dImmersionOutlineGetStraightEdgeOrigin(io, j);
       addVertex(mImmersionMesh, index++, origin[0], origin[1], origin[2]);
-      const double *const end = dImmersionOutlineGetStraightEdgeEnd(io, j);
+      const dReal *const end = dImmersionOutlineGetStraightEdgeEnd(io, j);
       addVertex(mImmersionMesh, index++, end[0], end[1], end[2]);
     }
 
@@ -233,7 +233,7 @@ void WbContactPointsRepresentation::updateRendering() {
     for (int j = 0; j < csize; ++j) {
       dImmersionOutlineGetCurvedEdge(io, j, &ce);
       double theta = ce.minAngle;
-      const double *const c = ce.center;
+      const dReal *const c = ce.center;
       const double stepSize = (ce.maxAngle - theta) / NUMBER_OF_THETA_STEPS;
       for (int k = 0; k < NUMBER_OF_THETA_STEPS; ++k) {
         dAddScaledVectors3(v, ce.e1, ce.e2, cos(theta), sin(theta));
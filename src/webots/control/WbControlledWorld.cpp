@@ -302,6 +302,15 @@ void WbControlledWorld::reset(bool restartControllers) {
   }
 }
 
+bool WbControlledWorld::loadState(const QString &name) {
+  if (!WbSimulationWorld::loadState(name))
+    return false;
+  // the time went back or forward: the controllers keep running from the loaded time
+  foreach (WbController *controller, mControllers)
+    controller->resetRequestTime();
+  return true;
+}
+
 void WbControlledWorld::checkIfReadRequestCompleted() {
   assert(!mControllers.isEmpty());
   if (!needToWait()) {
@@ -426,6 +435,20 @@ bool WbControlledWorld::needToWait(bool *waitForExternControllerStart) {
   return false;
 }
 
+void WbControlledWorld::waitForControllerRequests(int msecs) {
+  foreach (WbController *const controller, mControllers) {
+    if (controller->synchronization() && (!controller->isRequestPending() || controller->isIncompleteRequest())) {
+      if (controller->waitForRequest(msecs))
+        return;
+      break;
+    }
+  }
+
+  // the controllers are not connected yet, are terminating or do not answer: process the connections, the process
+  // notifications and the queued calls, the user inputs are ignored while the simulation is stepped
+  QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+}
+
 void WbControlledWorld::writePendingImmediateAnswer() {
   foreach (WbController *const controller, mControllers)
     controller->writePendingImmediateAnswer();
@@ -41,8 +41,12 @@ public:
   void writePendingImmediateAnswer();
   bool isExecutingStep() const { return mIsExecutingStep; }
   void checkIfReadRequestCompleted();
+  // when the simulation is stepped in a loop instead of from the step timer, waits until the next synchronized controller
+  // request is received or the timeout expires, the other events are processed if no controller can answer
+  void waitForControllerRequests(int msecs);
 
   void reset(bool restartControllers) override;
+  bool loadState(const QString &name) override;
 
   void step() override;
 
@@ -886,6 +886,18 @@ QString WbController::commandLine() const {  // returns the command line with do
   return commandLine;
 }
 
+bool WbController::waitForRequest(int msecs) {
+  if (mSocket == NULL || !mSocket->isValid())
+    return false;
+
+  if (mSocket->bytesAvailable() > 0) {
+    readRequest();
+    return true;
+  }
+  // readRequest() is called by the readyRead() signal emitted from waitForReadyRead()
+  return mSocket->waitForReadyRead(msecs);
+}
+
 void WbController::handleControllerExit() {
   if (mRobot->controllerName() == "<extern>") {
     processFinished(0, QProcess::NormalExit);
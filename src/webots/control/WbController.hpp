@@ -61,6 +61,8 @@ public:
   bool isRequestPending() const { return mRequestPending; }
   bool isRunning() const;
   bool isProcessingRequest() const { return mProcessingRequest; }
+  // reads the data sent by the libController without going through the event loop, returns false if nothing was received
+  bool waitForRequest(int msecs);
 
 signals:
   void hasTerminatedByItself(WbController *);
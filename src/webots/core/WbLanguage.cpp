@@ -463,9 +463,11 @@ static const char *C_API_FUNCTIONS = "wb_accelerometer_enable "
                                      "wb_supervisor_node_set_visibility "
                                      "wb_supervisor_set_label "
                                      "wb_supervisor_simulation_get_mode "
+                                     "wb_supervisor_simulation_load_state "
                                      "wb_supervisor_simulation_quit "
                                      "wb_supervisor_simulation_reset "
                                      "wb_supervisor_simulation_reset_physics "
+                                     "wb_supervisor_simulation_save_state "
                                      "wb_supervisor_simulation_set_mode "
                                      "wb_supervisor_virtual_reality_headset_get_position "
                                      "wb_supervisor_virtual_reality_headset_get_orientation "
@@ -51,6 +51,7 @@ public:
   // simulation time
   double time() const { return mTime; }  // milliseconds
   void resetTime();
+  void setTime(double time) { mTime = time; }  // when loading a saved state
   void increaseTime(double dt);
   bool hasStarted() const { return mTime > 0.0; }
 
@@ -26,6 +26,7 @@
 #include "WbOdeContact.hpp"
 #include "WbOdeContext.hpp"
 #include "WbOdeGeomData.hpp"
+#include "WbPerformanceLog.hpp"
 #include "WbPhysicsPlugin.hpp"
 #include "WbRadar.hpp"
 #include "WbReceiver.hpp"
@@ -37,11 +38,13 @@
 #include "WbWorld.hpp"
 #include "WbWorldInfo.hpp"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QMutex>
 
 #include <ode/fluid_dynamics/ode_fluid_dynamics.h>
 #include <ode/ode_MT.h>
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -50,7 +53,24 @@ const long long int WbSimulationCluster::WEBOTS_MAGIC_NUMBER = 0x7765626F7473LL;
 
 QMutex *WbSimulationCluster::cJointCreationMutex = NULL;
 
-WbSimulationCluster::WbSimulationCluster(WbOdeContext *context) : mContext(context), mSwapJointContactBuffer(false) {
+thread_local WbSimulationCluster::BroadphaseBuffer *WbSimulationCluster::cThreadBroadphaseBuffer = NULL;
+QList<WbSimulationCluster::BroadphaseBuffer *> WbSimulationCluster::cBroadphaseBuffers;
+QMutex WbSimulationCluster::cBroadphaseBuffersMutex;
+
+// maximum number of contacts per pair of geoms
+static const int MAX_CONTACTS = 10;
+// number of pairs collided by a narrowphase task
+static const int PAIRS_PER_TASK = 16;
+// number of immersions computed by a task, large enough for the threads not to write the same cache lines of the immersions
+// and counts and to keep the scheduling cost small compared with the immersions
+static const int IMMERSIONS_PER_TASK = 16;
+
+WbSimulationCluster::WbSimulationCluster(WbOdeContext *context) :
+  mContext(context),
+  mRemovedContactsCount(0),
+  mProfileCollisions(WbPerformanceLog::instance() != NULL),
+  mSwapJointContactBuffer(false),
+  mIntermediateSubStep(false) {
   cJointCreationMutex = context->jointGroupCreationMutex();
 }
 
@@ -65,6 +85,9 @@ WbSimulationCluster::~WbSimulationCluster() {
   dImmersionLinkGroupEmpty(mContext->immersionLinkGroup1());
   dImmersionLinkGroupEmpty(mContext->immersionLinkGroup2());
   cJointCreationMutex->unlock();
+
+  foreach (dImmersionOutlineID outline, mImmersionOutlines)
+    dImmersionOutlineDestroy(outline);
 }
 
 // do not remove this function it is useful to debug the physics engine
@@ -88,6 +111,7 @@ void WbSimulationCluster::handleInitialCollisions() {
     physicsPlugin->setCurrentContactJointGroup(physicsPluginContactJointGroup());
 
   dSpaceCollide(mContext->space(), this, odeNearCallback);
+  collidePairs();
   swapBuffer();
 }
 
@@ -99,13 +123,18 @@ void WbSimulationCluster::swapBuffer() {
     physicsPlugin->setCurrentContactJointGroup(physicsPluginContactJointGroup());
 }
 
-void WbSimulationCluster::step() {
+void WbSimulationCluster::step(double ms, bool lastSubStep) {
   dSpaceUpdateFunction *spaceUpdateFunc = NULL;
-  if (WbSolidDevice::hasDirtySensors())
+  if (lastSubStep && WbSolidDevice::hasDirtySensors())
     // update rays position after world step and before space collision detection
     spaceUpdateFunc = &odeSensorRaysUpdate;
-  dWorldStepAndSpaceCollide(mContext->space(), this, odeNearCallback, mContext->world(),
-                            WbWorld::instance()->basicTimeStep() * 0.001, &dWorldStep, spaceUpdateFunc);
+  // the forces of the controllers and of the physics plugin are only added once per basic time step
+  if (!lastSubStep || mIntermediateSubStep)
+    dWorldSetKeepForces(mContext->world(), !lastSubStep);
+  mIntermediateSubStep = !lastSubStep;
+  dWorldStepAndSpaceCollide(mContext->space(), this, odeNearCallback, mContext->world(), ms * 0.001,
+                            mContext->stepFunction(), spaceUpdateFunc);
+  collidePairs();
 
   // every step, we need to save contact points in 'back buffer'
   // here we swap the front buffer with the back buffer.
@@ -121,7 +150,8 @@ void WbSimulationCluster::step() {
     mContext->emptyEnabledBodyContactJointGroups2();
   dImmersionLinkGroupEmpty(immersionLinkGroup());
 
-  WbSolidDevice::clearDirtySensorsList();
+  if (lastSubStep)
+    WbSolidDevice::clearDirtySensorsList();
 
   // qDebug() << "number of physics plugin contacts 1:" << dJointGroupGetCount(mContext->physicsPluginContactJointGroup1());
   // qDebug() << "number of physics plugin contacts 2:" << dJointGroupGetCount(mContext->physicsPluginContactJointGroup2());
@@ -191,11 +221,23 @@ static void debugSurfaceParameters(const dSurfaceParameters *surf) {
 }
 */
 
+// search the ContactProperties node matching the contact materials of the two solids
+static const WbContactProperties *findContactProperties(const WbSolid *s1, const WbSolid *s2) {
+  const WbWorldInfo *const info = WbWorld::instance()->worldInfo();
+  const int size = info->contactPropertiesCount();
+  for (int i = 0; i < size; ++i) {
+    const WbContactProperties *const cp = info->contactProperties(i);
+    if ((cp->material1() == s1->contactMaterial() && cp->material2() == s2->contactMaterial()) ||
+        (cp->material1() == s2->contactMaterial() && cp->material2() == s1->contactMaterial()))
+      return cp;
+  }
+  return NULL;
+}
+
 // fill surface parameters using values in ContactProperties and Track nodes
 const WbContactProperties *WbSimulationCluster::fillSurfaceParameters(const WbSolid *s1, const WbSolid *s2,
                                                                       const WbGeometry *wg1, const WbGeometry *wg2,
                                                                       dContact *contact) {
-  const WbWorldInfo *const info = WbWorld::instance()->worldInfo();
   int j;
 
   // default values
@@ -210,37 +252,29 @@ const WbContactProperties *WbSimulationCluster::fillSurfaceParameters(const WbSo
   double soft_erp = 0.2;
   bool inversed = false;
   WbVector2 frictionRotation(0, 0);
-  const WbContactProperties *contactProperties = NULL;
-  // search in list
-  const int size = info->contactPropertiesCount();
-  for (int i = 0; i < size; ++i) {
-    const WbContactProperties *const cp = info->contactProperties(i);
-    if ((cp->material1() == s1->contactMaterial() && cp->material2() == s2->contactMaterial()) ||
-        (cp->material1() == s2->contactMaterial() && cp->material2() == s1->contactMaterial())) {
-      contactProperties = cp;
-      if (cp->material2() == s1->contactMaterial())
-        inversed = true;
-      frictionSize = cp->coulombFrictionSize();
-      bounce = cp->bounce();
-      bounce_vel = cp->bounceVelocity();
-      fdsSize = cp->forceDependentSlipSize();
-      soft_cfm = cp->softCFM();
-      soft_erp = cp->softERP();
-      for (j = 0; (j < frictionSize) && (j < 4); ++j) {
-        mu[j] = cp->coulombFriction(j);
-        if (mu[j] == -1.0)
-          mu[j] = dInfinity;
-      }
-      const WbVector3 rf = cp->rollingFriction();
-      for (j = 0; j < 3; ++j)
-        rho[j] = rf[j] == -1.0 ? dInfinity : rf[j];
-      for (j = 0; (j < fdsSize) && (j < 4); ++j)
-        fds[j] = cp->forceDependentSlip(j);
-      // get friction direction only if needed
-      if ((frictionSize > 1) || (fdsSize > 1))  // asymetric contact
-        frictionRotation = cp->frictionRotation();
-      break;
+  const WbContactProperties *const cp = findContactProperties(s1, s2);
+  if (cp) {
+    if (cp->material2() == s1->contactMaterial())
+      inversed = true;
+    frictionSize = cp->coulombFrictionSize();
+    bounce = cp->bounce();
+    bounce_vel = cp->bounceVelocity();
+    fdsSize = cp->forceDependentSlipSize();
+    soft_cfm = cp->softCFM();
+    soft_erp = cp->softERP();
+    for (j = 0; (j < frictionSize) && (j < 4); ++j) {
+      mu[j] = cp->coulombFriction(j);
+      if (mu[j] == -1.0)
+        mu[j] = dInfinity;
     }
+    const WbVector3 rf = cp->rollingFriction();
+    for (j = 0; j < 3; ++j)
+      rho[j] = rf[j] == -1.0 ? dInfinity : rf[j];
+    for (j = 0; (j < fdsSize) && (j < 4); ++j)
+      fds[j] = cp->forceDependentSlip(j);
+    // get friction direction only if needed
+    if ((frictionSize > 1) || (fdsSize > 1))  // asymetric contact
+      frictionRotation = cp->frictionRotation();
   }
 
   WbVector3 globalFdirS1, globalFdirS2;
@@ -407,7 +441,7 @@ const WbContactProperties *WbSimulationCluster::fillSurfaceParameters(const WbSo
       contact->fdir1[2] = forceDir.z() * (invertedSign ? -1 : 1);
     }
   }
-  return contactProperties;
+  return cp;
 }
 
 // fill surface parameters using values in ImmersionProperties nodes
@@ -503,6 +537,9 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
   const bool isRayGeom2 = dGeomGetClass(o2) == dRayClass;
   if (isRayGeom1 && isRayGeom2)
     return;
+  // the sensors are only updated at the end of the basic time step
+  if ((isRayGeom1 || isRayGeom2) && static_cast<WbSimulationCluster *>(data)->mIntermediateSubStep)
+    return;
 
   // don't reach this point if handled by physics plugin
   assert(odeGeomData1 && odeGeomData2 && odeGeomData1->magicNumber() == WEBOTS_MAGIC_NUMBER &&
@@ -514,7 +551,6 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
 
   dBodyID b1 = dGeomGetBody(o1);
   dBodyID b2 = dGeomGetBody(o2);
-  WbSimulationCluster *const cl = static_cast<WbSimulationCluster *>(data);
 
   if (!s1 || !s2) {
     if (isRayGeom1 || isRayGeom2)
@@ -542,36 +578,16 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
       if (immersionProperties == NULL)
         return;
 
+      // the immersion is computed in parallel with the other ones by collidePairs(), the solid geom comes first
       dImmersion immersion;
-      dImmersionOutlineID io = dImmersionOutlineCreate();
-      immersion.geom.outline = io;
-      const int n = s1 ? dImmerse(o1, o2, 1, &immersion.geom) : dImmerse(o2, o1, 1, &immersion.geom);
-      if (n == 0) {
-        dImmersionOutlineDestroy(io);
-        return;
-      }
-
-      assert((s1 && (o1 == immersion.geom.g1 && o2 == immersion.geom.g2)) ||
-             (s2 && (o2 == immersion.geom.g1 && o1 == immersion.geom.g2)));
-
-      dBodyID b = b1 ? b1 : b2;
-      dFluidID f = fluid->odeFluid();
-
-      wg1->setColliding();
-      wg2->setColliding();
+      immersion.geom.g1 = s1 ? o1 : o2;
+      immersion.geom.g2 = s1 ? o2 : o1;
+      immersion.geom.outline = NULL;
 
       // using immersion properties specified in Solid
-      cl->fillImmersionSurfaceParameters(solid, immersionProperties, &immersion.surface);
+      fillImmersionSurfaceParameters(solid, immersionProperties, &immersion.surface);
 
-      // add these links to the simulation
-      cJointCreationMutex->lock();  // TODO: check if this mutex is useful and possibly rename it
-      dImmersionLinkID iml = dImmersionLinkCreate(dBodyGetWorld(b), cl->immersionLinkGroup(), &immersion);
-      dImmersionLinkAttach(iml, b, f);
-      cJointCreationMutex->unlock();
-
-      // record immersion info for immersion outline rendering
-      WbWorld *const world = WbWorld::instance();
-      world->appendOdeImmersionGeom(immersion.geom);
+      threadBroadphaseBuffer()->immersions.append(immersion);
     }
 
     return;
@@ -628,10 +644,229 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
     }
   }
 
-  dContact contact[10];
-  const int n = dCollide(o1, o2, 10, &contact[0].geom, sizeof(dContact));
-  if (n == 0)
+  // the contacts are computed in parallel and turned into joints once the broadphase is over, see collidePairs()
+  const int key1 = wg1 ? wg1->uniqueId() : s1->uniqueId();
+  const int key2 = wg2 ? wg2->uniqueId() : s2->uniqueId();
+  // the geom serials break the ties between the pairs of the same nodes, e.g. the rays of a multi-ray sensor
+  CollisionPair pair = {o1, o2, key1, key2, odeGeomData1->serial(), odeGeomData2->serial(), 0, 0, 0, 0};
+  if (key1 > key2 || (key1 == key2 && pair.serial1 > pair.serial2)) {
+    std::swap(pair.key1, pair.key2);
+    std::swap(pair.serial1, pair.serial2);
+    // the order of the geoms of a pair depends on the space which found it, it defines the direction of the contact
+    // normals and the order of the bodies of the contact joints
+    if (static_cast<WbSimulationCluster *>(data)->mContext->isDeterministic())
+      std::swap(pair.o1, pair.o2);
+  }
+  threadBroadphaseBuffer()->pairs.append(pair);
+}
+
+WbSimulationCluster::BroadphaseBuffer *WbSimulationCluster::threadBroadphaseBuffer() {
+  if (!cThreadBroadphaseBuffer) {
+    // the buffers are never deleted because the ODE threads outlive the clusters
+    cThreadBroadphaseBuffer = new BroadphaseBuffer();
+    cBroadphaseBuffersMutex.lock();
+    cBroadphaseBuffers.append(cThreadBroadphaseBuffer);
+    cBroadphaseBuffersMutex.unlock();
+  }
+  return cThreadBroadphaseBuffer;
+}
+
+static int immersionKey(const dImmersion &immersion) {
+  const WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(immersion.geom.g1));
+  return odeGeomData->geometry() ? odeGeomData->geometry()->uniqueId() : odeGeomData->solid()->uniqueId();
+}
+
+static int immersionFluidKey(const dImmersion &immersion) {
+  const WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(immersion.geom.g2));
+  return odeGeomData->geometry() ? odeGeomData->geometry()->uniqueId() : odeGeomData->solid()->uniqueId();
+}
+
+// the forces of the immersion links of a body are summed in the order of the links
+static bool isImmersionLess(const dImmersion &a, const dImmersion &b) {
+  const int key1 = immersionKey(a), key2 = immersionKey(b);
+  return key1 < key2 || (key1 == key2 && immersionFluidKey(a) < immersionFluidKey(b));
+}
+
+// colliders storing temporary data in the geoms or in global caches cannot run concurrently
+static bool isThreadSafeCollider(dGeomID geom) {
+  const int geomClass = dGeomGetClass(geom);
+  return geomClass != dTriMeshClass && geomClass != dHeightfieldClass && geomClass != dGeomTransformClass;
+}
+
+// the trimesh immersers only read the geoms and collide them with the per-thread trimesh colliders, the temporal coherence
+// caches of the trimeshes are not enabled by Webots, and heightfields have no immerser. A geom transform still moves its
+// encapsulated geom while immersing it
+static bool isThreadSafeImmerser(dGeomID geom) {
+  return dGeomGetClass(geom) != dGeomTransformClass;
+}
+
+void WbSimulationCluster::collidePairsTask(unsigned int task, unsigned int worker, void *data) {
+  WbSimulationCluster *const cl = static_cast<WbSimulationCluster *>(data);
+  CollisionPair *const pairs = cl->mCollisionPairs.data();
+  QVector<dContact> &contacts = cl->mWorkerContacts[worker];
+  const int end = qMin((int)(task + 1) * PAIRS_PER_TASK, cl->mCollisionPairs.size());
+  for (int i = task * PAIRS_PER_TASK; i < end; ++i) {
+    CollisionPair &pair = pairs[i];
+    if (!isThreadSafeCollider(pair.o1) || !isThreadSafeCollider(pair.o2)) {
+      pair.contactCount = -1;  // collided afterwards by the calling thread
+      continue;
+    }
+    dContact contact[MAX_CONTACTS];
+    QElapsedTimer timer;
+    if (cl->mProfileCollisions)
+      timer.start();
+    const int n = dCollide(pair.o1, pair.o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+    if (cl->mProfileCollisions)
+      pair.nanoseconds = timer.nsecsElapsed();
+    pair.worker = worker;
+    pair.firstContact = contacts.size();
+    pair.contactCount = n;
+    for (int j = 0; j < n; ++j)
+      contacts.append(contact[j]);
+  }
+}
+
+void WbSimulationCluster::immerseTask(unsigned int task, unsigned int worker, void *data) {
+  WbSimulationCluster *const cl = static_cast<WbSimulationCluster *>(data);
+  dImmersion *const immersions = cl->mImmersions.data();
+  int *const counts = cl->mImmersionCounts.data();
+  const int end = qMin((int)(task + 1) * IMMERSIONS_PER_TASK, cl->mImmersions.size());
+  for (int i = task * IMMERSIONS_PER_TASK; i < end; ++i) {
+    dImmersionGeom &geom = immersions[i].geom;
+    if (!isThreadSafeImmerser(geom.g1) || !isThreadSafeImmerser(geom.g2)) {
+      counts[i] = -1;  // immersed afterwards by the calling thread
+      continue;
+    }
+    counts[i] = dImmerse(geom.g1, geom.g2, 1, &geom);
+  }
+}
+
+void WbSimulationCluster::collidePairs() {
+  // gather the pairs and immersions found by the broadphase threads
+  mCollisionPairs.clear();
+  mImmersions.clear();
+  mRemovedContactsCount = 0;
+  QVector<dImmersion> &immersions = mImmersions;
+  int threadCount = 0;
+  cBroadphaseBuffersMutex.lock();
+  foreach (BroadphaseBuffer *buffer, cBroadphaseBuffers) {
+    if (buffer->pairs.isEmpty() && buffer->immersions.isEmpty())
+      continue;
+    ++threadCount;
+    mCollisionPairs += buffer->pairs;
+    immersions += buffer->immersions;
+    buffer->pairs.clear();
+    buffer->immersions.clear();
+  }
+  cBroadphaseBuffersMutex.unlock();
+  // a single thread finds the pairs in a deterministic order, otherwise they are sorted so that the contact joints and
+  // immersion links are always created in the same order whatever the scheduling of the threads. In deterministic mode,
+  // they are always sorted so that this order does not depend on the number of threads either
+  if (threadCount > 1 || mContext->isDeterministic()) {
+    std::stable_sort(mCollisionPairs.begin(), mCollisionPairs.end());
+    std::stable_sort(immersions.begin(), immersions.end(), isImmersionLess);
+  }
+
+  // narrowphase: the pairs are collided in parallel, each worker storing its contacts in its own buffer
+  const int workerCount = qMax(mContext->numberOfThreads(), 1);
+  if (mWorkerContacts.size() < workerCount)
+    mWorkerContacts.resize(workerCount);
+  for (int i = 0; i < mWorkerContacts.size(); ++i)
+    mWorkerContacts[i].clear();
+  const int pairCount = mCollisionPairs.size();
+  dRunWorkerTasks((pairCount + PAIRS_PER_TASK - 1) / PAIRS_PER_TASK, workerCount, &collidePairsTask, this);
+
+  // merge: contact joints are created sequentially in the order of the pairs
+  for (int i = 0; i < pairCount; ++i) {
+    CollisionPair &pair = mCollisionPairs[i];
+    if (pair.contactCount < 0) {
+      dContact contact[MAX_CONTACTS];
+      QElapsedTimer timer;
+      if (mProfileCollisions)
+        timer.start();
+      pair.contactCount = dCollide(pair.o1, pair.o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact));
+      if (mProfileCollisions)
+        pair.nanoseconds = timer.nsecsElapsed();
+      if (pair.contactCount > 0)
+        handleContacts(pair.o1, pair.o2, contact, pair.contactCount);
+    } else if (pair.contactCount > 0)
+      handleContacts(pair.o1, pair.o2, &mWorkerContacts[pair.worker][pair.firstContact], pair.contactCount);
+    if (mProfileCollisions)
+      addCollisionCost(pair);
+  }
+
+  // the immersions are computed in parallel as well, each one filling its own outline. The outlines are kept from one
+  // step to the next one so that their edges are not reallocated, the outlines of the previous step are not used anymore
+  const int immersionCount = immersions.size();
+  while (mImmersionOutlines.size() < immersionCount)
+    mImmersionOutlines.append(dImmersionOutlineCreate());
+  mImmersionCounts.resize(immersionCount);
+  for (int i = 0; i < immersionCount; ++i) {
+    dImmersionOutlineReset(mImmersionOutlines[i]);
+    immersions[i].geom.outline = mImmersionOutlines[i];
+  }
+  dRunWorkerTasks((immersionCount + IMMERSIONS_PER_TASK - 1) / IMMERSIONS_PER_TASK, workerCount, &immerseTask, this);
+
+  for (int i = 0; i < immersionCount; ++i) {
+    dImmersion *const immersion = &immersions[i];
+    if (mImmersionCounts[i] < 0)
+      mImmersionCounts[i] = dImmerse(immersion->geom.g1, immersion->geom.g2, 1, &immersion->geom);
+    if (mImmersionCounts[i] > 0)
+      handleImmersion(immersion);
+  }
+}
+
+void WbSimulationCluster::addCollisionCost(const CollisionPair &pair) {
+  const WbSolid *s1 = static_cast<WbOdeGeomData *>(dGeomGetData(pair.o1))->solid();
+  const WbSolid *s2 = static_cast<WbOdeGeomData *>(dGeomGetData(pair.o2))->solid();
+  if (s1->uniqueId() > s2->uniqueId())
+    std::swap(s1, s2);
+  const QPair<int, int> key(s1->uniqueId(), s2->uniqueId());
+  QHash<QPair<int, int>, CollisionCost>::iterator it = mCollisionCosts.find(key);
+  if (it == mCollisionCosts.end()) {
+    // the names are computed once, the solids may be deleted before the world is closed
+    const CollisionCost cost = {s1->computeUniqueName(), s2->computeUniqueName(), 0, 0, 0};
+    it = mCollisionCosts.insert(key, cost);
+  }
+  it->callsCount += 1;
+  it->contactsCount += pair.contactCount;
+  it->nanoseconds += pair.nanoseconds;
+}
+
+void WbSimulationCluster::reportCollisionCosts() const {
+  WbPerformanceLog *log = WbPerformanceLog::instance();
+  if (!log)
     return;
+  foreach (const CollisionCost &cost, mCollisionCosts)
+    log->reportCollisionPairCost(cost.solid1, cost.solid2, cost.callsCount, cost.contactsCount, cost.nanoseconds);
+}
+
+void WbSimulationCluster::handleImmersion(dImmersion *immersion) {
+  static_cast<WbOdeGeomData *>(dGeomGetData(immersion->geom.g1))->geometry()->setColliding();
+  static_cast<WbOdeGeomData *>(dGeomGetData(immersion->geom.g2))->geometry()->setColliding();
+
+  // add the links to the simulation
+  dBodyID b = dGeomGetBody(immersion->geom.g1);
+  const WbOdeGeomData *const fluidGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(immersion->geom.g2));
+  dImmersionLinkID iml = dImmersionLinkCreate(dBodyGetWorld(b), immersionLinkGroup(), immersion);
+  dImmersionLinkAttach(iml, b, fluidGeomData->fluid()->odeFluid());
+
+  // record immersion info for immersion outline rendering
+  WbWorld *const world = WbWorld::instance();
+  world->appendOdeImmersionGeom(immersion->geom);
+}
+
+void WbSimulationCluster::handleContacts(dGeomID o1, dGeomID o2, dContact *contact, int n) {
+  WbOdeGeomData *const odeGeomData1 = static_cast<WbOdeGeomData *>(dGeomGetData(o1));
+  WbOdeGeomData *const odeGeomData2 = static_cast<WbOdeGeomData *>(dGeomGetData(o2));
+  WbSolid *const s1 = odeGeomData1->solid();
+  WbSolid *const s2 = odeGeomData2->solid();
+  WbGeometry *const wg1 = odeGeomData1->geometry();
+  WbGeometry *const wg2 = odeGeomData2->geometry();
+  const bool isRayGeom1 = dGeomGetClass(o1) == dRayClass;
+  const bool isRayGeom2 = dGeomGetClass(o2) == dRayClass;
+  dBodyID b1 = dGeomGetBody(o1);
+  dBodyID b2 = dGeomGetBody(o2);
 
   WbTouchSensor *const ts1 = dynamic_cast<WbTouchSensor *>(s1);
   if (ts1 && !isRayGeom2)
@@ -744,6 +979,14 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
   if ((s1->isKinematic() && b2Disabled) || (s2->isKinematic() && b1Disabled) || (b1Disabled && b2Disabled))
     return;
 
+  // keep only the most representative contact points of the manifold as specified in the ContactProperties
+  const WbContactProperties *const cp = findContactProperties(s1, s2);
+  if (cp && n > cp->maxContactJoints()) {
+    const int reducedCount = dReduceContacts(&contact[0].geom, n, sizeof(dContact), cp->maxContactJoints());
+    mRemovedContactsCount += n - reducedCount;
+    n = reducedCount;
+  }
+
   // From now on, solids have a non-null body
   // So, we can fill the contact surface parameters.
   //------------------------------------------------
@@ -752,20 +995,18 @@ void WbSimulationCluster::odeNearCallback(void *data, dGeomID o1, dGeomID o2) {
     assert(o1 == contact[i].geom.g1 && o2 == contact[i].geom.g2);
 
     // using contact properties specified in WorldInfo
-    const WbContactProperties *contactProperties = cl->fillSurfaceParameters(s1, s2, wg1, wg2, &contact[i]);
+    const WbContactProperties *contactProperties = fillSurfaceParameters(s1, s2, wg1, wg2, &contact[i]);
 
     // add these joints to the simulation
     dWorldID jointWorld = b1 ? dBodyGetWorld(b1) : dBodyGetWorld(b2);
 
-    cJointCreationMutex->lock();
     dJointGroupID group = 0;
     if (b1 == NULL || (s1->isKinematic() && !s2->isKinematic()))
-      group = cl->bodyContactJointGroup(b2);
+      group = bodyContactJointGroup(b2);
     else
-      group = cl->bodyContactJointGroup(b1);
+      group = bodyContactJointGroup(b1);
     dJointID contactJoint = dJointCreateContact(jointWorld, group, &contact[i]);
     dJointAttach(contactJoint, b1, b2);
-    cJointCreationMutex->unlock();
 
     // record contact points for graphical and sound rendering
     WbWorld *const world = WbWorld::instance();
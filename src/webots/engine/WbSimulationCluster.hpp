@@ -21,7 +21,10 @@
 
 #include <ode/fluid_dynamics/ode_fluid_dynamics.h>
 #include <ode/ode.h>
+#include <QtCore/QHash>
 #include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QVector>
 
 class WbContactProperties;
 class WbImmersionProperties;
@@ -39,7 +42,9 @@ public:
 
   // collision detection and simulation steps
   // for this cluster's world and space
-  void step();
+  // a basic time step may be divided in several sub-steps: the forces added to the bodies before the first sub-step are
+  // applied during all of them, and the sensor rays are only collided in the last one
+  void step(double ms, bool lastSubStep = true);
 
   // ODE objects
   dWorldID world() const;
@@ -50,10 +55,66 @@ public:
 
   void handleInitialCollisions();  // used to synchronize contact point representations and current positions
 
+  // number of contact points discarded by the manifold reduction during the last collision detection
+  int removedContactsCount() const { return mRemovedContactsCount; }
+
+  // write the collision detection cost of each pair of solids in the performance log
+  void reportCollisionCosts() const;
+
 private:
+  // pair of geoms that passed the broadphase and the Webots filters
+  struct CollisionPair {
+    dGeomID o1, o2;
+    int key1, key2;        // unique ids of the colliding nodes, the pairs are merged in this order
+    int serial1, serial2;  // serials of the geom data in the order of the keys, tie-break for the geoms of the same nodes
+    int worker;            // narrowphase buffer holding the contacts
+    int firstContact;      // index of the first contact in this buffer
+    int contactCount;
+    qint64 nanoseconds;  // collision detection time, only measured if the performance log is enabled
+    bool operator<(const CollisionPair &other) const {
+      if (key1 != other.key1)
+        return key1 < other.key1;
+      if (key2 != other.key2)
+        return key2 < other.key2;
+      return serial1 < other.serial1 || (serial1 == other.serial1 && serial2 < other.serial2);
+    }
+  };
+  // pairs and immersions found by the broadphase in one thread
+  struct BroadphaseBuffer {
+    QVector<CollisionPair> pairs;
+    QVector<dImmersion> immersions;
+  };
+
   WbOdeContext *mContext;
   static QMutex *cJointCreationMutex;
 
+  // the broadphase runs in the ODE threads: each thread fills its own buffer, registered once in cBroadphaseBuffers
+  static thread_local BroadphaseBuffer *cThreadBroadphaseBuffer;
+  static QList<BroadphaseBuffer *> cBroadphaseBuffers;
+  static QMutex cBroadphaseBuffersMutex;
+  static BroadphaseBuffer *threadBroadphaseBuffer();
+
+  // narrowphase and merge of the collected pairs, on the calling thread
+  QVector<CollisionPair> mCollisionPairs;
+  QVector<QVector<dContact>> mWorkerContacts;
+  int mRemovedContactsCount;
+  // collision detection cost of the pairs of solids, indexed by their unique ids
+  struct CollisionCost {
+    QString solid1, solid2;
+    qint64 callsCount, contactsCount, nanoseconds;
+  };
+  QHash<QPair<int, int>, CollisionCost> mCollisionCosts;
+  bool mProfileCollisions;
+  void addCollisionCost(const CollisionPair &pair);
+  void collidePairs();
+  static void collidePairsTask(unsigned int task, unsigned int worker, void *data);
+  QVector<dImmersion> mImmersions;
+  QVector<int> mImmersionCounts;                    // number of immersions returned by dImmerse(), -1 if not computed yet
+  QVector<dImmersionOutlineID> mImmersionOutlines;  // reused at every step, mImmersions[i] fills mImmersionOutlines[i]
+  static void immerseTask(unsigned int task, unsigned int worker, void *data);
+  void handleContacts(dGeomID o1, dGeomID o2, dContact *contact, int n);
+  void handleImmersion(dImmersion *immersion);
+
   QList<WbKinematicDifferentialWheels *> mCollisionedRobots;
   void handleKinematicsCollisions();
   void swapBuffer();
@@ -68,6 +129,7 @@ private:
   static void odeSensorRaysUpdate(int threadID);
   static const long long int WEBOTS_MAGIC_NUMBER;
   bool mSwapJointContactBuffer;
+  bool mIntermediateSubStep;
 };
 
 #endif
@@ -40,6 +40,7 @@
 #include "WbWrenRenderingContext.hpp"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
 #include <QtCore/QTimer>
 #include <QtCore/QtGlobal>
 
@@ -111,6 +112,9 @@ WbSimulationWorld::WbSimulationWorld(WbProtoList *protos, WbTokenizer *tokenizer
   if (mWorldLoadingCanceled)
     return;
 
+  // the automatic broadphase selection depends on the geoms created when finalizing the nodes
+  updateBroadphase();
+
   WbMassChecker::instance()->checkMasses();
 
   emit worldLoadingStatusHasChanged(tr("Initializing plugins (if any)"));
@@ -139,7 +143,9 @@ WbSimulationWorld::WbSimulationWorld(WbProtoList *protos, WbTokenizer *tokenizer
   connect(this, &WbSimulationWorld::physicsStepEnded, s, &WbSimulationState::physicsStepEnded);
   connect(this, &WbSimulationWorld::cameraRenderingStarted, s, &WbSimulationState::cameraRenderingStarted);
   connect(worldInfo(), &WbWorldInfo::optimalThreadCountChanged, this, &WbSimulationWorld::updateNumberOfThreads);
+  connect(worldInfo(), &WbWorldInfo::threadingModeChanged, this, &WbSimulationWorld::updateNumberOfThreads);
   connect(worldInfo(), &WbWorldInfo::randomSeedChanged, this, &WbSimulationWorld::updateRandomSeed);
+  connect(worldInfo(), &WbWorldInfo::broadphaseChanged, this, &WbSimulationWorld::updateBroadphase);
 
   if (WbTokenizer::worldFileVersion() < WbVersion(2021, 1, 1))
     WbLog::info(tr("You are using a world from an old version of Webots. The backwards compability algorithm will try to "
@@ -153,8 +159,10 @@ WbSimulationWorld::~WbSimulationWorld() {
   setIsCleaning(true);
 
   WbPerformanceLog *log = WbPerformanceLog::instance();
-  if (log)
+  if (log) {
+    mCluster->reportCollisionCosts();
     log->worldClosed(fileName(), logWorldMetrics());
+  }
 
   delete mTimer;
 
@@ -180,6 +188,12 @@ WbSimulationWorld::~WbSimulationWorld() {
   setIsCleaning(false);
 }
 
+void WbSimulationWorld::clearOdeContacts() {
+  mOdeContacts.clear();
+  // the immersion outlines belong to the cluster which reuses them at the next collision detection
+  mImmersionGeoms.clear();
+}
+
 void WbSimulationWorld::step() {
   WbPerformanceLog *log = WbPerformanceLog::instance();
   if (log)
@@ -222,11 +236,7 @@ void WbSimulationWorld::step() {
 
   if (log)
     log->startMeasure(WbPerformanceLog::PRE_PHYSICS_STEP);
-  mOdeContacts.clear();
-  const int size = mImmersionGeoms.size();
-  for (int i = 0; i < size; ++i)
-    dImmersionOutlineDestroy(mImmersionGeoms.at(i).outline);
-  mImmersionGeoms.clear();
+  clearOdeContacts();
 
   foreach (WbRobot *const robot, robots()) {
     if (robots().contains(robot))  // the 'processImmediateMessages' of another robot may have removed/regenerated this robot
@@ -248,9 +258,23 @@ void WbSimulationWorld::step() {
     log->stopMeasure(WbPerformanceLog::PRE_PHYSICS_STEP);
     log->startMeasure(WbPerformanceLog::PHYSICS_STEP);
   }
-  mCluster->step();
+  // the scene graph, the devices and the controllers are only updated once the sub-steps are over
+  const int subSteps = physicsSubSteps();
+  int removedContactsCount = 0;
+  for (int i = 0; i < subSteps; ++i) {
+    if (i > 0)
+      clearOdeContacts();
+    mCluster->step(timeStep / subSteps, i == subSteps - 1);
+    removedContactsCount += mCluster->removedContactsCount();
+  }
   if (log) {
     log->stopMeasure(WbPerformanceLog::PHYSICS_STEP);
+    int awakeBodiesCount, sleepingBodiesCount;
+    mOdeContext->countBodies(awakeBodiesCount, sleepingBodiesCount);
+    log->reportStepPhysicsStats(removedContactsCount, awakeBodiesCount, sleepingBodiesCount);
+    int contactJointsCount, contactJointAllocationsCount;
+    mOdeContext->contactJointPoolStats(contactJointsCount, contactJointAllocationsCount);
+    log->reportStepContactJointStats(contactJointsCount, contactJointAllocationsCount);
     log->startMeasure(WbPerformanceLog::POST_PHYSICS_STEP);
   }
 
@@ -262,9 +286,14 @@ void WbSimulationWorld::step() {
   if (mPhysicsPlugin)
     mPhysicsPlugin->stepEnd();
 
-  // call postPhysicsStep on all Solids to assign new coordinates
-  foreach (WbSolid *const solid, l)
-    solid->postPhysicsStep();
+  // the poses are computed from the bodies by the worker threads and assigned by postPhysicsStep on the main thread
+  WbSolid::computePhysicsPoses(l, mOdeContext->numberOfThreads());
+
+  // call postPhysicsStep on all Solids to assign new coordinates, the sleeping ones did not move
+  foreach (WbSolid *const solid, l) {
+    if (!solid->isResting())
+      solid->postPhysicsStep();
+  }
 
   emit physicsStepEnded();
 
@@ -363,7 +392,8 @@ void WbSimulationWorld::rayTracingEnabled() {
 void WbSimulationWorld::updateNumberOfThreads() {
   int numberOfthreads =
     qMin(WbPreferences::instance()->value("General/numberOfThreads", 1).toInt(), WbWorld::instance()->optimalThreadCount());
-  mOdeContext->setNumberOfThreads(numberOfthreads);
+  mOdeContext->setNumberOfThreads(numberOfthreads, worldInfo()->threadingMode() == "islands",
+                                  worldInfo()->deterministicPhysics());
 }
 
 void WbSimulationWorld::updateRandomSeed() {
@@ -373,6 +403,14 @@ void WbSimulationWorld::updateRandomSeed() {
     seed = QDateTime::currentMSecsSinceEpoch() + QCoreApplication::applicationPid();
   WbRandom::setSeed(seed);  // Webots random seed
   dRandSetSeed(seed);       // ODE random seed
+  // the QuickStep row order of the world does not depend on the draws of the physics plugin or of the other ODE users, and
+  // it is saved with the state of the world
+  dWorldSetRandomSeed(mOdeContext->world(), seed);
+}
+
+void WbSimulationWorld::updateBroadphase() {
+  assert(worldInfo());
+  mOdeContext->setBroadphase(worldInfo()->broadphase());
 }
 
 void WbSimulationWorld::storeLastSaveTime() {
@@ -416,6 +454,61 @@ void WbSimulationWorld::reset(bool restartControllers) {
   setModified(false);
 }
 
+bool WbSimulationWorld::saveState(const QString &name) {
+  if (mOdeContext->isClustered())
+    return false;
+
+  QByteArray state;
+  QDataStream stream(&state, QIODevice::WriteOnly);
+  const QList<WbSolid *> &solids = topSolids();
+  stream << solids.size();
+  foreach (const WbSolid *solid, solids)
+    stream << solid->uniqueId();
+  unsigned int w, z;
+  WbRandom::getState(w, z);
+  stream << WbSimulationState::instance()->time() << w << z << mOdeContext->saveState();
+  foreach (const WbSolid *solid, solids)
+    solid->writeSnapshot(stream);
+  mSavedStates.insert(name, state);
+  return true;
+}
+
+bool WbSimulationWorld::loadState(const QString &name) {
+  QHash<QString, QByteArray>::const_iterator it = mSavedStates.constFind(name);
+  if (it == mSavedStates.constEnd() || mOdeContext->isClustered())
+    return false;
+
+  QDataStream stream(it.value());
+  const QList<WbSolid *> &solids = topSolids();
+  int count;
+  stream >> count;
+  if (count != solids.size())
+    return false;
+  foreach (const WbSolid *solid, solids) {
+    int id;
+    stream >> id;
+    if (id != solid->uniqueId())
+      return false;
+  }
+  double time;
+  unsigned int w, z;
+  QByteArray odeState;
+  stream >> time >> w >> z >> odeState;
+  // the bodies and the joints are checked by ODE before anything is changed
+  if (!mOdeContext->loadState(odeState))
+    return false;
+
+  foreach (WbSolid *const solid, solids)
+    solid->readSnapshot(stream);
+  WbSimulationState::instance()->setTime(time);
+  WbRandom::setState(w, z);
+
+  // the contact joints were removed with the state, they are recreated at the loaded positions
+  clearOdeContacts();
+  mCluster->handleInitialCollisions();
+  return true;
+}
+
 void WbSimulationWorld::storeAddedNodeIfNeeded(WbNode *node) {
   mAddedNode << node;
   connect(node, &QObject::destroyed, this, &WbSimulationWorld::removeNodeFromAddedNodeList);
@@ -19,7 +19,9 @@
 // Description: world with physics/kinematic simulation
 //
 
+#include <QtCore/QByteArray>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 
@@ -50,6 +52,14 @@ public:
   bool saveAs(const QString &fileName) override;
   void reset(bool restartControllers) override;
 
+  // in-memory snapshots of the simulation time, of the random generators, of the ODE bodies and joints and of the joint
+  // positions and devices, saved and loaded by a Supervisor controller, they are lost when the world is reloaded
+  // they are not supported when the physics is clustered: the contact caches and the random generators of the cluster
+  // worlds are not part of the ODE snapshot, both functions return false and do nothing in this case
+  bool saveState(const QString &name);
+  // returns false and does not change anything if no state was saved with this name or if solids were added or removed
+  virtual bool loadState(const QString &name);
+
   void pauseStepTimer();
   void restartStepTimer();
 
@@ -80,15 +90,19 @@ private:
   double mSleepRealTime;
   QList<int> mElapsedTimeHistory;
   QVector<WbNode *> mAddedNode;  // list of nodes added since the simulation started
+  QHash<QString, QByteArray> mSavedStates;
 
   void storeLastSaveTime() override;
   bool mSimulationHasRunAfterSave;
   void propagateBoundingObjectMaterialUpdate(bool onMenuAction);
+  // forget the contact points and immersions of the previous collision detection
+  void clearOdeContacts();
 
 private slots:
   void removeNodeFromAddedNodeList(QObject *node);
   void propagateBoundingObjectUpdate() { propagateBoundingObjectMaterialUpdate(false); }
   void updateRandomSeed();
+  void updateBroadphase();
 };
 
 #endif
@@ -31,12 +31,14 @@
 #include "WbTranslator.hpp"
 #include "WbVersion.hpp"
 #include "WbWorld.hpp"
+#include "WbWrenOffscreenContext.hpp"
 #include "WbWrenOpenGlContext.hpp"
 #include "WbX3dStreamingServer.hpp"
 
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QProcess>
 #include <QtCore/QStringList>
 #include <QtCore/QTimer>
@@ -240,6 +242,25 @@ void WbGuiApplication::parseArguments() {
       mTask = UPDATE_PROTO_CACHE;
     } else if (arg.startsWith("--update-world"))
       mTask = UPDATE_WORLD;
+    else if (arg.startsWith("--batch-steps=")) {
+      bool ok;
+      const int steps = arg.mid(arg.indexOf('=') + 1).toInt(&ok);
+      if (!ok || steps <= 0) {
+        cout << tr("webots: invalid option: '%1': the number of steps should be a positive integer.")
+                  .arg(arg)
+                  .toUtf8()
+                  .constData()
+             << endl;
+        mTask = FAILURE;
+      } else {
+        // the world is loaded paused without creating the main window, see setupHeadless(), and stepped by
+        // WbSingleTaskApplication
+        mTask = BATCH_STEPS;
+        mTaskArguments = QStringList(QString::number(steps));
+        batch = true;
+        WbMessageBox::disable();
+      }
+    }
     else if (arg == "--enable-x3d-meta-file-export")
       WbWorld::enableX3DMetaFileExport();
     else if (arg.startsWith("--stream")) {
@@ -307,7 +328,8 @@ void WbGuiApplication::parseArguments() {
 
   if (logPerformanceMode) {
     WbPerformanceLog::enableSystemInfoLog(mTask == SYSINFO);
-    mTask = NORMAL;
+    if (mTask != BATCH_STEPS)
+      mTask = NORMAL;
   }
 
   if (WbPreferences::booleanEnvironmentVariable("WEBOTS_SAFE_MODE")) {
@@ -322,12 +344,14 @@ void WbGuiApplication::parseArguments() {
 }
 
 int WbGuiApplication::exec() {
+  const bool headless = mTask == BATCH_STEPS;
   if (mTask == NORMAL || mTask == UPDATE_WORLD) {
     if (setup()) {
       QApplication::processEvents();
       loadInitialWorld();
     }
-  }
+  } else if (headless && !setupHeadless())
+    mTask = FAILURE;
 
   WbSingleTaskApplication *task = NULL;
   if (mTask != NORMAL) {
@@ -342,9 +366,42 @@ int WbGuiApplication::exec() {
 
   int ret = QApplication::exec();
   delete task;
+  if (headless) {
+    // without main window, the world has to be deleted before the WREN context in which its nodes were created
+    delete mApplication;
+    mApplication = NULL;
+    WbWrenOffscreenContext::cleanup();
+    WbPerformanceLog::deleteInstance();
+  }
   return ret;
 }
 
+bool WbGuiApplication::setupHeadless() {
+  mSplash = NULL;
+  WbSimulationState::instance()->setMode(WbSimulationState::PAUSE);
+  WbSimulationState::instance()->setRendering(false);
+
+  if (mStartWorldName.isEmpty()) {
+    cerr << tr("A world file is required to run steps in batch.").toUtf8().constData() << endl;
+    return false;
+  }
+  if (QDir::isRelativePath(mStartWorldName))
+    mStartWorldName = mApplication->startupPath() + '/' + mStartWorldName;
+  if (!QFileInfo(mStartWorldName).isReadable()) {
+    cerr << tr("Could not open file: '%1'.").arg(mStartWorldName).toUtf8().constData() << endl;
+    return false;
+  }
+
+  // the nodes create their WREN objects, which are used by the rendering devices, in an offscreen OpenGL context
+  if (!WbWrenOffscreenContext::initialize(640, 480)) {
+    cerr << tr("Webots could not initialize the rendering system.").toUtf8().constData() << endl;
+    return false;
+  }
+
+  mApplication->setup();
+  return mApplication->loadWorld(mStartWorldName, false);
+}
+
 bool WbGuiApplication::setup() {
   WbPreferences *const prefs = WbPreferences::instance();
   if (mStartupMode == WbSimulationState::NONE)
@@ -39,7 +39,19 @@ public:
   void restart();
   static void setWindowsDarkMode(QWidget *);
 
-  enum Task { NORMAL, SYSINFO, HELP, VERSION, UPDATE_PROTO_CACHE, UPDATE_WORLD, INVALID_LOGIN, FAILURE, QUIT, CONVERT };
+  enum Task {
+    NORMAL,
+    SYSINFO,
+    HELP,
+    VERSION,
+    UPDATE_PROTO_CACHE,
+    UPDATE_WORLD,
+    BATCH_STEPS,
+    INVALID_LOGIN,
+    FAILURE,
+    QUIT,
+    CONVERT
+  };
   WbApplication *application() const { return mApplication; };
 
 protected:
@@ -68,6 +80,7 @@ private:
   void showHelp();
   void showSysInfo();
   bool setup();
+  bool setupHeadless();  // loads the world without the main window
   void setSplashMessage(const QString &);
   void closeSplashScreenIfNeeded();
   WbSimulationState::Mode startupModeFromPreferences() const;
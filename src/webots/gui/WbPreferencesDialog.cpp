@@ -23,6 +23,7 @@
 #include "WbStandardPaths.hpp"
 #include "WbSysInfo.hpp"
 #include "WbTranslator.hpp"
+#include "WbTriangleMeshCache.hpp"
 
 #include <QtCore/QDir>
 #include <QtCore/QStringList>
@@ -188,6 +189,8 @@ void WbPreferencesDialog::accept() {
     WbNetwork::instance()->setProxy();
   if (!mCacheSize->text().isEmpty())
     prefs->setValue("Network/cacheSize", mCacheSize->text().toInt());
+  if (!mTreeCacheSize->text().isEmpty())
+    prefs->setValue("General/treeCacheSize", mTreeCacheSize->text().toInt());
   emit changedByUser();
   QDialog::accept();
   if (willRestart)
@@ -206,6 +209,7 @@ void WbPreferencesDialog::openFontDialog() {
 
 void WbPreferencesDialog::clearCache() {
   WbNetwork::instance()->clearCache();
+  WbTriangleMeshCache::clearOdeTreeCache();
   WbMessageBox::info(tr("The cache has been cleared."), this);
   mTabWidget->removeTab(2);
   mTabWidget->addTab(createNetworkTab(), tr("Network"));
@@ -438,13 +442,22 @@ QWidget *WbPreferencesDialog::createNetworkTab() {
   layout->addWidget(mCacheSize, 0, 1);
 
   // row 1
+  mTreeCacheSize = new WbLineEdit(this);
+  mTreeCacheSize->setValidator(new QIntValidator(0, 65535));
+  mTreeCacheSize->setText(WbPreferences::instance()->value("General/treeCacheSize", 1024).toString());
+  layout->addWidget(new QLabel(tr("Set the size of the mesh collision cache (in MB):"), this), 1, 0);
+  layout->addWidget(mTreeCacheSize, 1, 1);
+
+  // row 2
   QPushButton *clearCacheButton = new QPushButton(QString("Clear the cache"), this);
   connect(clearCacheButton, &QPushButton::pressed, this, &WbPreferencesDialog::clearCache);
   layout->addWidget(new QLabel(tr("Amount of cache used : %1 MB.")
-                                 .arg(WbNetwork::instance()->networkAccessManager()->cache()->cacheSize() / (1024 * 1024)),
+                                 .arg((WbNetwork::instance()->networkAccessManager()->cache()->cacheSize() +
+                                       WbTriangleMeshCache::odeTreeCacheSize()) /
+                                      (1024 * 1024)),
                                this),
-                    1, 0);
-  layout->addWidget(clearCacheButton, 1, 1);
+                    2, 0);
+  layout->addWidget(clearCacheButton, 2, 1);
 
   return widget;
 }
@@ -14,12 +14,15 @@
 
 #include "WbSingleTaskApplication.hpp"
 
+#include "WbApplication.hpp"
 #include "WbApplicationInfo.hpp"
 #include "WbBasicJoint.hpp"
+#include "WbControlledWorld.hpp"
 #include "WbField.hpp"
 #include "WbProtoCachedInfo.hpp"
 #include "WbProtoList.hpp"
 #include "WbProtoModel.hpp"
+#include "WbSimulationState.hpp"
 #include "WbSysInfo.hpp"
 #include "WbTokenizer.hpp"
 #include "WbVersion.hpp"
@@ -27,6 +30,7 @@
 
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFileInfo>
 #include <QtGui/QOpenGLContext>
 #include <QtGui/QOpenGLFunctions>
@@ -52,6 +56,8 @@ void WbSingleTaskApplication::run() {
     updateProtoCacheFiles();
   else if (mTask == WbGuiApplication::UPDATE_WORLD)
     WbWorld::instance()->save();
+  else if (mTask == WbGuiApplication::BATCH_STEPS)
+    runSteps();
   else if (mTask == WbGuiApplication::CONVERT)
     convertProto();
 
@@ -157,6 +163,56 @@ void WbSingleTaskApplication::convertProto() const {
     cout << tr("The %1 PROTO is written to the file.").arg(model->name()).toUtf8().constData() << endl;
 }
 
+void WbSingleTaskApplication::runSteps() const {
+  const int steps = mTaskArguments.at(0).toInt();
+  WbControlledWorld *const world = WbControlledWorld::instance();
+  WbSimulationState *const state = WbSimulationState::instance();
+
+  // the world is deleted by the queued quit, reload or load requests of the controllers, stop stepping as soon as one is
+  // emitted
+  bool stopRequested = false;
+  const WbApplication *const application = WbApplication::instance();
+  QList<QMetaObject::Connection> connections;
+  connections << connect(application, &WbApplication::simulationQuitRequested, [&stopRequested]() { stopRequested = true; });
+  connections << connect(application, &WbApplication::worldReloadRequested, [&stopRequested]() { stopRequested = true; });
+  connections << connect(application, &WbApplication::worldLoadRequested, [&stopRequested]() { stopRequested = true; });
+
+  // the steps are executed in a tight loop instead of being triggered by the step timer through the event loop
+  state->setMode(WbSimulationState::FAST);
+  world->pauseStepTimer();
+  const double timeStep = world->basicTimeStep();
+  int executedSteps = 0;
+  QElapsedTimer timer;
+  timer.start();
+  while (executedSteps < steps && !stopRequested) {
+    if (world->isExecutingStep()) {
+      // the step waits for a robot window and is completed by the event loop, the event loop also accepts the controller
+      // connections and reads the output of the controller processes
+      QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+      continue;
+    }
+    const double time = state->time();
+    world->step();
+    if (state->time() > time)
+      ++executedSteps;
+    else if (!stopRequested)
+      world->waitForControllerRequests(100);
+  }
+  const double elapsed = timer.nsecsElapsed() * 1e-9;
+
+  foreach (const QMetaObject::Connection &connection, connections)
+    disconnect(connection);
+
+  cout << tr("%1 steps executed in %2 s: %3 steps/s, %4 times faster than real time.")
+            .arg(executedSteps)
+            .arg(elapsed, 0, 'f', 3)
+            .arg(elapsed > 0.0 ? executedSteps / elapsed : 0.0, 0, 'f', 1)
+            .arg(elapsed > 0.0 ? executedSteps * timeStep * 0.001 / elapsed : 0.0, 0, 'f', 2)
+            .toUtf8()
+            .constData()
+       << endl;
+}
+
 void WbSingleTaskApplication::showHelp() const {
   cout << tr("Usage: webots [options] [worldfile]").toUtf8().constData() << endl << endl;
   cout << tr("Options:").toUtf8().constData() << endl << endl;
@@ -177,6 +233,12 @@ void WbSingleTaskApplication::showHelp() const {
   cout << tr("    Minimize the Webots window on startup.").toUtf8().constData() << endl << endl;
   cout << "  --batch" << endl;
   cout << tr("    Prevent Webots from creating blocking pop-up windows.").toUtf8().constData() << endl << endl;
+  cout << "  --batch-steps=<steps>" << endl;
+  cout << tr("    Run the given number of steps of the world as fast as possible and exit.").toUtf8().constData() << endl;
+  cout << tr("    The world is loaded without any window and the steps are executed in a").toUtf8().constData() << endl;
+  cout << tr("    loop without rendering and without going through the event loop, the").toUtf8().constData() << endl;
+  cout << tr("    number of steps per second is printed on exit. This option implies").toUtf8().constData() << endl;
+  cout << tr("    --batch.").toUtf8().constData() << endl << endl;
   cout << "  --stdout" << endl;
   cout << tr("    Redirect the stdout of the controllers to the terminal.").toUtf8().constData() << endl << endl;
   cout << "  --stderr" << endl;
@@ -50,6 +50,7 @@ private:
   void showHelp() const;
   void showSysInfo() const;
   void updateProtoCacheFiles() const;
+  void runSteps() const;
 };
 
 #endif
@@ -44,6 +44,16 @@ unsigned int WbRandom::getSeed() {
   return gW;
 }
 
+void WbRandom::getState(unsigned int &w, unsigned int &z) {
+  w = gW;
+  z = gZ;
+}
+
+void WbRandom::setState(unsigned int w, unsigned int z) {
+  gW = w;
+  gZ = z;
+}
+
 unsigned int WbRandom::nextUInt() {
   gZ = 36969 * (gZ & 65535) + (gZ >> 16);
   gW = 18000 * (gW & 65535) + (gW >> 16);
@@ -23,6 +23,9 @@ namespace WbRandom {
   // reset the random seed
   void setSeed(unsigned int s);
   unsigned int getSeed();
+  // full state of the generator, the seed only gives its first half
+  void getState(unsigned int &w, unsigned int &z);
+  void setState(unsigned int w, unsigned int z);
   // use George Marsaglia's MWC algorithm to produce an unsigned integer
   unsigned int nextUInt();
   // returns a random number between 0..1 from a uniform distribution
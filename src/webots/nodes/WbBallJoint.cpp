@@ -36,6 +36,8 @@
 
 #include <ode/ode.h>
 
+#include <QtCore/QDataStream>
+
 // Constructors
 
 void WbBallJoint::init() {
@@ -694,6 +696,27 @@ void WbBallJoint::save(const QString &id) {
   mSavedPositions3[id] = mPosition3;
 }
 
+void WbBallJoint::writeSnapshot(QDataStream &stream) const {
+  WbHinge2Joint::writeSnapshot(stream);
+
+  for (int i = 0; i < mDevice3->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice3->item(i))->writeSnapshot(stream);
+
+  stream << mPosition3 << mOdePositionOffset3;
+}
+
+void WbBallJoint::readSnapshot(QDataStream &stream) {
+  WbHinge2Joint::readSnapshot(stream);
+
+  for (int i = 0; i < mDevice3->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice3->item(i))->readSnapshot(stream);
+
+  stream >> mPosition3 >> mOdePositionOffset3;
+  WbJointParameters *const p = parameters3();
+  if (p)
+    p->setPositionFromOde(mPosition3);
+}
+
 void WbBallJoint::applyToOdeAxis() {
   assert(mJoint);
 
@@ -40,6 +40,8 @@ public:
   void reset(const QString &id) override;
   void resetPhysics() override;
   void save(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  void readSnapshot(QDataStream &stream) override;
   QVector<WbLogicalDevice *> devices() const override;
   dJointID jointID() const override { return mControlMotor; }
   bool resetJointPositions() override;
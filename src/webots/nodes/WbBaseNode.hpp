@@ -29,6 +29,7 @@ class WbTransform;  // TODO: remove this dependency: a class should not have a d
 class WbSolid;      // TODO: remove this dependency: a class should not have a dependency on its subclass
 class WbBoundingSphere;
 
+class QDataStream;
 struct WrTransform;
 
 class WbBaseNode : public WbNode {
@@ -91,6 +92,11 @@ public:
   virtual void createOdeObjects() { mOdeObjectsCreatedCalled = true; }
   bool areOdeObjectsCreated() const { return mOdeObjectsCreatedCalled; }
 
+  // simulation state which is neither in the fields nor in the ODE bodies, saved in memory by WbSimulationWorld::saveState()
+  // reimplemented in WbSolid (recurse through the joints and the solid children), WbJoint, WbMotor and WbBrake
+  virtual void writeSnapshot(QDataStream &stream) const {}
+  virtual void readSnapshot(QDataStream &stream) {}
+
   // node as bounding object
   virtual bool isAValidBoundingObject(bool checkOde = false, bool warning = true) const { return false; }
   virtual bool isSuitableForInsertionInBoundingObject(bool warning = false) const { return false; }
@@ -20,10 +20,8 @@
 #include "WbFieldChecker.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTransform.hpp"
 #include "WbWorld.hpp"
 #include "WbWrenAbstractResizeManipulator.hpp"
@@ -223,9 +221,7 @@ void WbBox::applyToOdeData(bool correctSolidMass) {
   assert(dGeomGetClass(mOdeGeom) == dBoxClass);
   dGeomBoxSetLengths(mOdeGeom, size.x(), size.y(), size.z());
 
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
 
   if (correctSolidMass)
     applyToOdeMass();
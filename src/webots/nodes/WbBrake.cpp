@@ -45,6 +45,15 @@ void WbBrake::reset(const QString &id) {
   emit brakingChanged();
 }
 
+void WbBrake::writeSnapshot(QDataStream &stream) const {
+  stream << mBrakingDampingConstant;
+}
+
+void WbBrake::readSnapshot(QDataStream &stream) {
+  stream >> mBrakingDampingConstant;
+  emit brakingChanged();
+}
+
 void WbBrake::writeConfigure(QDataStream &stream) {
   stream << (unsigned short)tag();
   stream << (unsigned char)C_CONFIGURE;
@@ -34,6 +34,8 @@ public:
 
   // inherited from WbBaseNode
   void reset(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  void readSnapshot(QDataStream &stream) override;
 
   // inherited from WbDevice
   void writeConfigure(QDataStream &stream) override;
@@ -19,12 +19,10 @@
 #include "WbFieldChecker.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
 #include "WbSFBool.hpp"
 #include "WbSFInt.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTransform.hpp"
 #include "WbWrenRenderingContext.hpp"
 
@@ -318,9 +316,7 @@ void WbCapsule::applyToOdeData(bool correctSolidMass) {
   assert(dGeomGetClass(mOdeGeom) == dCapsuleClass);
   dGeomCapsuleSetParams(mOdeGeom, scaledRadius(), scaledHeight());
 
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
 
   if (correctSolidMass)
     applyToOdeMass();
@@ -361,9 +361,9 @@ void WbConnector::snapOrigins(WbConnector *other) {
   getOriginInWorldCoordinates(p1);
   other->getOriginInWorldCoordinates(p2);
 
-  // retrieve current body positions
-  const dReal *d1 = b1 ? dBodyGetPosition(b1) : matrix().translation().ptr();
-  const dReal *d2 = b2 ? dBodyGetPosition(b2) : other->matrix().translation().ptr();
+  // retrieve current body positions, they are only used if the body exists
+  const dReal *d1 = b1 ? dBodyGetPosition(b1) : NULL;
+  const dReal *d2 = b2 ? dBodyGetPosition(b2) : NULL;
 
   // each body must be shifted towards the other by half the distance
   dReal h[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]};
@@ -770,10 +770,11 @@ void WbConnector::addConfigure(QDataStream &stream) {
 // converts a rotation from quaternion to euler axis/angle representation
 // input: normalized quaternion 'q' in ODE compatible format:  [ w x y z ]
 // output: euler axis and angle 'aa' (VRML-like) format: [ x y z alpha ]
-static inline void quaternionToAxesAndAngle(const double q[4], double aa[4]) {
-#ifndef NDEBUG  // ensure that the quaternion is normalized as it should be
+static inline void quaternionToAxesAndAngle(const dQuaternion q, double aa[4]) {
+#ifndef NDEBUG  // ensure that the quaternion is normalized as it should be, within the precision of dReal
+  const double tolerance = sizeof(dReal) == sizeof(float) ? 1e-6 : 1e-10;
   double nn = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
-  assert(nn > 0.9999999999 && nn < 1.0000000001);
+  assert(nn > 1.0 - tolerance && nn < 1.0 + tolerance);
 #endif
   // if q[0] is slightly greater than 1 or slightly lower than -1, acos(q[0]) will return nan
   // unfortunately, due to floating point rounding, that happens even if the quaternion was just normalized
@@ -15,11 +15,12 @@
 #ifndef WB_CONNECTOR_HPP
 #define WB_CONNECTOR_HPP
 
+#include "WbOdeTypes.hpp"
 #include "WbSolidDevice.hpp"
 
 class WbSensor;
 class WbVector3;
-typedef double dQuaternion[4];
+typedef dReal dQuaternion[4];
 
 struct WrRenderable;
 struct WrMaterial;
@@ -119,7 +120,7 @@ private:
   void snapOrigins(WbConnector *other);
   void snapRotation(WbConnector *other, const WbVector3 &z1, const WbVector3 &z2);
   void rotateBodies(WbConnector *other, const dQuaternion q);
-  void getOriginInWorldCoordinates(double out[3]) const;
+  void getOriginInWorldCoordinates(dReal out[3]) const;
   void snapNow(WbConnector *other);
   double getEffectiveTensileStrength() const;
   double getEffectiveShearStrength() const;
@@ -31,6 +31,7 @@ void WbContactProperties::init() {
   mForceDependentSlip = findMFDouble("forceDependentSlip");
   mSoftErp = findSFDouble("softERP");
   mSoftCfm = findSFDouble("softCFM");
+  mMaxContactJoints = findSFInt("maxContactJoints");
   mBumpSound = findSFString("bumpSound");
   mRollSound = findSFString("rollSound");
   mSlideSound = findSFString("slideSound");
@@ -78,6 +79,7 @@ void WbContactProperties::preFinalize() {
   updateBounceVelocity();
   updateSoftCfm();
   updateSoftErp();
+  updateMaxContactJoints();
   updateBumpSound();
   updateRollSound();
   updateSlideSound();
@@ -96,6 +98,7 @@ void WbContactProperties::postFinalize() {
   connect(mForceDependentSlip, &WbSFDouble::changed, this, &WbContactProperties::updateForceDependentSlip);
   connect(mSoftErp, &WbSFDouble::changed, this, &WbContactProperties::updateSoftErp);
   connect(mSoftCfm, &WbSFDouble::changed, this, &WbContactProperties::updateSoftCfm);
+  connect(mMaxContactJoints, &WbSFInt::changed, this, &WbContactProperties::updateMaxContactJoints);
   connect(mBumpSound, &WbSFString::changed, this, &WbContactProperties::updateBumpSound);
   connect(mRollSound, &WbSFString::changed, this, &WbContactProperties::updateRollSound);
   connect(mSlideSound, &WbSFString::changed, this, &WbContactProperties::updateSlideSound);
@@ -197,6 +200,17 @@ void WbContactProperties::updateSoftErp() {
   emit needToEnableBodies();
 }
 
+void WbContactProperties::updateMaxContactJoints() {
+  // dCollide never returns more than 10 contact points per pair in WbSimulationCluster
+  if (WbFieldChecker::resetIntIfNotInRangeWithIncludedBounds(this, mMaxContactJoints, 1, 10, 10))
+    return;
+
+  if (areOdeObjectsCreated())
+    emit valuesChanged();
+
+  emit needToEnableBodies();
+}
+
 void WbContactProperties::loadSound(int index, const QString &sound, const QString &name, const WbSoundClip **clip) {
   if (isPostFinalizedCalled() && WbUrl::isWeb(name) && mDownloader[index] == NULL) {
     downloadAsset(name, index);
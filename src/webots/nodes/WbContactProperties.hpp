@@ -18,6 +18,7 @@
 #include "WbBaseNode.hpp"
 #include "WbMFDouble.hpp"
 #include "WbSFDouble.hpp"
+#include "WbSFInt.hpp"
 #include "WbSFString.hpp"
 #include "WbSFVector2.hpp"
 #include "WbSFVector3.hpp"
@@ -54,6 +55,7 @@ public:
   double forceDependentSlip(int index) const { return mForceDependentSlip->item(index); }
   double softERP() const { return mSoftErp->value(); }
   double softCFM() const { return mSoftCfm->value(); }
+  int maxContactJoints() const { return mMaxContactJoints->value(); }
   const WbSoundClip *bumpSoundClip() const { return mBumpSoundClip; }
   const WbSoundClip *rollSoundClip() const { return mRollSoundClip; }
   const WbSoundClip *slideSoundClip() const { return mSlideSoundClip; }
@@ -74,6 +76,7 @@ private:
   WbMFDouble *mForceDependentSlip;
   WbSFDouble *mSoftCfm;
   WbSFDouble *mSoftErp;
+  WbSFInt *mMaxContactJoints;
   WbSFString *mBumpSound;
   WbSFString *mRollSound;
   WbSFString *mSlideSound;
@@ -95,6 +98,7 @@ private slots:
   void updateBounceVelocity();
   void updateSoftCfm();
   void updateSoftErp();
+  void updateMaxContactJoints();
   void updateBumpSound();
   void updateRollSound();
   void updateSlideSound();
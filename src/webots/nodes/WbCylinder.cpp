@@ -21,12 +21,10 @@
 #include "WbMathsUtilities.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
 #include "WbSFBool.hpp"
 #include "WbSFInt.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTransform.hpp"
 #include "WbWrenRenderingContext.hpp"
 
@@ -335,9 +333,7 @@ void WbCylinder::applyToOdeData(bool correctSolidMass) {
   assert(dGeomGetClass(mOdeGeom) == dCylinderClass);
   dGeomCylinderSetParams(mOdeGeom, scaledRadius(), scaledHeight());
 
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
 
   if (correctSolidMass)
     applyToOdeMass();
@@ -22,14 +22,12 @@
 #include "WbMFDouble.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
 #include "WbRgb.hpp"
 #include "WbSFBool.hpp"
 #include "WbSFDouble.hpp"
 #include "WbSFInt.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTransform.hpp"
 #include "WbWrenMeshBuffers.hpp"
 #include "WbWrenRenderingContext.hpp"
@@ -446,9 +444,7 @@ void WbElevationGrid::applyToOdeData(bool correctSolidMass) {
   assert(dGeomGetClass(mOdeGeom) == dHeightfieldClass);
 
   dGeomHeightfieldSetHeightfieldData(mOdeGeom, mHeightfieldData);
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
   mLocalOdeGeomOffsetPosition = WbVector3(scaledWidth() / 2.0, scaledDepth() / 2.0, 0.0);
 }
 
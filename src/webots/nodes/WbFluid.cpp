@@ -25,6 +25,7 @@
 #include "WbNodeUtilities.hpp"
 #include "WbOdeContext.hpp"
 #include "WbOdeGeomData.hpp"
+#include "WbOdeUtilities.hpp"
 #include "WbPlane.hpp"
 #include "WbRotation.hpp"
 #include "WbSimulationState.hpp"
@@ -216,8 +217,11 @@ void WbFluid::updateViscosity() {
 }
 
 void WbFluid::updateStreamVelocity() {
-  if (mOdeFluid)
-    dFluidSetStreamVel(mOdeFluid, mStreamVelocity->value().ptr());
+  if (mOdeFluid) {
+    dVector3 velocity;
+    WbOdeUtilities::vector3ToOde(mStreamVelocity->value(), velocity);
+    dFluidSetStreamVel(mOdeFluid, velocity);
+  }
 }
 
 double WbFluid::density() const {
@@ -22,9 +22,11 @@
 #include "WbOdeGeomData.hpp"
 #include "WbPrecision.hpp"
 #include "WbResizeManipulator.hpp"
+#include "WbRobot.hpp"
 #include "WbSimulationState.hpp"
 #include "WbSlot.hpp"
 #include "WbSolid.hpp"
+#include "WbSolidDevice.hpp"
 #include "WbVector4.hpp"
 #include "WbWorld.hpp"
 #include "WbWrenMeshBuffers.hpp"
@@ -476,12 +478,25 @@ void WbGeometry::setOdeData(dGeomID geom, WbMatter *matterAncestor) {
 
   mOdeGeom = geom;
   WbSolid *s = dynamic_cast<WbSolid *>(matterAncestor);
-  if (s)
+  if (s) {
     dGeomSetData(geom, new WbOdeGeomData(s, this));
-  else
+    // the resting geoms of the sleeping solids are not collided with each other nor with the static environment, except for
+    // the devices and robots which need to detect these collisions
+    dGeomSetSleepCulling(geom, !dynamic_cast<WbSolidDevice *>(s) && !dynamic_cast<WbRobot *>(s));
+  } else
     dGeomSetData(geom, new WbOdeGeomData(dynamic_cast<WbFluid *>(matterAncestor), this));
 }
 
+void WbGeometry::setOdeGeomChanged() {
+  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
+  assert(odeGeomData);
+  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  // the sleeping solids touching this geometry are not collided with it anymore, see dGeomSetSleepCulling()
+  WbSolid *const solid = odeGeomData->solid();
+  if (solid && WbWorld::instance())
+    solid->awake();
+}
+
 // Utility functions
 
 WbBaseNode *WbGeometry::transformedGeometry() {  // returns an upper WbTransform lying in the same boundingObject if it does
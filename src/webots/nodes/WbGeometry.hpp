@@ -178,6 +178,8 @@ protected:
   WbVector3 mLocalOdeGeomOffsetPosition;
   dMass *mOdeMass;        // needed to correct the WbSolid parent mass after the destruction of a bounding WbGeometry
   void applyToOdeMass();  // modifies the ODE dMass when the dimensions change
+  // to be called when the ODE dGeom is resized, wakes up the solids it may touch
+  void setOdeGeomChanged();
   WbBaseNode *transformedGeometry();
   // Fluid
   virtual void checkFluidBoundingObjectOrientation();
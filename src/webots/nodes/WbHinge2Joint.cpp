@@ -31,6 +31,8 @@
 #include <wren/static_mesh.h>
 #include <wren/transform.h>
 
+#include <QtCore/QDataStream>
+
 // Constructors
 
 void WbHinge2Joint::init() {
@@ -430,6 +432,9 @@ void WbHinge2Joint::postPhysicsStep() {
     // if not controlling in position we use the angle rate feedback to update position (because at high speed angle feedback is
     // under-estimated)
     mPosition -= dJointGetHinge2Angle1Rate(mJoint) * mTimeStep / 1000.0;
+    if (WbWorld::instance()->physicsSubSteps() > 1)
+      // the rate of the last sub-step only tells how many turns the joint made during the whole step
+      mPosition = WbMathsUtilities::normalizeAngle(-dJointGetHinge2Angle1(mJoint) + mOdePositionOffset, mPosition);
   }
   WbJointParameters *const p = parameters();
   if (p)
@@ -440,8 +445,11 @@ void WbHinge2Joint::postPhysicsStep() {
 
   if (rm2 && rm2->isPIDPositionControl())
     mPosition2 = WbMathsUtilities::normalizeAngle(dJointGetHinge2Angle2(mJoint) + mOdePositionOffset2, mPosition2);
-  else
+  else {
     mPosition2 -= dJointGetHinge2Angle2Rate(mJoint) * mTimeStep / 1000.0;
+    if (WbWorld::instance()->physicsSubSteps() > 1)
+      mPosition2 = WbMathsUtilities::normalizeAngle(dJointGetHinge2Angle2(mJoint) + mOdePositionOffset2, mPosition2);
+  }
   WbJointParameters *const p2 = parameters2();
   if (p2)
     p2->setPositionFromOde(mPosition2);
@@ -484,6 +492,27 @@ void WbHinge2Joint::save(const QString &id) {
   mSavedPositions2[id] = mPosition2;
 }
 
+void WbHinge2Joint::writeSnapshot(QDataStream &stream) const {
+  WbJoint::writeSnapshot(stream);
+
+  for (int i = 0; i < mDevice2->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice2->item(i))->writeSnapshot(stream);
+
+  stream << mPosition2 << mOdePositionOffset2;
+}
+
+void WbHinge2Joint::readSnapshot(QDataStream &stream) {
+  WbJoint::readSnapshot(stream);
+
+  for (int i = 0; i < mDevice2->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice2->item(i))->readSnapshot(stream);
+
+  stream >> mPosition2 >> mOdePositionOffset2;
+  WbJointParameters *const p = parameters2();
+  if (p)
+    p->setPositionFromOde(mPosition2);
+}
+
 void WbHinge2Joint::updateEndPointZeroTranslationAndRotation() {
   if (solidEndPoint() == NULL)
     return;
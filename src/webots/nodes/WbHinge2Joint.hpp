@@ -42,6 +42,8 @@ public:
   void reset(const QString &id) override;
   void resetPhysics() override;
   void save(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  void readSnapshot(QDataStream &stream) override;
   QVector<WbLogicalDevice *> devices() const override;
   bool resetJointPositions() override;
   void setPosition(double position, int index = 1) override;
@@ -361,6 +361,13 @@ void WbHingeJoint::postPhysicsStep() {
     if (mIsReverseJoint)
       angleRate = -angleRate;
     mPosition -= angleRate * mTimeStep / 1000.0;
+    if (WbWorld::instance()->physicsSubSteps() > 1) {
+      // the rate of the last sub-step only tells how many turns the joint made during the whole step
+      double angle = dJointGetHingeAngle(mJoint);
+      if (!mIsReverseJoint)
+        angle = -angle;
+      mPosition = WbMathsUtilities::normalizeAngle(angle + mOdePositionOffset, mPosition);
+    }
   }
   WbJointParameters *const p = parameters();
   if (p)
@@ -31,6 +31,8 @@
 
 #include <ode/ode.h>
 
+#include <QtCore/QDataStream>
+
 void WbJoint::init() {
   mDevice = findMFNode("device");
 
@@ -121,6 +123,23 @@ void WbJoint::save(const QString &id) {
   mSavedPositions[id] = mPosition;
 }
 
+void WbJoint::writeSnapshot(QDataStream &stream) const {
+  for (int i = 0; i < mDevice->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice->item(i))->writeSnapshot(stream);
+
+  stream << mPosition << mOdePositionOffset;
+}
+
+void WbJoint::readSnapshot(QDataStream &stream) {
+  for (int i = 0; i < mDevice->size(); ++i)
+    static_cast<WbBaseNode *>(mDevice->item(i))->readSnapshot(stream);
+
+  stream >> mPosition >> mOdePositionOffset;
+  WbJointParameters *const p = parameters();
+  if (p)
+    p->setPositionFromOde(mPosition);
+}
+
 void WbJoint::setPosition(double position, int index) {
   if (index != 1)
     return;
@@ -43,6 +43,8 @@ public:
   void reset(const QString &id) override;
   virtual void resetPhysics();
   void save(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  void readSnapshot(QDataStream &stream) override;
   virtual QVector<WbLogicalDevice *> devices() const;
 
   WbJointParameters *parameters() const;
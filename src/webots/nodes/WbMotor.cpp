@@ -795,6 +795,16 @@ void WbMotor::reset(const QString &id) {
   mMotorForceOrTorque = mMaxForceOrTorque->value();
 }
 
+void WbMotor::writeSnapshot(QDataStream &stream) const {
+  stream << mTargetPosition << mTargetVelocity << mCurrentVelocity << mRawInput << mUserControl << mErrorIntegral
+         << mPreviousError << mMotorForceOrTorque << mKinematicVelocitySign;
+}
+
+void WbMotor::readSnapshot(QDataStream &stream) {
+  stream >> mTargetPosition >> mTargetVelocity >> mCurrentVelocity >> mRawInput >> mUserControl >> mErrorIntegral >>
+    mPreviousError >> mMotorForceOrTorque >> mKinematicVelocitySign;
+}
+
 void WbMotor::awake() const {
   const WbJoint *const j = joint();
   if (j) {
@@ -74,6 +74,8 @@ public:
   void writeAnswer(QDataStream &stream) override;
   bool refreshSensorIfNeeded() override;
   void reset(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  void readSnapshot(QDataStream &stream) override;
 
   QList<const WbBaseNode *> findClosestDescendantNodesWithDedicatedWrenNode() const override;
 
@@ -223,9 +223,9 @@ void WbPropeller::prePhysicsStep(double ms) {
     // Computes thrust and torque
     const WbTransform *const ut = upperTransform();
     const WbVector3 &cot = ut->matrix() * mCenterOfThrust->value();
-    double vp[4];
+    dVector3 vp;
     dBodyGetPointVel(b, cot.x(), cot.y(), cot.z(), vp);
-    const double V = dCalcVectorDot3(vp, mNormalizedAxis.ptr());
+    const double V = WbVector3(vp).dot(mNormalizedAxis);
 
     const WbVector2 &tcs = mTorqueConstants->value();
     mCurrentTorque = tcs.x() * velocity * absoluteVelocity - tcs.y() * absoluteVelocity * V;
@@ -37,6 +37,7 @@
 #include "WbOdeContact.hpp"
 #include "WbOdeContext.hpp"
 #include "WbOdeGeomData.hpp"
+#include "WbOdeUtilities.hpp"
 #include "WbPhysics.hpp"
 #include "WbPlane.hpp"
 #include "WbPropeller.hpp"
@@ -67,10 +68,13 @@
 #include <wren/transform.h>
 
 #include <ode/fluid_dynamics/ode_fluid_dynamics.h>
+#include <ode/ode_MT.h>
 
+#include <QtCore/QDataStream>
 #include <QtCore/QQueue>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStringList>
+#include <QtCore/QVarLengthArray>
 
 using namespace WbHiddenKinematicParameters;
 using namespace WbSolidUtilities;
@@ -105,6 +109,7 @@ void WbSolid::init() {
   mIsKinematic = false;
   mUpdatedInStep = false;
   mResetPhysicsInStep = false;
+  mPhysicsPose = NULL;
   mKinematicWarningPrinted = false;
   mHasDynamicSolidDescendant = false;
 
@@ -977,9 +982,8 @@ void WbSolid::adjustOdeMass(bool mergeMass) {
 
     // Translate the mass to solid's origin
     if (p->centerOfMass().size() == 1) {
-      dVector3 t;
-      dSubtractVectors3(t, scaledCenterOfMass().ptr(), mReferenceMass->c);
-      dMassTranslate(mOdeMass, t[0], t[1], t[2]);
+      const WbVector3 t = scaledCenterOfMass() - WbVector3(mReferenceMass->c);
+      dMassTranslate(mOdeMass, t.x(), t.y(), t.z());
     }
   }
 
@@ -1406,12 +1410,12 @@ void WbSolid::setInertiaMatrixFromBoundingObject() {
 
   p->setDensity(-1.0, true);
 
-  const double *const I = mReferenceMass->I;
+  const dReal *const I = mReferenceMass->I;
   s5 *= s3;
   p->setInertiaMatrix(I[0] * s5, I[5] * s5, I[10] * s5, I[1] * s5, I[2] * s5, I[6] * s5, true);
   p->checkInertiaMatrix(false);
 
-  const double *const c = mReferenceMass->c;
+  const dReal *const c = mReferenceMass->c;
   p->setCenterOfMass(c[0] * s, c[1] * s, c[2] * s, true);
   p->parsingInfo(tr("Bounding object's center of mass inserted."));
 
@@ -1624,7 +1628,7 @@ void WbSolid::updateCenterOfBuoyancy() {
   for (int i = 0; i < size; ++i) {
     const dImmersionGeom &ig = mListOfImmersions.at(i);
     const double volume = ig.volume;
-    const double *const cob = ig.buoyancyCenter;
+    const dReal *const cob = ig.buoyancyCenter;
     const dReal density = dFluidGetDensity(dGeomGetFluid(ig.g2));
     const dReal mass = density * volume;
     mCenterOfBuoyancy += mass * WbVector3(cob[0], cob[1], cob[2]);
@@ -1819,9 +1823,8 @@ void WbSolid::createOdeMass(bool reset) {
 
     // Translate the mass to solid's origin
     if (p->centerOfMass().size() == 1) {
-      dVector3 t;
-      dSubtractVectors3(t, scaledCenterOfMass().ptr(), mReferenceMass->c);
-      dMassTranslate(mOdeMass, t[0], t[1], t[2]);
+      const WbVector3 t = scaledCenterOfMass() - WbVector3(mReferenceMass->c);
+      dMassTranslate(mOdeMass, t.x(), t.y(), t.z());
     }
 
     updateTopSolidGlobalMass();
@@ -1843,7 +1846,7 @@ double WbSolid::volume() const {
   return 0.001 * mReferenceMass->mass;
 }
 
-const double *WbSolid::inertiaMatrix() const {
+const dReal *WbSolid::inertiaMatrix() const {
   return mMassAroundCoM->I;
 }
 
@@ -1893,74 +1896,92 @@ void WbSolid::updateTransformForPhysicsStep() {
 
   applyPhysicsTransform();
 
-  QList<WbSolid *> reversedList;
-  reversedList << this;
-  WbSolid *s = NULL;
-  WbNode *p = parentNode();
-  while (p != NULL && !p->isWorldRoot()) {
-    s = dynamic_cast<WbSolid *>(p);
-    if (s != NULL) {
-      if (s->mUpdatedInStep)
-        break;  // ancestor nodes already updated
-      reversedList.prepend(s);
-    }
-    p = p->parentNode();
+  // the cached upper solids are used instead of searching the solids among all the ancestor nodes
+  QVarLengthArray<WbSolid *, 16> ancestors;
+  ancestors.append(this);
+  WbSolid *s = upperSolid();
+  while (s && !s->mUpdatedInStep) {  // stop at the ancestor nodes already updated
+    ancestors.append(s);
+    s = s->upperSolid();
   }
 
   // update transform from root to current node as applyPhysicsTransform uses the upper transform matrix
-  QListIterator<WbSolid *> it(reversedList);
-  while (it.hasNext()) {
-    s = it.next();
+  for (int i = ancestors.size() - 1; i >= 0; --i) {
+    s = ancestors.at(i);
     s->applyPhysicsTransform();
     s->mUpdatedInStep = true;
   }
 }
 
 void WbSolid::applyPhysicsTransform() {
-  dVector3 result;  // VRML translation
-  dQuaternion qr;   // VRML rotation
-
-  // get current body rotation
   dBodyID b = body();
   if (!b)
     return;
-  dBodyCopyQuaternion(b, qr);
 
+  applyPhysicsVelocity(b);
+
+  double translation[3], rotation[4];
+  const WbTransform *const ut = upperTransform();
+  if (ut)
+    computePhysicsTransform(b, &ut->matrix(), 1.0 / ut->absoluteScale().x(), mSolidMerger->scaledCenterOfMass(), translation,
+                            rotation);
+  else
+    computePhysicsTransform(b, NULL, 1.0, mSolidMerger->scaledCenterOfMass(), translation, rotation);
+
+  // block signals from WbTransform (baseclass): we don't want to update the bodies and the geoms
+  setTransformFromOde(translation[0], translation[1], translation[2], rotation[0], rotation[1], rotation[2], rotation[3]);
+}
+
+void WbSolid::applyPhysicsVelocity(dBodyID b) {
   // update linear and angular velocity
   if (mLinearVelocity && mAngularVelocity) {
-    const double *const l = dBodyGetLinearVel(b);
-    const double *const a = dBodyGetAngularVel(b);
+    const dReal *const l = dBodyGetLinearVel(b);
+    const dReal *const a = dBodyGetAngularVel(b);
     mLinearVelocity->setValue(l[0], l[1], l[2]);
     mAngularVelocity->setValue(a[0], a[1], a[2]);
   }
+}
+
+// only reads the body and the arguments, so that it can be called from the worker threads
+void WbSolid::computePhysicsTransform(dBodyID b, const WbMatrix4 *upperMatrix, double invUpperScale,
+                                      const WbVector3 &centerOfMass, double translation[3], double rotation[4]) {
+  dVector3 result;  // VRML translation
+  dQuaternion qr;   // VRML rotation
+
+  // get current body rotation
+  dBodyCopyQuaternion(b, qr);
 
   // find Solid merger's frame center in world coordinates
-  const WbVector3 &com = mSolidMerger->scaledCenterOfMass();
-  if (com.isNull())
+  if (centerOfMass.isNull())
     dBodyCopyPosition(b, result);
   else
     // Solid center != com in this case
-    dBodyGetRelPointPos(b, -com.x(), -com.y(), -com.z(), result);
+    dBodyGetRelPointPos(b, -centerOfMass.x(), -centerOfMass.y(), -centerOfMass.z(), result);
   assert(!std::isnan(result[0]));
   // printf("new body pos = %f, %f, %f (apply phy.)\n", result[0], result[1], result[2]);
-  const WbTransform *const ut = upperTransform();
-  if (ut) {
-    const double invUtScale = 1.0 / ut->absoluteScale().x();
-    const double scaleFactor = invUtScale * invUtScale;
-    const WbMatrix4 &utm = ut->matrix();
-    const WbVector3 &prel = utm.pseudoInversed(WbVector3(result));
+  if (upperMatrix) {
+    const double scaleFactor = invUpperScale * invUpperScale;
+    const WbVector3 &prel = upperMatrix->pseudoInversed(WbVector3(result));
     result[0] = scaleFactor * prel[0];
     result[1] = scaleFactor * prel[1];
     result[2] = scaleFactor * prel[2];
     // printf("result = %f, %f, %f (apply phy.))\n", result[0], result[1], result[2]);
     // find rotation difference between upper transform and solid child
-    const WbQuaternion &q = utm.extractedQuaternion(invUtScale);
-    dQMultiply1(qr, q.ptr(), dBodyGetQuaternion(b));
+    dQuaternion q;
+    WbOdeUtilities::quaternionToOde(upperMatrix->extractedQuaternion(invUpperScale), q);
+    dQMultiply1(qr, q, dBodyGetQuaternion(b));
   }
 
+  translation[0] = result[0];
+  translation[1] = result[1];
+  translation[2] = result[2];
+
   if (std::isnan(qr[0]) || std::isnan(qr[1]) || std::isnan(qr[2]) || std::isnan(qr[3]) ||
       (qr[1] == 0.0 && qr[2] == 0.0 && qr[3] == 0.0)) {
-    setTransformFromOde(result[0], result[1], result[2], 0.0, 1.0, 0.0, 0.0);
+    rotation[0] = 0.0;
+    rotation[1] = 1.0;
+    rotation[2] = 0.0;
+    rotation[3] = 0.0;
     return;
   }
 
@@ -1972,13 +1993,157 @@ void WbSolid::applyPhysicsTransform() {
     angle -= 2.0 * M_PI;
 
   const double normInv = 1.0 / norm;
-  qr[1] *= normInv;
-  qr[2] *= normInv;
-  qr[3] *= normInv;
+  rotation[0] = qr[1] * normInv;
+  rotation[1] = qr[2] * normInv;
+  rotation[2] = qr[3] * normInv;
+  rotation[3] = angle;
+}
+
+// The poses are computed in two passes. appendPhysicsPoses() copies on the main thread everything that is needed besides the
+// ODE bodies: the relative matrices of the intermediate transforms, the matrix of the upper transform of the top solids,
+// the scales and the centers of mass. The worker threads compute one top solid each from these copies, the upper solids
+// being computed before their descendants. The matrices are multiplied in the same order as WbAbstractTransform::matrix()
+// does, so that the staged poses are equal to the ones computed serially by applyPhysicsTransform().
+struct WbSolid::PhysicsPose {
+  WbSolid *solid;
+  dBodyID body;  // NULL if the pose of the solid is not changed by the physics step
+  int parent;    // index of the pose of the upper solid, -1 for a top solid
+  // the relative matrices of the transforms between the upper solid and this solid, or the absolute matrix of the upper
+  // transform for a top solid
+  int firstMatrix;
+  int matrixCount;
+  double invUpperScale;
+  WbVector3 centerOfMass;
+  WbVector3 scale;
+  WbRotation rotation;  // value of the rotation field, updated the same way as WbSFRotation::setValueFromOde() does
+  // staged results
+  double odeTranslation[3];
+  double odeRotation[4];
+  WbMatrix4 matrix;  // absolute matrix, the relative one is copied beforehand if the solid is not moved by the physics
+};
+
+struct WbSolid::PhysicsPoses {
+  QVector<PhysicsPose> poses;
+  QVector<WbMatrix4> matrices;
+  QVector<int> tasks;  // index of the first pose of each top solid followed by the end of the last one
+};
+
+void WbSolid::computePhysicsPoses(const QList<WbSolid *> &topSolids, int threadCount) {
+  static PhysicsPoses p;
+  p.poses.clear();
+  p.matrices.clear();
+  p.tasks.clear();
+  if (threadCount <= 1)
+    return;
 
-  // block signals from WbTransform (baseclass): we don't want to update the bodies and the geoms
-  // printf("pos = %f, %f, %f\n", result[0], result[1], result[2]);
-  setTransformFromOde(result[0], result[1], result[2], qr[1], qr[2], qr[3], angle);
+  foreach (const WbSolid *const solid, topSolids) {
+    if (solid->isResting())
+      continue;
+    const int first = p.poses.size();
+    solid->appendPhysicsPoses(-1, p.poses, p.matrices);
+    if (p.poses.size() > first)
+      p.tasks.append(first);
+  }
+  if (p.tasks.size() < 2)
+    return;  // applyPhysicsTransform() is called by postPhysicsStep()
+  p.tasks.append(p.poses.size());
+
+  dRunWorkerTasks(p.tasks.size() - 1, threadCount, &computePhysicsPosesTask, &p);
+
+  for (int i = 0; i < p.poses.size(); ++i) {
+    const PhysicsPose &pose = p.poses.at(i);
+    if (pose.body)
+      pose.solid->mPhysicsPose = &pose;
+  }
+}
+
+void WbSolid::computePhysicsPosesTask(unsigned int task, unsigned int worker, void *data) {
+  PhysicsPoses *const p = static_cast<PhysicsPoses *>(data);
+  PhysicsPose *const poses = p->poses.data();
+  const WbMatrix4 *const matrices = p->matrices.constData();
+  const int end = p->tasks.at(task + 1);
+  for (int i = p->tasks.at(task); i < end; ++i) {
+    PhysicsPose &pose = poses[i];
+    WbMatrix4 upperMatrix;
+    bool hasUpperMatrix = true;
+    if (pose.parent >= 0) {
+      upperMatrix = poses[pose.parent].matrix;
+      for (int j = pose.firstMatrix; j < pose.firstMatrix + pose.matrixCount; ++j)
+        upperMatrix = upperMatrix * matrices[j];
+    } else if (pose.matrixCount > 0)
+      upperMatrix = matrices[pose.firstMatrix];
+    else
+      hasUpperMatrix = false;
+
+    if (pose.body) {
+      computePhysicsTransform(pose.body, hasUpperMatrix ? &upperMatrix : NULL, pose.invUpperScale, pose.centerOfMass,
+                              pose.odeTranslation, pose.odeRotation);
+      const double *const r = pose.odeRotation;
+      if (pose.rotation != WbRotation(r))
+        pose.rotation.setAxisAngle(r[0], r[1], r[2], r[3]);
+      pose.matrix.fromVrml(pose.odeTranslation[0], pose.odeTranslation[1], pose.odeTranslation[2], pose.rotation.x(),
+                           pose.rotation.y(), pose.rotation.z(), pose.rotation.angle(), pose.scale.x(), pose.scale.y(),
+                           pose.scale.z());
+    }
+    if (hasUpperMatrix)
+      pose.matrix = upperMatrix * pose.matrix;
+  }
+}
+
+void WbSolid::appendPhysicsPoses(int parent, QVector<PhysicsPose> &poses, QVector<WbMatrix4> &matrices) const {
+  if (mResetPhysicsInStep)
+    return;  // the physics is reset first by postPhysicsStep() which then computes the poses of this subtree serially
+
+  const int firstMatrix = matrices.size();
+  const WbTransform *const ut = upperTransform();
+  if (parent < 0) {
+    if (ut)
+      matrices.append(ut->matrix());
+  } else {
+    const WbTransform *const us = poses.at(parent).solid;
+    QVarLengthArray<const WbTransform *, 8> transforms;
+    for (const WbTransform *t = ut; t != us; t = t->upperTransform()) {
+      if (!t) {
+        matrices.resize(firstMatrix);
+        return;
+      }
+      transforms.append(t);
+    }
+    for (int i = transforms.size() - 1; i >= 0; --i) {
+      const WbTransform *const t = transforms.at(i);
+      WbMatrix4 m;
+      m.fromVrml(t->translation(), t->rotation(), t->scale());
+      matrices.append(m);
+    }
+  }
+
+  PhysicsPose pose;
+  pose.solid = const_cast<WbSolid *>(this);
+  const dBodyID b = body();
+  pose.body = b && dBodyIsEnabled(b) ? b : NULL;
+  pose.parent = parent;
+  pose.firstMatrix = firstMatrix;
+  pose.matrixCount = matrices.size() - firstMatrix;
+  pose.invUpperScale = ut ? 1.0 / ut->absoluteScale().x() : 1.0;
+  if (pose.body) {
+    pose.centerOfMass = mSolidMerger->scaledCenterOfMass();
+    pose.scale = scale();
+    pose.rotation = rotation();
+  } else
+    pose.matrix.fromVrml(translation(), rotation(), scale());
+  poses.append(pose);
+
+  const int index = poses.size() - 1;
+  for (int i = 0; i < mSolidChildren.size(); ++i)
+    mSolidChildren.at(i)->appendPhysicsPoses(index, poses, matrices);
+}
+
+void WbSolid::applyPhysicsPose() {
+  const PhysicsPose *const pose = mPhysicsPose;
+  applyPhysicsVelocity(pose->body);
+  const double *const t = pose->odeTranslation;
+  const double *const r = pose->odeRotation;
+  setTransformFromOde(t[0], t[1], t[2], r[0], r[1], r[2], r[3]);
 }
 
 //////////////////
@@ -1998,8 +2163,13 @@ void WbSolid::postPhysicsStep() {
     mResetPhysicsInStep = false;
   }
 
-  if (body && dBodyIsEnabled(body))
-    applyPhysicsTransform();
+  if (body && dBodyIsEnabled(body)) {
+    if (mPhysicsPose)
+      applyPhysicsPose();
+    else
+      applyPhysicsTransform();
+  }
+  mPhysicsPose = NULL;
 
   // Warning: do not use foreach here => Qt foreach loop are very inefficient here
   for (i = 0; i < mJointChildren.size(); ++i)
@@ -2108,6 +2278,25 @@ bool WbSolid::isSleeping() const {
   return false;
 }
 
+bool WbSolid::isResting() const {
+  // the devices and robots have to be updated after each physics step
+  if (nodeType() != WB_NODE_SOLID || mResetPhysicsInStep || !isSleeping())
+    return false;
+
+  // a disabled joint doesn't connect its end point to the island of this solid
+  for (int i = 0; i < mJointChildren.size(); ++i) {
+    if (!mJointChildren.at(i)->isEnabled())
+      return false;
+  }
+
+  for (int i = 0; i < mSolidChildren.size(); ++i) {
+    if (!mSolidChildren.at(i)->isResting())
+      return false;
+  }
+
+  return true;
+}
+
 // ODE encapsulated methods
 void WbSolid::addForceAtPosition(const WbVector3 &force, const WbVector3 &position) {
   dBodyAddForceAtPos(bodyMerger(), force.x(), force.y(), force.z(), position.x(), position.y(), position.z());
@@ -2208,6 +2397,23 @@ void WbSolid::save(const QString &id) {
     p->save(id);
 }
 
+void WbSolid::writeSnapshot(QDataStream &stream) const {
+  for (int i = 0; i < mJointChildren.size(); ++i)
+    mJointChildren.at(i)->writeSnapshot(stream);
+  for (int i = 0; i < mSolidChildren.size(); ++i)
+    mSolidChildren.at(i)->writeSnapshot(stream);
+}
+
+void WbSolid::readSnapshot(QDataStream &stream) {
+  // unlike postPhysicsStep(), the disabled bodies may also have been moved
+  if (body())
+    applyPhysicsTransform();
+  for (int i = 0; i < mJointChildren.size(); ++i)
+    mJointChildren.at(i)->readSnapshot(stream);
+  for (int i = 0; i < mSolidChildren.size(); ++i)
+    mSolidChildren.at(i)->readSnapshot(stream);
+}
+
 // Recursive reset methods
 // It resets the positions of all ODE dGeoms, static or not, based on the current translation and rotation fields
 // It also resets the velocities of all dBodies to 0.0
@@ -2393,7 +2599,7 @@ void WbSolid::extractContactPoints() {
     return;
 
   const WbWorld *const world = WbWorld::instance();
-  const QList<WbOdeContact> &fullList = world->odeContacts();
+  const QVector<WbOdeContact> &fullList = world->odeContacts();
   const int size = fullList.size();
 
   for (int i = 0; i < size; ++i) {
@@ -2404,13 +2610,13 @@ void WbSolid::extractContactPoints() {
     const WbSolid *const s2 = odeGeomData2->solid();
 
     if (s1 == this || s2 == this) {
-      const double *const pos = cg.pos;
+      const dReal *const pos = cg.pos;
       const WbVector3 v(pos[0], pos[1], pos[2]);
       mListOfContactPoints.append(v);
     }
 
     if (s1->topSolid() == this || s2->topSolid() == this) {
-      const double *const pos = cg.pos;
+      const dReal *const pos = cg.pos;
       const WbVector3 v(pos[0], pos[1], pos[2]);
       mGlobalListOfContactPoints.append(v);
       if (s1->topSolid() == this)
@@ -2433,7 +2639,7 @@ void WbSolid::extractImmersions() {
     return;
 
   const WbWorld *const world = WbWorld::instance();
-  const QList<dImmersionGeom> &fullList = world->immersionGeoms();
+  const QVector<dImmersionGeom> &fullList = world->immersionGeoms();
   const int size = fullList.size();
 
   for (int i = 0; i < size; ++i) {
@@ -2884,8 +3090,8 @@ void WbSolid::collectHiddenKinematicParameters(HiddenKinematicParametersMap &map
 void WbSolid::saveHiddenFieldValues() const {
   if (isSolidMerger()) {
     const dBodyID b = mSolidMerger->body();
-    const double *const l = dBodyGetLinearVel(b);
-    const double *const a = dBodyGetAngularVel(b);
+    const dReal *const l = dBodyGetLinearVel(b);
+    const dReal *const a = dBodyGetAngularVel(b);
     mLinearVelocity->setValue(l[0], l[1], l[2]);
     mAngularVelocity->setValue(a[0], a[1], a[2]);
   }
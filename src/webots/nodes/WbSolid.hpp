@@ -63,10 +63,16 @@ public:
   void setMatrixNeedUpdate() override;
   void reset(const QString &id) override;
   void save(const QString &id) override;
+  void writeSnapshot(QDataStream &stream) const override;
+  // the bodies must have been loaded before, the poses and the velocities of the solids are updated from them
+  void readSnapshot(QDataStream &stream) override;
 
   // processing before / after ODE world step
   virtual void prePhysicsStep(double ms);
   virtual void postPhysicsStep();
+  // computes the poses of the moving top solids and of their descendants from the ODE bodies on the worker threads, they
+  // are applied by postPhysicsStep() on the main thread
+  static void computePhysicsPoses(const QList<WbSolid *> &topSolids, int threadCount);
 
   void setScaleNeedUpdate() override;
   void createOdeObjects() override;
@@ -93,7 +99,7 @@ public:
   dJointID joint() const { return mJoint; }
   dBodyID body() const;
   double mass() const;
-  const double *inertiaMatrix() const;
+  const dReal *inertiaMatrix() const;
   double globalMass() const { return mGlobalMass; }
   double globalVolume() const { return mGlobalVolume; }
   const WbVector3 &globalCenterOfMass() const { return mGlobalCenterOfMass; }
@@ -140,6 +146,8 @@ public:
 
   // sleeping flags
   bool isSleeping() const;
+  // the solid and its descendants are sleeping, their pose is not changed by the physics step
+  bool isResting() const;
 
   // awakening
   void awake();
@@ -329,6 +337,18 @@ private:
   bool mResetPhysicsInStep;  // used to completely reset physics when the solid is also moved in the same step
   void setGeomAndBodyPositions();
   void applyPhysicsTransform();
+  void applyPhysicsVelocity(dBodyID b);
+  static void computePhysicsTransform(dBodyID b, const WbMatrix4 *upperMatrix, double invUpperScale,
+                                      const WbVector3 &centerOfMass, double translation[3], double rotation[4]);
+
+  // poses staged by computePhysicsPoses()
+  struct PhysicsPose;
+  struct PhysicsPoses;
+  const PhysicsPose *mPhysicsPose;
+  void appendPhysicsPoses(int parent, QVector<PhysicsPose> &poses, QVector<WbMatrix4> &matrices) const;
+  void applyPhysicsPose();
+  static void computePhysicsPosesTask(unsigned int task, unsigned int worker, void *data);
+
   void computePlaneParams(WbTransform *transform, WbVector3 &n, double &d) const;
   void resetJoints();  // reset joint to any linked solid to this one or to one of its descendants
   void setBodiesAndJointsToParents();
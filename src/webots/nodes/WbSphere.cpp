@@ -20,12 +20,10 @@
 #include "WbMathsUtilities.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
 #include "WbSFBool.hpp"
 #include "WbSFInt.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTokenizer.hpp"
 #include "WbTransform.hpp"
 #include "WbVersion.hpp"
@@ -331,9 +329,7 @@ void WbSphere::applyToOdeData(bool correctSolidMass) {
   assert(dGeomGetClass(mOdeGeom) == dSphereClass);
   dGeomSphereSetRadius(mOdeGeom, scaledRadius());
 
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
 
   if (correctSolidMass)
     applyToOdeMass();
@@ -18,10 +18,8 @@
 #include "WbField.hpp"
 #include "WbMatter.hpp"
 #include "WbNodeUtilities.hpp"
-#include "WbOdeGeomData.hpp"
 #include "WbRay.hpp"
 #include "WbResizeManipulator.hpp"
-#include "WbSimulationState.hpp"
 #include "WbTransform.hpp"
 #include "WbTriangleMesh.hpp"
 #include "WbWorld.hpp"
@@ -309,8 +307,8 @@ void WbTriangleMeshGeometry::setOdeTrimeshData() {
   mTrimeshData = dGeomTriMeshDataCreate();
   mScaledCoordinatesNeedUpdate = true;
   updateScaledCoordinates();
-  dGeomTriMeshDataBuildDouble(mTrimeshData, mTriangleMesh->scaledCoordinatesData(), 3 * sizeof(double), n,
-                              mTriangleMesh->indicesData(), 3 * nt, 3 * sizeof(int));
+  WbTriangleMeshCache::buildOdeTrimeshData(mTrimeshData, mTriangleMesh->scaledCoordinatesData(), n,
+                                           mTriangleMesh->indicesData(), nt);
 }
 
 // works only for meshes made up of triangles
@@ -333,9 +331,7 @@ void WbTriangleMeshGeometry::applyToOdeData(bool correctSolidMass) {
 
   dGeomTriMeshSetData(mOdeGeom, mTrimeshData);
 
-  WbOdeGeomData *const odeGeomData = static_cast<WbOdeGeomData *>(dGeomGetData(mOdeGeom));
-  assert(odeGeomData);
-  odeGeomData->setLastChangeTime(WbSimulationState::instance()->time());
+  setOdeGeomChanged();
 
   if (mCorrectSolidMass)
     applyToOdeMass();
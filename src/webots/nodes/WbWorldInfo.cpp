@@ -42,8 +42,16 @@ void WbWorldInfo::init(const WbVersion *version) {
   mErp = findSFDouble("ERP");
   mPhysics = findSFString("physics");
   mBasicTimeStep = findSFDouble("basicTimeStep");
+  mPhysicsSubSteps = findSFInt("physicsSubSteps");
   mFps = findSFDouble("FPS");
   mOptimalThreadCount = findSFInt("optimalThreadCount");
+  mThreadingMode = findSFString("threadingMode");
+  mDeterministicPhysics = findSFBool("deterministicPhysics");
+  mBroadphase = findSFString("broadphase");
+  mPhysicsSolver = findSFString("physicsSolver");
+  mQuickStepIterations = findSFInt("quickStepIterations");
+  mQuickStepOverRelaxation = findSFDouble("quickStepOverRelaxation");
+  mQuickStepWarmStarting = findSFBool("quickStepWarmStarting");
   mPhysicsDisableTime = findSFDouble("physicsDisableTime");
   mPhysicsDisableLinearThreshold = findSFDouble("physicsDisableLinearThreshold");
   mPhysicsDisableAngularThreshold = findSFDouble("physicsDisableAngularThreshold");
@@ -123,7 +131,11 @@ void WbWorldInfo::preFinalize() {
   updateCfm();
   updateErp();
   updateBasicTimeStep();
+  updatePhysicsSubSteps();
   updateFps();
+  updateThreadingMode();
+  updateBroadphase();
+  updatePhysicsSolver();
   updateLineScale();
   updateDragForceScale();
   updateDragTorqueScale();
@@ -150,9 +162,17 @@ void WbWorldInfo::postFinalize() {
   connect(mCfm, &WbSFDouble::changed, this, &WbWorldInfo::updateCfm);
   connect(mErp, &WbSFDouble::changed, this, &WbWorldInfo::updateErp);
   connect(mBasicTimeStep, &WbSFDouble::changed, this, &WbWorldInfo::updateBasicTimeStep);
+  connect(mPhysicsSubSteps, &WbSFInt::changed, this, &WbWorldInfo::updatePhysicsSubSteps);
   connect(mOptimalThreadCount, &WbSFInt::changed, this, &WbWorldInfo::updateOptimalThreadCount);
   connect(mOptimalThreadCount, &WbSFInt::changed, this, &WbWorldInfo::displayOptimalThreadCountWarning);
+  connect(mThreadingMode, &WbSFString::changed, this, &WbWorldInfo::updateThreadingMode);
+  connect(mDeterministicPhysics, &WbSFBool::changed, this, &WbWorldInfo::updateThreadingMode);
+  connect(mBroadphase, &WbSFString::changed, this, &WbWorldInfo::updateBroadphase);
   connect(mFps, &WbSFDouble::changed, this, &WbWorldInfo::updateFps);
+  connect(mPhysicsSolver, &WbSFString::changed, this, &WbWorldInfo::updatePhysicsSolver);
+  connect(mQuickStepIterations, &WbSFInt::changed, this, &WbWorldInfo::updatePhysicsSolver);
+  connect(mQuickStepOverRelaxation, &WbSFDouble::changed, this, &WbWorldInfo::updatePhysicsSolver);
+  connect(mQuickStepWarmStarting, &WbSFBool::changed, this, &WbWorldInfo::updatePhysicsSolver);
   connect(mLineScale, &WbSFDouble::changed, this, &WbWorldInfo::updateLineScale);
   connect(mDragForceScale, &WbSFDouble::changed, this, &WbWorldInfo::updateDragForceScale);
   connect(mDragTorqueScale, &WbSFDouble::changed, this, &WbWorldInfo::updateDragTorqueScale);
@@ -218,19 +238,26 @@ void WbWorldInfo::createOdeObjects() {
   applyToOdeErp();
   applyToOdeGlobalDamping();
   applyToOdePhysicsDisableTime();
+  applyToOdePhysicsSolver();
 }
 
 void WbWorldInfo::updateBasicTimeStep() {
   WbFieldChecker::resetDoubleIfNonPositive(this, mBasicTimeStep, 32.0);
 }
 
+void WbWorldInfo::updatePhysicsSubSteps() {
+  WbFieldChecker::resetIntIfNonPositive(this, mPhysicsSubSteps, 1);
+}
+
 void WbWorldInfo::updateFps() {
   WbFieldChecker::resetDoubleIfNonPositive(this, mFps, 60.0);
 }
 
 void WbWorldInfo::displayOptimalThreadCountWarning() {
   int threadPreferenceNumber = WbPreferences::instance()->value("General/numberOfThreads", 1).toInt();
-  if (mOptimalThreadCount->value() > 1 and threadPreferenceNumber > 1)
+  // islands are solved the same way whatever the number of threads, so are the clusters in deterministic mode
+  if (mOptimalThreadCount->value() > 1 and threadPreferenceNumber > 1 and mThreadingMode->value() != "islands" and
+      !mDeterministicPhysics->value())
     parsingWarn(
       tr("Physics multi-threading is enabled. "
          "This can have a noticeable impact on the simulation speed (negative or positive depending on the simulated world). "
@@ -242,12 +269,66 @@ void WbWorldInfo::updateOptimalThreadCount() {
   // loading a world where the 'optimalThreadCount' field is higher than the limit set in the preferences will therefore not
   // raise any warning
   int threadPreferenceNumber = WbPreferences::instance()->value("General/numberOfThreads", 1).toInt();
-  if (mOptimalThreadCount->value() > threadPreferenceNumber)
-    parsingWarn(tr("A limit of '%1' threads is set in the preferences.").arg(threadPreferenceNumber));
-  else if (!WbFieldChecker::resetIntIfNonPositive(this, mOptimalThreadCount, 1))
+  if (mOptimalThreadCount->value() > threadPreferenceNumber) {
+    // the field is clamped rather than ignored, so that supervisors can read the thread count actually used
+    parsingWarn(tr("A limit of '%1' threads is set in the preferences. 'optimalThreadCount' is reset to '%1'.")
+                  .arg(threadPreferenceNumber));
+    mOptimalThreadCount->setValue(threadPreferenceNumber);
+  } else if (!WbFieldChecker::resetIntIfNonPositive(this, mOptimalThreadCount, 1))
     emit optimalThreadCountChanged();
 }
 
+void WbWorldInfo::updateThreadingMode() {
+  if (mThreadingMode->value() != "clusters" && mThreadingMode->value() != "islands") {
+    mThreadingMode->setValue("clusters");
+    parsingWarn(tr("'threadingMode' must either be 'clusters' or 'islands'. Reset to default value 'clusters'."));
+    return;
+  }
+  emit threadingModeChanged();
+}
+
+void WbWorldInfo::updateBroadphase() {
+  const QStringList broadphases = QStringList() << "simple"
+                                                << "sweepAndPrune"
+                                                << "hash"
+                                                << "quadTree"
+                                                << "bvh"
+                                                << "auto";
+  if (!broadphases.contains(mBroadphase->value())) {
+    mBroadphase->setValue("simple");
+    parsingWarn(tr("'broadphase' must either be 'simple', 'sweepAndPrune', 'hash', 'quadTree', 'bvh' or 'auto'. Reset to "
+                   "default value 'simple'."));
+    return;
+  }
+  emit broadphaseChanged();
+}
+
+void WbWorldInfo::updatePhysicsSolver() {
+  if (mPhysicsSolver->value() != "direct" && mPhysicsSolver->value() != "quickStep" &&
+      mPhysicsSolver->value() != "articulated") {
+    mPhysicsSolver->setValue("direct");
+    parsingWarn(
+      tr("'physicsSolver' must either be 'direct', 'quickStep' or 'articulated'. Reset to default value 'direct'."));
+    return;
+  }
+  if (WbFieldChecker::resetIntIfNonPositive(this, mQuickStepIterations, 20))
+    return;
+  if (WbFieldChecker::resetDoubleIfNotInRangeWithExcludedBounds(this, mQuickStepOverRelaxation, 0.0, 2.0, 1.3))
+    return;
+
+  if (areOdeObjectsCreated())
+    applyToOdePhysicsSolver();
+}
+
+void WbWorldInfo::applyToOdePhysicsSolver() {
+  WbOdeContext *const context = WbOdeContext::instance();
+  context->setQuickStepSolver(mPhysicsSolver->value() == "quickStep");
+  context->setArticulatedBodySolver(mPhysicsSolver->value() == "articulated");
+  context->setQuickStepParameters(mQuickStepIterations->value(), mQuickStepOverRelaxation->value(),
+                                  mQuickStepWarmStarting->value());
+  emit globalPhysicsPropertiesChanged();
+}
+
 void WbWorldInfo::updateLineScale() {
   if (WbFieldChecker::resetDoubleIfNegative(this, mLineScale, 0.0))
     return;
@@ -16,6 +16,7 @@
 #define WB_WORLD_INFO_HPP
 
 #include "WbBaseNode.hpp"
+#include "WbSFBool.hpp"
 #include "WbSFDouble.hpp"
 #include "WbSFInt.hpp"
 #include "WbSFString.hpp"
@@ -53,8 +54,16 @@ public:
   double erp() const { return mErp->value(); }
   const QString &physics() const { return mPhysics->value(); }
   double basicTimeStep() const { return mBasicTimeStep->value(); }
+  int physicsSubSteps() const { return mPhysicsSubSteps->value(); }
   double fps() const { return mFps->value(); }
   int optimalThreadCount() const { return mOptimalThreadCount->value(); }
+  const QString &threadingMode() const { return mThreadingMode->value(); }
+  bool deterministicPhysics() const { return mDeterministicPhysics->value(); }
+  const QString &broadphase() const { return mBroadphase->value(); }
+  const QString &physicsSolver() const { return mPhysicsSolver->value(); }
+  int quickStepIterations() const { return mQuickStepIterations->value(); }
+  double quickStepOverRelaxation() const { return mQuickStepOverRelaxation->value(); }
+  bool quickStepWarmStarting() const { return mQuickStepWarmStarting->value(); }
   double physicsDisableTime() const { return mPhysicsDisableTime->value(); }
   double physicsDisableLinearThreshold() const { return mPhysicsDisableLinearThreshold->value(); }
   double physicsDisableAngularThreshold() const { return mPhysicsDisableAngularThreshold->value(); }
@@ -96,6 +105,8 @@ signals:
   void titleChanged();
   void globalPhysicsPropertiesChanged();
   void optimalThreadCountChanged();
+  void threadingModeChanged();
+  void broadphaseChanged();
   void randomSeedChanged();
 
 private:
@@ -113,8 +124,16 @@ private:
   WbSFDouble *mErp;
   WbSFString *mPhysics;
   WbSFDouble *mBasicTimeStep;
+  WbSFInt *mPhysicsSubSteps;
   WbSFDouble *mFps;
   WbSFInt *mOptimalThreadCount;
+  WbSFString *mThreadingMode;
+  WbSFBool *mDeterministicPhysics;
+  WbSFString *mBroadphase;
+  WbSFString *mPhysicsSolver;
+  WbSFInt *mQuickStepIterations;
+  WbSFDouble *mQuickStepOverRelaxation;
+  WbSFBool *mQuickStepWarmStarting;
   WbSFDouble *mPhysicsDisableTime;
   WbSFDouble *mPhysicsDisableLinearThreshold;
   WbSFDouble *mPhysicsDisableAngularThreshold;
@@ -147,12 +166,17 @@ private:
   // Non-slot update methods
   void applyToOdeGlobalDamping();
   void applyToOdePhysicsDisableTime();
+  void applyToOdePhysicsSolver();
   void updateGravityBasis();
 
 private slots:
   void updateBasicTimeStep();
+  void updatePhysicsSubSteps();
   void updateFps();
   void updateOptimalThreadCount();
+  void updateThreadingMode();
+  void updateBroadphase();
+  void updatePhysicsSolver();
   void updateLineScale();
   void updateDragForceScale();
   void updateDragTorqueScale();
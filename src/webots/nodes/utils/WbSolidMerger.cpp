@@ -33,6 +33,7 @@ WbSolidMerger::WbSolidMerger(WbSolid *solid) :
   mBodyArtificiallyDisabled(false) {
   assert(mSolid);
   mBody = dBodyCreate(WbOdeContext::instance()->world());
+  WbOdeContext::instance()->addBody(mBody);
   mOdeMass = new dMass;  // stores inertia relative the merger's CoM and its solid frame
   dMassSetZero(mOdeMass);
 
@@ -41,6 +42,7 @@ WbSolidMerger::WbSolidMerger(WbSolid *solid) :
 
 WbSolidMerger::~WbSolidMerger() {
   WbOdeContext::instance()->removeBodyContactJointGroup(mBody);
+  WbOdeContext::instance()->removeBody(mBody);
   dBodyDestroy(mBody);
   mBody = NULL;
 
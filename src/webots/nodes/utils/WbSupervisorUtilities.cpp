@@ -40,6 +40,7 @@
 #include "WbSFNode.hpp"
 #include "WbSFVector2.hpp"
 #include "WbSelection.hpp"
+#include "WbSimulationWorld.hpp"
 #include "WbStandardPaths.hpp"
 #include "WbTemplateManager.hpp"
 #include "WbViewpoint.hpp"
@@ -612,6 +613,21 @@ void WbSupervisorUtilities::handleMessage(QDataStream &stream) {
     case C_SUPERVISOR_SIMULATION_RESET_PHYSICS:
       WbApplication::instance()->resetPhysics();
       return;
+    case C_SUPERVISOR_SIMULATION_SAVE_STATE: {
+      const QString &stateName = readString(stream);
+      if (!WbSimulationWorld::instance()->saveState(stateName))
+        mRobot->warn(tr("wb_supervisor_simulation_save_state(): not supported when the physics runs in clusters on several "
+                        "threads, set WorldInfo.threadingMode to \"islands\" or use a single thread."));
+      return;
+    }
+    case C_SUPERVISOR_SIMULATION_LOAD_STATE: {
+      const QString &stateName = readString(stream);
+      if (!WbSimulationWorld::instance()->loadState(stateName))
+        mRobot->warn(tr("wb_supervisor_simulation_load_state(): no state saved as '%1', the world changed since it was "
+                        "saved or the physics runs in clusters on several threads.")
+                       .arg(stateName));
+      return;
+    }
     case C_SUPERVISOR_SIMULATION_CHANGE_MODE: {
       int newMode;
       stream >> newMode;
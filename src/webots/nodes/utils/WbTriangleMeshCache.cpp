@@ -17,12 +17,21 @@
 #include "WbCoordinate.hpp"
 #include "WbMFInt.hpp"
 #include "WbNormal.hpp"
+#include "WbPreferences.hpp"
 #include "WbSFBool.hpp"
 #include "WbSFDouble.hpp"
 #include "WbTextureCoordinate.hpp"
 #include "WbTriangleMesh.hpp"
 #include "WbTriangleMeshGeometry.hpp"
 
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <ode/ode.h>
+
 #include <cassert>
 #include <cstdlib>
 #include <functional>
@@ -74,4 +83,85 @@ namespace WbTriangleMeshCache {
 
     user->setTriangleMesh(NULL);
   }
+
+  // smaller trees are built faster than they are read from the disk
+  static const int MIN_CACHED_TREE_TRIANGLES = 1000;
+
+  static const QString &odeTreeCachePath() {
+    static QString path;
+    if (path.isEmpty()) {
+      path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/trimesh/";
+      QDir().mkpath(path);
+    }
+    return path;
+  }
+
+  static qint64 maximumOdeTreeCacheSize() {
+    return 1024LL * 1024LL * WbPreferences::instance()->value("General/treeCacheSize", 1024).toLongLong();
+  }
+
+  // removes the least recently used trees until the cache fits in its maximum size
+  static void evictOdeTrees(qint64 maximumSize) {
+    // sorted from the most to the least recently used, as the files used are touched
+    const QFileInfoList files = QDir(odeTreeCachePath()).entryInfoList(QStringList("*.tree"), QDir::Files, QDir::Time);
+    qint64 size = 0;
+    foreach (const QFileInfo &info, files)
+      size += info.size();
+    // the trees mapped by another Webots instance may fail to be removed on Windows, they are removed later
+    for (int i = files.size() - 1; i >= 0 && size > maximumSize; --i) {
+      if (QFile::remove(files[i].absoluteFilePath()))
+        size -= files[i].size();
+    }
+  }
+
+  qint64 odeTreeCacheSize() {
+    qint64 size = 0;
+    foreach (const QFileInfo &info, QDir(odeTreeCachePath()).entryInfoList(QStringList("*.tree"), QDir::Files))
+      size += info.size();
+    return size;
+  }
+
+  void clearOdeTreeCache() { evictOdeTrees(0); }
+
+  void buildOdeTrimeshData(dTriMeshDataID data, const double *vertices, int vertexCount, const int *indices,
+                           int triangleCount) {
+    const qint64 maximumCacheSize = maximumOdeTreeCacheSize();
+    if (triangleCount < MIN_CACHED_TREE_TRIANGLES || maximumCacheSize <= 0) {
+      dGeomTriMeshDataBuildDouble(data, vertices, 3 * sizeof(double), vertexCount, indices, 3 * triangleCount,
+                                  3 * sizeof(int));
+      return;
+    }
+
+    // the trees are built from the scaled vertices, so the scale is part of the key
+    const QString fileName = odeTreeCachePath() + QString("%1%2.tree")
+                                                    .arg(sipHash13x(vertices, 3 * vertexCount), 16, 16, QChar('0'))
+                                                    .arg(sipHash13x(indices, 3 * triangleCount), 16, 16, QChar('0'));
+    bool built = false;
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly) && file.size() > 0) {
+      // the mapped nodes are copied and relocated by ODE, the file is unmapped when closed
+      const uchar *tree = file.map(0, file.size());
+      if (tree) {
+        // ODE builds the tree itself if the cached one doesn't match the mesh
+        if (dGeomTriMeshDataBuildDoubleWithTree(data, vertices, 3 * sizeof(double), vertexCount, indices, 3 * triangleCount,
+                                                3 * sizeof(int), tree, file.size())) {
+          // the modification time orders the trees for the eviction
+          file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+          return;
+        }
+        built = true;
+      }
+    }
+    file.close();
+    if (!built)
+      dGeomTriMeshDataBuildDouble(data, vertices, 3 * sizeof(double), vertexCount, indices, 3 * triangleCount,
+                                  3 * sizeof(int));
+
+    // missing or outdated tree, QSaveFile replaces the file atomically so that concurrent instances never read a partial tree
+    QByteArray tree(static_cast<int>(dGeomTriMeshDataGetTree(data, NULL)), Qt::Uninitialized);
+    dGeomTriMeshDataGetTree(data, tree.data());
+    QSaveFile saveFile(fileName);
+    if (saveFile.open(QIODevice::WriteOnly) && saveFile.write(tree) == tree.size() && saveFile.commit())
+      evictOdeTrees(maximumCacheSize);
+  }
 }  // namespace WbTriangleMeshCache
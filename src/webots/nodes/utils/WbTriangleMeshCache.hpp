@@ -17,9 +17,13 @@
 
 #include "sip_hash.hpp"
 
+#include <QtCore/QtGlobal>
+
 class WbTriangleMeshGeometry;
 class WbTriangleMesh;
 
+typedef struct dxTriMeshData *dTriMeshDataID;
+
 namespace WbTriangleMeshCache {
   extern const highwayhash::HH_U64 SIPHASH_KEY[2];
 
@@ -54,6 +58,16 @@ namespace WbTriangleMeshCache {
 
   void useTriangleMesh(WbTriangleMeshGeometry *user);
   void releaseTriangleMesh(WbTriangleMeshGeometry *user);
+
+  // Builds the ODE trimesh data of the given scaled mesh. The OPCODE collision tree is loaded from the on-disk cache if it
+  // was already built for the same vertices and indices, by this or a previous run, and is saved to the cache otherwise.
+  void buildOdeTrimeshData(dTriMeshDataID data, const double *vertices, int vertexCount, const int *indices,
+                           int triangleCount);
+
+  // The on-disk cache is limited to the General/treeCacheSize preference, in MB, by removing the least recently used trees.
+  // A size of 0 disables the cache.
+  qint64 odeTreeCacheSize();
+  void clearOdeTreeCache();
 }  // namespace WbTriangleMeshCache
 
 #endif
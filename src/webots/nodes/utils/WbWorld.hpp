@@ -22,6 +22,7 @@
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QVector>
 #include "WbWorldInfo.hpp"
 
 class WbGroup;
@@ -131,10 +132,12 @@ public:
 
   // shortcut
   double basicTimeStep() const { return mWorldInfo->basicTimeStep(); }
+  // number of ODE steps run in each basic time step
+  int physicsSubSteps() const { return mWorldInfo->physicsSubSteps(); }
   int optimalThreadCount() const { return mWorldInfo->optimalThreadCount(); }
 
-  const QList<WbOdeContact> &odeContacts() const { return mOdeContacts; }
-  const QList<dImmersionGeom> &immersionGeoms() const { return mImmersionGeoms; }
+  const QVector<WbOdeContact> &odeContacts() const { return mOdeContacts; }
+  const QVector<dImmersionGeom> &immersionGeoms() const { return mImmersionGeoms; }
   void appendOdeContact(const WbOdeContact &odeContact);
   void appendOdeImmersionGeom(const dImmersionGeom &immersionGeom);
 
@@ -166,9 +169,9 @@ public slots:
   }
 
 protected:
-  // collecting contact and immersion geometries
-  QList<WbOdeContact> mOdeContacts;
-  QList<dImmersionGeom> mImmersionGeoms;
+  // collecting contact and immersion geometries, the vectors keep their capacity when cleared at each step
+  QVector<WbOdeContact> mOdeContacts;
+  QVector<dImmersionGeom> mImmersionGeoms;
   bool mWorldLoadingCanceled;
   bool mResetRequested;
   bool mRestartControllers;
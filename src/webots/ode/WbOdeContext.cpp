@@ -14,18 +14,26 @@
 
 #include "WbOdeContext.hpp"
 
+#include "WbLog.hpp"
+
 #include <ode/fluid_dynamics/objects_fluid_dynamics.h>
+#include <algorithm>
 #include <cassert>
 
 WbOdeContext *WbOdeContext::cOdeContext = NULL;
+int WbOdeContext::cContactJointPoolCapacity = 0;
 
 WbOdeContext::WbOdeContext() : QObject() {
   dInitODE();
+  // the headers and the library disagree on the size of dReal if they were not built with the same ODE_PRECISION
+  if (!dCheckConfiguration(sizeof(dReal) == sizeof(float) ? "ODE_single_precision" : "ODE_double_precision"))
+    WbLog::fatal(tr("The ODE library was not built with the same precision as Webots."));
   mWorld = dWorldCreate();
   dWorldSetLinearDampingThreshold(mWorld, 0.0);
   dWorldSetAngularDampingThreshold(mWorld, 0.0);
 
   mSpace = dSimpleSpaceCreate(NULL);
+  mBroadphase = "simple";
 
   mJointGroupCreationMutex = new QMutex();
   mImmersionLinkGroup1 = dImmersionLinkGroupCreate();
@@ -34,8 +42,15 @@ WbOdeContext::WbOdeContext() : QObject() {
   mPhysicsPluginContactJointGroup2 = dJointGroupCreate(0);
   mBodyContactJointGroupList1.clear();
   mBodyContactJointGroupList2.clear();
+  mContactJointPool = dJointPoolCreate(cContactJointPoolCapacity);
+  // the initial capacity is allocated while loading the world, it is not reported in the step statistics
+  mContactJointPoolAllocationsCount = dJointPoolGetAllocationCount(mContactJointPool);
 
   mNumberOfThreads = -1;
+  mIslandThreading = false;
+  mDeterministic = false;
+  mQuickStepWarmStarting = false;
+  mStepFunction = &dWorldStep;
   cOdeContext = this;
 }
 
@@ -50,6 +65,9 @@ WbOdeContext::~WbOdeContext() {
   }
   mBodyContactJointGroupList1.clear();
   mBodyContactJointGroupList2.clear();
+  // the contacts of a reloaded world are usually similar
+  cContactJointPoolCapacity = dJointPoolGetHighWaterMark(mContactJointPool);
+  dJointPoolDestroy(mContactJointPool);
 
   dJointGroupDestroy(mPhysicsPluginContactJointGroup1);
   dJointGroupDestroy(mPhysicsPluginContactJointGroup2);
@@ -63,10 +81,28 @@ WbOdeContext::~WbOdeContext() {
   cOdeContext = NULL;
 }
 
-void WbOdeContext::setNumberOfThreads(int n) {
-  if (mNumberOfThreads == n)
+void WbOdeContext::setNumberOfThreads(int n, bool islandThreading, bool deterministic) {
+  if (mNumberOfThreads == n && mIslandThreading == islandThreading && mDeterministic == deterministic)
     return;
   mNumberOfThreads = n;
+  mIslandThreading = islandThreading;
+  mDeterministic = deterministic;
+  // the islands are built in the creation order of the bodies, whatever the cluster worlds they have been moved to
+  dWorldSetDeterministic(mWorld, mDeterministic);
+  applyQuickStepWarmStarting();
+  // in island threading mode, ODE is not clustered: dWorldStep solves the independent islands on n threads
+  // and dWorldQuickStep relaxes the graph-coloured constraints of the large islands on n threads
+  if (mIslandThreading) {
+    dToggleODE_MT(0);
+    dWorldSetIslandThreadCount(mWorld, n);
+    dWorldSetQuickStepThreadCount(mWorld, n);
+    dWorldSetQuickStepDeterministic(mWorld, mDeterministic);
+    return;
+  }
+  dWorldSetIslandThreadCount(mWorld, 1);
+  dWorldSetQuickStepThreadCount(mWorld, 1);
+  // the random reordering of the sequential SOR draws from a generator shared by the clusters stepped concurrently
+  dWorldSetQuickStepDeterministic(mWorld, mDeterministic);
   // dToggleODE_MT(0) will cause ODE to work non-threaded
   // dToggleODE_MT(1) will cause ODE to work on multi-thread with a single thread, which is inefficient
   // This is why when we set the number of threads to 1, we want to revert to the non-threaded mode
@@ -76,6 +112,125 @@ void WbOdeContext::setNumberOfThreads(int n) {
     dToggleODE_MT(n);
 }
 
+void WbOdeContext::setQuickStepSolver(bool enabled) {
+  mStepFunction = enabled ? &dWorldQuickStep : &dWorldStep;
+}
+
+void WbOdeContext::setArticulatedBodySolver(bool enabled) {
+  // only used by dWorldStep: the hinge and slider trees are integrated in reduced coordinates
+  dWorldSetArticulatedBodySolver(mWorld, enabled);
+}
+
+void WbOdeContext::setQuickStepParameters(int iterations, double overRelaxation, bool warmStarting) {
+  dWorldSetQuickStepNumIterations(mWorld, iterations);
+  dWorldSetQuickStepW(mWorld, overRelaxation);
+  mQuickStepWarmStarting = warmStarting;
+  applyQuickStepWarmStarting();
+}
+
+void WbOdeContext::applyQuickStepWarmStarting() {
+  // the contact cache is kept by each cluster world for its own copies of the static geoms: a body moving to another
+  // cluster loses its warm start, which would make the clustered results depend on the number of threads
+  const bool enabled = mQuickStepWarmStarting && (!mDeterministic || mIslandThreading);
+  // start from 90% of the previous impulses, reusing them fully causes jerkiness in motor-driven joints
+  dWorldSetQuickStepWarmStarting(mWorld, enabled ? 0.9 : 0.0);
+}
+
+// compute the bounding box of the finite geoms of a space, planes and other infinite geoms are ignored
+// returns the number of finite geoms
+static int computeFiniteBounds(dSpaceID space, dVector3 minimum, dVector3 maximum) {
+  for (int j = 0; j < 3; ++j) {
+    minimum[j] = dInfinity;
+    maximum[j] = -dInfinity;
+  }
+  int finiteCount = 0;
+  const int count = dSpaceGetNumGeoms(space);
+  for (int i = 0; i < count; ++i) {
+    dReal aabb[6];
+    dGeomGetAABB(dSpaceGetGeom(space, i), aabb);
+    if (aabb[0] == -dInfinity || aabb[1] == dInfinity || aabb[2] == -dInfinity || aabb[3] == dInfinity ||
+        aabb[4] == -dInfinity || aabb[5] == dInfinity)
+      continue;
+    for (int j = 0; j < 3; ++j) {
+      minimum[j] = qMin(minimum[j], aabb[2 * j]);
+      maximum[j] = qMax(maximum[j], aabb[2 * j + 1]);
+    }
+    ++finiteCount;
+  }
+  return finiteCount;
+}
+
+void WbOdeContext::setBroadphase(const QString &broadphase) {
+  const QString type = broadphase == "auto" ? automaticBroadphase() : broadphase;
+  if (type == mBroadphase)
+    return;
+
+  // creating a space recombines the ode_MT clusters, so that all the geoms are back in the main space
+  dSpaceID space = createSpace(type);
+  // geoms are added at the front of the spaces, moving them from the last one preserves their order
+  for (int i = dSpaceGetNumGeoms(mSpace) - 1; i >= 0; --i) {
+    dGeomID geom = dSpaceGetGeom(mSpace, i);
+    dSpaceRemove(mSpace, geom);
+    dSpaceAdd(space, geom);
+  }
+  dSpaceDestroy(mSpace);
+  mSpace = space;
+  mBroadphase = type;
+}
+
+QString WbOdeContext::automaticBroadphase() const {
+  // below a few hundred geoms, testing all the pairs is faster than maintaining any acceleration structure
+  if (dSpaceGetNumGeoms(mSpace) < 256)
+    return "simple";
+
+  // in large worlds, most geoms are static and far from each other: the AABB tree only updates the moving ones and
+  // prunes the sensor rays much better than the sweep and prune
+  dVector3 minimum, maximum;
+  if (computeFiniteBounds(mSpace, minimum, maximum) > 0) {
+    // the world size is measured on the axes orthogonal to the gravity
+    dVector3 gravity;
+    dWorldGetGravity(mWorld, gravity);
+    int up = 0;
+    for (int j = 1; j < 3; ++j) {
+      if (qAbs(gravity[j]) > qAbs(gravity[up]))
+        up = j;
+    }
+    for (int j = 0; j < 3; ++j) {
+      if (j != up && maximum[j] - minimum[j] > 500.0)
+        return "bvh";
+    }
+  }
+  return "sweepAndPrune";
+}
+
+dSpaceID WbOdeContext::createSpace(const QString &broadphase) const {
+  if (broadphase == "sweepAndPrune")
+    return dSweepAndPruneSpaceCreate(NULL, dSAP_AXES_XYZ);  // X is horizontal in every coordinate system
+  if (broadphase == "hash")
+    return dHashSpaceCreate(NULL);
+  if (broadphase == "bvh")
+    return dBVHSpaceCreate(NULL);
+  if (broadphase == "quadTree") {
+    // the tree covers the finite geoms currently in the main space, the other geoms are stored in its root block
+    dVector3 minimum, maximum;
+    const int finiteCount = computeFiniteBounds(mSpace, minimum, maximum);
+    dVector3 center = {0.0, 0.0, 0.0};
+    dVector3 extents = {100.0, 100.0, 100.0};
+    if (finiteCount > 0) {
+      for (int j = 0; j < 3; ++j) {
+        center[j] = 0.5 * (minimum[j] + maximum[j]);
+        extents[j] = qMax(0.55 * (maximum[j] - minimum[j]), 1.0);
+      }
+    }
+    // about 8 geoms per leaf
+    int depth = 1;
+    while (depth < 8 && (8 << (2 * depth)) < finiteCount)
+      ++depth;
+    return dQuadTreeSpaceCreate(NULL, center, extents, depth);
+  }
+  return dSimpleSpaceCreate(NULL);
+}
+
 void WbOdeContext::setGravity(double x, double y, double z) {
   dWorldSetGravity(mWorld, x, y, z);
 }
@@ -120,11 +275,11 @@ void WbOdeContext::emptyEnabledBodyContactJointGroups2() {
 }
 
 dJointGroupID WbOdeContext::bodyContactJointGroup1(dBodyID b) {
-  // mutex is locked in WbSimulationCluster before calling this function
+  // only called when merging the contacts of WbSimulationCluster, after the parallel collision detection
   QHash<dBodyID, dJointGroupID>::const_iterator it = mBodyContactJointGroupList1.find(b);
   if (it == mBodyContactJointGroupList1.end()) {
     // body not found
-    dJointGroupID group = dJointGroupCreate(0);
+    dJointGroupID group = dJointGroupCreateFromPool(mContactJointPool);
     mBodyContactJointGroupList1.insert(b, group);
     return group;
   }
@@ -133,11 +288,11 @@ dJointGroupID WbOdeContext::bodyContactJointGroup1(dBodyID b) {
 }
 
 dJointGroupID WbOdeContext::bodyContactJointGroup2(dBodyID b) {
-  // mutex is locked in WbSimulationCluster before calling this function
+  // only called when merging the contacts of WbSimulationCluster, after the parallel collision detection
   QHash<dBodyID, dJointGroupID>::const_iterator it = mBodyContactJointGroupList2.find(b);
   if (it == mBodyContactJointGroupList2.end()) {
     // body not found
-    dJointGroupID group = dJointGroupCreate(0);
+    dJointGroupID group = dJointGroupCreateFromPool(mContactJointPool);
     mBodyContactJointGroupList2.insert(b, group);
     return group;
   }
@@ -145,6 +300,59 @@ dJointGroupID WbOdeContext::bodyContactJointGroup2(dBodyID b) {
   return it.value();
 }
 
+void WbOdeContext::countBodies(int &awake, int &sleeping) const {
+  awake = 0;
+  foreach (const dBodyID b, mBodies) {
+    if (dBodyIsEnabled(b))
+      ++awake;
+  }
+  sleeping = mBodies.size() - awake;
+}
+
+QVector<dBodyID> WbOdeContext::sortedBodies() const {
+  QVector<dBodyID> bodies;
+  bodies.reserve(mBodies.size());
+  foreach (const dBodyID b, mBodies)
+    bodies.append(b);
+  std::sort(bodies.begin(), bodies.end());
+  return bodies;
+}
+
+QByteArray WbOdeContext::saveState() const {
+  // the bodies are passed explicitly as they may have been moved to the worlds of the clusters
+  const QVector<dBodyID> bodies = sortedBodies();
+  QByteArray state;
+  state.resize(dWorldGetStateSize(mWorld, bodies.constData(), bodies.size()));
+  dWorldSaveState(mWorld, bodies.constData(), bodies.size(), state.data());
+  return state;
+}
+
+bool WbOdeContext::loadState(const QByteArray &state) {
+  const QVector<dBodyID> bodies = sortedBodies();
+  if (!dWorldLoadState(mWorld, bodies.constData(), bodies.size(), state.constData(), state.size()))
+    return false;
+
+  // the contact joints match the previous positions, including the ones of the disabled bodies which are kept otherwise
+  mJointGroupCreationMutex->lock();
+  foreach (const dJointGroupID group, mBodyContactJointGroupList1)
+    dJointGroupEmpty(group);
+  foreach (const dJointGroupID group, mBodyContactJointGroupList2)
+    dJointGroupEmpty(group);
+  dJointGroupEmpty(mPhysicsPluginContactJointGroup1);
+  dJointGroupEmpty(mPhysicsPluginContactJointGroup2);
+  dImmersionLinkGroupEmpty(mImmersionLinkGroup1);
+  dImmersionLinkGroupEmpty(mImmersionLinkGroup2);
+  mJointGroupCreationMutex->unlock();
+  return true;
+}
+
+void WbOdeContext::contactJointPoolStats(int &jointsCount, int &allocationsCount) {
+  jointsCount = dJointPoolGetCount(mContactJointPool);
+  const int totalAllocationsCount = dJointPoolGetAllocationCount(mContactJointPool);
+  allocationsCount = totalAllocationsCount - mContactJointPoolAllocationsCount;
+  mContactJointPoolAllocationsCount = totalAllocationsCount;
+}
+
 void WbOdeContext::removeBodyContactJointGroup(dBodyID b) {
   mJointGroupCreationMutex->lock();
   if (mBodyContactJointGroupList1.contains(b)) {
@@ -18,9 +18,13 @@
 #include <ode/fluid_dynamics/common_fluid_dynamics.h>
 #include <ode/ode.h>
 
+#include <QtCore/QByteArray>
 #include <QtCore/QHash>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
 
 class WbOdeContext : public QObject {
   Q_OBJECT
@@ -40,12 +44,25 @@ public:
   void setErp(double erp);
   void setDamping(double linear, double angular);
   void setPhysicsDisableTime(double time);
-  void setNumberOfThreads(int n);
+  // in deterministic mode, the results do not depend on the number of threads
+  void setNumberOfThreads(int n, bool islandThreading, bool deterministic);
+  void setQuickStepSolver(bool enabled);
+  void setArticulatedBodySolver(bool enabled);
+  void setQuickStepParameters(int iterations, double overRelaxation, bool warmStarting);
+  // replace the main space by a space of the given type and move its geoms to the new space
+  // "auto" selects the type according to the number and extent of the geoms currently in the main space
+  void setBroadphase(const QString &broadphase);
 
   // getters
   dWorldID world() const { return mWorld; }
   dSpaceID space() const { return mSpace; }
   int numberOfThreads() const { return mNumberOfThreads; }
+  bool isIslandThreading() const { return mIslandThreading; }
+  bool isDeterministic() const { return mDeterministic; }
+  // type of the main space, "auto" is never returned
+  const QString &broadphase() const { return mBroadphase; }
+  // dWorldStep (direct LCP solver) or dWorldQuickStep (iterative SOR solver)
+  dWorldStepFunction *stepFunction() const { return mStepFunction; }
 
   QMutex *jointGroupCreationMutex() { return mJointGroupCreationMutex; }
   dImmersionLinkGroupID immersionLinkGroup1() const { return mImmersionLinkGroup1; }
@@ -53,26 +70,59 @@ public:
   dJointGroupID physicsPluginContactJointGroup1() const { return mPhysicsPluginContactJointGroup1; }
   dJointGroupID physicsPluginContactJointGroup2() const { return mPhysicsPluginContactJointGroup2; }
 
+  // the contact joints of all the bodies are stored in a pool which only allocates memory beyond its high-water mark
   void emptyEnabledBodyContactJointGroups1();
   void emptyEnabledBodyContactJointGroups2();
   dJointGroupID bodyContactJointGroup1(dBodyID b);
   dJointGroupID bodyContactJointGroup2(dBodyID b);
   void removeBodyContactJointGroup(dBodyID b);
+  // number of contact joints in the pool and number of memory allocations done by the pool since the last call
+  void contactJointPoolStats(int &jointsCount, int &allocationsCount);
+
+  // bodies created by the solids, used to count the sleeping ones
+  void addBody(dBodyID b) { mBodies.insert(b); }
+  void removeBody(dBodyID b) { mBodies.remove(b); }
+  void countBodies(int &awake, int &sleeping) const;
+
+  // true if ODE_MT steps the bodies in the worlds of several clusters
+  bool isClustered() const { return !mIslandThreading && mNumberOfThreads > 1; }
+
+  // snapshot of the bodies created by the solids, of their joints and of the random generator of the world
+  // it can only be loaded in the same process, the contact joints are not part of it and are removed when it is loaded
+  QByteArray saveState() const;
+  // returns false and does not change anything if bodies or joints were added or removed since the state was saved
+  bool loadState(const QByteArray &state);
 
 signals:
   void worldDefaultDampingChanged();
 
 private:
+  QString automaticBroadphase() const;
+  dSpaceID createSpace(const QString &broadphase) const;
+  void applyQuickStepWarmStarting();
+  // the bodies in the same order whatever the insertions and removals done in mBodies since the state was saved
+  QVector<dBodyID> sortedBodies() const;
+
   dWorldID mWorld;
   dSpaceID mSpace;
 
   QMutex *mJointGroupCreationMutex;
   QHash<dBodyID, dJointGroupID> mBodyContactJointGroupList1, mBodyContactJointGroupList2;
+  dJointPoolID mContactJointPool;
+  int mContactJointPoolAllocationsCount;
+  QSet<dBodyID> mBodies;
   dImmersionLinkGroupID mImmersionLinkGroup1, mImmersionLinkGroup2;
   dJointGroupID mPhysicsPluginContactJointGroup1, mPhysicsPluginContactJointGroup2;
 
   int mNumberOfThreads;
+  bool mIslandThreading;
+  bool mDeterministic;
+  bool mQuickStepWarmStarting;
+  dWorldStepFunction *mStepFunction;
+  QString mBroadphase;
   static WbOdeContext *cOdeContext;
+  // high-water mark of the contact joint pool of the previous world, used to size the pool of the next one
+  static int cContactJointPoolCapacity;
 };
 
 #endif
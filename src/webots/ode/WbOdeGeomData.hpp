@@ -26,12 +26,14 @@ public:
     mFluid(NULL),
     mSolid(solid),
     mGeometry(geometry),
+    mSerial(nextSerial()),
     mMagicNumber(0x7765626F7473LL) {}
   explicit WbOdeGeomData(WbFluid *fluid, WbGeometry *geometry = NULL) :
     mFluid(fluid),
     mSolid(NULL),
     mGeometry(geometry),
     mLastChangeTime(0.0),
+    mSerial(nextSerial()),
     mMagicNumber(0x7765626F7473LL) {}
   virtual ~WbOdeGeomData() {}
 
@@ -41,13 +43,22 @@ public:
   WbGeometry *geometry() const { return mGeometry; }
   double lastChangeTime() const { return mLastChangeTime; }
   void setLastChangeTime(double time) { mLastChangeTime = time; }
+  // creation order, distinguishes the geoms of the same node, e.g. the rays of a multi-ray sensor
+  int serial() const { return mSerial; }
   const long long int &magicNumber() const { return mMagicNumber; }
 
 private:
+  // the geom data are only created by the main thread
+  static int nextSerial() {
+    static int serial = 0;
+    return serial++;
+  }
+
   WbFluid *mFluid;
   WbSolid *mSolid;
   WbGeometry *mGeometry;
   double mLastChangeTime;
+  const int mSerial;
   const long long int mMagicNumber;  // this number allows to distinguish WbOdeGeomData from users' own data put into an ODE
                                      // dGeomID (in "webots" replace each character by its hex. ascii)
 };
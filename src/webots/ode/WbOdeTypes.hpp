@@ -15,6 +15,14 @@
 #ifndef WB_ODE_TYPES_HPP
 #define WB_ODE_TYPES_HPP
 
+// same definition as ode/precision.h, which is not in the include path of every module: dReal is a float in the
+// single precision builds of ODE (ODE_PRECISION=single)
+#ifdef dIDESINGLE
+typedef float dReal;
+#else
+typedef double dReal;
+#endif
+
 typedef struct dxSpace *dSpaceID;
 typedef struct dxBody *dBodyID;
 typedef struct dxJoint *dJointID;
@@ -14,6 +14,9 @@
 
 #include "WbOdeUtilities.hpp"
 
+#include "WbQuaternion.hpp"
+#include "WbVector3.hpp"
+
 void WbOdeUtilities::convertSpringAndDampingConstants(double spring, double damping, double timeStep, double &cfm,
                                                       double &erp) {
   const double hs = timeStep * spring;
@@ -22,3 +25,16 @@ void WbOdeUtilities::convertSpringAndDampingConstants(double spring, double damp
   if (erp > 1.0)
     erp = 1.0;
 }
+
+void WbOdeUtilities::vector3ToOde(const WbVector3 &v, dReal result[3]) {
+  result[0] = v.x();
+  result[1] = v.y();
+  result[2] = v.z();
+}
+
+void WbOdeUtilities::quaternionToOde(const WbQuaternion &q, dReal result[4]) {
+  result[0] = q.w();
+  result[1] = q.x();
+  result[2] = q.y();
+  result[3] = q.z();
+}
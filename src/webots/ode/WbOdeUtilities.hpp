@@ -15,8 +15,17 @@
 #ifndef WB_ODE_UTILITIES_HPP
 #define WB_ODE_UTILITIES_HPP
 
+#include "WbOdeTypes.hpp"
+
+class WbQuaternion;
+class WbVector3;
+
 namespace WbOdeUtilities {
   void convertSpringAndDampingConstants(double spring, double damping, double timeStep, double &cfm, double &erp);
+
+  // copy Webots values into ODE arrays, whatever the precision of dReal
+  void vector3ToOde(const WbVector3 &v, dReal result[3]);
+  void quaternionToOde(const WbQuaternion &q, dReal result[4]);
 };
 
 #endif
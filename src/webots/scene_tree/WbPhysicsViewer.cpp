@@ -208,7 +208,7 @@ void WbPhysicsViewer::updateCenterOfMass() {
 void WbPhysicsViewer::updateInertiaMatrix() {
   if (mSolid->mass() != 0.0 && (mIncludingExcludingDescendants->currentIndex() == LOCAL)) {
     mInertiaMatrixMainLabel->setText(tr("Inertia matrix:"));
-    const double *const I = mSolid->inertiaMatrix();
+    const dReal *const I = mSolid->inertiaMatrix();
     for (int i = 0; i < 3; ++i) {
       mInertiaMatrixLabel[i]->setText(WbPrecision::doubleToString(I[i], WbPrecision::GUI_MEDIUM));
       mInertiaMatrixLabel[i + 3]->setText(WbPrecision::doubleToString(I[i + 4], WbPrecision::GUI_MEDIUM));
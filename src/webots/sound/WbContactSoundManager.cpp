@@ -59,7 +59,7 @@ void WbContactSoundManager::clearAllContactSoundSources() {
   gContactSounds.clear();
 }
 
-void WbContactSoundManager::update(const QList<WbOdeContact> &odeContacts) {
+void WbContactSoundManager::update(const QVector<WbOdeContact> &odeContacts) {
   foreach (const WbOdeContact &odeContact, odeContacts)
     newOdeContact(odeContact);
 
@@ -19,12 +19,12 @@
 // Description: manage contact sounds
 //
 
-#include <QtCore/QList>
+#include <QtCore/QVector>
 
 class WbOdeContact;
 
 namespace WbContactSoundManager {
-  void update(const QList<WbOdeContact> &odeContacts);
+  void update(const QVector<WbOdeContact> &odeContacts);
   void clearAllContactSoundSources();
 };  // namespace WbContactSoundManager
 
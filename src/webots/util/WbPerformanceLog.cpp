@@ -19,6 +19,10 @@
 #include "WbSysInfo.hpp"
 
 #include <QtCore/QElapsedTimer>
+
+#include <ode/ode.h>
+
+#include <algorithm>
 #include <cassert>
 
 class Measurement {
@@ -71,13 +75,32 @@ double Measurement::totalValue() const {
 }
 
 static bool gLogSystemInfo = false;
-static const char *const gInfoLabels[] = {"loading",           "prePhysics",
-                                          "physics",           "postPhysics",
-                                          "mainRendering",     "virtualRealityHeadsetRendering",
-                                          "gpuMemoryTransfer", "trianglesCount",
-                                          "deviceRendering",   "deviceWindowRendering",
+static const char *const gInfoLabels[] = {"loading",
+                                          "prePhysics",
+                                          "physics",
+                                          "postPhysics",
+                                          "mainRendering",
+                                          "virtualRealityHeadsetRendering",
+                                          "gpuMemoryTransfer",
+                                          "trianglesCount",
+                                          "removedContactsCount",
+                                          "awakeBodiesCount",
+                                          "sleepingBodiesCount",
+                                          "contactJointsCount",
+                                          "contactJointAllocationsCount",
+                                          "deviceRendering",
+                                          "deviceWindowRendering",
                                           "controller"};
 
+static const char *const gGeomClassLabels[] = {"sphere", "box",    "capsule",   "cylinder", "plane",
+                                               "ray",    "convex", "transform", "trimesh",  "heightfield"};
+// number of solid pairs written in the log, the most expensive ones first
+static const int MAX_LOGGED_COLLISION_PAIRS = 20;
+
+static QString geomClassLabel(int geomClass) {
+  return geomClass <= dHeightfieldClass ? gGeomClassLabels[geomClass] : QString("class%1").arg(geomClass);
+}
+
 WbPerformanceLog *WbPerformanceLog::cInstance = NULL;
 
 void WbPerformanceLog::createInstance(const QString &fileName, int stepsCount) {
@@ -110,9 +133,13 @@ WbPerformanceLog::WbPerformanceLog(const QString &fileName, int stepsCount) :
   mFile = new QFile(mFileName);
   for (int i = 0; i < INFO_COUNT; ++i)
     mTimers[i] = new QElapsedTimer();
+  // dCollide() records the cost of each pair of geometry classes
+  dCollideEnableProfiling(1);
+  dCollideResetProfiles();
 }
 
 WbPerformanceLog::~WbPerformanceLog() {
+  dCollideEnableProfiling(0);
   for (int i = 0; i < INFO_COUNT; ++i) {
     delete mTimers[i];
     mTimers[i] = NULL;
@@ -120,8 +147,11 @@ WbPerformanceLog::~WbPerformanceLog() {
 }
 
 void WbPerformanceLog::worldClosed(const QString &worldName, const QString &worldMetrics) {
-  if (mStepsCount == 0)
+  if (mStepsCount == 0) {
+    mCollisionPairCosts.clear();
+    dCollideResetProfiles();
     return;
+  }
 
   // log the system info only once per file if requested
   bool logSysInfo = gLogSystemInfo && !mFile->exists();
@@ -146,6 +176,7 @@ void WbPerformanceLog::worldClosed(const QString &worldName, const QString &worl
   closeFile();
 
   writeTotalValues();
+  writeCollisionCosts();
 
   // reset values
   mIsLogCompleted = false;
@@ -162,6 +193,8 @@ void WbPerformanceLog::worldClosed(const QString &worldName, const QString &worl
   foreach (const QString &key, mControllersValues.keys())
     delete mControllersValues[key];
   mControllersValues.clear();
+  mCollisionPairCosts.clear();
+  dCollideResetProfiles();
 }
 
 void WbPerformanceLog::writeTotalValues() {
@@ -184,7 +217,7 @@ void WbPerformanceLog::writeTotalValues() {
   QStringList headers;
   for (int i = 0; i < INFO_COUNT - 4; ++i) {
     QString s = QString("<") + gInfoLabels[i];
-    if (i == MAIN_TRIANGLES_COUNT)
+    if (isCount(i))
       s += ">";
     else
       s += "(ms)>";
@@ -201,7 +234,7 @@ void WbPerformanceLog::writeTotalValues() {
   int i = 0;
   for (; i < INFO_COUNT - 4; ++i) {
     double value = 0.0;
-    if (i == MAIN_TRIANGLES_COUNT)
+    if (isCount(i))
       value = ((double)mValues[i]) / ((double)mValuesCount[i]);
     else if (mValuesCount[i] == 0)
       value = 0;
@@ -220,7 +253,7 @@ void WbPerformanceLog::writeTotalValues() {
   out << "\n" << QString("TOT").leftJustified(6, ' ') << " " << QString::number(mStepsCount).rightJustified(12, ' ') << " ";
   for (i = 0; i < INFO_COUNT - 4; ++i) {
     double value = 0.0;
-    if (i == MAIN_TRIANGLES_COUNT)
+    if (isCount(i))
       value = mValues[i];
     else
       value = 1e-3 * mValues[i];
@@ -237,6 +270,63 @@ void WbPerformanceLog::writeTotalValues() {
   closeFile();
 }
 
+void WbPerformanceLog::writeCollisionCosts() {
+  struct ClassPairCost {
+    int class1, class2;
+    dCollideProfile profile;
+  };
+  QVector<ClassPairCost> classPairCosts;
+  for (int i = 0; i < dGeomNumClasses; ++i) {
+    for (int j = i; j < dGeomNumClasses; ++j) {
+      ClassPairCost cost = {i, j, {0, 0, 0.0}};
+      dCollideGetProfile(i, j, &cost.profile);
+      if (cost.profile.callCount > 0)
+        classPairCosts.append(cost);
+    }
+  }
+  if (classPairCosts.isEmpty() && mCollisionPairCosts.isEmpty())
+    return;
+
+  // the most expensive pairs first
+  std::stable_sort(classPairCosts.begin(), classPairCosts.end(),
+                   [](const ClassPairCost &a, const ClassPairCost &b) { return a.profile.time > b.profile.time; });
+  std::stable_sort(mCollisionPairCosts.begin(), mCollisionPairCosts.end(),
+                   [](const CollisionPairCost &a, const CollisionPairCost &b) { return a.nanoseconds > b.nanoseconds; });
+
+  if (!openFile())
+    return;
+  QTextStream out(mFile);
+  QStringList headers;
+  headers << "<callsCount>"
+          << "<contactsCount>"
+          << "<time(ms)>"
+          << "<timePerCall(us)>";
+  out << "Collision detection per geometry class pair:\n";
+  out << QString("<classes>").leftJustified(24, ' ') << " " << headers.join(" ") << "\n";
+  foreach (const ClassPairCost &cost, classPairCosts) {
+    const QString classes = geomClassLabel(cost.class1) + "-" + geomClassLabel(cost.class2);
+    out << classes.leftJustified(24, ' ') << " "
+        << QString::number(cost.profile.callCount).rightJustified(headers[0].size(), ' ') << " "
+        << QString::number(cost.profile.contactCount).rightJustified(headers[1].size(), ' ') << " "
+        << justifiedNumber(1e3 * cost.profile.time, headers[2].size()) << " "
+        << justifiedNumber(1e6 * cost.profile.time / cost.profile.callCount, headers[3].size()) << "\n";
+  }
+  out << "Collision detection per solid pair (" << qMin(mCollisionPairCosts.size(), MAX_LOGGED_COLLISION_PAIRS) << " of "
+      << mCollisionPairCosts.size() << "):\n";
+  out << "<solids> " << headers.join(" ") << "\n";
+  for (int i = 0; i < mCollisionPairCosts.size() && i < MAX_LOGGED_COLLISION_PAIRS; ++i) {
+    const CollisionPairCost &cost = mCollisionPairCosts[i];
+    out << "\"" << cost.solid1 << "\"-\"" << cost.solid2 << "\" "
+        << QString::number(cost.callsCount).rightJustified(headers[0].size(), ' ') << " "
+        << QString::number(cost.contactsCount).rightJustified(headers[1].size(), ' ') << " "
+        << justifiedNumber(1e-6 * cost.nanoseconds, headers[2].size()) << " "
+        << justifiedNumber(1e-3 * cost.nanoseconds / cost.callsCount, headers[3].size()) << "\n";
+  }
+  out << "\n";
+
+  closeFile();
+}
+
 void WbPerformanceLog::stepChanged() {
   if (mIsLogCompleted)
     return;
@@ -304,6 +394,28 @@ void WbPerformanceLog::reportStepRenderingStats(int trianglesCount) {
   mValuesCount[MAIN_TRIANGLES_COUNT] += 1;
 }
 
+void WbPerformanceLog::reportStepPhysicsStats(int removedContactsCount, int awakeBodiesCount, int sleepingBodiesCount) {
+  mValues[REMOVED_CONTACTS_COUNT] += removedContactsCount;
+  mValuesCount[REMOVED_CONTACTS_COUNT] += 1;
+  mValues[AWAKE_BODIES_COUNT] += awakeBodiesCount;
+  mValuesCount[AWAKE_BODIES_COUNT] += 1;
+  mValues[SLEEPING_BODIES_COUNT] += sleepingBodiesCount;
+  mValuesCount[SLEEPING_BODIES_COUNT] += 1;
+}
+
+void WbPerformanceLog::reportStepContactJointStats(int contactJointsCount, int allocationsCount) {
+  mValues[CONTACT_JOINTS_COUNT] += contactJointsCount;
+  mValuesCount[CONTACT_JOINTS_COUNT] += 1;
+  mValues[CONTACT_JOINT_ALLOCATIONS_COUNT] += allocationsCount;
+  mValuesCount[CONTACT_JOINT_ALLOCATIONS_COUNT] += 1;
+}
+
+void WbPerformanceLog::reportCollisionPairCost(const QString &solid1, const QString &solid2, qint64 callsCount,
+                                               qint64 contactsCount, qint64 nanoseconds) {
+  const CollisionPairCost cost = {solid1, solid2, callsCount, contactsCount, nanoseconds};
+  mCollisionPairCosts.append(cost);
+}
+
 void WbPerformanceLog::writeLog(const QString &text) {
   if (!openFile())
     return;
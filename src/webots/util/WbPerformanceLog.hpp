@@ -42,6 +42,11 @@ public:
     VIRTUAL_REALITY_HEADSET_RENDERING,
     GPU_MEMORY_TRANSFER,
     MAIN_TRIANGLES_COUNT,
+    REMOVED_CONTACTS_COUNT,
+    AWAKE_BODIES_COUNT,
+    SLEEPING_BODIES_COUNT,
+    CONTACT_JOINTS_COUNT,
+    CONTACT_JOINT_ALLOCATIONS_COUNT,
     DEVICE_RENDERING,
     DEVICE_WINDOW_RENDERING,
     CONTROLLER,
@@ -65,6 +70,11 @@ public:
   void setAvgFPS(double value) { mAverageFPS = value; }
 
   void reportStepRenderingStats(int trianglesCount);
+  void reportStepPhysicsStats(int removedContactsCount, int awakeBodiesCount, int sleepingBodiesCount);
+  void reportStepContactJointStats(int contactJointsCount, int allocationsCount);
+  // cost of the collision detection between two solids over the whole simulation, written when the world is closed
+  void reportCollisionPairCost(const QString &solid1, const QString &solid2, qint64 callsCount, qint64 contactsCount,
+                               qint64 nanoseconds);
 
 private:
   static WbPerformanceLog *cInstance;
@@ -75,7 +85,12 @@ private:
   bool openFile();
   void closeFile();
   void writeTotalValues();
+  void writeCollisionCosts();
   static QString justifiedNumber(double value, int size);
+  static bool isCount(int type) {
+    return type == MAIN_TRIANGLES_COUNT || type == REMOVED_CONTACTS_COUNT || type == AWAKE_BODIES_COUNT ||
+           type == SLEEPING_BODIES_COUNT || type == CONTACT_JOINTS_COUNT || type == CONTACT_JOINT_ALLOCATIONS_COUNT;
+  }
 
   QString mFileName;
   QFile *mFile;
@@ -91,6 +106,12 @@ private:
 
   QHash<QString, Measurement *> mRenderingDevicesValues;
   QHash<QString, Measurement *> mControllersValues;
+
+  struct CollisionPairCost {
+    QString solid1, solid2;
+    qint64 callsCount, contactsCount, nanoseconds;
+  };
+  QVector<CollisionPairCost> mCollisionPairCosts;
 };
 
 #endif
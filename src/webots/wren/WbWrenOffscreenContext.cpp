@@ -0,0 +1,95 @@
+// Copyright 1996-2021 Cyberbotics Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "WbWrenOffscreenContext.hpp"
+
+#include "WbStandardPaths.hpp"
+#include "WbSysInfo.hpp"
+#include "WbWrenOpenGlContext.hpp"
+#include "WbWrenPostProcessingEffects.hpp"
+#include "WbWrenRenderingContext.hpp"
+#include "WbWrenShaders.hpp"
+
+#include <wren/config.h>
+#include <wren/gl_state.h>
+#include <wren/scene.h>
+#include <wren/viewport.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtGui/QOffscreenSurface>
+
+#include <cassert>
+
+static QOffscreenSurface *gSurface = NULL;
+
+bool WbWrenOffscreenContext::initialize(int width, int height) {
+  assert(!gSurface);
+  QDir::addSearchPath("gl", WbStandardPaths::resourcesPath() + "wren");
+
+  // same format as the one of the main 3D view, see WbWrenWindow
+  QSurfaceFormat format;
+  format.setVersion(3, 3);
+  format.setProfile(QSurfaceFormat::CoreProfile);
+  format.setRedBufferSize(8);
+  format.setGreenBufferSize(8);
+  format.setBlueBufferSize(8);
+#ifndef __APPLE__
+  format.setAlphaBufferSize(8);
+#endif
+  format.setDepthBufferSize(24);
+  format.setStencilBufferSize(8);
+
+  gSurface = new QOffscreenSurface();
+  gSurface->setFormat(format);
+  gSurface->create();
+  WbWrenOpenGlContext::init(qApp, gSurface, format);
+  const QSurfaceFormat actualFormat = WbWrenOpenGlContext::instance()->format();
+  if (!gSurface->isValid() || !WbWrenOpenGlContext::instance()->isValid() ||
+      actualFormat.majorVersion() * 10 + actualFormat.minorVersion() < 33)
+    return false;
+
+  WbWrenOpenGlContext::makeWrenCurrent();
+  wr_scene_init(wr_scene_get_instance());
+  wr_config_set_requires_flush_after_draw(WbSysInfo::isVirtualMachine());
+  wr_config_set_requires_depth_buffer_distortion(WbSysInfo::isVirtualMachine());
+  // the main viewport has no frame buffer as it is never rendered, the devices render into their own frame buffers
+  wr_viewport_set_size(wr_scene_get_viewport(wr_scene_get_instance()), width, height);
+  wr_scene_set_fog_program(wr_scene_get_instance(), WbWrenShaders::fogShader());
+  wr_scene_set_shadow_volume_program(wr_scene_get_instance(), WbWrenShaders::shadowVolumeShader());
+  WbSysInfo::initializeOpenGlInfo();
+  WbWrenOpenGlContext::doneWren();
+
+  WbWrenPostProcessingEffects::loadResources();
+  WbWrenRenderingContext::setWrenRenderingContext(width, height);
+  return true;
+}
+
+void WbWrenOffscreenContext::cleanup() {
+  if (!gSurface)
+    return;
+
+  WbWrenRenderingContext::cleanup();
+  if (wr_gl_state_is_initialized()) {
+    WbWrenOpenGlContext::makeWrenCurrent();
+    WbWrenPostProcessingEffects::clearResources();
+    wr_scene_destroy();
+    WbWrenShaders::deleteShaders();
+    WbWrenOpenGlContext::doneWren();
+  }
+  WbWrenOpenGlContext::destroy();
+
+  delete gSurface;
+  gSurface = NULL;
+}
@@ -0,0 +1,29 @@
+// Copyright 1996-2021 Cyberbotics Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef WB_WREN_OFFSCREEN_CONTEXT_HPP
+#define WB_WREN_OFFSCREEN_CONTEXT_HPP
+
+//
+// Description: WREN context created on an offscreen surface instead of the 3D view of the main window,
+//              so that a world can be loaded and stepped without creating any window
+//
+
+namespace WbWrenOffscreenContext {
+  // creates the OpenGL context and initializes the WREN scene, returns false if the rendering system cannot be initialized
+  bool initialize(int width, int height);
+  void cleanup();
+};  // namespace WbWrenOffscreenContext
+
+#endif
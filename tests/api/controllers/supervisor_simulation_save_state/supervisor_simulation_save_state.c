@@ -0,0 +1,75 @@
+/*
+ * Description:  Test Supervisor device API
+ *               This file contains tests of the in-memory simulation states:
+ *                 wb_supervisor_simulation_save_state,
+ *                 wb_supervisor_simulation_load_state
+ *               The world uses the "sweepAndPrune" broadphase whose geoms are removed from and added back to their space
+ *               when a state is loaded, and QuickStep warm starting with boxes which fall asleep.
+ */
+
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define TIME_STEP 8
+#define N_BOXES 4
+#define N_STEPS 250
+
+static WbNodeRef boxes[N_BOXES];
+
+static void record_poses(double *poses) {
+  for (int i = 0; i < N_BOXES; ++i) {
+    const double *position = wb_supervisor_node_get_position(boxes[i]);
+    const double *orientation = wb_supervisor_node_get_orientation(boxes[i]);
+    for (int j = 0; j < 3; ++j)
+      poses[12 * i + j] = position[j];
+    for (int j = 0; j < 9; ++j)
+      poses[12 * i + 3 + j] = orientation[j];
+  }
+}
+
+static void run(double *poses) {
+  for (int i = 0; i < N_STEPS; ++i)
+    wb_robot_step(TIME_STEP);
+  record_poses(poses);
+}
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const char *defs[N_BOXES] = {"BOX1", "BOX2", "BOX3", "BOX4"};
+  for (int i = 0; i < N_BOXES; ++i) {
+    boxes[i] = wb_supervisor_node_get_from_def(defs[i]);
+    ts_assert_pointer_not_null(boxes[i], "The supervisor cannot get the WbNodeRef of %s.", defs[i]);
+  }
+
+  // the boxes are still falling
+  wb_robot_step(10 * TIME_STEP);
+  wb_supervisor_simulation_save_state("falling");
+
+  double poses[12 * N_BOXES];
+  double replayed_poses[12 * N_BOXES];
+  run(poses);
+  const double end_time = wb_robot_get_time();
+
+  // the boxes have fallen asleep in the meantime, the contact joints of the disabled bodies are kept by ODE
+  // the state is applied before the next step, which starts from the saved time
+  for (int pass = 0; pass < 2; ++pass) {
+    wb_supervisor_simulation_load_state("falling");
+    run(replayed_poses);
+    ts_assert_double_equal(wb_robot_get_time(), end_time, "The simulation time was not loaded (pass %d).", pass);
+    ts_assert_doubles_equal(12 * N_BOXES, replayed_poses, poses, "The poses differ after the state was loaded (pass %d).",
+                            pass);
+  }
+
+  // loading a state which was never saved does nothing
+  wb_supervisor_simulation_load_state("unknown");
+  wb_robot_step(TIME_STEP);
+  ts_assert_double_in_delta(wb_robot_get_time(), end_time + 0.001 * TIME_STEP, 1e-9,
+                            "An unknown state changed the simulation time.");
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}
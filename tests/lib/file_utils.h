@@ -46,7 +46,7 @@ char *get_file_content(const char *filename) {
 
 bool compare_file_content(const char *fn1, const char *fn2) {
   FILE *f1 = fopen(fn1, "r");
-  FILE *f2 = fopen(fn1, "r");
+  FILE *f2 = fopen(fn2, "r");
 
   if (f1 == NULL || f2 == NULL)
     return false;
@@ -0,0 +1,82 @@
+/*
+ * Description: Test the articulated-body solver (WorldInfo.physicsSolver "articulated") against the closed-form solution
+ *              of small oscillations: a rod hanging from a hinge and a chain of two rods started in its slow normal mode.
+ *              The hinge anchors must not drift apart.
+ */
+
+#include <math.h>
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define LENGTH 0.5
+#define WIDTH 0.02
+#define GRAVITY 9.81
+#define AMPLITUDE 0.05
+#define DURATION 2.0
+
+static double angle(const double *anchor, const double *center) {
+  return atan2(center[0] - anchor[0], anchor[2] - center[2]);
+}
+
+static double distance(const double *anchor, const double *center) {
+  return sqrt((center[0] - anchor[0]) * (center[0] - anchor[0]) + (center[2] - anchor[2]) * (center[2] - anchor[2]));
+}
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const int time_step = (int)wb_robot_get_basic_time_step();
+  const WbNodeRef rod = wb_supervisor_node_get_from_def("ROD");
+  const WbNodeRef upper_rod = wb_supervisor_node_get_from_def("UPPER_ROD");
+  const WbNodeRef lower_rod = wb_supervisor_node_get_from_def("LOWER_ROD");
+  const double rod_anchor[3] = {0.0, 0.0, 1.0};
+  const double chain_anchor[3] = {1.0, 0.0, 1.0};
+
+  // uniform rods of mass m: inertia about the center m * (LENGTH^2 + WIDTH^2) / 12
+  const double ic = (LENGTH * LENGTH + WIDTH * WIDTH) / 12.0;
+
+  // single rod: omega^2 = m * g * LENGTH / 2 / (Ic + m * LENGTH^2 / 4)
+  const double rod_omega = sqrt(GRAVITY * LENGTH / 2.0 / (ic + LENGTH * LENGTH / 4.0));
+
+  // chain of two rods, absolute angles: M * theta'' + K * theta = 0 with
+  // M / m = [Ic + 5 * LENGTH^2 / 4, LENGTH^2 / 2; LENGTH^2 / 2, Ic + LENGTH^2 / 4]
+  // and K / m = g * LENGTH * [3 / 2, 0; 0, 1 / 2]
+  const double a = ic + 1.25 * LENGTH * LENGTH, b = 0.5 * LENGTH * LENGTH, c = ic + 0.25 * LENGTH * LENGTH;
+  const double k1 = 1.5 * GRAVITY * LENGTH, k2 = 0.5 * GRAVITY * LENGTH;
+  const double qa = a * c - b * b, qb = k1 * c + k2 * a, qc = k1 * k2;
+  const double slow_lambda = (qb - sqrt(qb * qb - 4.0 * qa * qc)) / (2.0 * qa);
+  const double chain_omega = sqrt(slow_lambda);
+  // the world starts the chain in this mode: the lower rod angle is AMPLITUDE * ratio
+  const double ratio = (k1 - slow_lambda * a) / (slow_lambda * b);
+
+  double max_gap = 0.0;
+  while (wb_robot_get_time() < DURATION) {
+    ts_assert_boolean_equal(wb_robot_step(time_step) != -1, "Controller stopped before the end of the test.");
+    const double t = wb_robot_get_time();
+
+    const double *center = wb_supervisor_node_get_position(rod);
+    ts_assert_double_in_delta(angle(rod_anchor, center), AMPLITUDE * cos(rod_omega * t), 0.002,
+                              "The angle of the single rod does not follow the closed-form solution at %g s.", t);
+    max_gap = fmax(max_gap, fabs(distance(rod_anchor, center) - LENGTH / 2.0));
+
+    const double *upper_center = wb_supervisor_node_get_position(upper_rod);
+    const double *lower_center = wb_supervisor_node_get_position(lower_rod);
+    // the lower end of the upper rod, where the second hinge is
+    const double joint[3] = {2.0 * upper_center[0] - chain_anchor[0], 0.0, 2.0 * upper_center[2] - chain_anchor[2]};
+    ts_assert_double_in_delta(angle(chain_anchor, upper_center), AMPLITUDE * cos(chain_omega * t), 0.002,
+                              "The angle of the upper rod does not follow the slow normal mode at %g s.", t);
+    ts_assert_double_in_delta(angle(joint, lower_center), ratio * AMPLITUDE * cos(chain_omega * t), 0.002,
+                              "The angle of the lower rod does not follow the slow normal mode at %g s.", t);
+    max_gap = fmax(max_gap, fabs(distance(chain_anchor, upper_center) - LENGTH / 2.0));
+    max_gap = fmax(max_gap, fabs(distance(joint, lower_center) - LENGTH / 2.0));
+  }
+
+  // in maximal coordinates, the anchors drift apart by about 1e-6 m with this time step
+  ts_assert_double_in_delta(max_gap, 0.0, 1e-9, "The hinge anchors drifted apart by %g m.", max_gap);
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+/*
+ * Description: Test every value of WorldInfo.broadphase: balls are dropped on pedestals of different heights spread on a large
+ *              area and must come to rest on top of them, which requires the broadphase to find every ball-pedestal pair.
+ */
+
+#include <stdio.h>
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define PEDESTAL_COUNT 6
+#define BALL_RADIUS 0.1
+#define DROP_HEIGHT 0.5
+#define DURATION 2.0
+
+static const char *broadphases[] = {"simple", "sweepAndPrune", "hash", "quadTree", "bvh", "auto"};
+// centers of the top faces of the pedestals, as defined in the world
+static const double tops[PEDESTAL_COUNT][3] = {{0, 0, 0.2},     {3, 0, 0.5},      {-40, 25, 1},
+                                               {60, -35, 0.1}, {-75, -80, 2}, {90, 70, 0.3}};
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const int time_step = (int)wb_robot_get_basic_time_step();
+  const WbFieldRef broadphase = wb_supervisor_node_get_field(wb_supervisor_node_get_from_def("WORLD_INFO"), "broadphase");
+  WbNodeRef balls[PEDESTAL_COUNT];
+  for (int i = 0; i < PEDESTAL_COUNT; ++i) {
+    char name[16];
+    sprintf(name, "BALL_%d", i + 1);
+    balls[i] = wb_supervisor_node_get_from_def(name);
+  }
+
+  for (size_t b = 0; b < sizeof(broadphases) / sizeof(broadphases[0]); ++b) {
+    wb_supervisor_field_set_sf_string(broadphase, broadphases[b]);
+    for (int i = 0; i < PEDESTAL_COUNT; ++i) {
+      const double translation[3] = {tops[i][0], tops[i][1], tops[i][2] + DROP_HEIGHT};
+      wb_supervisor_field_set_sf_vec3f(wb_supervisor_node_get_field(balls[i], "translation"), translation);
+      wb_supervisor_node_reset_physics(balls[i]);
+    }
+
+    const double end = wb_robot_get_time() + DURATION;
+    while (wb_robot_get_time() < end)
+      ts_assert_boolean_equal(wb_robot_step(time_step) != -1, "Controller stopped before the end of the test.");
+
+    for (int i = 0; i < PEDESTAL_COUNT; ++i) {
+      const double *position = wb_supervisor_node_get_position(balls[i]);
+      ts_assert_vec3_in_delta(position[0], position[1], position[2], tops[i][0], tops[i][1], tops[i][2] + BALL_RADIUS, 0.005,
+                              "With the '%s' broadphase, ball %d is at (%g, %g, %g) instead of resting on its pedestal.",
+                              broadphases[b], i + 1, position[0], position[1], position[2]);
+    }
+  }
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}
@@ -1,3 +1,4 @@
+#include <webots/nodes.h>
 #include <webots/receiver.h>
 #include <webots/robot.h>
 #include <webots/supervisor.h>
@@ -7,13 +8,92 @@
 #include "../../../lib/ts_assertion.h"
 #include "../../../lib/ts_utils.h"
 
+#include <stdio.h>
 #include <time.h>
 
 #define TIME_STEP 16
+#define RECORDED_STEPS 200
+#define N_PASSES 3
 
 static const char *ode_dif = "../../plugins/physics/ode_dif_exporter/ode.dif";
 static const char *ode_tmp_dif = "ode_tmp.dif";
 
+// the world is run once per thread count, its trajectories have to be identical. Webots clamps WorldInfo.optimalThreadCount
+// to the General/numberOfThreads preference, which defaults to the number of cores: the runs whose thread count cannot be
+// applied are skipped and reported
+static const int thread_counts[N_PASSES] = {1, 2, 8};
+static const char *trajectory_files[N_PASSES] = {"trajectory_1.txt", "trajectory_2.txt", "trajectory_8.txt"};
+
+static void remove_stale_files() {
+  // the files written by the previous runs are only kept if the last one was written just before the world reload
+  time_t now;
+  time(&now);
+  double delta = -1.0;
+  if (file_exists(ode_tmp_dif))
+    delta = difftime(now, file_get_creation_time(ode_tmp_dif));
+  for (int i = 0; i < N_PASSES; ++i) {
+    if (file_exists(trajectory_files[i])) {
+      const double d = difftime(now, file_get_creation_time(trajectory_files[i]));
+      if (delta < 0.0 || d < delta)
+        delta = d;
+    }
+  }
+  // printf("delta time = %f\n", delta);
+  if (delta <= 2.0)
+    return;
+
+  if (file_exists(ode_tmp_dif)) {
+    ts_assert_boolean_equal(remove_file(ode_tmp_dif), "Cannot remove ODE tmp dif file");
+    ts_assert_boolean_not_equal(file_exists(ode_tmp_dif), "Cannot remove ODE tmp dif file");
+  }
+  for (int i = 0; i < N_PASSES; ++i) {
+    if (file_exists(trajectory_files[i]))
+      ts_assert_boolean_equal(remove_file(trajectory_files[i]), "Cannot remove trajectory file '%s'", trajectory_files[i]);
+  }
+}
+
+static void reload_world() {
+  wb_supervisor_world_reload();
+  wb_robot_cleanup();
+  exit(EXIT_SUCCESS);
+}
+
+// check the DIF file exported by the physics plugin against the one of the previous run
+static bool check_ode_dif(const char *message) {
+  if (string_starts_with("Failure", message))
+    ts_assert_boolean_equal(0, "%s", message);
+
+  ts_assert_boolean_equal(file_exists(ode_dif), "Expected ODE dif file not present");
+
+  if (!file_exists(ode_tmp_dif)) {
+    move_file(ode_dif, ode_tmp_dif);
+    reload_world();
+  }
+
+  ts_assert_boolean_equal(compare_file_content(ode_tmp_dif, ode_dif), "The ODE dif files contents differ");
+  ts_assert_boolean_equal(file_contains_string(ode_dif, "body[5]") && file_contains_string(ode_dif, "dynamics.hinge_joint"),
+                          "The ODE dif file doesn't contain the expected patterns");
+  return true;
+}
+
+// the pose of the top-level solids is written in hexadecimal so that any difference is detected
+static void record_poses(FILE *file, WbFieldRef children) {
+  const int count = wb_supervisor_field_get_count(children);
+  for (int i = 0; i < count; ++i) {
+    WbNodeRef node = wb_supervisor_field_get_mf_node(children, i);
+    if (wb_supervisor_node_get_type(node) != WB_NODE_SOLID)
+      continue;
+    const double *position = wb_supervisor_node_get_position(node);
+    const double *orientation = wb_supervisor_node_get_orientation(node);
+    fprintf(file, "%d:", i);
+    for (int j = 0; j < 3; ++j)
+      fprintf(file, " %a", position[j]);
+    for (int j = 0; j < 9; ++j)
+      fprintf(file, " %a", orientation[j]);
+    fprintf(file, "\n");
+  }
+}
+
 int main(int argc, char **argv) {
   ts_setup(argv[0]);
 
@@ -23,51 +103,73 @@ int main(int argc, char **argv) {
   if (file_exists(ode_dif))
     ts_assert_boolean_equal(remove_file(ode_dif), "Cannot remove ODE dif file");
 
-  time_t now;
-  time(&now);
+  remove_stale_files();
 
+  // the first run only exports the DIF file, the next ones record a trajectory each
+  int pass = -1;
   if (file_exists(ode_tmp_dif)) {
-    double delta = difftime(now, file_get_creation_time(ode_tmp_dif));
-    // printf("delta time = %f\n", delta);
-    if (delta > 2.0) {
-      ts_assert_boolean_equal(remove_file(ode_tmp_dif), "Cannot remove ODE tmp dif file");
-      ts_assert_boolean_not_equal(file_exists(ode_tmp_dif), "Cannot remove ODE tmp dif file");
+    pass = 0;
+    while (pass < N_PASSES && file_exists(trajectory_files[pass]))
+      pass++;
+    ts_assert_boolean_not_equal(pass == N_PASSES, "Unexpected trajectory files");
+  }
+
+  WbFieldRef children = wb_supervisor_node_get_field(wb_supervisor_node_get_root(), "children");
+  WbFieldRef thread_count = NULL;
+  FILE *trajectory = NULL;
+  if (pass >= 0) {
+    // the thread count has to be set before the first step to be used from the start of the simulation
+    const int count = wb_supervisor_field_get_count(children);
+    for (int i = 0; i < count; ++i) {
+      WbNodeRef node = wb_supervisor_field_get_mf_node(children, i);
+      if (wb_supervisor_node_get_type(node) == WB_NODE_WORLD_INFO)
+        thread_count = wb_supervisor_node_get_field(node, "optimalThreadCount");
     }
+    ts_assert_pointer_not_null(thread_count, "WorldInfo.optimalThreadCount not found");
+    wb_supervisor_field_set_sf_int32(thread_count, thread_counts[pass]);
+    trajectory = fopen(trajectory_files[pass], "w");
+    ts_assert_pointer_not_null(trajectory, "Cannot open trajectory file '%s'", trajectory_files[pass]);
   }
 
+  // only the first pass waits for the DIF file, which is the same for every thread count
+  bool ode_dif_checked = pass > 0;
+  int step = 0;
   while (wb_robot_step(TIME_STEP) != -1) {
     while (wb_receiver_get_queue_length(receiver) > 0) {
-      const char *message = wb_receiver_get_data(receiver);
-      if (string_starts_with("Failure", message))
-        ts_assert_boolean_equal(0, "%s", message);
-
-      ts_assert_boolean_equal(file_exists(ode_dif), "Expected ODE dif file not present");
-
-      if (file_exists(ode_tmp_dif)) {
-        // a previous simulation has run
-        if (compare_file_content(ode_tmp_dif, ode_dif)) {
-          if (file_contains_string(ode_dif, "body[5]") && file_contains_string(ode_dif, "dynamics.hinge_joint")) {
-            ts_send_success();
-            return EXIT_SUCCESS;
-          } else {
-            ts_assert_boolean_equal(0, "The ODE dif file doesn't contain the expected patterns");
-            wb_robot_cleanup();
-            exit(EXIT_FAILURE);
-          }
-        } else {
-          ts_assert_boolean_equal(0, "The ODE dif files contents differ");
-          wb_robot_cleanup();
-          exit(EXIT_FAILURE);
-        }
-      } else {
-        move_file(ode_dif, ode_tmp_dif);
-        wb_supervisor_world_reload();
-        wb_robot_cleanup();
-        exit(EXIT_SUCCESS);
-      }
-
+      if (!ode_dif_checked)
+        ode_dif_checked = check_ode_dif(wb_receiver_get_data(receiver));
       wb_receiver_next_packet(receiver);
     }
+
+    if (trajectory == NULL)
+      continue;
+
+    if (step == 0 && wb_supervisor_field_get_sf_int32(thread_count) != thread_counts[pass]) {
+      printf("Skipping the run with %d threads: the General/numberOfThreads preference limits the physics to %d threads.\n",
+             thread_counts[pass], wb_supervisor_field_get_sf_int32(thread_count));
+      fprintf(trajectory, "skipped\n");
+      step = RECORDED_STEPS;
+    }
+
+    if (step < RECORDED_STEPS) {
+      record_poses(trajectory, children);
+      step++;
+    }
+
+    if (step == RECORDED_STEPS && ode_dif_checked) {
+      fclose(trajectory);
+      if (pass < N_PASSES - 1)
+        reload_world();
+
+      for (int i = 1; i < N_PASSES; ++i) {
+        if (file_contains_string(trajectory_files[i], "skipped"))
+          continue;
+        ts_assert_boolean_equal(compare_file_content(trajectory_files[0], trajectory_files[i]),
+                                "The trajectories with %d and %d threads differ", thread_counts[0], thread_counts[i]);
+      }
+      ts_send_success();
+      return EXIT_SUCCESS;
+    }
   }
 
   wb_robot_cleanup();
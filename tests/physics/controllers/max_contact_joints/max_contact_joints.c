@@ -0,0 +1,39 @@
+/*
+ * Description: Test ContactProperties.maxContactJoints: the contact points of boxes resting on the floor are reduced to the
+ *              number set for their contact material, the boxes without limit keep the 4 corners of their bottom face. With
+ *              3 contact points, a box still rests flat on the floor.
+ */
+
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define BOX_HALF_SIZE 0.1
+
+static const char *boxes[] = {"DEFAULT_BOX", "THREE_CONTACTS_BOX", "ONE_CONTACT_BOX"};
+static const int expected_contacts[] = {4, 3, 1};
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const int time_step = (int)wb_robot_get_basic_time_step();
+  while (wb_robot_get_time() < 0.5)
+    wb_robot_step(time_step);
+
+  for (int i = 0; i < 3; ++i) {
+    const WbNodeRef box = wb_supervisor_node_get_from_def(boxes[i]);
+    const int count = wb_supervisor_node_get_number_of_contact_points(box, false);
+    ts_assert_int_equal(count, expected_contacts[i], "'%s' has %d contact points instead of %d.", boxes[i], count,
+                        expected_contacts[i]);
+  }
+
+  const double *position = wb_supervisor_node_get_position(wb_supervisor_node_get_from_def("THREE_CONTACTS_BOX"));
+  ts_assert_double_in_delta(position[2], BOX_HALF_SIZE, 0.005, "The box with 3 contact points does not rest on the floor.");
+  const double *orientation = wb_supervisor_node_get_orientation(wb_supervisor_node_get_from_def("THREE_CONTACTS_BOX"));
+  ts_assert_double_in_delta(orientation[8], 1.0, 1e-4, "The box with 3 contact points is tilted.");
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include <webots/nodes.h>
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/file_utils.h"
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define TIME_STEP 16
+#define RECORDED_STEPS 150
+#define N_PASSES 2
+#define N_SOLIDS 9
+
+// the world is run serially and with the poses computed by the worker threads, the poses of the solids have to be identical.
+// The solids are nested in scaled and rotated transforms, are linked by joints, have an offset center of mass or are merged
+// with the body of their upper solid
+static const int thread_counts[N_PASSES] = {1, 4};
+static const char *pose_files[N_PASSES] = {"poses_1.txt", "poses_4.txt"};
+static const char *solids[N_SOLIDS] = {"ARM", "LINK_1", "LINK_1_TIP", "LINK_2", "ROD", "BOB", "BOX_1", "BOX_2", "BOX_3"};
+
+static void remove_stale_files() {
+  // the files written by the previous runs are only kept if the last one was written just before the world reload
+  time_t now;
+  time(&now);
+  double delta = -1.0;
+  for (int i = 0; i < N_PASSES; ++i) {
+    if (file_exists(pose_files[i])) {
+      const double d = difftime(now, file_get_creation_time(pose_files[i]));
+      if (delta < 0.0 || d < delta)
+        delta = d;
+    }
+  }
+  if (delta <= 2.0)
+    return;
+
+  for (int i = 0; i < N_PASSES; ++i) {
+    if (file_exists(pose_files[i]))
+      ts_assert_boolean_equal(remove_file(pose_files[i]), "Cannot remove pose file '%s'", pose_files[i]);
+  }
+}
+
+// both the fields set from the bodies and the absolute poses are written in hexadecimal so that any difference is detected
+static void record_poses(FILE *file, WbNodeRef *nodes) {
+  for (int i = 0; i < N_SOLIDS; ++i) {
+    const double *translation = wb_supervisor_field_get_sf_vec3f(wb_supervisor_node_get_field(nodes[i], "translation"));
+    const double *rotation = wb_supervisor_field_get_sf_rotation(wb_supervisor_node_get_field(nodes[i], "rotation"));
+    const double *position = wb_supervisor_node_get_position(nodes[i]);
+    const double *orientation = wb_supervisor_node_get_orientation(nodes[i]);
+    fprintf(file, "%s:", solids[i]);
+    for (int j = 0; j < 3; ++j)
+      fprintf(file, " %a", translation[j]);
+    for (int j = 0; j < 4; ++j)
+      fprintf(file, " %a", rotation[j]);
+    for (int j = 0; j < 3; ++j)
+      fprintf(file, " %a", position[j]);
+    for (int j = 0; j < 9; ++j)
+      fprintf(file, " %a", orientation[j]);
+    fprintf(file, "\n");
+  }
+}
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  remove_stale_files();
+
+  int pass = 0;
+  while (pass < N_PASSES && file_exists(pose_files[pass]))
+    pass++;
+  ts_assert_boolean_not_equal(pass == N_PASSES, "Unexpected pose files");
+
+  WbNodeRef nodes[N_SOLIDS];
+  for (int i = 0; i < N_SOLIDS; ++i) {
+    nodes[i] = wb_supervisor_node_get_from_def(solids[i]);
+    ts_assert_pointer_not_null(nodes[i], "Solid '%s' not found", solids[i]);
+  }
+
+  // the thread count has to be set before the first step to be used from the start of the simulation
+  WbFieldRef children = wb_supervisor_node_get_field(wb_supervisor_node_get_root(), "children");
+  WbFieldRef thread_count = NULL;
+  const int count = wb_supervisor_field_get_count(children);
+  for (int i = 0; i < count; ++i) {
+    WbNodeRef node = wb_supervisor_field_get_mf_node(children, i);
+    if (wb_supervisor_node_get_type(node) == WB_NODE_WORLD_INFO)
+      thread_count = wb_supervisor_node_get_field(node, "optimalThreadCount");
+  }
+  ts_assert_pointer_not_null(thread_count, "WorldInfo.optimalThreadCount not found");
+  wb_supervisor_field_set_sf_int32(thread_count, thread_counts[pass]);
+  FILE *poses = fopen(pose_files[pass], "w");
+  ts_assert_pointer_not_null(poses, "Cannot open pose file '%s'", pose_files[pass]);
+
+  int step = 0;
+  while (wb_robot_step(TIME_STEP) != -1) {
+    if (step == 0 && wb_supervisor_field_get_sf_int32(thread_count) != thread_counts[pass]) {
+      // Webots clamps WorldInfo.optimalThreadCount to the General/numberOfThreads preference
+      printf("Skipping the run with %d threads: the General/numberOfThreads preference limits the physics to %d threads.\n",
+             thread_counts[pass], wb_supervisor_field_get_sf_int32(thread_count));
+      fprintf(poses, "skipped\n");
+      step = RECORDED_STEPS;
+    }
+
+    if (step < RECORDED_STEPS) {
+      record_poses(poses, nodes);
+      step++;
+    }
+
+    if (step == RECORDED_STEPS) {
+      fclose(poses);
+      if (pass < N_PASSES - 1) {
+        wb_supervisor_world_reload();
+        wb_robot_cleanup();
+        return EXIT_SUCCESS;
+      }
+
+      if (!file_contains_string(pose_files[1], "skipped"))
+        ts_assert_boolean_equal(compare_file_content(pose_files[0], pose_files[1]),
+                                "The poses computed serially and with %d threads differ", thread_counts[1]);
+      ts_send_success();
+      return EXIT_SUCCESS;
+    }
+  }
+
+  wb_robot_cleanup();
+  return EXIT_SUCCESS;
+}
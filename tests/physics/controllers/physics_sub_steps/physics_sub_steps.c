@@ -0,0 +1,55 @@
+/*
+ * Description: Test WorldInfo.physicsSubSteps: a basic time step of 32 ms is integrated in 4 physics steps of 8 ms. A falling
+ *              ball must follow the semi-implicit Euler integration of gravity with the 8 ms step, while the controller
+ *              still runs every 32 ms, and a ball resting on the floor must stay on it.
+ */
+
+#include <math.h>
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define SUB_STEPS 4
+#define GRAVITY 9.81
+#define START_HEIGHT 100.0
+#define RADIUS 0.1
+#define DURATION 2.0
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const int time_step = (int)wb_robot_get_basic_time_step();
+  const double dt = 0.001 * time_step / SUB_STEPS;
+  const WbNodeRef falling_ball = wb_supervisor_node_get_from_def("FALLING_BALL");
+  const WbNodeRef resting_ball = wb_supervisor_node_get_from_def("RESTING_BALL");
+
+  int n = 0;  // number of physics steps
+  while (wb_robot_get_time() < DURATION) {
+    const double previous_time = wb_robot_get_time();
+    ts_assert_boolean_equal(wb_robot_step(time_step) != -1, "Controller stopped before the end of the test.");
+    n += SUB_STEPS;
+    const double t = wb_robot_get_time();
+    ts_assert_double_in_delta(t - previous_time, 0.001 * time_step, 1e-9,
+                              "The controller is not run every basic time step with sub-steps.");
+
+    // v_k = -g * k * dt and z_k = z_(k-1) + v_k * dt, hence z_n = z_0 - g * dt^2 * n * (n + 1) / 2
+    const double expected = START_HEIGHT - GRAVITY * dt * dt * n * (n + 1) / 2.0;
+    const double *position = wb_supervisor_node_get_position(falling_ball);
+    ts_assert_double_in_delta(position[2], expected, 1e-9,
+                              "The falling ball is not integrated with %d sub-steps at %g s: z = %.12f instead of %.12f.",
+                              SUB_STEPS, t, position[2], expected);
+  }
+
+  // integrated with a single step of 32 ms, the ball would be 0.24 m lower after 2 s
+  const double single_step = START_HEIGHT - GRAVITY * DURATION * (DURATION + 0.001 * time_step) / 2.0;
+  ts_assert_double_is_bigger(wb_supervisor_node_get_position(falling_ball)[2] - single_step, 0.1,
+                             "The falling ball is integrated with the basic time step.");
+
+  const double *position = wb_supervisor_node_get_position(resting_ball);
+  ts_assert_double_in_delta(position[2], RADIUS, 0.005, "The resting ball is not on the floor: z = %g.", position[2]);
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}
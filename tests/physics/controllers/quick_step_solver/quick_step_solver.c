@@ -0,0 +1,76 @@
+/*
+ * Description: Test WorldInfo.physicsSolver "quickStep" and its parameters. With 20 iterations, a tower of 5 boxes stands
+ *              and a falling ball follows the semi-implicit Euler integration of gravity like with the direct solver. The
+ *              parameters are then changed to a single iteration without warm starting and the tower is rebuilt: it has to
+ *              collapse, which shows that the new parameters are used.
+ */
+
+#include <stdio.h>
+#include <webots/robot.h>
+#include <webots/supervisor.h>
+
+#include "../../../lib/ts_assertion.h"
+#include "../../../lib/ts_utils.h"
+
+#define BOX_COUNT 5
+#define BOX_SIZE 0.2
+#define GRAVITY 9.81
+#define BALL_START_HEIGHT 100.0
+#define DURATION 3.0
+
+static WbNodeRef boxes[BOX_COUNT];
+
+static void build_tower() {
+  static const double rotation[4] = {0.0, 0.0, 1.0, 0.0};
+  for (int i = 0; i < BOX_COUNT; ++i) {
+    const double translation[3] = {0.0, 0.0, BOX_SIZE * (i + 0.5)};
+    wb_supervisor_field_set_sf_vec3f(wb_supervisor_node_get_field(boxes[i], "translation"), translation);
+    wb_supervisor_field_set_sf_rotation(wb_supervisor_node_get_field(boxes[i], "rotation"), rotation);
+    wb_supervisor_node_reset_physics(boxes[i]);
+  }
+}
+
+static void run(int time_step, double duration) {
+  const double end = wb_robot_get_time() + duration;
+  while (wb_robot_get_time() < end)
+    ts_assert_boolean_equal(wb_robot_step(time_step) != -1, "Controller stopped before the end of the test.");
+}
+
+int main(int argc, char **argv) {
+  ts_setup(argv[0]);
+
+  const int time_step = (int)wb_robot_get_basic_time_step();
+  const double dt = 0.001 * time_step;
+  const WbNodeRef world_info = wb_supervisor_node_get_from_def("WORLD_INFO");
+  const WbNodeRef ball = wb_supervisor_node_get_from_def("BALL");
+  for (int i = 0; i < BOX_COUNT; ++i) {
+    char name[8];
+    sprintf(name, "BOX_%d", i + 1);
+    boxes[i] = wb_supervisor_node_get_from_def(name);
+  }
+
+  run(time_step, DURATION);
+
+  // z_n = z_0 - g * dt^2 * n * (n + 1) / 2 after n steps
+  const int n = (int)(wb_robot_get_time() / dt + 0.5);
+  const double expected = BALL_START_HEIGHT - GRAVITY * dt * dt * n * (n + 1) / 2.0;
+  ts_assert_double_in_delta(wb_supervisor_node_get_position(ball)[2], expected, 1e-9,
+                            "The falling ball is not integrated like with the direct solver.");
+
+  const double *top = wb_supervisor_node_get_position(boxes[BOX_COUNT - 1]);
+  ts_assert_vec3_in_delta(top[0], top[1], top[2], 0.0, 0.0, BOX_SIZE * (BOX_COUNT - 0.5), 0.05,
+                          "The tower does not stand with 20 iterations, its top is at (%g, %g, %g).", top[0], top[1], top[2]);
+
+  wb_supervisor_field_set_sf_int32(wb_supervisor_node_get_field(world_info, "quickStepIterations"), 1);
+  wb_supervisor_field_set_sf_float(wb_supervisor_node_get_field(world_info, "quickStepOverRelaxation"), 1.0);
+  wb_supervisor_field_set_sf_bool(wb_supervisor_node_get_field(world_info, "quickStepWarmStarting"), false);
+  build_tower();
+  run(time_step, DURATION);
+
+  top = wb_supervisor_node_get_position(boxes[BOX_COUNT - 1]);
+  ts_assert_double_is_bigger(BOX_SIZE * (BOX_COUNT - 1), top[2],
+                             "The tower still stands with a single iteration, its top is at %g m.", top[2]);
+
+  ts_send_success();
+  return EXIT_SUCCESS;
+}